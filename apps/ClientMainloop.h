@@ -50,6 +50,17 @@ class ClientMainloop : boost::noncopyable {
             m_ctx.update();
         }
     }
+    /// @brief Like mainloop(), but instead of returning right away, waits
+    /// (up to the timeout) for a report to arrive.
+    /// @returns false if paused (the mutex is held elsewhere).
+    bool waitForReport(uint64_t timeoutMicroseconds) {
+        lock_type lock(m_mutex, boost::try_to_lock);
+        if (!lock) {
+            return false;
+        }
+        m_ctx.waitForAnyReport(timeoutMicroseconds);
+        return true;
+    }
     mutex_type &getMutex() { return m_mutex; }
 
   private:
@@ -37,6 +37,8 @@
 #include <stdexcept>
 
 static const auto SLEEP_TIME = boost::posix_time::milliseconds(1);
+/// @brief Longest time a loop iteration waits for reports, in microseconds.
+static const uint64_t WAIT_TIME = 1000;
 
 class ClientMainloopThread : boost::noncopyable {
   public:
@@ -64,8 +66,10 @@ class ClientMainloopThread : boost::noncopyable {
     }
 
     void oneLoop() {
-        m_mainloop.mainloop();
-        boost::this_thread::sleep(SLEEP_TIME);
+        if (!m_mainloop.waitForReport(WAIT_TIME)) {
+            /// Paused: don't spin.
+            boost::this_thread::sleep(SLEEP_TIME);
+        }
     }
 
     template <typename T>
@@ -123,19 +123,19 @@ int main(int argc, char *argv[]) {
         OSVR_OrientationState state;
         OSVR_TimeValue timestamp;
         OSVR_ReturnCode ret;
+        /// State may be read while the mainloop thread is running.
+        ret = osvrGetOrientationState(iface.get(), &timestamp, &state);
+        if (ret != OSVR_RETURN_SUCCESS) {
+            cerr << "Sorry, no orientation state available for this route - "
+                    "are you sure you have a device plugged in and your "
+                    "path correct?" << endl;
+            std::cin.ignore();
+            return -1;
+        }
         {
-            /// briefly interrupt the client mainloop so we can get stuff done
-            /// with the client state.
+            /// briefly interrupt the client mainloop so we can send the
+            /// updated route.
             ClientMainloopThread::lock_type lock(client.getMutex());
-            ret = osvrGetOrientationState(iface.get(), &timestamp, &state);
-            if (ret != OSVR_RETURN_SUCCESS) {
-                cerr
-                    << "Sorry, no orientation state available for this route - "
-                       "are you sure you have a device plugged in and your "
-                       "path correct?" << endl;
-                std::cin.ignore();
-                return -1;
-            }
             auto q = osvr::util::fromQuat(state);
 
             // see
@@ -29,33 +29,122 @@
 #include <osvr/Client/Export.h>
 #include <osvr/Client/ClientContext_fwd.h>
 #include <osvr/Client/ClientInterfacePtr.h>
+#include <osvr/Client/InterfaceCore.h>
+#include <osvr/Client/QueuedCallback.h>
 #include <osvr/Common/RouteContainer.h>
+#include <osvr/Common/ClockSync.h>
 #include <osvr/Util/KeyedOwnershipContainer.h>
+#include <osvr/Util/SPSCQueue.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
 #include <boost/any.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 // Standard includes
 #include <string>
 #include <vector>
 #include <map>
+#include <deque>
+#include <atomic>
 
 struct OSVR_ClientContextObject : boost::noncopyable {
   public:
     typedef std::vector<osvr::client::ClientInterfacePtr> InterfaceList;
+    typedef std::vector<osvr::client::InterfaceCorePtr> InterfaceCoreList;
+    typedef boost::recursive_mutex UpdateMutex;
+    typedef boost::lock_guard<UpdateMutex> UpdateLock;
     /// @brief Destructor
     virtual ~OSVR_ClientContextObject();
 
     /// @brief System-wide update method.
+    ///
+    /// With a network thread running, this only delivers callbacks queued by
+    /// that thread (if any), so it is cheap to call. Otherwise, callbacks of
+    /// coalescing interfaces are delivered at the end.
     OSVR_CLIENT_EXPORT void update();
 
+    /// @brief Like update(), but stops delivering callbacks once the given
+    /// time budget has been spent: the rest are delivered by later calls.
+    ///
+    /// Processing network messages (which only updates state) is not
+    /// interrupted, so the budget bounds callback delivery, where time
+    /// generally goes when a burst of reports arrives.
+    ///
+    /// @param microseconds Time budget.
+    /// @param dropSuperseded If true, a pending tracker callback is discarded
+    /// instead of delivered when a newer report for the same interface,
+    /// report type, and sensor is also pending.
+    OSVR_CLIENT_EXPORT void updateWithBudget(uint64_t microseconds,
+                                             bool dropSuperseded);
+
+    /// @brief Blocks until a report for the given interface (or for any
+    /// interface, if null) has been dispatched, or the timeout expires.
+    ///
+    /// Without a network thread, this waits on the connection and processes
+    /// messages as they arrive, like a series of update() calls. With one,
+    /// this sleeps until that thread handles a matching report, then
+    /// delivers queued callbacks as update() would.
+    ///
+    /// @returns true if a matching report was dispatched.
+    OSVR_CLIENT_EXPORT bool
+    waitForReport(::osvr::client::ClientInterface const *iface,
+                  uint64_t timeoutMicroseconds);
+
+    /// @brief Called for every report dispatched to any interface.
+    void noteReport() { ++m_reportCount; }
+
+    /// @brief Starts processing network messages on an internal thread
+    /// instead of in update().
+    ///
+    /// @param callbacksOnNetworkThread If true, callbacks are called directly
+    /// on the network thread. Otherwise, they are queued and called from
+    /// update(), on whatever thread calls it.
+    OSVR_CLIENT_EXPORT void startNetworkThread(bool callbacksOnNetworkThread);
+
+    /// @brief Stops the network thread, if running, discarding any callbacks
+    /// still queued. Derived classes must call this in their destructor.
+    OSVR_CLIENT_EXPORT void stopNetworkThread();
+
+    /// @brief Is the network thread running?
+    bool hasNetworkThread() const { return m_networkThread.joinable(); }
+
+    /// @brief Are callbacks being queued for delivery in update()?
+    bool isQueueingCallbacks() const {
+        return m_queueCallbacks || m_deferCallbacks;
+    }
+
+    /// @brief Can callbacks be deferred to update() at all? False if they
+    /// must be called directly on the network thread.
+    bool canDeferCallbacks() const { return !m_callbacksOnNetworkThread; }
+
+    /// @brief Queues a callback invocation to be run by update() - only
+    /// called during message processing when isQueueingCallbacks() is true
+    /// or, for coalescing interfaces, canDeferCallbacks() is true.
+    ///
+    /// @returns false if the queue from the network thread was full, in
+    /// which case the callback was dropped.
+    OSVR_CLIENT_EXPORT bool
+    queueCallback(osvr::client::QueuedCallback &&callback);
+
+    /// @brief Mutex held while processing messages, whether on the network
+    /// thread or in update(). Methods here that touch state shared with it
+    /// lock it already; hold it for anything else that does.
+    UpdateMutex &getUpdateMutex() const { return m_updateMutex; }
+
     /// @brief Accessor for app ID
     std::string const &getAppId() const;
 
     /// @brief Creates an interface object for the given path. The context
     /// retains shared ownership.
     ///
+    /// Interface objects for the same path share state and receive each
+    /// report through a single dispatch, but each has its own callbacks.
+    ///
     /// @param path Path to a resource. Should be absolute.
     OSVR_CLIENT_EXPORT::osvr::client::ClientInterfacePtr
     getInterface(const char path[]);
@@ -71,8 +160,15 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     OSVR_CLIENT_EXPORT::osvr::client::ClientInterfacePtr
     releaseInterface(::osvr::client::ClientInterface *iface);
 
+    /// @brief Accessor for the interface list - hold the update mutex while
+    /// using it from outside the network thread.
     InterfaceList const &getInterfaces() const { return m_interfaces; }
 
+    /// @brief Accessor for the shared state of each path with interface
+    /// objects, one per path: dispatch reports to these. Hold the update
+    /// mutex while using it from outside the network thread.
+    InterfaceCoreList const &getInterfaceCores() const { return m_cores; }
+
     /// @brief Sends a JSON route/transform object to the server.
     OSVR_CLIENT_EXPORT void sendRoute(std::string const &route);
 
@@ -98,20 +194,89 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     /// @returns true if the object was found and released.
     OSVR_CLIENT_EXPORT bool releaseObject(void *obj);
 
+    /// @brief Translates a timestamp from the server's clock into this
+    /// client's clock, using the current clock offset estimate.
+    OSVR_CLIENT_EXPORT osvr::util::time::TimeValue
+    toClientTime(osvr::util::time::TimeValue const &serverTime) const;
+
+    /// @brief Gets the server clock offset/round-trip time estimator.
+    osvr::common::ClockOffsetEstimator const &getClockOffset() const {
+        return m_clockOffset;
+    }
+
   protected:
     /// @brief Constructor for derived class use only.
     OSVR_ClientContextObject(const char appId[]);
 
     osvr::common::RouteContainer m_routingDirectives;
 
+    /// @brief Fed by derived classes from clock ping/pong exchanges.
+    osvr::common::ClockOffsetEstimator m_clockOffset;
+
+    /// @brief Waits up to the given time for network activity, processing
+    /// any messages that arrive. The default implementation just sleeps
+    /// briefly: derived classes should block on their connection instead.
+    virtual void m_waitForNetwork(uint64_t microseconds);
+
+    /// @brief Changes whenever a path gains its first interface object or
+    /// loses its last, so derived classes can notice changes to
+    /// getInterfaceCores().
+    uint64_t m_getInterfaceCoreGeneration() const { return m_coreGeneration; }
+
   private:
     virtual void m_update() = 0;
     virtual void m_sendRoute(std::string const &route) = 0;
+    /// @brief Processes network messages and updates interfaces.
+    void m_updateNow();
+    void m_networkThreadLoop();
+    /// @brief Delivers pending callbacks until the budget (measured from
+    /// the monotonic clock time start) is spent.
+    void m_deliverQueuedCallbacks(osvr::util::time::TimeValue const &start,
+                                  uint64_t budget, bool dropSuperseded);
+    void m_addPendingCallback(osvr::client::QueuedCallback &&callback);
+    /// @brief Ends a (possibly nested) pass of message dispatch, applying
+    /// changes to m_cores put off while routers might be iterating it.
+    void m_endDispatch();
     std::string const m_appId;
     InterfaceList m_interfaces;
+    InterfaceCoreList m_cores;
+    uint64_t m_coreGeneration;
+    /// @brief Nesting depth of message dispatch: while nonzero, m_cores is
+    /// not modified.
+    std::size_t m_dispatchDepth;
+    /// @brief Cores created during dispatch, added to m_cores afterwards.
+    InterfaceCoreList m_coresAddedInDispatch;
     std::map<std::string, std::string> m_params;
 
     osvr::util::KeyedOwnershipContainer m_ownedObjects;
+
+    mutable UpdateMutex m_updateMutex;
+    boost::thread m_networkThread;
+    std::atomic<bool> m_runNetworkThread;
+    /// @brief Set while the network thread runs in queued-callback mode.
+    bool m_queueCallbacks;
+    /// @brief Set while the network thread calls callbacks directly.
+    bool m_callbacksOnNetworkThread;
+    /// @brief Set while a budgeted update processes messages on this thread.
+    bool m_deferCallbacks;
+    /// @brief Hands callbacks from the network thread to update().
+    osvr::util::SPSCQueue<osvr::client::QueuedCallback> m_callbackQueue;
+    /// @brief Callbacks dropped because the queue was full.
+    std::atomic<std::size_t> m_droppedCallbacks;
+    /// @brief Callbacks awaiting delivery by update() - only touched by the
+    /// thread calling update().
+    std::deque<osvr::client::QueuedCallback> m_pendingCallbacks;
+    /// @brief Number of supersedable pending callbacks per key.
+    std::map<osvr::client::SupersedeKey, std::size_t> m_pendingPerKey;
+    /// @brief Number of superseded callbacks skipped so far per key.
+    std::map<osvr::client::SupersedeKey, std::size_t> m_skippedPerKey;
+
+    /// @brief Number of reports dispatched to any interface.
+    std::atomic<uint64_t> m_reportCount;
+    /// @brief Lets waitForReport() sleep until the network thread has
+    /// dispatched reports.
+    boost::mutex m_reportWaitMutex;
+    boost::condition_variable m_reportDispatched;
 };
 
 #endif // INCLUDED_ContextImpl_h_GUID_9000C62E_3693_4888_83A2_0D26F4591B6A
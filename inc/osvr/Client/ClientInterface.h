@@ -29,84 +29,279 @@
 #include <osvr/Client/Export.h>
 #include <osvr/Client/ClientContext_fwd.h>
 #include <osvr/Client/ClientInterfacePtr.h>
-#include <osvr/Client/InterfaceState.h>
+#include <osvr/Client/InterfaceCore.h>
 #include <osvr/Client/InterfaceCallbacks.h>
+#include <osvr/Client/CoalescedReports.h>
+#include <osvr/Client/QueuedCallback.h>
 #include <osvr/Client/StateType.h>
 #include <osvr/Client/ReportStateTraits.h>
+#include <osvr/Client/ReportTypes.h>
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ClientCallbackTypesC.h>
+#include <osvr/Util/SharedPtr.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/locks.hpp>
 
 // Standard includes
 #include <string>
 #include <vector>
 #include <functional>
+#include <algorithm>
 
-struct OSVR_ClientInterfaceObject : boost::noncopyable {
+struct OSVR_ClientInterfaceObject
+    : boost::noncopyable,
+      osvr::enable_shared_from_this<OSVR_ClientInterfaceObject> {
   private:
     struct PrivateConstructor {};
 
   public:
     /// @brief Constructor - only to be called by ClientContext
+    ///
+    /// @param core State shared with any other interface objects for the
+    /// same path.
     OSVR_ClientInterfaceObject(::osvr::client::ClientContext *ctx,
-                               std::string const &path,
+                               osvr::client::InterfaceCorePtr const &core,
                                PrivateConstructor const &);
 
     /// @brief Get the path as a string.
     std::string const &getPath() const;
 
+    /// @brief Gets the state shared by all interface objects for this path.
+    osvr::client::InterfaceCorePtr const &getCore() const { return m_core; }
+
     /// @brief If state exists for the given ReportType on this interface, it
     /// will be returned in the arguments, and true will be returned.
     template <typename ReportType>
     bool getState(osvr::util::time::TimeValue &timestamp,
                   typename osvr::client::traits::StateType<ReportType>::type &
                       state) const {
-        if (!m_state.hasState<ReportType>()) {
-            return false;
-        }
-        m_state.getState<ReportType>(timestamp, state);
-        return true;
+        return m_core->getState<ReportType>(timestamp, state);
+    }
+
+    /// @brief Sets the number of recent states retained per report type for
+    /// getStateAt(). Zero (the default) disables history.
+    ///
+    /// History is shared by all interface objects for the same path, so the
+    /// largest capacity requested among them is used.
+    OSVR_CLIENT_EXPORT void setHistoryCapacity(std::size_t capacity);
+
+    /// @brief Gets the history capacity requested through this object.
+    std::size_t getHistoryCapacity() const { return m_historyCapacity; }
+
+    /// @brief Looks up state for the given ReportType at (or interpolated to)
+    /// the given time from the retained history.
+    ///
+    /// Safe to call from any thread: it does not wait for a network thread
+    /// to finish processing messages.
+    ///
+    /// @returns false if history is disabled or empty for this report type.
+    template <typename ReportType>
+    bool getStateAt(osvr::util::time::TimeValue const &target,
+                    bool interpolate, osvr::util::time::TimeValue &timestamp,
+                    typename osvr::client::traits::StateType<ReportType>::type &
+                        state) const {
+        return m_core->getStateAt<ReportType>(target, interpolate, timestamp,
+                                              state);
+    }
+
+    /// @brief Extrapolates the latest pose to the given time (in the client
+    /// clock domain) using velocities estimated from recent pose reports.
+    ///
+    /// Lock-free, so safe to call from a render thread.
+    ///
+    /// @returns false if no pose state exists.
+    OSVR_CLIENT_EXPORT bool
+    getPredictedPoseState(osvr::util::time::TimeValue const &target,
+                          OSVR_PoseState &state) const;
+
+    /// @brief Enables or disables coalescing of callbacks: all reports of a
+    /// type for a sensor received within one update are combined into a
+    /// single call with the newest report. State is still updated for every
+    /// report. Button reports are never coalesced.
+    ///
+    /// Coalesced callbacks are called at the end of an update. Has no effect
+    /// if callbacks are called directly on a network thread.
+    OSVR_CLIENT_EXPORT void setCoalesceCallbacks(bool coalesce);
+
+    /// @brief During a callback, the number of earlier reports skipped in
+    /// favor of the current one because of coalescing (or dropping
+    /// superseded reports). Zero otherwise.
+    std::size_t getSkippedReportCount() const { return m_skippedReports; }
+
+    /// @brief Number of reports (of any type) dispatched to this path.
+    uint64_t getReportCount() const { return m_core->getReportCount(); }
+
+    /// @brief Number of reports for this path lost on the way from the
+    /// server, as told by sequence numbers.
+    uint64_t getLostReportCount() const {
+        UpdateLock lock(m_getUpdateMutex());
+        return m_core->getLostReportCount();
+    }
+
+    /// @brief Number of reports for this path discarded for arriving after
+    /// a newer one, which would have replaced newer state.
+    uint64_t getReorderedReportCount() const {
+        UpdateLock lock(m_getUpdateMutex());
+        return m_core->getReorderedReportCount();
     }
 
     /// @brief Register a callback for a known report type.
+    ///
+    /// @note If the context queues callbacks for delivery in update(), call
+    /// this from the same thread that calls update().
     template <typename CallbackType>
     void registerCallback(CallbackType cb, void *userdata) {
+        UpdateLock lock(m_getUpdateMutex());
         m_callbacks.addCallback(cb, userdata);
     }
 
-    /// @brief Save state and trigger all callbacks for the given known report
-    /// type.
+  private:
+    typedef boost::lock_guard<boost::recursive_mutex> UpdateLock;
+
+    /// @brief Calls (or queues) the callbacks registered with this object -
+    /// state has already been updated by the core.
     template <typename ReportType>
-    void triggerCallbacks(const OSVR_TimeValue &timestamp,
-                          ReportType const &report) {
-        m_setState(timestamp, report,
-                   osvr::client::traits::KeepStateForReport<ReportType>());
-        m_callbacks.triggerCallbacks(timestamp, report);
+    void m_deliverCallbacks(const OSVR_TimeValue &localTimestamp,
+                            ReportType const &report,
+                            osvr::shared_ptr<void> const &keepAlive) {
+        if (!m_callbacks.hasCallbacks<ReportType>()) {
+            return;
+        }
+        if (!m_shouldQueueCallbacks()) {
+            m_callbacks.triggerCallbacks(localTimestamp, report);
+            return;
+        }
+        if (m_coalesce &&
+            osvr::client::traits::CanCoalesceReport<ReportType>::value) {
+            m_queueCoalesced(localTimestamp, report, keepAlive);
+            return;
+        }
+        /// The interface may be freed before the queue is drained.
+        osvr::weak_ptr<OSVR_ClientInterfaceObject> weakSelf(
+            shared_from_this());
+        osvr::client::QueuedCallback queued;
+        queued.deliver = [weakSelf, localTimestamp, report,
+                          keepAlive](std::size_t skipped) {
+            (void)keepAlive;
+            auto self = weakSelf.lock();
+            if (self) {
+                self->m_skippedReports = skipped;
+                self->m_callbacks.triggerCallbacks(localTimestamp, report);
+                self->m_skippedReports = 0;
+            }
+        };
+        queued.key = osvr::client::SupersedeKey(
+            this, osvr::client::traits::ReportTypeIndex<ReportType>::value,
+            report.sensor);
+        queued.supersedable =
+            osvr::client::traits::IsTrackerReport<ReportType>::value;
+        m_queueCallback(std::move(queued));
     }
 
-    /// @brief Update any state.
-    void update();
-
-  private:
-    /// @brief Helper function for setting state
+    /// @brief Stores a report for coalescing, queueing a callback to deliver
+    /// the newest one only if none is pending for its type and sensor.
     template <typename ReportType>
-    void m_setState(const OSVR_TimeValue &timestamp, ReportType const &report,
-                    std::true_type const &) {
-        m_state.setStateFromReport(timestamp, report);
+    void m_queueCoalesced(const OSVR_TimeValue &localTimestamp,
+                          ReportType const &report,
+                          osvr::shared_ptr<void> const &keepAlive) {
+        if (!m_coalesced.store(localTimestamp, report, keepAlive)) {
+            return;
+        }
+        osvr::weak_ptr<OSVR_ClientInterfaceObject> weakSelf(
+            shared_from_this());
+        const OSVR_ChannelCount sensor = report.sensor;
+        osvr::client::QueuedCallback queued;
+        queued.deliver = [weakSelf, sensor](std::size_t) {
+            auto self = weakSelf.lock();
+            if (self) {
+                self->m_deliverCoalesced<ReportType>(sensor);
+            }
+        };
+        queued.key = osvr::client::SupersedeKey(
+            this, osvr::client::traits::ReportTypeIndex<ReportType>::value,
+            sensor);
+        if (!m_queueCallback(std::move(queued))) {
+            m_coalesced.cancel<ReportType>(sensor);
+        }
     }
 
-    /// @brief Helper function for "setting state" on reports we don't keep
-    /// state from
+    /// @brief Calls the callbacks with the newest coalesced report.
     template <typename ReportType>
-    void m_setState(const OSVR_TimeValue &, ReportType const &,
-                    std::false_type const &) {}
+    void m_deliverCoalesced(OSVR_ChannelCount sensor) {
+        OSVR_TimeValue timestamp;
+        ReportType report;
+        osvr::shared_ptr<void> keepAlive;
+        std::size_t skipped;
+        if (!m_coalesced.take(sensor, timestamp, report, keepAlive,
+                              skipped)) {
+            return;
+        }
+        m_skippedReports = skipped;
+        m_callbacks.triggerCallbacks(timestamp, report);
+        m_skippedReports = 0;
+    }
+
+    /// @brief The context's update mutex, guarding the callbacks and
+    /// settings against its network thread.
+    OSVR_CLIENT_EXPORT boost::recursive_mutex &m_getUpdateMutex() const;
+
+    /// @brief Should callbacks be queued rather than called right away?
+    OSVR_CLIENT_EXPORT bool m_shouldQueueCallbacks() const;
+
+    /// @brief Queues a callback invocation with the context.
+    ///
+    /// @returns false if the context's queue was full and the callback was
+    /// dropped.
+    OSVR_CLIENT_EXPORT bool
+    m_queueCallback(osvr::client::QueuedCallback &&callback);
+
     ::osvr::client::ClientContext *m_ctx;
-    std::string const m_path;
+    osvr::client::InterfaceCorePtr m_core;
     osvr::client::InterfaceCallbacks m_callbacks;
-    osvr::client::InterfaceState m_state;
+    std::size_t m_historyCapacity;
+    bool m_coalesce;
+    osvr::client::CoalescedReports m_coalesced;
+    std::size_t m_skippedReports;
     friend struct OSVR_ClientContextObject;
+    friend class osvr::client::InterfaceCore;
 };
 
+namespace osvr {
+namespace client {
+    template <typename ReportType>
+    inline void
+    InterfaceCore::triggerCallbacks(const OSVR_TimeValue &timestamp,
+                                    ReportType const &report,
+                                    shared_ptr<void> const &keepAlive) {
+        const OSVR_TimeValue localTimestamp = m_toClientTime(timestamp);
+        m_noteReport();
+        m_setState(localTimestamp, report,
+                   traits::KeepStateForReport<ReportType>());
+        m_updatePrediction(localTimestamp, report);
+        /// A callback called directly may add or release interface objects,
+        /// so hold on to the ones we started with.
+        if (m_handles.size() == 1) {
+            ClientInterfacePtr handle(m_handles.front()->shared_from_this());
+            handle->m_deliverCallbacks(localTimestamp, report, keepAlive);
+            return;
+        }
+        std::vector<ClientInterfacePtr> handles;
+        handles.reserve(m_handles.size());
+        for (auto const &handle : m_handles) {
+            handles.push_back(handle->shared_from_this());
+        }
+        for (auto const &handle : handles) {
+            /// Skip any released by an earlier callback.
+            if (std::find(begin(m_handles), end(m_handles), handle.get()) !=
+                end(m_handles)) {
+                handle->m_deliverCallbacks(localTimestamp, report, keepAlive);
+            }
+        }
+    }
+} // namespace client
+} // namespace osvr
+
 #endif // INCLUDED_ClientInterface_h_GUID_A3A55368_DE2F_4980_BAE9_1C398B0D40A1
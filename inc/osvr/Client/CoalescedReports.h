@@ -0,0 +1,173 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_CoalescedReports_h_GUID_DD6D5CF8_010A_4F64_A979_E64BE7B3A993
+#define INCLUDED_CoalescedReports_h_GUID_DD6D5CF8_010A_4F64_A979_E64BE7B3A993
+
+// Internal Includes
+#include <osvr/Client/ReportMap.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+#include <boost/fusion/include/at_key.hpp>
+#include <boost/fusion/include/for_each.hpp>
+#include <boost/mpl/placeholders.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+// Standard includes
+#include <vector>
+#include <cstddef>
+
+namespace osvr {
+namespace client {
+    /// @brief The newest report of a type for one sensor, waiting for its
+    /// coalesced callback.
+    template <typename ReportType> struct CoalescedReport {
+        OSVR_ChannelCount sensor;
+        /// @brief Whether a callback has been queued and not yet delivered.
+        bool pending;
+        /// @brief Reports replaced since the callback was queued.
+        std::size_t skipped;
+        util::time::TimeValue timestamp;
+        ReportType report;
+        shared_ptr<void> keepAlive;
+    };
+
+    /// @brief Metafunction computing the slots kept for a report type: one
+    /// per sensor seen, usually just one for an interface.
+    template <typename ReportType> struct CoalescedReportSlots {
+        typedef std::vector<CoalescedReport<ReportType> > type;
+    };
+
+    typedef traits::GenerateReportMap<
+        CoalescedReportSlots<boost::mpl::_1> >::type CoalescedReportMap;
+
+    /// @brief Holds the newest report per report type and sensor for an
+    /// interface that coalesces callbacks, so that only the first report in
+    /// an update has to queue a callback and later ones just overwrite it.
+    ///
+    /// Slots are kept once created, so steady-state coalescing does not
+    /// allocate. Reports may be stored on a network thread while another
+    /// thread delivers: a mutex private to this object guards the slots.
+    class CoalescedReports {
+      public:
+        /// @brief Records a report as the newest for its sensor.
+        ///
+        /// @returns true if a callback must be queued to deliver it, false
+        /// if one is already pending and will deliver this report instead.
+        template <typename ReportType>
+        bool store(util::time::TimeValue const &timestamp,
+                   ReportType const &report,
+                   shared_ptr<void> const &keepAlive) {
+            Lock lock(m_mutex);
+            CoalescedReport<ReportType> &slot =
+                m_slot<ReportType>(report.sensor);
+            slot.timestamp = timestamp;
+            slot.report = report;
+            slot.keepAlive = keepAlive;
+            if (slot.pending) {
+                ++slot.skipped;
+                return false;
+            }
+            slot.pending = true;
+            slot.skipped = 0;
+            return true;
+        }
+
+        /// @brief Takes the newest report for a sensor out for delivery.
+        ///
+        /// @returns false if there was no pending report.
+        template <typename ReportType>
+        bool take(OSVR_ChannelCount sensor, util::time::TimeValue &timestamp,
+                  ReportType &report, shared_ptr<void> &keepAlive,
+                  std::size_t &skipped) {
+            Lock lock(m_mutex);
+            CoalescedReport<ReportType> &slot = m_slot<ReportType>(sensor);
+            if (!slot.pending) {
+                return false;
+            }
+            timestamp = slot.timestamp;
+            report = slot.report;
+            keepAlive = slot.keepAlive;
+            slot.keepAlive.reset();
+            skipped = slot.skipped;
+            slot.pending = false;
+            return true;
+        }
+
+        /// @brief Undoes store() for a sensor whose callback could not be
+        /// queued after all, so the next report queues one again.
+        template <typename ReportType> void cancel(OSVR_ChannelCount sensor) {
+            Lock lock(m_mutex);
+            CoalescedReport<ReportType> &slot = m_slot<ReportType>(sensor);
+            slot.pending = false;
+            slot.keepAlive.reset();
+        }
+
+        /// @brief Forgets all pending reports, for when their queued
+        /// callbacks have been discarded.
+        void clear() {
+            Lock lock(m_mutex);
+            boost::fusion::for_each(m_slots, ClearSlots());
+        }
+
+      private:
+        typedef boost::lock_guard<boost::mutex> Lock;
+
+        struct ClearSlots {
+            template <typename Pair> void operator()(Pair &p) const {
+                for (auto &slot : p.second) {
+                    slot.pending = false;
+                    slot.keepAlive.reset();
+                }
+            }
+        };
+
+        template <typename ReportType>
+        CoalescedReport<ReportType> &m_slot(OSVR_ChannelCount sensor) {
+            typename CoalescedReportSlots<ReportType>::type &slots =
+                boost::fusion::at_key<ReportType>(m_slots);
+            for (auto &slot : slots) {
+                if (slot.sensor == sensor) {
+                    return slot;
+                }
+            }
+            CoalescedReport<ReportType> slot;
+            slot.sensor = sensor;
+            slot.pending = false;
+            slot.skipped = 0;
+            slots.push_back(slot);
+            return slots.back();
+        }
+
+        boost::mutex m_mutex;
+        CoalescedReportMap m_slots;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_CoalescedReports_h_GUID_DD6D5CF8_010A_4F64_A979_E64BE7B3A993
@@ -38,6 +38,16 @@
 namespace osvr {
 namespace client {
 
+    /// @brief Creates a client context connecting to the given host.
+    ///
+    /// A host of the form `unix:path` (or just `unix:` for the default path)
+    /// connects to a server on this machine that sends device reports over
+    /// the Unix domain socket at that path. A host of the form `inproc:name`
+    /// (or just `inproc:`) takes device reports straight from a server in
+    /// this process, created with an in-process connection of that name. A
+    /// host of the form `shm:name` (or just `shm:` for the default region)
+    /// reads device reports from the shared memory region a server on this
+    /// machine publishes them in.
     OSVR_CLIENT_EXPORT ClientContext *
     createContext(const char appId[], const char host[] = "localhost");
 
@@ -29,6 +29,7 @@
 #include <osvr/Client/ReportMap.h>
 #include <osvr/Client/ReportTypes.h>
 #include <osvr/Client/ReportFromCallback.h>
+#include <osvr/Client/CallbackType.h>
 #include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
@@ -39,15 +40,59 @@
 
 // Standard includes
 #include <vector>
-#include <functional>
+#include <cstddef>
 
 namespace osvr {
 namespace client {
+    /// @brief Storage for the C callbacks (function pointer and userdata)
+    /// registered for one report type, called directly on dispatch.
+    ///
+    /// The first few registrations are stored inline, so the common cases
+    /// of dispatch touch no additional heap memory and registration does not
+    /// allocate.
+    template <typename CallbackType> class CallbackList {
+      public:
+        CallbackList() : m_inlineCount(0) {}
+
+        void add(CallbackType cb, void *userdata) {
+            Entry e = {cb, userdata};
+            if (m_inlineCount < INLINE_CAPACITY) {
+                m_inline[m_inlineCount] = e;
+                ++m_inlineCount;
+            } else {
+                m_overflow.push_back(e);
+            }
+        }
+
+        template <typename ReportType>
+        void call(util::time::TimeValue const &timestamp,
+                  ReportType const &report) const {
+            for (std::size_t i = 0; i < m_inlineCount; ++i) {
+                m_inline[i].cb(m_inline[i].userdata, &timestamp, &report);
+            }
+            for (auto const &e : m_overflow) {
+                e.cb(e.userdata, &timestamp, &report);
+            }
+        }
+
+        std::size_t size() const { return m_inlineCount + m_overflow.size(); }
+
+      private:
+        static const std::size_t INLINE_CAPACITY = 4;
+        struct Entry {
+            CallbackType cb;
+            void *userdata;
+        };
+        Entry m_inline[INLINE_CAPACITY];
+        std::size_t m_inlineCount;
+        std::vector<Entry> m_overflow;
+    };
+
     /// @brief Metafunction computing the storage for callbacks for a report
     /// type.
     template <typename ReportType> struct CallbackStorageType {
-        typedef std::vector<std::function<void(const OSVR_TimeValue *,
-                                               const ReportType *)> > type;
+        typedef CallbackList<
+            typename traits::CallbackType<ReportType>::type> type;
     };
 
     typedef traits::GenerateReportMap<CallbackStorageType<boost::mpl::_> >::type
@@ -61,20 +106,19 @@ namespace client {
         void addCallback(CallbackType cb, void *userdata) {
             typedef typename traits::ReportFromCallback<CallbackType>::type
                 ReportType;
-            using namespace std::placeholders;
-            boost::fusion::at_key<ReportType>(m_callbacks)
-                .push_back(std::bind(cb, userdata, _1, _2));
+            boost::fusion::at_key<ReportType>(m_callbacks).add(cb, userdata);
         }
 
         template <typename ReportType>
         void triggerCallbacks(util::time::TimeValue const &timestamp,
                               ReportType const &report) const {
-            for (auto const &f :
-                 boost::fusion::at_key<ReportType>(m_callbacks)) {
-                f(&timestamp, &report);
-            }
-            /// @todo do we fail silently or throw exception if we are asked for
-            /// state we don't have?
+            boost::fusion::at_key<ReportType>(m_callbacks)
+                .call(timestamp, report);
+        }
+
+        /// @brief Are any callbacks registered for the given report type?
+        template <typename ReportType> bool hasCallbacks() const {
+            return boost::fusion::at_key<ReportType>(m_callbacks).size() != 0;
         }
 
       private:
@@ -0,0 +1,229 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InterfaceCore_h_GUID_5580B003_1DB7_47DA_A7AC_AC8C770A229F
+#define INCLUDED_InterfaceCore_h_GUID_5580B003_1DB7_47DA_A7AC_AC8C770A229F
+
+// Internal Includes
+#include <osvr/Client/Export.h>
+#include <osvr/Client/ClientContext_fwd.h>
+#include <osvr/Client/ClientInterfacePtr.h>
+#include <osvr/Client/InterfaceState.h>
+#include <osvr/Client/InterfaceHistory.h>
+#include <osvr/Client/PosePredictor.h>
+#include <osvr/Client/StateType.h>
+#include <osvr/Client/ReportStateTraits.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/SeqLock.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+namespace osvr {
+namespace client {
+    class InterfaceCore;
+    /// @brief Pointer for holding InterfaceCore objects safely.
+    typedef shared_ptr<InterfaceCore> InterfaceCorePtr;
+
+    /// @brief The part of an interface shared by all interface objects for
+    /// the same path: state, history, pose prediction, and the interface
+    /// objects to pass reports on to.
+    ///
+    /// Reports are dispatched once per core, which updates state once and
+    /// then calls the callbacks registered with each interface object.
+    ///
+    /// Owned jointly by the interface objects for its path: the context
+    /// creates one for the first such object and drops it when the last one
+    /// is released. Methods must be called with the context's update mutex
+    /// held, except for the state, history, and prediction queries.
+    class InterfaceCore : boost::noncopyable {
+      public:
+        /// @brief Constructor - only to be called by ClientContext
+        InterfaceCore(ClientContext *ctx, std::string const &path);
+
+        /// @brief Get the path as a string.
+        std::string const &getPath() const { return m_path; }
+
+        /// @brief If state exists for the given ReportType, it will be
+        /// returned in the arguments, and true will be returned.
+        template <typename ReportType>
+        bool getState(util::time::TimeValue &timestamp,
+                      typename traits::StateType<ReportType>::type &state)
+            const {
+            if (!m_state.hasState<ReportType>()) {
+                return false;
+            }
+            m_state.getState<ReportType>(timestamp, state);
+            return true;
+        }
+
+        /// @brief Looks up state from the retained history: see
+        /// ClientInterface::getStateAt()
+        ///
+        /// Only locks the history itself, which is held just long enough to
+        /// record each report, so may be called from any thread.
+        template <typename ReportType>
+        bool getStateAt(util::time::TimeValue const &target, bool interpolate,
+                        util::time::TimeValue &timestamp,
+                        typename traits::StateType<ReportType>::type &state)
+            const {
+            HistoryLock lock(m_historyMutex);
+            return m_history.getStateAt<ReportType>(target, interpolate,
+                                                    timestamp, state);
+        }
+
+        /// @brief Extrapolates the latest pose to the given time.
+        ///
+        /// Works from a copy of the predictor published after each update,
+        /// so may be called from any thread without locking.
+        OSVR_CLIENT_EXPORT bool
+        getPredictedPoseState(util::time::TimeValue const &target,
+                              OSVR_PoseState &state) const;
+
+        /// @brief Passes velocities measured by the device on to pose
+        /// prediction, in place of those estimated from successive poses:
+        /// call after triggering callbacks for the pose they go with.
+        void setReportedVelocity(OSVR_Vec3 const *linear,
+                                 OSVR_Vec3 const *angular) {
+            m_posePredictor.setVelocity(linear, angular);
+            m_publishedPredictor.store(m_posePredictor);
+        }
+
+        /// @brief Number of reports (of any type) dispatched to this path.
+        uint64_t getReportCount() const { return m_reportCount; }
+
+        /// @brief Number of reports for this path lost on the way from the
+        /// server.
+        uint64_t getLostReportCount() const { return m_lostReports; }
+
+        /// @brief Number of reports for this path discarded for arriving
+        /// after a newer one.
+        uint64_t getReorderedReportCount() const {
+            return m_reorderedReports;
+        }
+
+        /// @brief Adds to the loss and reordering counts: lost may be
+        /// negative when a report counted as lost arrives late.
+        void addSequenceStats(int64_t lost, uint64_t reordered) {
+            m_lostReports += uint64_t(lost);
+            m_reorderedReports += reordered;
+        }
+
+        /// @brief Save state, then trigger the callbacks of every interface
+        /// object for this path, for the given known report type.
+        ///
+        /// Defined in ClientInterface.h, since it needs the complete type.
+        ///
+        /// @param timestamp Report timestamp in the server's clock domain: it
+        /// is translated into the client's before being stored or passed on.
+        /// @param keepAlive Owner of any data the report points to, kept
+        /// alive until queued callbacks have run.
+        template <typename ReportType>
+        void triggerCallbacks(const OSVR_TimeValue &timestamp,
+                              ReportType const &report,
+                              shared_ptr<void> const &keepAlive =
+                                  shared_ptr<void>());
+
+        /// @brief Adds an interface object for this path.
+        void addHandle(ClientInterface *handle);
+
+        /// @brief Removes an interface object for this path.
+        void removeHandle(ClientInterface *handle);
+
+        /// @brief Are there any interface objects left for this path?
+        bool hasHandles() const { return !m_handles.empty(); }
+
+        /// @brief Recomputes the history capacity: the largest requested by
+        /// any interface object for this path.
+        void updateHistoryCapacity();
+
+        /// @brief Update any state.
+        void update();
+
+      private:
+        typedef boost::lock_guard<boost::mutex> HistoryLock;
+
+        /// @brief Translates a server timestamp using the context's clock
+        /// offset.
+        OSVR_CLIENT_EXPORT OSVR_TimeValue
+        m_toClientTime(OSVR_TimeValue const &timestamp) const;
+
+        /// @brief Counts a report for this path and the context.
+        OSVR_CLIENT_EXPORT void m_noteReport();
+
+        /// @brief Helper function for setting state
+        template <typename ReportType>
+        void m_setState(const OSVR_TimeValue &timestamp,
+                        ReportType const &report, std::true_type const &) {
+            m_state.setStateFromReport(timestamp, report);
+            HistoryLock lock(m_historyMutex);
+            m_history.addReport(timestamp, report);
+        }
+
+        /// @brief Helper function for "setting state" on reports we don't
+        /// keep state from
+        template <typename ReportType>
+        void m_setState(const OSVR_TimeValue &, ReportType const &,
+                        std::false_type const &) {}
+
+        /// @brief Feeds pose reports to the pose predictor.
+        void m_updatePrediction(const OSVR_TimeValue &timestamp,
+                                OSVR_PoseReport const &report) {
+            m_posePredictor.addSample(timestamp, report.pose);
+            m_publishedPredictor.store(m_posePredictor);
+        }
+
+        /// @brief Other report types don't take part in prediction.
+        template <typename ReportType>
+        void m_updatePrediction(const OSVR_TimeValue &, ReportType const &) {}
+
+        ClientContext *m_ctx;
+        std::string const m_path;
+        InterfaceState m_state;
+        /// @brief Guards m_history only, unlike the context's update mutex
+        /// which is held for a whole pass over incoming messages.
+        mutable boost::mutex m_historyMutex;
+        InterfaceHistory m_history;
+        /// @brief Only touched with the update mutex held.
+        PosePredictor m_posePredictor;
+        /// @brief Copy of m_posePredictor for lock-free prediction.
+        util::SeqLocked<PosePredictor> m_publishedPredictor;
+        std::atomic<uint64_t> m_reportCount;
+        uint64_t m_lostReports;
+        uint64_t m_reorderedReports;
+        std::vector<ClientInterface *> m_handles;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_InterfaceCore_h_GUID_5580B003_1DB7_47DA_A7AC_AC8C770A229F
@@ -0,0 +1,203 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InterfaceHistory_h_GUID_869D9F2A_714B_4A44_93E6_28A1C11C712E
+#define INCLUDED_InterfaceHistory_h_GUID_869D9F2A_714B_4A44_93E6_28A1C11C712E
+
+// Internal Includes
+#include <osvr/Client/Export.h>
+#include <osvr/Client/InterfaceState.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/circular_buffer.hpp>
+#include <boost/fusion/include/at_key.hpp>
+#include <boost/fusion/include/for_each.hpp>
+#include <boost/mpl/placeholders.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+
+namespace osvr {
+namespace client {
+    /// @name State interpolation
+    /// @brief Blend between two states: `t` of 0 yields `a`, 1 yields `b`.
+    ///
+    /// Positions and analogs are interpolated linearly, orientations by
+    /// slerp, and buttons take the nearer value.
+    /// @{
+    OSVR_CLIENT_EXPORT void interpolateState(OSVR_PoseState const &a,
+                                             OSVR_PoseState const &b, double t,
+                                             OSVR_PoseState &out);
+    OSVR_CLIENT_EXPORT void interpolateState(OSVR_PositionState const &a,
+                                             OSVR_PositionState const &b,
+                                             double t, OSVR_PositionState &out);
+    OSVR_CLIENT_EXPORT void interpolateState(OSVR_OrientationState const &a,
+                                             OSVR_OrientationState const &b,
+                                             double t,
+                                             OSVR_OrientationState &out);
+    OSVR_CLIENT_EXPORT void interpolateState(OSVR_ButtonState const &a,
+                                             OSVR_ButtonState const &b,
+                                             double t, OSVR_ButtonState &out);
+    OSVR_CLIENT_EXPORT void interpolateState(OSVR_AnalogState const &a,
+                                             OSVR_AnalogState const &b,
+                                             double t, OSVR_AnalogState &out);
+    /// @}
+
+    /// @brief Metafunction taking a report type and returning a history
+    /// buffer type.
+    template <typename ReportType> struct HistoryValueType {
+        typedef boost::circular_buffer<StateMapContents<ReportType> > type;
+    };
+
+    /// @brief Data structure mapping from a report type to a history buffer.
+    typedef traits::GenerateReportMap<
+        HistoryValueType<boost::mpl::_1> >::type HistoryMap;
+
+    /// @brief Optional, fixed-capacity history of recent states for each
+    /// report type, kept sorted by timestamp, for looking up the state at a
+    /// given time.
+    ///
+    /// Disabled (zero capacity) by default, in which case recording costs a
+    /// single branch.
+    class InterfaceHistory {
+      public:
+        /// @brief Sets the number of samples retained for each report type,
+        /// discarding the oldest if reducing. Zero disables history.
+        void setCapacity(std::size_t capacity) {
+            boost::fusion::for_each(m_history, SetCapacity(capacity));
+        }
+
+        template <typename ReportType>
+        void addReport(util::time::TimeValue const &timestamp,
+                       ReportType const &report) {
+            typename HistoryValueType<ReportType>::type &buf =
+                boost::fusion::at_key<ReportType>(m_history);
+            if (buf.capacity() == 0) {
+                return;
+            }
+            StateMapContents<ReportType> c;
+            c.state = reportState(report);
+            c.timestamp = timestamp;
+            if (buf.empty() || !isBefore(timestamp, buf.back().timestamp)) {
+                buf.push_back(c);
+            } else {
+                /// Out-of-order report: keep the buffer sorted.
+                buf.insert(std::upper_bound(buf.begin(), buf.end(), c,
+                                            &InterfaceHistory::compare<
+                                                ReportType>),
+                           c);
+            }
+        }
+
+        template <typename ReportType> bool hasHistory() const {
+            return !boost::fusion::at_key<ReportType>(m_history).empty();
+        }
+
+        /// @brief Looks up the state at the given time.
+        ///
+        /// Targets outside the retained range are clamped to the oldest or
+        /// newest sample.
+        ///
+        /// @param target The time of interest.
+        /// @param interpolate If true, blend the two samples surrounding the
+        /// target; otherwise return the one nearest in time.
+        /// @param[out] timestamp The timestamp of the returned state: the
+        /// target itself if interpolated.
+        /// @param[out] state The state.
+        /// @returns false if no history exists for this report type.
+        template <typename ReportType>
+        bool
+        getStateAt(util::time::TimeValue const &target, bool interpolate,
+                   util::time::TimeValue &timestamp,
+                   typename traits::StateType<ReportType>::type &state) const {
+            typedef StateMapContents<ReportType> contents_type;
+            typename HistoryValueType<ReportType>::type const &buf =
+                boost::fusion::at_key<ReportType>(m_history);
+            if (buf.empty()) {
+                return false;
+            }
+            contents_type key;
+            key.timestamp = target;
+            auto it = std::lower_bound(buf.begin(), buf.end(), key,
+                                       &InterfaceHistory::compare<ReportType>);
+            if (it == buf.begin() || it == buf.end()) {
+                contents_type const &c =
+                    (it == buf.begin()) ? buf.front() : buf.back();
+                timestamp = c.timestamp;
+                state = c.state;
+                return true;
+            }
+            contents_type const &after = *it;
+            contents_type const &before = *(it - 1);
+            const double span =
+                util::time::duration(after.timestamp, before.timestamp);
+            const double t =
+                span > 0
+                    ? util::time::duration(target, before.timestamp) / span
+                    : 0;
+            if (interpolate) {
+                interpolateState(before.state, after.state, t, state);
+                timestamp = target;
+            } else {
+                contents_type const &c = (t < 0.5) ? before : after;
+                timestamp = c.timestamp;
+                state = c.state;
+            }
+            return true;
+        }
+
+      private:
+        static bool isBefore(util::time::TimeValue const &a,
+                             util::time::TimeValue const &b) {
+            return a.seconds < b.seconds ||
+                   (a.seconds == b.seconds && a.microseconds < b.microseconds);
+        }
+
+        template <typename ReportType>
+        static bool compare(StateMapContents<ReportType> const &a,
+                            StateMapContents<ReportType> const &b) {
+            return isBefore(a.timestamp, b.timestamp);
+        }
+
+        class SetCapacity {
+          public:
+            SetCapacity(std::size_t capacity) : m_capacity(capacity) {}
+            template <typename Pair> void operator()(Pair &p) const {
+                p.second.set_capacity(m_capacity);
+            }
+
+          private:
+            std::size_t m_capacity;
+        };
+
+        HistoryMap m_history;
+    };
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_InterfaceHistory_h_GUID_869D9F2A_714B_4A44_93E6_28A1C11C712E
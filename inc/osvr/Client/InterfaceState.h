@@ -30,12 +30,12 @@
 #include <osvr/Client/StateType.h>
 #include <osvr/Client/ReportState.h>
 #include <osvr/Util/TimeValue.h>
+#include <osvr/Util/SeqLock.h>
 
 // Library/third-party includes
 #include <boost/fusion/include/has_key.hpp>
 #include <boost/fusion/include/at_key.hpp>
 #include <boost/mpl/placeholders.hpp>
-#include <boost/optional.hpp>
 
 // Standard includes
 // - none
@@ -53,16 +53,20 @@ namespace client {
     /// @brief Metafunction taking a report type and returning a state map
     /// value type.
     template <typename ReportType> struct StateMapValueType {
-        typedef boost::optional<StateMapContents<ReportType> > type;
+        typedef util::SeqLocked<StateMapContents<ReportType> > type;
     };
 
-    /// @brief Data structure mapping from a report type to an optional state
-    /// value.
+    /// @brief Data structure mapping from a report type to a (possibly
+    /// never-set) state value.
     typedef traits::GenerateReportMap<StateMapValueType<boost::mpl::_1> >::type
         StateMap;
 
     /// @brief Class to maintain state for an interface for each report (and
     /// thus state) type explicitly enumerated.
+    ///
+    /// State is published through a sequence lock, so one thread (the one
+    /// calling osvrClientUpdate) may set state while others read it without
+    /// any external locking.
     class InterfaceState {
       public:
         template <typename ReportType>
@@ -71,11 +75,11 @@ namespace client {
             StateMapContents<ReportType> c;
             c.state = reportState(report);
             c.timestamp = timestamp;
-            boost::fusion::at_key<ReportType>(m_states) = c;
+            boost::fusion::at_key<ReportType>(m_states).store(c);
         }
 
         template <typename ReportType> bool hasState() const {
-            return bool(boost::fusion::at_key<ReportType>(m_states));
+            return boost::fusion::at_key<ReportType>(m_states).hasValue();
         }
 
         template <typename ReportType>
@@ -83,9 +87,10 @@ namespace client {
         getState(util::time::TimeValue &timestamp,
                  typename traits::StateType<ReportType>::type &state) const {
             if (hasState<ReportType>()) {
-                timestamp =
-                    boost::fusion::at_key<ReportType>(m_states)->timestamp;
-                state = boost::fusion::at_key<ReportType>(m_states)->state;
+                StateMapContents<ReportType> c =
+                    boost::fusion::at_key<ReportType>(m_states).load();
+                timestamp = c.timestamp;
+                state = c.state;
             }
             /// @todo do we fail silently or throw exception if we are asked for
             /// state we don't have?
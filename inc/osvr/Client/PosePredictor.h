@@ -0,0 +1,103 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PosePredictor_h_GUID_ECAE3D10_88DA_4046_BB91_D7951FDCAF32
+#define INCLUDED_PosePredictor_h_GUID_ECAE3D10_88DA_4046_BB91_D7951FDCAF32
+
+// Internal Includes
+#include <osvr/Client/Export.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace client {
+    /// @brief Estimates linear and angular velocity from successive pose
+    /// reports, and extrapolates the most recent pose to a requested time.
+    ///
+    /// Velocities are smoothed with a simple exponential filter. If reports
+    /// stop arriving for too long, the velocity estimate is discarded rather
+    /// than extrapolated from stale data, and prediction degrades to returning
+    /// the last pose.
+    class PosePredictor {
+      public:
+        OSVR_CLIENT_EXPORT PosePredictor();
+
+        /// @brief Record a new pose report.
+        OSVR_CLIENT_EXPORT void
+        addSample(util::time::TimeValue const &timestamp,
+                  OSVR_PoseState const &pose);
+
+        /// @brief Replace the velocity estimate with velocities measured by
+        /// the device along with the latest sample.
+        ///
+        /// @param linear Linear velocity, or null to keep the estimate.
+        /// @param angular Angular velocity, or null to keep the estimate.
+        OSVR_CLIENT_EXPORT void setVelocity(OSVR_Vec3 const *linear,
+                                            OSVR_Vec3 const *angular);
+
+        /// @brief Have we received any pose at all?
+        bool hasPose() const { return m_hasPose; }
+
+        /// @brief Do we have a current velocity estimate?
+        bool hasVelocity() const { return m_hasVelocity; }
+
+        /// @brief Extrapolate the latest pose to the given target time.
+        ///
+        /// The extrapolation interval is clamped to maxPredictionSeconds() in
+        /// either direction.
+        ///
+        /// @returns false if no pose has been received.
+        OSVR_CLIENT_EXPORT bool predict(util::time::TimeValue const &target,
+                                        OSVR_PoseState &pose) const;
+
+        /// @brief Linear velocity estimate, in units per second.
+        OSVR_Vec3 const &getLinearVelocity() const { return m_linearVelocity; }
+
+        /// @brief Angular velocity estimate, as a rotation vector (axis scaled
+        /// by radians per second) in the tracker's base frame.
+        OSVR_Vec3 const &getAngularVelocity() const {
+            return m_angularVelocity;
+        }
+
+        /// @brief The furthest, in seconds, that a pose will be extrapolated.
+        static double maxPredictionSeconds();
+
+      private:
+        bool m_hasPose;
+        bool m_hasVelocity;
+        util::time::TimeValue m_timestamp;
+        OSVR_PoseState m_pose;
+        OSVR_Vec3 m_linearVelocity;
+        OSVR_Vec3 m_angularVelocity;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_PosePredictor_h_GUID_ECAE3D10_88DA_4046_BB91_D7951FDCAF32
@@ -0,0 +1,64 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_QueuedCallback_h_GUID_5DAAA5DD_AEB4_47B5_A89E_ACDF569687D1
+#define INCLUDED_QueuedCallback_h_GUID_5DAAA5DD_AEB4_47B5_A89E_ACDF569687D1
+
+// Internal Includes
+#include <osvr/Util/ChannelCountC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <functional>
+#include <tuple>
+#include <cstddef>
+
+namespace osvr {
+namespace client {
+    /// @brief Identifies a stream of reports in which a report may make the
+    /// previous one obsolete: an interface, a report type, and a sensor.
+    typedef std::tuple<void const *, int, OSVR_ChannelCount> SupersedeKey;
+
+    /// @brief A callback invocation deferred for later delivery from the
+    /// client context's update().
+    struct QueuedCallback {
+        QueuedCallback() : supersedable(false) {}
+
+        /// @brief Calls the callbacks, given the number of earlier reports
+        /// skipped in favor of this one.
+        std::function<void(std::size_t)> deliver;
+
+        /// @brief Whether a later queued callback with an equal key makes
+        /// this one obsolete (tracker reports), so it may be dropped.
+        bool supersedable;
+
+        /// @brief The stream this report belongs to.
+        SupersedeKey key;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_QueuedCallback_h_GUID_5DAAA5DD_AEB4_47B5_A89E_ACDF569687D1
@@ -46,6 +46,23 @@ namespace client {
         template <>
         struct KeepStateForReport<OSVR_ImagingReport> : std::false_type {};
 
+        /// @brief Type predicate: Whether a report type carries tracker data,
+        /// where each report makes the previous one for its sensor obsolete.
+        template <typename T> struct IsTrackerReport : std::false_type {};
+        template <>
+        struct IsTrackerReport<OSVR_PoseReport> : std::true_type {};
+        template <>
+        struct IsTrackerReport<OSVR_PositionReport> : std::true_type {};
+        template <>
+        struct IsTrackerReport<OSVR_OrientationReport> : std::true_type {};
+
+        /// @brief Type predicate: Whether callbacks for a report type may be
+        /// coalesced. Button reports are discrete events (each press and
+        /// release matters), so never are.
+        template <typename T> struct CanCoalesceReport : std::true_type {};
+        template <>
+        struct CanCoalesceReport<OSVR_ButtonReport> : std::false_type {};
+
     } // namespace traits
 
 } // namespace client
@@ -30,6 +30,9 @@
 
 // Library/third-party includes
 #include <boost/mpl/vector.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/begin.hpp>
+#include <boost/mpl/distance.hpp>
 
 // Standard includes
 // - none
@@ -45,6 +48,14 @@ namespace client {
                                    OSVR_OrientationReport,
                                    OSVR_ImagingReport> ReportTypes;
 
+        /// @brief Metafunction returning the position of a report type in
+        /// ReportTypes, for use as a compact runtime identifier.
+        template <typename T>
+        struct ReportTypeIndex
+            : boost::mpl::distance<
+                  typename boost::mpl::begin<ReportTypes>::type,
+                  typename boost::mpl::find<ReportTypes, T>::type>::type {};
+
     } // namespace traits
 
 } // namespace client
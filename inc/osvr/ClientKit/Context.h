@@ -58,6 +58,20 @@ namespace clientkit {
         }
     }
 
+    inline void ClientContext::updateWithBudget(uint64_t microseconds,
+                                                uint32_t flags) {
+        OSVR_ReturnCode ret =
+            osvrClientUpdateWithBudget(m_context, microseconds, flags);
+        if (OSVR_RETURN_SUCCESS != ret) {
+            throw std::runtime_error("Error updating context.");
+        }
+    }
+
+    inline bool ClientContext::waitForAnyReport(uint64_t timeoutMicroseconds) {
+        return OSVR_RETURN_SUCCESS ==
+               osvrClientWaitForAnyReport(m_context, timeoutMicroseconds);
+    }
+
     inline Interface ClientContext::getInterface(const std::string &path) {
         OSVR_ClientInterface interface = NULL;
         OSVR_ReturnCode ret =
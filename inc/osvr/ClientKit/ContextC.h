@@ -51,11 +51,28 @@ OSVR_EXTERN_C_BEGIN
     @{
 */
 
+/** @brief osvrClientInit() flag: process network messages on an internal
+    thread, so they are handled promptly regardless of how often
+    osvrClientUpdate() is called. Callbacks are queued and delivered by
+    osvrClientUpdate(), on the thread that calls it, which is then cheap.
+
+    State queries (osvrGetPoseState() and friends) always reflect the latest
+    report handled by the network thread.
+*/
+#define OSVR_CLIENT_INIT_NETWORK_THREAD (1u << 0)
+
+/** @brief osvrClientInit() flag: like #OSVR_CLIENT_INIT_NETWORK_THREAD, but
+    callbacks are called directly on the internal network thread as reports
+    arrive. Your callbacks must then be thread-safe and return quickly.
+*/
+#define OSVR_CLIENT_INIT_CALLBACKS_ON_NETWORK_THREAD (1u << 1)
+
 /** @brief Initialize the library.
 
     @param applicationIdentifier A null terminated string identifying your
    application. Reverse DNS format strongly suggested.
-    @param flags initialization options (reserved) - pass 0 for now.
+    @param flags initialization options: 0 or a bitwise-or of
+   OSVR_CLIENT_INIT_ flags.
 
     @returns Client context - will be needed for subsequent calls
 */
@@ -65,10 +82,65 @@ osvrClientInit(const char applicationIdentifier[],
 
 /** @brief Updates the state of the context - call regularly in your mainloop.
 
+    If the context was initialized with a network thread, this just delivers
+    any callbacks that thread has queued.
+
     @param ctx Client context
 */
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientUpdate(OSVR_ClientContext ctx);
 
+/** @brief osvrClientUpdateWithBudget() flag: when several tracker reports
+    for the same interface, report type, and sensor are pending, skip the
+    callbacks for all but the newest rather than replaying them.
+*/
+#define OSVR_CLIENT_UPDATE_DROP_SUPERSEDED (1u << 0)
+
+/** @brief Like osvrClientUpdate(), but stops calling callbacks once the given
+    time budget is spent. Callbacks not yet called are kept, in order, for
+    later calls to osvrClientUpdate() or osvrClientUpdateWithBudget().
+
+    Handling network messages and updating interface state is not
+    interrupted, so the call may still take somewhat longer than the budget
+    after a stall.
+
+    @param ctx Client context
+    @param microseconds Time budget for the call.
+    @param flags 0 or a bitwise-or of OSVR_CLIENT_UPDATE_ flags.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientUpdateWithBudget(OSVR_ClientContext ctx, uint64_t microseconds,
+                           uint32_t flags OSVR_CPP_ONLY(= 0));
+
+/** @brief Block until a report for the given interface has been dispatched
+    (its callbacks called), or the timeout expires - an efficient alternative
+    to polling osvrClientUpdate() with a sleep.
+
+    Without a network thread, this waits on the connection socket and handles
+    messages as they arrive, exactly as repeated osvrClientUpdate() calls
+    would. With one, it sleeps until that thread handles a matching report,
+    then delivers queued callbacks.
+
+    @param ctx Client context
+    @param iface Interface to wait for a report on.
+    @param timeoutMicroseconds Maximum time to wait.
+
+    @returns OSVR_RETURN_SUCCESS if a report was dispatched, failure on
+   timeout or invalid arguments.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientWaitForReport(OSVR_ClientContext ctx, OSVR_ClientInterface iface,
+                        uint64_t timeoutMicroseconds);
+
+/** @brief Like osvrClientWaitForReport(), but returns once a report for any
+    interface of the context has been dispatched.
+
+    @param ctx Client context
+    @param timeoutMicroseconds Maximum time to wait.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientWaitForAnyReport(OSVR_ClientContext ctx,
+                           uint64_t timeoutMicroseconds);
+
 /** @brief Shutdown the library.
     @param ctx Client context
 */
@@ -58,7 +58,8 @@ namespace clientkit {
         /// @brief Initialize the library.
         /// @param applicationIdentifier A string identifying your application.
         /// Reverse DNS format strongly suggested.
-        /// @param flags initialization options (reserved, optional)
+        /// @param flags initialization options, such as
+        /// #OSVR_CLIENT_INIT_NETWORK_THREAD (optional)
         ClientContext(const char applicationIdentifier[], uint32_t flags = 0u);
 
         /// @brief Initialize the context with an existing context.
@@ -72,6 +73,17 @@ namespace clientkit {
         /// mainloop.
         void update();
 
+        /// @brief Updates the state of the context, but stops calling
+        /// callbacks once the time budget is spent.
+        /// @param microseconds Time budget.
+        /// @param flags 0 or #OSVR_CLIENT_UPDATE_DROP_SUPERSEDED
+        void updateWithBudget(uint64_t microseconds, uint32_t flags = 0u);
+
+        /// @brief Blocks until a report for any interface has been dispatched
+        /// or the timeout expires.
+        /// @returns true if a report was dispatched.
+        bool waitForAnyReport(uint64_t timeoutMicroseconds);
+
         /// @brief Get the interface associated with the given path.
         /// @param path A resource path.
         /// @returns The interface object.
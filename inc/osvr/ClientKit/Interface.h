@@ -30,6 +30,7 @@
 #include <osvr/ClientKit/Interface_decl.h>
 #include <osvr/ClientKit/Context_decl.h>
 #include <osvr/ClientKit/InterfaceC.h>
+#include <osvr/ClientKit/ContextC.h>
 #include <osvr/ClientKit/InterfaceCallbackC.h>
 
 // Library/third-party includes
@@ -51,6 +52,12 @@ namespace clientkit {
 
     inline void Interface::free() { m_ctx->free(*this); }
 
+    inline bool Interface::waitForReport(uint64_t timeoutMicroseconds) {
+        return OSVR_RETURN_SUCCESS ==
+               osvrClientWaitForReport(m_ctx->get(), m_interface,
+                                       timeoutMicroseconds);
+    }
+
     inline void
     Interface::takeOwnership(util::boost_util::DeletablePtr const &obj) {
         m_deletables.push_back(obj);
@@ -35,6 +35,8 @@
 #include <osvr/Util/ReturnCodesC.h>
 #include <osvr/Util/AnnotationMacrosC.h>
 #include <osvr/Util/ClientOpaqueTypesC.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/BoolC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -69,6 +71,66 @@ osvrClientGetInterface(OSVR_ClientContext ctx, const char path[],
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
 osvrClientFreeInterface(OSVR_ClientContext ctx, OSVR_ClientInterface iface);
 
+/** @brief Set how many recent reports of each type an interface retains, for
+    use with the osvrGet...StateAtTime() functions.
+
+    History is disabled (capacity 0) by default.
+
+    @param iface The interface object
+    @param capacity Number of samples to retain per report type, or 0 to
+   disable and discard history.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetInterfaceHistoryCapacity(OSVR_ClientInterface iface,
+                                      uint32_t capacity);
+
+/** @brief Enable or disable callback coalescing for an interface, for
+    high-rate devices where only the newest report matters to the app.
+
+    When enabled, all reports of a given type for a given sensor received
+    during one osvrClientUpdate() result in a single call to each callback,
+    with the newest report, at the end of the update. Interface state is still
+    updated for every report. Use osvrClientGetSkippedReportCount() within a
+    callback to find out how many reports were combined. Button reports are
+    never coalesced, since every press and release matters.
+
+    Has no effect if the context calls callbacks directly on its network
+    thread.
+
+    @param iface The interface object
+    @param coalesce OSVR_TRUE to enable, OSVR_FALSE (the default) to disable.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetInterfaceCallbackCoalescing(OSVR_ClientInterface iface,
+                                         OSVR_CBool coalesce);
+
+/** @brief From within a callback, get the number of earlier reports that were
+    skipped in favor of the current one by coalescing (or by
+    #OSVR_CLIENT_UPDATE_DROP_SUPERSEDED).
+
+    @param iface The interface object
+    @param[out] count Number of skipped reports, 0 outside a callback.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetSkippedReportCount(OSVR_ClientInterface iface, uint32_t *count);
+
+/** @brief Get the number of reports for an interface's path that were lost,
+    or arrived out of order, on the way from the server.
+
+    Out-of-order reports are discarded rather than replacing newer state.
+    Counts cover reports carrying sequence numbers: tracker and analog reports
+    over the network, and all reports over same-machine transports. They are
+    shared by all interface objects for the same path.
+
+    @param iface The interface object
+    @param[out] lost Number of reports lost (pass NULL if not needed).
+    @param[out] reordered Number of reports discarded for arriving after a
+   newer one (pass NULL if not needed).
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetInterfaceSequenceStats(OSVR_ClientInterface iface,
+                                    uint64_t *lost, uint64_t *reordered);
+
 /** @} */
 OSVR_EXTERN_C_END
 
@@ -37,6 +37,8 @@
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/BoolC.h>
+#include <osvr/Util/StdInt.h>
 
 /* Library/third-party includes */
 /* none */
@@ -46,6 +48,14 @@
 
 OSVR_EXTERN_C_BEGIN
 
+/* All of these functions may be called from any thread, concurrently with
+   osvrClientUpdate, without external locking. The osvrGet...State and
+   osvrGetPredictedPoseState functions never block, and the
+   osvrGet...StateAtTime functions only for as long as it takes to record a
+   single report. The batch osvrGet...States functions take the context's
+   update lock, so they block while reports are being processed: for up to a
+   whole pass of osvrClientUpdate or the network thread. */
+
 #define OSVR_CALLBACK_METHODS(TYPE)                                            \
     /** @brief Get TYPE state from an interface, returning failure if none     \
      * exists */                                                               \
@@ -61,6 +71,66 @@ OSVR_CALLBACK_METHODS(Analog)
 
 #undef OSVR_CALLBACK_METHODS
 
+#define OSVR_BATCH_METHODS(TYPE)                                               \
+    /** @brief Get TYPE state from each of an array of interfaces belonging    \
+     * to ctx in one call. The states are a consistent snapshot: none of them  \
+     * reflect a report received after another was read. valid, if not NULL,   \
+     * is set per interface; returns failure if any interface has no state     \
+     * (leaving its entries untouched). */                                     \
+    OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##States(               \
+        OSVR_ClientContext ctx, uint32_t count,                                \
+        OSVR_ClientInterface const *ifaces, struct OSVR_TimeValue *timestamps, \
+        OSVR_##TYPE##State *states, OSVR_CBool *valid);
+
+OSVR_BATCH_METHODS(Pose)
+OSVR_BATCH_METHODS(Position)
+OSVR_BATCH_METHODS(Orientation)
+OSVR_BATCH_METHODS(Button)
+OSVR_BATCH_METHODS(Analog)
+
+#undef OSVR_BATCH_METHODS
+
+#define OSVR_HISTORY_METHODS(TYPE)                                             \
+    /** @brief Get TYPE state from an interface's history at the given time,   \
+     * returning failure if history is disabled or empty. If interpolate is    \
+     * true, the two samples surrounding the time are blended, and timestamp   \
+     * is set to the requested time; otherwise the nearest sample is           \
+     * returned with its own timestamp. */                                     \
+    OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrGet##TYPE##StateAtTime(          \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *time,         \
+        OSVR_CBool interpolate, struct OSVR_TimeValue *timestamp,              \
+        OSVR_##TYPE##State *state);
+
+OSVR_HISTORY_METHODS(Pose)
+OSVR_HISTORY_METHODS(Position)
+OSVR_HISTORY_METHODS(Orientation)
+OSVR_HISTORY_METHODS(Button)
+OSVR_HISTORY_METHODS(Analog)
+
+#undef OSVR_HISTORY_METHODS
+
+/** @brief Get the pose state from an interface, extrapolated to a target time
+    using linear and angular velocity estimated from recent pose reports.
+
+    Typically used to predict the head pose at the time the frame being
+    rendered will reach the display. The target time is in the same clock
+    domain as report timestamps (see osvrTimeValueGetSteadyNow()), and the
+    extrapolation interval is limited to a short horizon.
+
+    If too few reports have arrived to estimate velocity, the latest pose is
+    returned unmodified.
+
+    @param iface The interface to query.
+    @param targetTime The time to predict the pose for.
+    @param [out] state The predicted pose.
+
+    @returns failure if no pose state exists.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrGetPredictedPoseState(OSVR_ClientInterface iface,
+                          OSVR_IN_PTR struct OSVR_TimeValue const *targetTime,
+                          OSVR_OUT OSVR_PoseState *state);
+
 OSVR_EXTERN_C_END
 
 #endif
@@ -76,6 +76,11 @@ namespace clientkit {
         /// @brief Get the associated ClientContext
         ClientContext &getContext();
 
+        /// @brief Blocks until a report for this interface has been
+        /// dispatched or the timeout expires.
+        /// @returns true if a report was dispatched.
+        bool waitForReport(uint64_t timeoutMicroseconds);
+
         /// @brief Manually free the interface before the context is closed.
         ///
         /// This is not required, but can be used, for instance, to ensure that
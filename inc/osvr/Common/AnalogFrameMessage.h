@@ -0,0 +1,330 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AnalogFrameMessage_h_GUID_9DDF0A61_D64F_407A_B5CB_D8B1CBE5A4D3
+#define INCLUDED_AnalogFrameMessage_h_GUID_9DDF0A61_D64F_407A_B5CB_D8B1CBE5A4D3
+
+// Internal Includes
+#include <osvr/Common/Endianness.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    /// @brief The payload of a VRPN message carrying values of an analog
+    /// device, without VRPN's limit on the number of channels.
+    ///
+    /// In network byte order: a sequence number (see ReportSequenceCounter),
+    /// the encoding and a sparse flag (one byte each), a reserved 16-bit
+    /// word, the number of values, the first channel, and the scale as a
+    /// 64-bit float. A dense frame then carries the values of channels
+    /// [first, first + count); a sparse frame carries the (ascending) channel
+    /// numbers as 32-bit integers, followed by their values.
+    class AnalogFrameMessage {
+      public:
+        /// @brief How each value is sent.
+        enum Encoding {
+            /// @brief Full precision.
+            FLOAT64 = 0,
+            /// @brief Single precision, at half the size.
+            FLOAT32 = 1,
+            /// @brief Multiples of the frame's scale, clamped to +/-32767.
+            INT16 = 2
+        };
+
+        enum {
+            /// @brief Largest message: small enough to fit in a single UDP
+            /// datagram.
+            MAX_SIZE = 1400
+        };
+
+        /// @brief VRPN message type name.
+        static const char *identifier() { return "com.osvr.analog.frame"; }
+
+        /// @brief Size of each value in the given encoding.
+        static std::size_t valueSize(Encoding encoding) {
+            switch (encoding) {
+            case FLOAT32:
+                return sizeof(float);
+            case INT16:
+                return sizeof(int16_t);
+            default:
+                return sizeof(double);
+            }
+        }
+
+        /// @brief Size of a dense frame of the given number of values.
+        static std::size_t denseSize(Encoding encoding, std::size_t count) {
+            return HEADER_SIZE + count * valueSize(encoding);
+        }
+
+        /// @brief Size of a sparse frame of the given number of values.
+        static std::size_t sparseSize(Encoding encoding, std::size_t count) {
+            return HEADER_SIZE +
+                   count * (sizeof(uint32_t) + valueSize(encoding));
+        }
+
+        /// @brief Most values a dense frame can carry.
+        static std::size_t maxDense(Encoding encoding) {
+            return (MAX_SIZE - HEADER_SIZE) / valueSize(encoding);
+        }
+
+        /// @brief Most values a sparse frame can carry.
+        static std::size_t maxSparse(Encoding encoding) {
+            return (MAX_SIZE - HEADER_SIZE) /
+                   (sizeof(uint32_t) + valueSize(encoding));
+        }
+
+        /// @brief Encodes the values of channels [first, first + count).
+        ///
+        /// @param buf Destination, with room for at least MAX_SIZE bytes.
+        /// @param scale Value of one step, for INT16: must be positive.
+        /// @param count Number of values, at most maxDense(): any more are
+        /// not encoded.
+        ///
+        /// @returns the number of bytes written.
+        static std::size_t encodeDense(char *buf, uint32_t sequence,
+                                       Encoding encoding, double scale,
+                                       int32_t first,
+                                       OSVR_AnalogState const vals[],
+                                       std::size_t count) {
+            count = std::min(count, maxDense(encoding));
+            s_putHeader(buf, sequence, encoding, false, count, first, scale);
+            for (std::size_t i = 0; i < count; ++i) {
+                s_putValue(buf, encoding, scale, vals[i]);
+            }
+            return denseSize(encoding, count);
+        }
+
+        /// @brief Encodes the values of the listed channels.
+        ///
+        /// @param channels Channel numbers, in ascending order.
+        /// @param vals Values of all channels, indexed by channel number.
+        /// @param count Number of channels listed, at most maxSparse(): any
+        /// more are not encoded.
+        ///
+        /// @returns the number of bytes written.
+        static std::size_t encodeSparse(char *buf, uint32_t sequence,
+                                        Encoding encoding, double scale,
+                                        uint32_t const channels[],
+                                        OSVR_AnalogState const vals[],
+                                        std::size_t count) {
+            count = std::min(count, maxSparse(encoding));
+            s_putHeader(buf, sequence, encoding, true, count, 0, scale);
+            for (std::size_t i = 0; i < count; ++i) {
+                s_put(buf, channels[i]);
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                s_putValue(buf, encoding, scale, vals[channels[i]]);
+            }
+            return sparseSize(encoding, count);
+        }
+
+        /// @brief Wraps a received message, without copying it: the buffer
+        /// must outlive this object.
+        AnalogFrameMessage(char const *buf, std::size_t len)
+            : m_buf(buf), m_sequence(0), m_encoding(FLOAT64), m_sparse(false),
+              m_count(0), m_first(0), m_scale(0) {
+            if (len < HEADER_SIZE) {
+                m_buf = nullptr;
+                return;
+            }
+            uint8_t encoding;
+            uint8_t sparse;
+            uint16_t reserved;
+            s_get(buf, m_sequence);
+            s_get(buf, encoding);
+            s_get(buf, sparse);
+            s_get(buf, reserved);
+            s_get(buf, m_count);
+            s_get(buf, m_first);
+            s_get(buf, m_scale);
+            if (encoding > INT16 || sparse > 1) {
+                m_buf = nullptr;
+                return;
+            }
+            m_encoding = Encoding(encoding);
+            m_sparse = (sparse != 0);
+            const std::size_t limit =
+                m_sparse ? maxSparse(m_encoding) : maxDense(m_encoding);
+            const std::size_t expected =
+                m_sparse ? sparseSize(m_encoding, m_count)
+                         : denseSize(m_encoding, m_count);
+            if (m_count > limit || len != expected ||
+                (m_encoding == INT16 && !(m_scale > 0))) {
+                m_buf = nullptr;
+            }
+        }
+
+        /// @brief Did the constructor find a well-formed message?
+        bool isValid() const { return m_buf != nullptr; }
+
+        uint32_t getSequence() const { return m_sequence; }
+        Encoding getEncoding() const { return m_encoding; }
+        bool isSparse() const { return m_sparse; }
+        std::size_t getCount() const { return m_count; }
+
+        /// @brief Decodes the value of a channel, if this message carries
+        /// it.
+        bool getValue(int32_t channel, OSVR_AnalogState &val) const {
+            std::size_t index;
+            if (!m_find(channel, index)) {
+                return false;
+            }
+            char const *buf = m_buf + HEADER_SIZE +
+                              (m_sparse ? m_count * sizeof(uint32_t) : 0) +
+                              index * valueSize(m_encoding);
+            val = s_getValue(buf, m_encoding, m_scale);
+            return true;
+        }
+
+      private:
+        enum {
+            HEADER_SIZE = 4 * sizeof(uint32_t) + sizeof(double),
+            INT16_LIMIT = 32767
+        };
+
+        /// @brief Finds the position of a channel's value in the message.
+        bool m_find(int32_t channel, std::size_t &index) const {
+            if (!isValid() || channel < 0) {
+                return false;
+            }
+            if (!m_sparse) {
+                if (channel < m_first ||
+                    uint32_t(channel - m_first) >= m_count) {
+                    return false;
+                }
+                index = std::size_t(channel - m_first);
+                return true;
+            }
+            /// Binary search of the channel list.
+            std::size_t lo = 0;
+            std::size_t hi = m_count;
+            while (lo < hi) {
+                const std::size_t mid = lo + (hi - lo) / 2;
+                char const *buf = m_buf + HEADER_SIZE + mid * sizeof(uint32_t);
+                uint32_t listed;
+                s_get(buf, listed);
+                if (listed == uint32_t(channel)) {
+                    index = mid;
+                    return true;
+                }
+                if (listed < uint32_t(channel)) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return false;
+        }
+
+        static void s_putHeader(char *&buf, uint32_t sequence,
+                                Encoding encoding, bool sparse,
+                                std::size_t count, int32_t first,
+                                double scale) {
+            s_put(buf, sequence);
+            s_put(buf, uint8_t(encoding));
+            s_put(buf, uint8_t(sparse ? 1 : 0));
+            s_put(buf, uint16_t(0));
+            s_put(buf, uint32_t(count));
+            s_put(buf, first);
+            s_put(buf, scale);
+        }
+
+        static void s_putValue(char *&buf, Encoding encoding, double scale,
+                               OSVR_AnalogState val) {
+            switch (encoding) {
+            case FLOAT32:
+                s_put(buf, serialization::safe_pun<uint32_t>(float(val)));
+                return;
+            case INT16: {
+                const double limit = INT16_LIMIT;
+                const double steps = std::floor(val / scale + 0.5);
+                s_put(buf, int16_t(std::max(-limit, std::min(steps, limit))));
+                return;
+            }
+            default:
+                s_put(buf, val);
+                return;
+            }
+        }
+
+        static OSVR_AnalogState s_getValue(char const *buf, Encoding encoding,
+                                           double scale) {
+            switch (encoding) {
+            case FLOAT32: {
+                uint32_t word;
+                s_get(buf, word);
+                return serialization::safe_pun<float>(word);
+            }
+            case INT16: {
+                int16_t steps;
+                s_get(buf, steps);
+                return steps * scale;
+            }
+            default: {
+                OSVR_AnalogState val;
+                s_get(buf, val);
+                return val;
+            }
+            }
+        }
+
+        /// @brief Writes a value in network byte order, advancing the
+        /// pointer.
+        template <typename T> static void s_put(char *&buf, T val) {
+            val = serialization::hton(val);
+            std::memcpy(buf, &val, sizeof(val));
+            buf += sizeof(val);
+        }
+
+        /// @brief Reads a value in network byte order, advancing the
+        /// pointer.
+        template <typename T> static void s_get(char const *&buf, T &val) {
+            std::memcpy(&val, buf, sizeof(val));
+            val = serialization::ntoh(val);
+            buf += sizeof(val);
+        }
+
+        char const *m_buf;
+        uint32_t m_sequence;
+        Encoding m_encoding;
+        bool m_sparse;
+        uint32_t m_count;
+        int32_t m_first;
+        double m_scale;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_AnalogFrameMessage_h_GUID_9DDF0A61_D64F_407A_B5CB_D8B1CBE5A4D3
@@ -92,7 +92,7 @@ namespace common {
         void packMessage(Buffer<T> const &buf, RawMessageType const &msgType,
                          uint32_t classOfService = vrpn_CONNECTION_RELIABLE) {
             util::time::TimeValue t;
-            util::time::getNow(t);
+            util::time::getSteadyNow(t);
             m_packMessage(buf.size(), buf.data(), msgType, t, classOfService);
         }
 
@@ -0,0 +1,138 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ClockSync_h_GUID_51337EDA_95D6_47BD_96B4_F8C9609E2868
+#define INCLUDED_ClockSync_h_GUID_51337EDA_95D6_47BD_96B4_F8C9609E2868
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <deque>
+#include <cstddef>
+#include <random>
+
+namespace osvr {
+namespace common {
+    /// @brief The timestamps carried by a clock synchronization ping/pong
+    /// exchange, each in the clock domain of the host that recorded it.
+    struct ClockSyncTimestamps {
+        /// @brief Chosen by the client and echoed back by the server, so a
+        /// client can tell pongs answering its own pings from pongs answering
+        /// other clients on the same connection.
+        uint32_t nonce;
+        /// @brief Client clock when the ping was sent.
+        util::time::TimeValue clientSent;
+        /// @brief Server clock when the ping was received.
+        util::time::TimeValue serverReceived;
+        /// @brief Server clock when the pong was sent.
+        util::time::TimeValue serverSent;
+    };
+
+    /// @brief Estimates the offset between a server clock and the local
+    /// (client) clock from a series of ping/pong exchanges.
+    ///
+    /// Uses the usual NTP-style computation for each exchange, and reports the
+    /// sample with the smallest round-trip time out of a sliding window, since
+    /// that sample's offset is least contaminated by queuing delay.
+    class ClockOffsetEstimator {
+      public:
+        /// @brief Constructor
+        ///
+        /// @param windowSize Number of recent exchanges to consider.
+        OSVR_COMMON_EXPORT explicit ClockOffsetEstimator(
+            std::size_t windowSize = 8);
+
+        /// @brief Records a ping about to be sent.
+        ///
+        /// @param clientSent Client clock at send time.
+        /// @return The nonce to send with the ping.
+        OSVR_COMMON_EXPORT uint32_t
+        startExchange(util::time::TimeValue const &clientSent);
+
+        /// @brief Adds the results of an exchange if the pong answers a ping
+        /// recorded by startExchange() and not yet answered: both the nonce
+        /// and the client send time must match.
+        ///
+        /// @return false if the pong was ignored, such as one answering
+        /// another client's ping.
+        OSVR_COMMON_EXPORT bool
+        addResponse(ClockSyncTimestamps const &timestamps,
+                    util::time::TimeValue const &clientReceived);
+
+        /// @brief Adds the results of a completed exchange, without checking
+        /// it against outstanding pings.
+        ///
+        /// @param timestamps The timestamps carried in the pong.
+        /// @param clientReceived Client clock when the pong was received.
+        OSVR_COMMON_EXPORT void
+        addSample(ClockSyncTimestamps const &timestamps,
+                  util::time::TimeValue const &clientReceived);
+
+        /// @brief Have we received at least one usable sample?
+        OSVR_COMMON_EXPORT bool hasEstimate() const;
+
+        /// @brief Gets the current estimate of server clock minus client
+        /// clock. Zero if there is no estimate.
+        OSVR_COMMON_EXPORT util::time::TimeValue getOffset() const;
+
+        /// @brief Gets the round-trip time of the sample the current offset
+        /// estimate was taken from. Zero if there is no estimate.
+        OSVR_COMMON_EXPORT util::time::TimeValue getRoundTripTime() const;
+
+        /// @brief Translates a timestamp from the server clock domain to the
+        /// client clock domain. Returns the input unchanged if there is no
+        /// estimate yet.
+        OSVR_COMMON_EXPORT util::time::TimeValue
+        toClientTime(util::time::TimeValue const &serverTime) const;
+
+        /// @brief Discards all samples and outstanding pings, such as after a
+        /// reconnection.
+        OSVR_COMMON_EXPORT void reset();
+
+      private:
+        struct Sample {
+            int64_t offset;
+            int64_t roundTrip;
+        };
+        struct Ping {
+            uint32_t nonce;
+            util::time::TimeValue clientSent;
+        };
+        void m_updateBest();
+        std::size_t m_windowSize;
+        std::deque<Sample> m_samples;
+        Sample m_best;
+        std::deque<Ping> m_outstanding;
+        std::mt19937 m_nonces;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ClockSync_h_GUID_51337EDA_95D6_47BD_96B4_F8C9609E2868
@@ -0,0 +1,214 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_CompiledTransform_h_GUID_15DCF682_93F6_4D5A_A174_658E14E24D97
+#define INCLUDED_CompiledTransform_h_GUID_15DCF682_93F6_4D5A_A174_658E14E24D97
+
+// Internal Includes
+#include <osvr/Common/Transform.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+
+    /// @brief A Transform prepared for applying to many poses.
+    ///
+    /// Route transforms are almost always rigid, so where the pre and post
+    /// matrices are, they are stored as quaternion and translation pairs and
+    /// applied with quaternion math, skipping whatever parts are identity.
+    /// Anything else (such as a change of basis to a different handedness)
+    /// falls back to applying the matrices.
+    class CompiledTransform {
+      public:
+        enum Kind {
+            /// @brief Leaves poses unchanged.
+            IDENTITY,
+            /// @brief Rotations only, without translation.
+            ROTATION,
+            /// @brief Translations only, without rotation.
+            TRANSLATION,
+            /// @brief Rigid transforms with rotation and translation.
+            RIGID,
+            /// @brief Not rigid: applied as 4x4 matrices.
+            GENERAL
+        };
+
+        /// @brief Compiles the given transform.
+        explicit CompiledTransform(Transform const &xform = Transform())
+            : m_kind(GENERAL), m_xform(xform) {
+            const bool rigid =
+                s_decompose(xform.getPre(), m_preRotation,
+                            m_preTranslation) &&
+                s_decompose(xform.getPost(), m_postRotation,
+                            m_postTranslation);
+            if (!rigid) {
+                return;
+            }
+            const bool rotates = !s_isIdentity(m_preRotation) ||
+                                 !s_isIdentity(m_postRotation);
+            const bool translates = !m_preTranslation.isZero(s_tolerance()) ||
+                                    !m_postTranslation.isZero(s_tolerance());
+            if (rotates && translates) {
+                m_kind = RIGID;
+            } else if (rotates) {
+                m_kind = ROTATION;
+            } else if (translates) {
+                m_kind = TRANSLATION;
+            } else {
+                m_kind = IDENTITY;
+            }
+        }
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        Kind getKind() const { return m_kind; }
+
+        Transform const &getTransform() const { return m_xform; }
+
+        /// @brief Apply the transformation to a pose, in place: equivalent to
+        /// Transform::transform() on the pose's matrix.
+        void apply(OSVR_Pose3 &pose) const {
+            switch (m_kind) {
+            case IDENTITY:
+                return;
+            case ROTATION: {
+                Eigen::Quaterniond q(util::fromQuat(pose.rotation));
+                util::vecMap(pose.translation) =
+                    m_postRotation * util::vecMap(pose.translation);
+                util::toQuat(m_postRotation * q * m_preRotation,
+                             pose.rotation);
+                return;
+            }
+            case TRANSLATION: {
+                Eigen::Quaterniond q(util::fromQuat(pose.rotation));
+                util::vecMap(pose.translation) +=
+                    q * m_preTranslation + m_postTranslation;
+                return;
+            }
+            case RIGID: {
+                Eigen::Quaterniond q(util::fromQuat(pose.rotation));
+                Eigen::Vector3d t(util::vecMap(pose.translation));
+                t += q * m_preTranslation;
+                util::vecMap(pose.translation) =
+                    m_postRotation * t + m_postTranslation;
+                util::toQuat(m_postRotation * q * m_preRotation,
+                             pose.rotation);
+                return;
+            }
+            case GENERAL:
+                util::toPose(
+                    m_xform.transform(util::fromPose(pose).matrix()), pose);
+                return;
+            }
+        }
+
+        /// @brief Apply the transformation to the velocity of a body, in
+        /// place, to match apply() on its pose.
+        ///
+        /// @param rotation The body's orientation, before apply().
+        /// @param linear Linear velocity, or null if unknown.
+        /// @param angular Angular velocity (as a rotation vector in the base
+        /// frame), or null if unknown.
+        ///
+        /// @returns false, leaving the velocities unchanged, if they can't be
+        /// transformed: for transforms that aren't rigid, or linear velocity
+        /// under a pre-translation without the angular velocity.
+        bool applyToVelocity(OSVR_Quaternion const &rotation,
+                             OSVR_Vec3 *linear, OSVR_Vec3 *angular) const {
+            if (m_kind == IDENTITY) {
+                return true;
+            }
+            if (m_kind == GENERAL) {
+                return false;
+            }
+            if (linear) {
+                Eigen::Vector3d vel(util::vecMap(*linear));
+                /// A pre-translation moves the point tracked away from the
+                /// body's origin, so rotation adds to its linear velocity.
+                const Eigen::Vector3d lever =
+                    util::fromQuat(rotation) * m_preTranslation;
+                if (!lever.isZero(s_tolerance())) {
+                    if (!angular) {
+                        return false;
+                    }
+                    vel += util::vecMap(*angular).cross(lever);
+                }
+                util::vecMap(*linear) = m_postRotation * vel;
+            }
+            if (angular) {
+                util::vecMap(*angular) =
+                    m_postRotation * util::vecMap(*angular);
+            }
+            return true;
+        }
+
+      private:
+        /// @brief Tolerance for treating parts of a transform as rigid or
+        /// identity.
+        static double s_tolerance() { return 1e-6; }
+
+        /// @brief Splits a rigid transform matrix into rotation and
+        /// translation.
+        ///
+        /// @returns false if the matrix is not a rigid transform.
+        static bool s_decompose(Eigen::Matrix4d const &mat,
+                                Eigen::Quaterniond &rotation,
+                                Eigen::Vector3d &translation) {
+            const Eigen::Matrix3d rot = mat.topLeftCorner<3, 3>();
+            const bool rigid =
+                mat.row(3).isApprox(Eigen::RowVector4d(0, 0, 0, 1),
+                                    s_tolerance()) &&
+                (rot.transpose() * rot).isIdentity(s_tolerance()) &&
+                rot.determinant() > 0;
+            if (!rigid) {
+                return false;
+            }
+            rotation = Eigen::Quaterniond(rot).normalized();
+            translation = mat.topRightCorner<3, 1>();
+            return true;
+        }
+
+        static bool s_isIdentity(Eigen::Quaterniond const &q) {
+            return q.vec().isZero(s_tolerance());
+        }
+
+        Kind m_kind;
+        Eigen::Quaterniond m_preRotation;
+        Eigen::Quaterniond m_postRotation;
+        Eigen::Vector3d m_preTranslation;
+        Eigen::Vector3d m_postTranslation;
+        Transform m_xform;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_CompiledTransform_h_GUID_15DCF682_93F6_4D5A_A174_658E14E24D97
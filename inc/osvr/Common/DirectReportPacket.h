@@ -0,0 +1,295 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DirectReportPacket_h_GUID_1628635D_B115_488E_A916_DF510CDD5107
+#define INCLUDED_DirectReportPacket_h_GUID_1628635D_B115_488E_A916_DF510CDD5107
+
+// Internal Includes
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TrackerStateC.h>
+#include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    /// @brief A device report in a compact native form, for transports
+    /// between a server and clients on the same machine, so both ends share
+    /// a byte order and need no serialization.
+    ///
+    /// Devices are identified by a number the server assigns: a DEVICE_NAME
+    /// packet associates the number with the device's name.
+    class DirectReportPacket {
+      public:
+        enum Kind {
+            /// @brief No valid contents.
+            INVALID = 0,
+            /// @brief Announces the name for a device number.
+            DEVICE_NAME,
+            /// @brief Poses for a run of consecutive sensors, sampled at the
+            /// same time.
+            TRACKER,
+            /// @brief Values for a run of consecutive analog channels.
+            ANALOG,
+            /// @brief States for a run of consecutive buttons.
+            BUTTON,
+            /// @brief The complete tracker state of one sensor.
+            TRACKER_STATE
+        };
+
+        /// @brief Largest number of analog channels in one packet.
+        static std::size_t maxValues() {
+            return s_maxPayload() / sizeof(OSVR_AnalogState);
+        }
+
+        /// @brief Largest number of poses in one packet.
+        static std::size_t maxPoses() {
+            return s_maxPayload() / sizeof(OSVR_PoseState);
+        }
+
+        DirectReportPacket() {
+            /// data() and size() treat the header and payload as one block.
+            static_assert(offsetof(DirectReportPacket, m_payload) ==
+                              sizeof(Header),
+                          "The payload must directly follow the header");
+            std::memset(&m_header, 0, sizeof(m_header));
+        }
+
+        /// @brief Copies only the meaningful bytes, since most packets are
+        /// much smaller than the payload capacity.
+        DirectReportPacket(DirectReportPacket const &other) {
+            m_copy(other);
+        }
+
+        /// @overload
+        DirectReportPacket &operator=(DirectReportPacket const &other) {
+            if (this != &other) {
+                m_copy(other);
+            }
+            return *this;
+        }
+
+        Kind getKind() const { return static_cast<Kind>(m_header.kind); }
+        uint32_t getDevice() const { return m_header.device; }
+        /// @brief First sensor or channel for TRACKER, ANALOG and BUTTON.
+        int32_t getSensor() const { return m_header.sensor; }
+        /// @brief Number of sensors or channels for TRACKER, ANALOG and
+        /// BUTTON.
+        std::size_t getCount() const { return m_header.count; }
+        OSVR_TimeValue const &getTimestamp() const {
+            return m_header.timestamp;
+        }
+
+        /// @brief Sequence number among the device's packets of the same
+        /// kind: see ReportSequenceCounter.
+        uint32_t getSequence() const { return m_header.sequence; }
+
+        /// @brief Sets the sequence number - call after setting contents.
+        void setSequence(uint32_t sequence) { m_header.sequence = sequence; }
+
+        /// @brief Does this packet carry the given sensor or channel?
+        bool hasSensor(int32_t sensor) const {
+            return sensor >= m_header.sensor &&
+                   sensor - m_header.sensor < m_header.count;
+        }
+
+        void setDeviceName(uint32_t device, std::string const &name) {
+            std::size_t len = std::min(name.size(), s_maxPayload());
+            m_setHeader(DEVICE_NAME, device, 0, len, OSVR_TimeValue());
+            std::memcpy(m_payload, name.data(), len);
+        }
+
+        std::string getDeviceName() const {
+            return std::string(reinterpret_cast<char const *>(m_payload),
+                               m_header.count);
+        }
+
+        void setPose(uint32_t device, int32_t sensor,
+                     OSVR_TimeValue const &timestamp,
+                     OSVR_PoseState const &pose) {
+            setPoses(device, sensor, timestamp, &pose, 1);
+        }
+
+        /// @brief Sets poses for sensors [first, first + count).
+        void setPoses(uint32_t device, int32_t first,
+                      OSVR_TimeValue const &timestamp,
+                      OSVR_PoseState const poses[], std::size_t count) {
+            count = std::min(count, maxPoses());
+            m_setHeader(TRACKER, device, first, count, timestamp);
+            std::memcpy(m_payload, poses, count * sizeof(OSVR_PoseState));
+        }
+
+        /// @brief Gets the pose of the first sensor.
+        OSVR_PoseState getPose() const { return getPose(m_header.sensor); }
+
+        /// @brief Gets the pose of a sensor - check hasSensor() first.
+        OSVR_PoseState getPose(int32_t sensor) const {
+            OSVR_PoseState ret;
+            std::memcpy(&ret, m_payload + (sensor - m_header.sensor) *
+                                              sizeof(OSVR_PoseState),
+                        sizeof(ret));
+            return ret;
+        }
+
+        void setTrackerState(uint32_t device, int32_t sensor,
+                             OSVR_TimeValue const &timestamp,
+                             OSVR_TrackerState const &state) {
+            m_setHeader(TRACKER_STATE, device, sensor, 1, timestamp);
+            std::memcpy(m_payload, &state, sizeof(state));
+        }
+
+        OSVR_TrackerState getTrackerState() const {
+            OSVR_TrackerState ret;
+            std::memcpy(&ret, m_payload, sizeof(ret));
+            return ret;
+        }
+
+        /// @brief Sets values for channels [first, first + count).
+        void setAnalogs(uint32_t device, int32_t first,
+                        OSVR_TimeValue const &timestamp,
+                        OSVR_AnalogState const vals[], std::size_t count) {
+            count = std::min(count, maxValues());
+            m_setHeader(ANALOG, device, first, count, timestamp);
+            std::memcpy(m_payload, vals, count * sizeof(OSVR_AnalogState));
+        }
+
+        /// @brief Gets the value of a channel - check hasSensor() first.
+        OSVR_AnalogState getAnalog(int32_t channel) const {
+            OSVR_AnalogState ret;
+            std::memcpy(&ret, m_payload + (channel - m_header.sensor) *
+                                              sizeof(OSVR_AnalogState),
+                        sizeof(ret));
+            return ret;
+        }
+
+        /// @brief Sets states for buttons [first, first + count).
+        void setButtons(uint32_t device, int32_t first,
+                        OSVR_TimeValue const &timestamp,
+                        OSVR_ButtonState const vals[], std::size_t count) {
+            count = std::min(count, s_maxPayload());
+            m_setHeader(BUTTON, device, first, count, timestamp);
+            std::memcpy(m_payload, vals, count * sizeof(OSVR_ButtonState));
+        }
+
+        /// @brief Gets the state of a button - check hasSensor() first.
+        OSVR_ButtonState getButton(int32_t button) const {
+            return m_payload[button - m_header.sensor];
+        }
+
+        /// @brief Start of the packet's bytes, for sending.
+        void const *data() const { return &m_header; }
+
+        /// @brief Number of meaningful bytes starting at data().
+        std::size_t size() const { return sizeof(Header) + m_payloadSize(); }
+
+        /// @brief Largest possible size().
+        static std::size_t maxSize() {
+            return sizeof(Header) + s_maxPayload();
+        }
+
+        /// @brief Copies in a received packet.
+        ///
+        /// @returns false (leaving the packet INVALID) if the bytes do not
+        /// hold a well-formed packet.
+        bool assign(void const *buf, std::size_t len) {
+            m_header.kind = INVALID;
+            if (len < sizeof(Header) || len > maxSize()) {
+                return false;
+            }
+            std::memcpy(&m_header, buf, sizeof(Header));
+            std::memcpy(m_payload, static_cast<char const *>(buf) +
+                                       sizeof(Header),
+                        len - sizeof(Header));
+            if (getKind() < DEVICE_NAME || getKind() > TRACKER_STATE ||
+                size() != len) {
+                m_header.kind = INVALID;
+                return false;
+            }
+            return true;
+        }
+
+      private:
+        /// @brief Payload capacity in bytes: enough for the most channels a
+        /// VRPN analog device can have.
+        enum { MAX_PAYLOAD = 128 * sizeof(OSVR_AnalogState) };
+        static std::size_t s_maxPayload() { return MAX_PAYLOAD; }
+
+        struct Header {
+            uint8_t kind;
+            uint8_t reserved;
+            uint16_t count;
+            uint32_t device;
+            int32_t sensor;
+            uint32_t sequence;
+            OSVR_TimeValue timestamp;
+        };
+
+        void m_setHeader(Kind kind, uint32_t device, int32_t sensor,
+                         std::size_t count, OSVR_TimeValue const &timestamp) {
+            m_header.kind = static_cast<uint8_t>(kind);
+            m_header.reserved = 0;
+            m_header.count = static_cast<uint16_t>(count);
+            m_header.device = device;
+            m_header.sensor = sensor;
+            m_header.sequence = 0;
+            m_header.timestamp = timestamp;
+        }
+
+        void m_copy(DirectReportPacket const &other) {
+            m_header = other.m_header;
+            std::memcpy(m_payload, other.m_payload, other.m_payloadSize());
+        }
+
+        std::size_t m_payloadSize() const {
+            switch (getKind()) {
+            case DEVICE_NAME:
+                return m_header.count;
+            case TRACKER:
+                return m_header.count * sizeof(OSVR_PoseState);
+            case ANALOG:
+                return m_header.count * sizeof(OSVR_AnalogState);
+            case BUTTON:
+                return m_header.count * sizeof(OSVR_ButtonState);
+            case TRACKER_STATE:
+                return sizeof(OSVR_TrackerState);
+            default:
+                return 0;
+            }
+        }
+
+        Header m_header;
+        unsigned char m_payload[MAX_PAYLOAD];
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_DirectReportPacket_h_GUID_1628635D_B115_488E_A916_DF510CDD5107
@@ -0,0 +1,180 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InProcessReportHub_h_GUID_0A751176_8123_42DC_A78A_320209FA2139
+#define INCLUDED_InProcessReportHub_h_GUID_0A751176_8123_42DC_A78A_320209FA2139
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/DirectReportPacket.h>
+#include <osvr/Util/SPSCQueue.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    class InProcessReportHub;
+    typedef shared_ptr<InProcessReportHub> InProcessReportHubPtr;
+
+    /// @brief Prefix of client host strings that select an in-process
+    /// connection: followed by the hub name, or by nothing for the default.
+    inline const char *getInProcessHostPrefix() { return "inproc:"; }
+
+    /// @brief Hands device reports from a server to client contexts in the
+    /// same process, without sockets or serialization.
+    ///
+    /// Each subscribed client gets its own lock-free queue of
+    /// DirectReportPacket objects. Like other DirectReportPacket transports,
+    /// the hub numbers devices and queues a DEVICE_NAME packet for each,
+    /// both to existing subscribers when a device is added and to new
+    /// subscribers for devices already added. When a client's queue is
+    /// full, tracker and analog packets are dropped, but button and
+    /// DEVICE_NAME packets are kept in order in an overflow list.
+    ///
+    /// The queues have a single producer, so only one server may publish to
+    /// a hub, as enforced by attachServer(), and its side (addDevice() and
+    /// publish()) must be called from one thread at a time, as a Connection
+    /// already ensures for device sends. The client side may be called from
+    /// any thread.
+    class InProcessReportHub : boost::noncopyable {
+      public:
+        /// @brief The packets waiting for one client.
+        ///
+        /// Lock-free unless the queue has filled up, after which packets
+        /// that must not be dropped go to a list behind a mutex until the
+        /// client has caught up.
+        class Queue : boost::noncopyable {
+          public:
+            explicit Queue(std::size_t capacity);
+
+            /// @brief Dequeues the oldest packet - client thread only.
+            ///
+            /// @returns false if there are none.
+            OSVR_COMMON_EXPORT bool pop(DirectReportPacket &packet);
+
+            /// @brief Are there no packets waiting?
+            OSVR_COMMON_EXPORT bool empty() const;
+
+            /// @brief Number of packets that fit before the overflow list
+            /// is used.
+            std::size_t capacity() const { return m_queue.capacity(); }
+
+          private:
+            friend class InProcessReportHub;
+            /// @brief Enqueues a packet - server thread only.
+            ///
+            /// @returns false if it was dropped.
+            bool m_push(DirectReportPacket const &packet);
+
+            util::SPSCQueue<DirectReportPacket> m_queue;
+            /// @brief Set while the overflow list is in use: until it has
+            /// been emptied, everything goes there, to stay in order.
+            std::atomic<bool> m_overflowing;
+            mutable boost::mutex m_overflowMutex;
+            std::deque<DirectReportPacket> m_overflow;
+        };
+        typedef shared_ptr<Queue> QueuePtr;
+
+        /// @brief Gets the hub with the given name, creating it if no server
+        /// or client in this process holds it.
+        OSVR_COMMON_EXPORT static InProcessReportHubPtr
+        get(std::string const &name = std::string());
+
+        /// @brief Claims the hub for a server.
+        ///
+        /// @returns false if another server already holds it.
+        OSVR_COMMON_EXPORT bool attachServer();
+
+        /// @brief Releases the hub claimed with attachServer().
+        OSVR_COMMON_EXPORT void detachServer();
+
+        /// @brief Numbers a device, announcing it to subscribers.
+        OSVR_COMMON_EXPORT uint32_t addDevice(std::string const &name);
+
+        /// @brief Gets the name of a device by number.
+        ///
+        /// @returns false if no such device has been added.
+        OSVR_COMMON_EXPORT bool getDeviceName(uint32_t device,
+                                              std::string &name);
+
+        /// @brief Queues a packet for every subscriber.
+        OSVR_COMMON_EXPORT void publish(DirectReportPacket const &packet);
+
+        /// @brief Creates a queue for a new client.
+        OSVR_COMMON_EXPORT QueuePtr subscribe();
+
+        /// @brief Stops queueing packets for a client.
+        OSVR_COMMON_EXPORT void unsubscribe(QueuePtr const &queue);
+
+        /// @brief Waits for a packet in a client's queue.
+        ///
+        /// @returns false if the queue was still empty after the given
+        /// number of microseconds.
+        OSVR_COMMON_EXPORT bool waitForPackets(Queue const &queue,
+                                               uint64_t microseconds);
+
+        /// @brief Number of tracker and analog packets dropped because a
+        /// subscriber's queue was full.
+        std::size_t getDroppedPackets() const { return m_dropped; }
+
+        /// @brief Constructor - use get() instead.
+        InProcessReportHub();
+
+      private:
+        typedef std::vector<QueuePtr> QueueList;
+        void m_push(Queue &queue, DirectReportPacket const &packet);
+        /// @brief Wakes any clients in waitForPackets().
+        void m_wake();
+
+        /// @brief Protects changes to the device names and subscriber list,
+        /// and the server claim.
+        boost::mutex m_mutex;
+        bool m_hasServer;
+        std::vector<std::string> m_deviceNames;
+        /// @brief Replaced, never modified, so publish() can use a snapshot
+        /// without locking.
+        shared_ptr<const QueueList> m_queues;
+        std::atomic<std::size_t> m_dropped;
+        /// @brief Clients in waitForPackets(), so publishing only takes the
+        /// lock to wake them if there are any.
+        std::atomic<std::size_t> m_waiters;
+        boost::mutex m_waitMutex;
+        boost::condition_variable m_published;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_InProcessReportHub_h_GUID_0A751176_8123_42DC_A78A_320209FA2139
@@ -0,0 +1,169 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseBatchMessage_h_GUID_F7BE22D7_C7B0_4FC1_B833_48F411FAEBDC
+#define INCLUDED_PoseBatchMessage_h_GUID_F7BE22D7_C7B0_4FC1_B833_48F411FAEBDC
+
+// Internal Includes
+#include <osvr/Common/Endianness.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    /// @brief The payload of a VRPN message carrying the poses of a run of
+    /// consecutive sensors of one tracker device, all sampled at the
+    /// message's timestamp.
+    ///
+    /// In network byte order: a sequence number (see ReportSequenceCounter),
+    /// the first sensor, the number of poses, a reserved word, then for each
+    /// pose the translation (x, y, z) and rotation (w, x, y, z) as 64-bit
+    /// floats.
+    class PoseBatchMessage {
+      public:
+        enum {
+            /// @brief Most poses in one message: few enough for a message
+            /// to fit in a single UDP datagram.
+            MAX_POSES = 24
+        };
+
+        /// @brief VRPN message type name.
+        static const char *identifier() { return "com.osvr.tracker.posebatch"; }
+
+        /// @brief Size of a message carrying the given number of poses.
+        static std::size_t size(std::size_t count) {
+            return HEADER_SIZE + count * POSE_SIZE;
+        }
+
+        /// @brief Largest possible size().
+        static std::size_t maxSize() { return size(MAX_POSES); }
+
+        /// @brief Encodes the poses of sensors [first, first + count).
+        ///
+        /// @param buf Destination, with room for at least maxSize() bytes.
+        /// @param count Number of poses, at most MAX_POSES: any more are not
+        /// encoded.
+        ///
+        /// @returns the number of bytes written.
+        static std::size_t encode(char *buf, uint32_t sequence, int32_t first,
+                                  OSVR_PoseState const poses[],
+                                  std::size_t count) {
+            count = std::min(count, std::size_t(MAX_POSES));
+            s_put(buf, sequence);
+            s_put(buf, first);
+            s_put(buf, uint32_t(count));
+            s_put(buf, uint32_t(0));
+            for (std::size_t i = 0; i < count; ++i) {
+                for (auto val : poses[i].translation.data) {
+                    s_put(buf, val);
+                }
+                for (auto val : poses[i].rotation.data) {
+                    s_put(buf, val);
+                }
+            }
+            return size(count);
+        }
+
+        /// @brief Wraps a received message, without copying it: the buffer
+        /// must outlive this object.
+        PoseBatchMessage(char const *buf, std::size_t len)
+            : m_buf(buf), m_sequence(0), m_first(0), m_count(0) {
+            if (len < HEADER_SIZE) {
+                m_buf = nullptr;
+                return;
+            }
+            s_get(buf, m_sequence);
+            s_get(buf, m_first);
+            s_get(buf, m_count);
+            if (m_count > MAX_POSES || len != size(m_count)) {
+                m_buf = nullptr;
+            }
+        }
+
+        /// @brief Did the constructor find a well-formed message?
+        bool isValid() const { return m_buf != nullptr; }
+
+        uint32_t getSequence() const { return m_sequence; }
+        int32_t getFirst() const { return m_first; }
+        std::size_t getCount() const { return m_count; }
+
+        /// @brief Does this message carry a pose for the given sensor?
+        bool hasSensor(int32_t sensor) const {
+            return isValid() && sensor >= m_first &&
+                   uint32_t(sensor - m_first) < m_count;
+        }
+
+        /// @brief Decodes the pose of a sensor - check hasSensor() first.
+        OSVR_PoseState getPose(int32_t sensor) const {
+            char const *buf =
+                m_buf + HEADER_SIZE + (sensor - m_first) * POSE_SIZE;
+            OSVR_PoseState ret;
+            for (auto &val : ret.translation.data) {
+                s_get(buf, val);
+            }
+            for (auto &val : ret.rotation.data) {
+                s_get(buf, val);
+            }
+            return ret;
+        }
+
+      private:
+        enum {
+            HEADER_SIZE = 4 * sizeof(uint32_t),
+            POSE_SIZE = 7 * sizeof(double)
+        };
+
+        /// @brief Writes a value in network byte order, advancing the
+        /// pointer.
+        template <typename T> static void s_put(char *&buf, T val) {
+            val = serialization::hton(val);
+            std::memcpy(buf, &val, sizeof(val));
+            buf += sizeof(val);
+        }
+
+        /// @brief Reads a value in network byte order, advancing the
+        /// pointer.
+        template <typename T> static void s_get(char const *&buf, T &val) {
+            std::memcpy(&val, buf, sizeof(val));
+            val = serialization::ntoh(val);
+            buf += sizeof(val);
+        }
+
+        char const *m_buf;
+        uint32_t m_sequence;
+        int32_t m_first;
+        uint32_t m_count;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PoseBatchMessage_h_GUID_F7BE22D7_C7B0_4FC1_B833_48F411FAEBDC
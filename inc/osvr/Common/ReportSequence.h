@@ -0,0 +1,141 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ReportSequence_h_GUID_48AF2F4C_A07F_41D5_B939_6A54BCDB228F
+#define INCLUDED_ReportSequence_h_GUID_48AF2F4C_A07F_41D5_B939_6A54BCDB228F
+
+// Internal Includes
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief Report sequence numbers are 31 bits, wrapping around, so they
+    /// fit alongside a marker bit in the padding word of a VRPN tracker
+    /// message.
+    inline uint32_t getReportSequenceMask() { return 0x7fffffff; }
+
+    /// @brief Set in the padding word of a VRPN tracker message when it
+    /// holds a sequence number: older servers fill it with the (small,
+    /// non-negative) sensor number instead.
+    inline uint32_t getTrackerSequenceMarker() { return 0x80000000; }
+
+    /// @brief Numbers the reports of one stream (one report type from one
+    /// device) on the server.
+    class ReportSequenceCounter {
+      public:
+        ReportSequenceCounter() : m_next(0) {}
+
+        /// @brief Gets the number for the next report sent.
+        uint32_t next() {
+            const uint32_t ret = m_next;
+            m_next = (m_next + 1) & getReportSequenceMask();
+            return ret;
+        }
+
+      private:
+        uint32_t m_next;
+    };
+
+    /// @brief Checks the sequence numbers of a stream of reports as they
+    /// arrive at a client, counting those lost and those arriving out of
+    /// order.
+    class ReportSequenceChecker {
+      public:
+        enum {
+            /// @brief How far back a sequence number may jump and still be
+            /// taken as a late report, rather than as a server restart.
+            REORDER_WINDOW = 256
+        };
+
+        ReportSequenceChecker()
+            : m_started(false), m_next(0), m_lost(0), m_reordered(0) {}
+
+        /// @brief Checks the sequence number of an arriving report.
+        ///
+        /// @returns false if the report is older than one already accepted,
+        /// so would overwrite newer state and should be discarded.
+        bool check(uint32_t sequence) {
+            sequence &= getReportSequenceMask();
+            if (!m_started) {
+                m_started = true;
+                m_next = s_after(sequence);
+                return true;
+            }
+            const int32_t ahead = s_distance(m_next, sequence);
+            if (ahead >= 0) {
+                m_lost += uint64_t(ahead);
+                m_next = s_after(sequence);
+                return true;
+            }
+            if (ahead < -REORDER_WINDOW) {
+                /// The server started numbering afresh.
+                m_next = s_after(sequence);
+                return true;
+            }
+            /// Counted as lost when a later report arrived first.
+            if (m_lost > 0) {
+                --m_lost;
+            }
+            ++m_reordered;
+            return false;
+        }
+
+        /// @brief Number of reports skipped over, and not (yet) received
+        /// late.
+        uint64_t getLost() const { return m_lost; }
+
+        /// @brief Number of reports discarded for arriving after a newer
+        /// one.
+        uint64_t getReordered() const { return m_reordered; }
+
+        /// @brief Forgets the stream, such as after a reconnection.
+        void reset() { *this = ReportSequenceChecker(); }
+
+      private:
+        static uint32_t s_after(uint32_t sequence) {
+            return (sequence + 1) & getReportSequenceMask();
+        }
+        /// @brief Signed distance from one sequence number to another,
+        /// taking the shorter way around.
+        static int32_t s_distance(uint32_t from, uint32_t to) {
+            const uint32_t mask = getReportSequenceMask();
+            const uint32_t diff = (to - from) & mask;
+            return diff > (mask >> 1) ? -static_cast<int32_t>(mask - diff) - 1
+                                      : static_cast<int32_t>(diff);
+        }
+        bool m_started;
+        uint32_t m_next;
+        uint64_t m_lost;
+        uint64_t m_reordered;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ReportSequence_h_GUID_48AF2F4C_A07F_41D5_B939_6A54BCDB228F
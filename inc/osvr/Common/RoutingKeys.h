@@ -48,6 +48,16 @@ namespace common {
 
         /// @brief the key to access a child transform
         OSVR_COMMON_EXPORT const char *child();
+
+        /// @brief The key in a routing directive to request that the server
+        /// apply the source's transform once for all clients, instead of
+        /// each client applying it.
+        OSVR_COMMON_EXPORT const char *serverTransform();
+
+        /// @brief The key in a routing directive to a TrackerFilter
+        /// description, for the server to smooth the poses once for all
+        /// clients (after applying the transform).
+        OSVR_COMMON_EXPORT const char *serverFilter();
     } // namespace routing_keys
 } // namespace common
 } // namespace osvr
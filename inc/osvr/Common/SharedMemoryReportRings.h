@@ -0,0 +1,191 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SharedMemoryReportRings_h_GUID_080A0712_B9A5_4862_92B2_8763827DCA7D
+#define INCLUDED_SharedMemoryReportRings_h_GUID_080A0712_B9A5_4862_92B2_8763827DCA7D
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/DirectReportPacket.h>
+#include <osvr/Util/UniquePtr.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+// Standard includes
+#include <string>
+#include <atomic>
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief Prefix of client host strings that select a shared memory
+    /// connection: followed by the region name, or by nothing for the
+    /// default.
+    inline const char *getSharedMemoryHostPrefix() { return "shm:"; }
+
+    /// @brief Shared memory region name used when none is given.
+    inline const char *getDefaultSharedMemoryName() {
+        return "osvr_server_reports";
+    }
+
+    class SharedMemoryReportRings;
+    typedef unique_ptr<SharedMemoryReportRings> SharedMemoryReportRingsPtr;
+
+    /// @brief A shared memory region where a server publishes device reports
+    /// (as DirectReportPacket records) for clients on the same machine to
+    /// read without any system call.
+    ///
+    /// Each device gets a ring of its most recent reports. Each slot in a
+    /// ring has its own sequence lock, so the server never waits on clients,
+    /// and a client only retries a read that overlapped a write. Reading a
+    /// tracker report touches a couple of cache lines.
+    ///
+    /// The server marks the region closed when it exits, and otherwise
+    /// beats a heartbeat, so clients can tell a region left behind by a
+    /// server that crashed or hung.
+    ///
+    /// Only one thread may publish at a time, as a Connection already
+    /// ensures for device sends. Each reader must be used from one thread at
+    /// a time.
+    class SharedMemoryReportRings : boost::noncopyable {
+      public:
+        enum {
+            /// @brief Reports kept per device: a client that falls further
+            /// behind loses the oldest.
+            HISTORY = 16,
+            /// @brief Most devices a region can hold.
+            MAX_DEVICES = 128
+        };
+
+        /// @brief Creates the region for a server, replacing any left
+        /// behind by a server that did not exit cleanly.
+        ///
+        /// @throws std::runtime_error if the region could not be created.
+        OSVR_COMMON_EXPORT static SharedMemoryReportRingsPtr
+        create(std::string const &name);
+
+        /// @brief Opens the region for a client.
+        ///
+        /// @returns null if there is no such region, or it has an
+        /// incompatible layout.
+        OSVR_COMMON_EXPORT static SharedMemoryReportRingsPtr
+        open(std::string const &name);
+
+        /// @brief The server's destructor marks the region closed (so
+        /// clients let go of it) and removes it.
+        OSVR_COMMON_EXPORT ~SharedMemoryReportRings();
+
+        /// @name Server methods
+        /// @{
+        /// @brief Adds a ring for a device.
+        ///
+        /// @returns false if the region is full.
+        OSVR_COMMON_EXPORT bool addDevice(std::string const &name,
+                                          uint32_t &device);
+
+        /// @brief Writes a report into its device's ring.
+        OSVR_COMMON_EXPORT void publish(DirectReportPacket const &packet);
+
+        /// @brief Notes that the server is still running: call regularly,
+        /// such as each time through the server loop.
+        OSVR_COMMON_EXPORT void heartbeat();
+        /// @}
+
+        /// @name Client methods
+        /// @{
+        /// @brief Has the server that created the region gone away?
+        OSVR_COMMON_EXPORT bool isClosed() const;
+
+        /// @brief Seconds since the server's last heartbeat(), by the
+        /// machine-wide monotonic clock.
+        OSVR_COMMON_EXPORT double getHeartbeatAge() const;
+
+        OSVR_COMMON_EXPORT uint32_t getNumDevices() const;
+
+        OSVR_COMMON_EXPORT std::string getDeviceName(uint32_t device) const;
+
+        /// @brief Number of reports ever written for a device: the position
+        /// to start reading from to skip those already there.
+        OSVR_COMMON_EXPORT uint64_t getWritten(uint32_t device) const;
+
+        /// @brief Passes each report written for the device since the given
+        /// position to the handler, in order.
+        ///
+        /// @returns The position to read from next time.
+        template <typename F>
+        uint64_t read(uint32_t device, uint64_t from, F &&handler) {
+            const uint64_t written = getWritten(device);
+            if (from > written) {
+                from = written;
+            }
+            if (written - from > HISTORY) {
+                m_lost += written - HISTORY - from;
+                from = written - HISTORY;
+            }
+            for (uint64_t i = from; i < written; ++i) {
+                if (m_readSlot(device, i)) {
+                    handler(m_packet);
+                } else {
+                    ++m_lost;
+                }
+            }
+            return written;
+        }
+
+        /// @brief Number of reports this reader missed because they were
+        /// overwritten before being read.
+        uint64_t getLostReports() const { return m_lost; }
+        /// @}
+
+      private:
+        struct Header;
+        struct DeviceEntry;
+        struct Slot;
+
+        SharedMemoryReportRings(std::string const &name, bool owner);
+        static std::size_t s_slotsOffset();
+        static std::size_t s_regionSize();
+        Header &m_header() const;
+        DeviceEntry &m_device(uint32_t device) const;
+        Slot &m_slot(uint32_t device, uint64_t index) const;
+        /// @brief Copies a report into m_packet.
+        ///
+        /// @returns false if it has been overwritten or is unreadable.
+        OSVR_COMMON_EXPORT bool m_readSlot(uint32_t device, uint64_t index);
+
+        std::string const m_name;
+        bool const m_owner;
+        boost::interprocess::shared_memory_object m_shm;
+        boost::interprocess::mapped_region m_region;
+        DirectReportPacket m_packet;
+        uint64_t m_lost;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_SharedMemoryReportRings_h_GUID_080A0712_B9A5_4862_92B2_8763827DCA7D
@@ -0,0 +1,70 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SourceSubscription_h_GUID_6867C193_B685_4150_8992_1FE03201F00E
+#define INCLUDED_SourceSubscription_h_GUID_6867C193_B685_4150_8992_1FE03201F00E
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief A device (and optionally a single sensor or channel of it) on
+    /// the server whose data a client is using.
+    struct SourceSubscription {
+        /// @brief Indicates that all sensors of the device are used.
+        enum { ALL_SENSORS = -1 };
+
+        SourceSubscription() : sensor(ALL_SENSORS) {}
+        SourceSubscription(std::string const &dev, int sens = ALL_SENSORS)
+            : device(dev), sensor(sens) {}
+
+        /// @brief Device name, without any host.
+        std::string device;
+        /// @brief Sensor or channel number, or ALL_SENSORS.
+        int sensor;
+    };
+
+    typedef std::vector<SourceSubscription> SourceSubscriptionList;
+
+    inline bool operator==(SourceSubscription const &lhs,
+                           SourceSubscription const &rhs) {
+        return lhs.device == rhs.device && lhs.sensor == rhs.sensor;
+    }
+
+    inline bool operator!=(SourceSubscription const &lhs,
+                           SourceSubscription const &rhs) {
+        return !(lhs == rhs);
+    }
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_SourceSubscription_h_GUID_6867C193_B685_4150_8992_1FE03201F00E
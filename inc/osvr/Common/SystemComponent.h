@@ -30,12 +30,16 @@
 #include <osvr/Common/Export.h>
 #include <osvr/Common/DeviceComponent.h>
 #include <osvr/Common/SerializationTags.h>
+#include <osvr/Common/ClockSync.h>
+#include <osvr/Common/SourceSubscription.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
-// - none
+#include <functional>
+#include <vector>
+#include <string>
 
 namespace osvr {
 namespace common {
@@ -61,6 +65,27 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class ClockPingToServer
+            : public MessageRegistration<ClockPingToServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class ClockPongFromServer
+            : public MessageRegistration<ClockPongFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class ClientSubscriptionsToServer
+            : public MessageRegistration<ClientSubscriptionsToServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -94,9 +119,74 @@ namespace common {
         registerClientRouteUpdateHandler(vrpn_MESSAGEHANDLER handler,
                                          void *userdata);
 
+        /// @brief Message from client to server, carrying a client-chosen
+        /// nonce and the client clock at send time, for clock offset
+        /// estimation.
+        messages::ClockPingToServer clockPing;
+
+        /// @brief Message from server to client, answering a clock ping.
+        ///
+        /// Pongs go to every client on the connection, so clients must match
+        /// the echoed nonce against their own outstanding pings (see
+        /// ClockOffsetEstimator::addResponse()).
+        messages::ClockPongFromServer clockPong;
+
+        /// @brief Sends a clock ping.
+        ///
+        /// @param nonce Value the server echoes back in its pong, as returned
+        /// by ClockOffsetEstimator::startExchange().
+        /// @param clientSent Current client (steady clock) time.
+        OSVR_COMMON_EXPORT void
+        sendClockPing(uint32_t nonce, util::time::TimeValue const &clientSent);
+
+        /// @brief Server side: answer each incoming clock ping with a pong.
+        OSVR_COMMON_EXPORT void respondToClockPings();
+
+        /// @brief Handler for clock pongs: receives the exchange timestamps
+        /// and the client time the pong arrived.
+        typedef std::function<void(ClockSyncTimestamps const &,
+                                   util::time::TimeValue const &)>
+            ClockPongHandler;
+        OSVR_COMMON_EXPORT void registerClockPongHandler(ClockPongHandler cb);
+
+        /// @brief Message from client to server, replacing the list of
+        /// sources that client is using.
+        messages::ClientSubscriptionsToServer subscriptionsIn;
+
+        /// @brief Sends the full list of sources a client is using. Clients
+        /// re-send it periodically: the server forgets clients it has not
+        /// heard from in a while.
+        ///
+        /// @param clientId Identifier unique to the sending client context.
+        /// @param connectionId Identifier unique to the connection the client
+        /// context uses, which other client contexts may share.
+        OSVR_COMMON_EXPORT void
+        sendClientSubscriptions(std::string const &clientId,
+                                std::string const &connectionId,
+                                SourceSubscriptionList const &sources);
+
+        /// @brief Handler for client subscriptions: receives the client ID,
+        /// connection ID (the client ID again, from clients that don't send
+        /// one), and its complete source list.
+        typedef std::function<void(std::string const &, std::string const &,
+                                   SourceSubscriptionList const &)>
+            ClientSubscriptionsHandler;
+        OSVR_COMMON_EXPORT void
+        registerClientSubscriptionsHandler(ClientSubscriptionsHandler cb);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
+
+        static int VRPN_CALLBACK
+        m_handleClockPing(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleClockPong(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleClientSubscriptions(void *userdata, vrpn_HANDLERPARAM p);
+
+        std::vector<ClockPongHandler> m_clockPongCb;
+        std::vector<ClientSubscriptionsHandler> m_subscriptionsCb;
     };
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,131 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerFilter_h_GUID_A0C11910_E3B1_4D1F_906C_2022E0A23B26
+#define INCLUDED_TrackerFilter_h_GUID_A0C11910_E3B1_4D1F_906C_2022E0A23B26
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <json/value.h>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <vector>
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief Smooths the poses reported by the sensors of one tracker.
+    ///
+    /// State is kept for each sensor, as a column of a matrix, so that the
+    /// poses of a run of sensors (such as a PoseBatchMessage) are filtered
+    /// together, each step applied to all of them at once.
+    ///
+    /// Filters are described in JSON by a "type" and its parameters:
+    ///
+    /// - "exponential": `alpha` (default 0.5), or `positionAlpha` and
+    /// `orientationAlpha` separately: the weight given each new sample.
+    /// - "oneEuro": `position` and `orientation` objects, each with
+    /// `minCutoff` (Hz, default 1), `beta` (default 0), and
+    /// `derivativeCutoff` (Hz, default 1): the "1 Euro" filter of Casiez et
+    /// al., on each pose's position and orientation as vectors.
+    /// - "kalmanOrientation": `processNoise` (per second, default 1) and
+    /// `measurementNoise` (default 0.01): a Kalman filter with a scalar
+    /// variance per sensor, for orientation only.
+    ///
+    /// Orientations are blended as (normalized) quaternions, which is close
+    /// to spherical interpolation for the small steps between samples.
+    class TrackerFilter : boost::noncopyable {
+      public:
+        /// @brief Creates a filter from its JSON description.
+        ///
+        /// @throws std::runtime_error for an unknown type.
+        OSVR_COMMON_EXPORT static unique_ptr<TrackerFilter>
+        create(Json::Value const &config);
+
+        OSVR_COMMON_EXPORT virtual ~TrackerFilter();
+
+        /// @brief Filters, in place, the poses of sensors [first, first +
+        /// count), all sampled at the given time.
+        OSVR_COMMON_EXPORT void filter(util::time::TimeValue const &timestamp,
+                                       OSVR_ChannelCount first,
+                                       OSVR_PoseState poses[],
+                                       OSVR_ChannelCount count);
+
+        /// @brief Forgets all sensors, such as when the source changes.
+        OSVR_COMMON_EXPORT void reset();
+
+      protected:
+        /// @brief Poses as columns: translation then rotation (w, x, y, z),
+        /// the layout of OSVR_PoseState.
+        typedef Eigen::Matrix<double, 7, Eigen::Dynamic> PoseMatrix;
+        typedef Eigen::Map<PoseMatrix> PoseMap;
+        /// @brief A value for each sensor of a run.
+        typedef Eigen::Array<double, 1, Eigen::Dynamic> SensorArray;
+
+        TrackerFilter();
+
+        /// @brief Filters the poses of sensors [first, first + poses.cols()).
+        ///
+        /// @param poses The samples, to filter in place. Orientations have
+        /// been flipped as needed to be on the same hemisphere as those
+        /// from m_previous(), so can be blended componentwise, and are
+        /// normalized again afterwards.
+        /// @param dt Seconds since the previous sample of each sensor,
+        /// indexed by sensor like m_previous(): only the run being filtered
+        /// is current.
+        virtual void m_filter(std::size_t first, PoseMap &poses,
+                              SensorArray const &dt) = 0;
+
+        /// @brief Makes room for state for the given number of sensors.
+        ///
+        /// Filters should size any scratch space they need here, indexed by
+        /// sensor, so that filtering a report never allocates.
+        virtual void m_resize(std::size_t sensors) = 0;
+
+        /// @brief Resets any state of a sensor other than its previous pose.
+        virtual void m_resetSensor(std::size_t sensor) = 0;
+
+        /// @brief The last filtered pose of each sensor.
+        PoseMatrix const &m_previous() const { return m_prev; }
+
+      private:
+        PoseMatrix m_prev;
+        std::vector<util::time::TimeValue> m_times;
+        std::vector<bool> m_valid;
+        SensorArray m_dt;
+        /// @brief Scratch space for a value per sensor.
+        SensorArray m_scratch;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerFilter_h_GUID_A0C11910_E3B1_4D1F_906C_2022E0A23B26
@@ -0,0 +1,76 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackerStateMessage_h_GUID_F3A192E9_E881_4744_9C07_829E80606C7C
+#define INCLUDED_TrackerStateMessage_h_GUID_F3A192E9_E881_4744_9C07_829E80606C7C
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Util/TrackerStateC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief The payload of a VRPN message carrying an OSVR_TrackerState
+    /// for one sensor, in place of a VRPN tracker message.
+    ///
+    /// Holds a sequence number (see ReportSequenceCounter), the sensor, and
+    /// the flags, followed by only the parts of the state the flags mark
+    /// valid: 64-bit floats, or 32-bit floats with
+    /// OSVR_TRACKER_SINGLE_PRECISION.
+    class TrackerStateMessage {
+      public:
+        /// @brief VRPN message type name.
+        static const char *identifier() { return "com.osvr.tracker.state"; }
+
+        /// @brief Replaces the contents of a buffer with a message.
+        OSVR_COMMON_EXPORT static void encode(Buffer<> &buf,
+                                              uint32_t sequence,
+                                              int32_t sensor,
+                                              OSVR_TrackerState const &state);
+
+        /// @brief Decodes a message: parts of the state not flagged valid
+        /// are zeroed, or identity for the rotation.
+        ///
+        /// @returns false if the bytes do not hold a well-formed message.
+        OSVR_COMMON_EXPORT static bool decode(char const *buf,
+                                              std::size_t len,
+                                              uint32_t &sequence,
+                                              int32_t &sensor,
+                                              OSVR_TrackerState &state);
+
+      private:
+        class MessageSerialization;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerStateMessage_h_GUID_F3A192E9_E881_4744_9C07_829E80606C7C
@@ -0,0 +1,56 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_UnixSocketPath_h_GUID_0DB09BAF_BFF9_4B57_8F4E_1C0A681C59E0
+#define INCLUDED_UnixSocketPath_h_GUID_0DB09BAF_BFF9_4B57_8F4E_1C0A681C59E0
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+#if !defined(_WIN32)
+/// @brief Defined where servers and clients can use Unix domain sockets.
+#define OSVR_HAVE_UNIX_SOCKETS
+#endif
+
+namespace osvr {
+namespace common {
+    /// @brief Prefix of client host strings that select a Unix domain socket
+    /// connection: followed by the socket path, or by nothing for the
+    /// default.
+    inline const char *getUnixSocketHostPrefix() { return "unix:"; }
+
+    /// @brief Socket path used when none is given.
+    inline const char *getDefaultUnixSocketPath() {
+        return "/tmp/osvr_server.sock";
+    }
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_UnixSocketPath_h_GUID_0DB09BAF_BFF9_4B57_8F4E_1C0A681C59E0
@@ -31,6 +31,8 @@
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/SubscriptionFilter.h>
+#include <osvr/Connection/ReportSuppression.h>
 #include <osvr/Util/DeviceCallbackTypesC.h>
 #include <osvr/PluginHost/RegistrationContext_fwd.h>
 
@@ -67,6 +69,29 @@ namespace connection {
         OSVR_CONNECTION_EXPORT static ConnectionPtr
         createSharedConnection(boost::optional<std::string const &> iface,
                                boost::optional<int> port);
+        /// @brief Factory method to create a local-machine-only connection
+        /// that sends device reports to clients over a Unix domain socket.
+        /// @param path Filesystem path of the socket, unset/default means
+        /// common::getDefaultUnixSocketPath()
+        /// @throws std::runtime_error if Unix domain sockets are not
+        /// available on this platform, or the socket could not be created.
+        OSVR_CONNECTION_EXPORT static ConnectionPtr
+        createUnixSocketConnection(boost::optional<std::string const &> path);
+        /// @brief Factory method to create a local-machine-only connection
+        /// that hands device reports to client contexts in the same process.
+        /// @param name Name clients pass (as `inproc:name`) to find this
+        /// connection, unset/default means the empty name.
+        /// @throws std::runtime_error if another in-process connection with
+        /// the same name exists.
+        OSVR_CONNECTION_EXPORT static ConnectionPtr
+        createInProcessConnection(boost::optional<std::string const &> name);
+        /// @brief Factory method to create a local-machine-only connection
+        /// that publishes device reports to clients through shared memory.
+        /// @param name Name of the shared memory region, unset/default means
+        /// common::getDefaultSharedMemoryName()
+        /// @throws std::runtime_error if the region could not be created.
+        OSVR_CONNECTION_EXPORT static ConnectionPtr
+        createSharedMemoryConnection(boost::optional<std::string const &> name);
         /// @}
 
         /// @name Context Storage
@@ -111,6 +136,14 @@ namespace connection {
         OSVR_CONNECTION_EXPORT void
         registerConnectionHandler(std::function<void()> handler);
 
+        /// @brief Access the record of which devices, sensors, and channels
+        /// clients are using, consulted before packing device data.
+        OSVR_CONNECTION_EXPORT SubscriptionFilter &getSubscriptionFilter();
+
+        /// @brief Access the settings and counters for skipping analog and
+        /// tracker reports that change nothing.
+        OSVR_CONNECTION_EXPORT ReportSuppression &getReportSuppression();
+
         /// @brief Destructor
         OSVR_CONNECTION_EXPORT virtual ~Connection();
 
@@ -183,6 +216,8 @@ namespace connection {
       private:
         typedef std::vector<ConnectionDevicePtr> DeviceList;
         DeviceList m_devices;
+        SubscriptionFilter m_subscriptions;
+        ReportSuppression m_reportSuppression;
     };
 } // namespace connection
 } // namespace osvr
@@ -30,6 +30,7 @@
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Connection/MessageTypePtr.h>
 #include <osvr/Connection/DeviceTokenPtr.h>
+#include <osvr/Connection/SubscriptionFilter.h>
 #include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
@@ -62,12 +63,17 @@ namespace connection {
         void process();
 
         /// @brief Send message (as primary device name)
+        ///
+        /// Dropped if no client is using this device.
         void sendData(util::time::TimeValue const &timestamp, MessageType *type,
                       const char *bytestream, size_t len);
 
         /// @brief For use only by DeviceToken
         void setDeviceToken(DeviceToken &token);
 
+        /// @brief For use only by Connection
+        void setSubscription(DeviceSubscriptionPtr const &subscription);
+
       protected:
         /// @brief Does this connection device have a device token? Should be
         /// true in nearly every case.
@@ -92,6 +98,7 @@ namespace connection {
       private:
         NameList m_names;
         DeviceToken *m_token;
+        DeviceSubscriptionPtr m_subscription;
     };
 } // namespace connection
 } // namespace osvr
@@ -35,6 +35,7 @@
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/ServerInterfaceList.h>
 #include <osvr/Common/DeviceComponentPtr.h>
+#include <osvr/Common/AnalogFrameMessage.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -66,6 +67,14 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     setAnalogs(OSVR_ChannelCount num,
                osvr::connection::AnalogServerInterface **iface);
 
+    /// @brief Requests that analog values be sent as AnalogFrameMessage
+    /// messages in the given encoding.
+    ///
+    /// @param scale Value of one step, for the INT16 encoding.
+    OSVR_CONNECTION_EXPORT void
+    setAnalogEncoding(osvr::common::AnalogFrameMessage::Encoding encoding,
+                      double scale);
+
     /// @brief Returns an analog interface through the pointer-pointer.
     void returnAnalogInterface(osvr::connection::AnalogServerInterface &iface);
 
@@ -106,6 +115,11 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     getContext();
 
     boost::optional<OSVR_ChannelCount> getAnalogs() const { return m_analogs; }
+    boost::optional<osvr::common::AnalogFrameMessage::Encoding>
+    getAnalogEncoding() const {
+        return m_analogEncoding;
+    }
+    double getAnalogScale() const { return m_analogScale; }
     boost::optional<OSVR_ChannelCount> getButtons() const { return m_buttons; }
     bool getTracker() const { return m_tracker; }
     osvr::connection::ServerInterfaceList const &getServerInterfaces() const {
@@ -123,6 +137,9 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     std::string m_qualifiedName;
     boost::optional<OSVR_ChannelCount> m_analogs;
     osvr::connection::AnalogServerInterface **m_analogIface;
+    boost::optional<osvr::common::AnalogFrameMessage::Encoding>
+        m_analogEncoding;
+    double m_analogScale;
     boost::optional<OSVR_ChannelCount> m_buttons;
     osvr::connection::ButtonServerInterface **m_buttonIface;
     bool m_tracker;
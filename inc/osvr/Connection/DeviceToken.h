@@ -72,6 +72,12 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     OSVR_CONNECTION_EXPORT static osvr::connection::DeviceTokenPtr
     createVirtualDevice(std::string const &name,
                         osvr::connection::ConnectionPtr const &conn);
+    /// @overload
+    ///
+    /// For virtual devices with standard interfaces (tracker, etc.) set up
+    /// in the init object.
+    OSVR_CONNECTION_EXPORT static osvr::connection::DeviceTokenPtr
+    createVirtualDevice(osvr::connection::DeviceInitObject &init);
     /// @}
 
     /// @brief Destructor
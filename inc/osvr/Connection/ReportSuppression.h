@@ -0,0 +1,510 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ReportSuppression_h_GUID_6E232E0B_5926_432F_A1B8_E8680D7AE4BD
+#define INCLUDED_ReportSuppression_h_GUID_6E232E0B_5926_432F_A1B8_E8680D7AE4BD
+
+// Internal Includes
+#include <osvr/Connection/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <utility>
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace osvr {
+namespace connection {
+    /// @brief Settings for skipping analog and tracker reports that don't
+    /// change a device's data enough to matter.
+    struct ReportSuppressionSettings {
+        ReportSuppressionSettings()
+            : enabled(false), epsilon(0), maxInterval(0), maxRate(0) {}
+        /// @brief Skip reports that change nothing? Otherwise, every tracker
+        /// report is sent, and every analog change, whatever its size.
+        bool enabled;
+        /// @brief Largest change in any value (an analog channel, or a
+        /// component of a position or orientation) still treated as no
+        /// change: 0 to skip only exact repeats.
+        double epsilon;
+        /// @brief Seconds after which a report is sent even if it changes
+        /// nothing, as a keep-alive: 0 for no limit.
+        double maxInterval;
+        /// @brief Most reports sent per second for each sensor of a tracker,
+        /// or for an analog device as a whole: 0 for no limit. Reports that
+        /// come faster are held back, keeping only the newest, whether or
+        /// not suppression is enabled. See ReportRateBudget for a limit on
+        /// all the devices of a connection together.
+        double maxRate;
+    };
+
+    /// @brief A number of analog and tracker reports per second shared by
+    /// every device on a connection, so that many devices together can't
+    /// flood it even if each keeps to its own maximum rate.
+    ///
+    /// Each report sent spends from the budget, which refills at the
+    /// maximum rate and saves up at most a tenth of a second's worth.
+    /// Reports over budget are held back like those over a device's own
+    /// maximum rate.
+    class ReportRateBudget : boost::noncopyable {
+      public:
+        ReportRateBudget()
+            : m_maxRate(0), m_available(0), m_hasRefilled(false) {}
+
+        /// @brief Sets the most reports sent per second: 0 for no limit.
+        void setMaxRate(double maxRate) {
+            m_maxRate = maxRate;
+            m_hasRefilled = false;
+        }
+
+        double getMaxRate() const { return m_maxRate; }
+
+        /// @brief Is there a limit at all?
+        bool isLimited() const { return m_maxRate > 0; }
+
+        /// @brief Is there enough budget left to send a report now, by the
+        /// monotonic clock?
+        bool isAvailable(util::time::TimeValue const &now) {
+            if (!isLimited()) {
+                return true;
+            }
+            m_refill(now);
+            return m_available >= 1;
+        }
+
+        /// @brief Spends the budget for a report sent.
+        void spend() {
+            if (isLimited()) {
+                m_available -= 1;
+            }
+        }
+
+      private:
+        void m_refill(util::time::TimeValue const &now) {
+            const double most = std::max(1.0, m_maxRate / 10);
+            if (m_hasRefilled) {
+                m_available =
+                    std::min(most, m_available +
+                                       util::time::duration(now, m_refilled) *
+                                           m_maxRate);
+            } else {
+                m_available = most;
+            }
+            m_hasRefilled = true;
+            m_refilled = now;
+        }
+        double m_maxRate;
+        double m_available;
+        bool m_hasRefilled;
+        util::time::TimeValue m_refilled;
+    };
+    typedef shared_ptr<ReportRateBudget> ReportRateBudgetPtr;
+
+    /// @brief The report suppression settings and counters for a single
+    /// device. Kept up to date by the ReportSuppression it came from.
+    class DeviceReportSuppression : boost::noncopyable {
+      public:
+        DeviceReportSuppression()
+            : m_sent(0), m_suppressed(0), m_conflated(0) {}
+
+        ReportSuppressionSettings const &getSettings() const {
+            return m_settings;
+        }
+
+        /// @brief Is the change between two analog values too small to
+        /// report? Without suppression, only equal values are.
+        bool isUnchanged(double a, double b) const {
+            return m_settings.enabled ? std::abs(a - b) <= m_settings.epsilon
+                                      : a == b;
+        }
+
+        /// @brief Is the change between two analog values one that only
+        /// suppression keeps from being reported: real, but no larger than
+        /// epsilon?
+        bool isSuppressed(double a, double b) const {
+            return m_settings.enabled && a != b &&
+                   std::abs(a - b) <= m_settings.epsilon;
+        }
+
+        /// @brief Is the change between two poses too small to report?
+        /// Never, without suppression.
+        OSVR_CONNECTION_EXPORT bool isUnchanged(OSVR_PoseState const &a,
+                                                OSVR_PoseState const &b) const;
+
+        /// @brief Should a report be sent even if it changes nothing, given
+        /// when the last one was?
+        bool isKeepAliveDue(util::time::TimeValue const &lastSent,
+                            util::time::TimeValue const &now) const {
+            return m_settings.enabled && m_settings.maxInterval > 0 &&
+                   util::time::duration(now, lastSent) >=
+                       m_settings.maxInterval;
+        }
+
+        /// @brief Must a report be held back, given when the last one for
+        /// the same sensor was sent? Both times are by the monotonic clock.
+        bool isRateLimited(util::time::TimeValue const &lastSent,
+                           util::time::TimeValue const &now) const {
+            return m_settings.maxRate > 0 &&
+                   util::time::duration(now, lastSent) * m_settings.maxRate <
+                       1;
+        }
+
+        /// @brief Is there a limit on the reports of the connection as a
+        /// whole?
+        bool hasConnectionLimit() const {
+            return m_connectionBudget && m_connectionBudget->isLimited();
+        }
+
+        /// @brief Does the limit on the connection as a whole allow sending
+        /// a report now? Both times are by the monotonic clock.
+        bool isConnectionBudgetAvailable(util::time::TimeValue const &now) {
+            return !m_connectionBudget || m_connectionBudget->isAvailable(now);
+        }
+
+        /// @brief Spends the connection's budget for a report sent.
+        void spendConnectionBudget() {
+            if (m_connectionBudget) {
+                m_connectionBudget->spend();
+            }
+        }
+
+        /// @brief Counts a report sent.
+        void countSent() { ++m_sent; }
+
+        /// @brief Counts a report skipped for changing nothing: only those
+        /// that suppression skipped, not those no client wants or that repeat
+        /// the last values exactly.
+        void countSuppressed() { ++m_suppressed; }
+
+        /// @brief Counts a report held back by the rate limit and replaced
+        /// by a newer one before it could be sent.
+        void countConflated() { ++m_conflated; }
+
+        uint64_t getSentCount() const { return m_sent; }
+        uint64_t getSuppressedCount() const { return m_suppressed; }
+        uint64_t getConflatedCount() const { return m_conflated; }
+
+      private:
+        friend class ReportSuppression;
+        ReportSuppressionSettings m_settings;
+        ReportRateBudgetPtr m_connectionBudget;
+        uint64_t m_sent;
+        uint64_t m_suppressed;
+        uint64_t m_conflated;
+    };
+    typedef shared_ptr<DeviceReportSuppression> DeviceReportSuppressionPtr;
+
+    /// @brief Decides which reports of each sensor of a device come faster
+    /// than its maximum rate, or than the budget of its connection allows,
+    /// and must be held back until they may be sent,
+    /// without keeping the reports themselves: for devices that keep their
+    /// newest data anyway, like analog servers. See ReportConflator to keep
+    /// the reports too.
+    ///
+    /// Reports are counted only when they are replaced: whatever is sent
+    /// goes on to be counted as usual.
+    ///
+    /// Times of sending are by the monotonic clock: read for each call, or
+    /// passed in as `now`.
+    class ReportRateLimiter {
+      public:
+        explicit ReportRateLimiter(DeviceReportSuppressionPtr const &device)
+            : m_device(device), m_numHeld(0) {}
+
+        /// @brief Checks whether a report may be sent now, recording it as
+        /// sent if so, or else as held back, replacing any held already.
+        ///
+        /// @returns true if the report should be held back.
+        bool hold(OSVR_ChannelCount sensor,
+                  util::time::TimeValue const &timestamp) {
+            if (!m_mayHold()) {
+                return false;
+            }
+            util::time::TimeValue now;
+            util::time::getMonotonicNow(now);
+            return hold(sensor, timestamp, now);
+        }
+
+        /// @overload
+        bool hold(OSVR_ChannelCount sensor,
+                  util::time::TimeValue const &timestamp,
+                  util::time::TimeValue const &now) {
+            if (!m_mayHold()) {
+                return false;
+            }
+            if (sensor >= m_entries.size()) {
+                m_entries.resize(sensor + 1);
+            }
+            Entry &entry = m_entries[sensor];
+            const bool limited =
+                !m_device->isConnectionBudgetAvailable(now) ||
+                (entry.hasSent && m_device->isRateLimited(entry.sent, now));
+            if (entry.held) {
+                m_device->countConflated();
+            }
+            if (!limited) {
+                m_release(entry);
+                m_recordSent(entry, now);
+                return false;
+            }
+            if (!entry.held) {
+                entry.held = true;
+                ++m_numHeld;
+            }
+            entry.timestamp = timestamp;
+            return true;
+        }
+
+        /// @brief Are any reports held back?
+        bool isHolding() const { return m_numHeld != 0; }
+
+        /// @brief Releases each report held back whose time has come, by
+        /// calling `f(sensor, timestamp)`.
+        template <typename F> void flush(F &&f) {
+            if (m_numHeld == 0) {
+                return;
+            }
+            util::time::TimeValue now;
+            util::time::getMonotonicNow(now);
+            flush(std::forward<F>(f), now);
+        }
+
+        /// @overload
+        template <typename F>
+        void flush(F &&f, util::time::TimeValue const &now) {
+            if (m_numHeld == 0) {
+                return;
+            }
+            for (std::size_t i = 0, e = m_entries.size(); i < e; ++i) {
+                Entry &entry = m_entries[i];
+                if (!entry.held || (entry.hasSent &&
+                                    m_device->isRateLimited(entry.sent, now))) {
+                    continue;
+                }
+                if (!m_device->isConnectionBudgetAvailable(now)) {
+                    /// Nothing else may be sent either.
+                    return;
+                }
+                m_release(entry);
+                m_recordSent(entry, now);
+                f(OSVR_ChannelCount(i), entry.timestamp);
+            }
+        }
+
+      private:
+        struct Entry {
+            Entry() : held(false), hasSent(false) {}
+            bool held;
+            bool hasSent;
+            /// @brief Monotonic clock time of the last report sent.
+            util::time::TimeValue sent;
+            /// @brief Timestamp of the report held.
+            util::time::TimeValue timestamp;
+        };
+        /// @brief Could a report be held? Not without a maximum rate, once
+        /// everything held before it was set has been released.
+        bool m_mayHold() const {
+            return m_device->getSettings().maxRate > 0 ||
+                   m_device->hasConnectionLimit() || m_numHeld != 0;
+        }
+        void m_recordSent(Entry &entry, util::time::TimeValue const &now) {
+            entry.hasSent = true;
+            entry.sent = now;
+            m_device->spendConnectionBudget();
+        }
+        void m_release(Entry &entry) {
+            if (entry.held) {
+                entry.held = false;
+                --m_numHeld;
+            }
+        }
+        DeviceReportSuppressionPtr m_device;
+        std::vector<Entry> m_entries;
+        std::size_t m_numHeld;
+    };
+
+    /// @brief Holds back the reports of each sensor of a device that come
+    /// faster than its maximum rate, keeping only the newest until it may be
+    /// sent: see ReportRateLimiter.
+    ///
+    /// @tparam Report Type of the reports held.
+    template <typename Report> class ReportConflator {
+      public:
+        explicit ReportConflator(DeviceReportSuppressionPtr const &device)
+            : m_limiter(device) {}
+
+        /// @brief Checks whether a report may be sent now, recording it as
+        /// sent if so.
+        ///
+        /// @returns null if the report should be sent now, or else where to
+        /// store it to be held back, replacing any held already.
+        Report *hold(OSVR_ChannelCount sensor,
+                     util::time::TimeValue const &timestamp) {
+            return m_limiter.hold(sensor, timestamp) ? m_slot(sensor)
+                                                     : nullptr;
+        }
+
+        /// @overload
+        Report *hold(OSVR_ChannelCount sensor,
+                     util::time::TimeValue const &timestamp,
+                     util::time::TimeValue const &now) {
+            return m_limiter.hold(sensor, timestamp, now) ? m_slot(sensor)
+                                                          : nullptr;
+        }
+
+        /// @brief Are any reports held back?
+        bool isHolding() const { return m_limiter.isHolding(); }
+
+        /// @brief Sends each report held back whose time has come, by
+        /// calling `f(sensor, report, timestamp)`.
+        template <typename F> void flush(F &&f) {
+            if (!isHolding()) {
+                return;
+            }
+            util::time::TimeValue now;
+            util::time::getMonotonicNow(now);
+            flush(std::forward<F>(f), now);
+        }
+
+        /// @overload
+        template <typename F>
+        void flush(F &&f, util::time::TimeValue const &now) {
+            m_limiter.flush([&](OSVR_ChannelCount sensor,
+                                util::time::TimeValue const &timestamp) {
+                f(sensor, m_reports[sensor], timestamp);
+            }, now);
+        }
+
+      private:
+        Report *m_slot(OSVR_ChannelCount sensor) {
+            if (sensor >= m_reports.size()) {
+                m_reports.resize(sensor + 1);
+            }
+            return &m_reports[sensor];
+        }
+        ReportRateLimiter m_limiter;
+        std::vector<Report> m_reports;
+    };
+
+    /// @brief Remembers the last pose sent for each sensor of a tracker, to
+    /// decide which poses to suppress.
+    class PoseSuppressor {
+      public:
+        explicit PoseSuppressor(DeviceReportSuppressionPtr const &device)
+            : m_device(device) {}
+
+        /// @brief Should the pose of a sensor be sent? If so, it is recorded
+        /// as the last one sent. Either way, it is counted.
+        OSVR_CONNECTION_EXPORT bool
+        shouldSend(OSVR_ChannelCount sensor, OSVR_PoseState const &pose,
+                   util::time::TimeValue const &timestamp);
+
+        /// @brief Should the poses of sensors [first, first + count), sent
+        /// together, be sent? Only if any of them would be on its own: if
+        /// so, all are recorded as sent.
+        OSVR_CONNECTION_EXPORT bool
+        shouldSend(OSVR_ChannelCount first, OSVR_PoseState const poses[],
+                   OSVR_ChannelCount count,
+                   util::time::TimeValue const &timestamp);
+
+      private:
+        struct Entry {
+            Entry() : valid(false) {}
+            bool valid;
+            OSVR_PoseState pose;
+            util::time::TimeValue sent;
+        };
+        bool m_isUnchanged(OSVR_ChannelCount sensor,
+                           OSVR_PoseState const &pose,
+                           util::time::TimeValue const &timestamp) const;
+        void m_record(OSVR_ChannelCount sensor, OSVR_PoseState const &pose,
+                      util::time::TimeValue const &timestamp);
+        DeviceReportSuppressionPtr m_device;
+        std::vector<Entry> m_entries;
+    };
+
+    /// @brief Holds the report suppression settings and counters of each
+    /// device on a connection, and the budget they share.
+    ///
+    /// Devices get the defaults in effect when they are first looked up, so
+    /// setting the defaults just before creating devices configures just
+    /// those devices.
+    class ReportSuppression : boost::noncopyable {
+      public:
+        ReportSuppression() : m_budget(make_shared<ReportRateBudget>()) {}
+
+        /// @brief Sets the settings given to devices first seen from now on.
+        void setDefaults(ReportSuppressionSettings const &settings) {
+            m_defaults = settings;
+        }
+
+        ReportSuppressionSettings const &getDefaults() const {
+            return m_defaults;
+        }
+
+        /// @brief Sets the most analog and tracker reports sent per second
+        /// by all devices together, whenever they were created: 0 for no
+        /// limit.
+        void setMaxConnectionRate(double maxRate) {
+            m_budget->setMaxRate(maxRate);
+        }
+
+        double getMaxConnectionRate() const { return m_budget->getMaxRate(); }
+
+        /// @brief Gets the (live-updated) settings and counters for a
+        /// device, creating them from the defaults if required.
+        OSVR_CONNECTION_EXPORT DeviceReportSuppressionPtr
+        getDevice(std::string const &device);
+
+        /// @brief Changes the settings of a device.
+        OSVR_CONNECTION_EXPORT void
+        setDevice(std::string const &device,
+                  ReportSuppressionSettings const &settings);
+
+        typedef std::map<std::string, DeviceReportSuppressionPtr> DeviceMap;
+
+        /// @brief Access every device seen so far, such as for their
+        /// counters.
+        DeviceMap const &getDevices() const { return m_devices; }
+
+      private:
+        ReportSuppressionSettings m_defaults;
+        ReportRateBudgetPtr m_budget;
+        DeviceMap m_devices;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_ReportSuppression_h_GUID_6E232E0B_5926_432F_A1B8_E8680D7AE4BD
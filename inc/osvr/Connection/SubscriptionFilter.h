@@ -0,0 +1,200 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SubscriptionFilter_h_GUID_7809142B_EFCE_43D5_AE2C_4A8267A39C9D
+#define INCLUDED_SubscriptionFilter_h_GUID_7809142B_EFCE_43D5_AE2C_4A8267A39C9D
+
+// Internal Includes
+#include <osvr/Connection/Export.h>
+#include <osvr/Common/SourceSubscription.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <map>
+#include <cstddef>
+
+namespace osvr {
+namespace connection {
+    /// @brief Which parts of a single device's data are in use by at least one
+    /// client. Kept up to date by the SubscriptionFilter it came from.
+    class DeviceSubscription : boost::noncopyable {
+      public:
+        DeviceSubscription() : m_all(true), m_any(true) {}
+
+        /// @brief Is any data from this device in use?
+        bool wantsAny() const { return m_any; }
+
+        /// @brief Is the given sensor or channel of this device in use?
+        bool wants(int sensor) const {
+            return m_all || (sensor >= 0 &&
+                             static_cast<std::size_t>(sensor) <
+                                 m_sensors.size() &&
+                             m_sensors[sensor]);
+        }
+
+        /// @brief Is any of sensors or channels [first, first + count) of
+        /// this device in use?
+        bool wantsAnyOf(int first, int count) const {
+            for (int i = first; i < first + count; ++i) {
+                if (wants(i)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+      private:
+        friend class SubscriptionFilter;
+        void m_reset(bool wanted);
+        void m_add(int sensor);
+
+        bool m_all;
+        bool m_any;
+        std::vector<bool> m_sensors;
+    };
+    typedef shared_ptr<DeviceSubscription> DeviceSubscriptionPtr;
+
+    /// @brief Tracks which devices, sensors, and channels connected clients
+    /// use, so that servers can skip packing data nobody will receive.
+    ///
+    /// Clients each report their complete list of sources, and must refresh
+    /// it periodically: clients that stop doing so are forgotten by
+    /// expireClients(). Filtering is disabled by default, in which case
+    /// everything is reported as wanted.
+    ///
+    /// Plain VRPN clients and older OSVR clients never report their sources,
+    /// so while fewer connections have a client that reported than are
+    /// connected, as counted by addConnection() and removeConnection(),
+    /// everything is reported as wanted too. Several client contexts in one
+    /// process may share a connection, so clients are counted by the
+    /// connection they name, not one by one.
+    class SubscriptionFilter : boost::noncopyable {
+      public:
+        OSVR_CONNECTION_EXPORT SubscriptionFilter();
+
+        /// @brief Turns filtering on or off.
+        OSVR_CONNECTION_EXPORT void setEnabled(bool enabled);
+
+        bool isEnabled() const { return m_enabled; }
+
+        /// @brief Gets the (live-updated) subscription state for a device,
+        /// creating it if required.
+        OSVR_CONNECTION_EXPORT DeviceSubscriptionPtr
+        getDevice(std::string const &device);
+
+        /// @brief Replaces the list of sources used by a client, and notes
+        /// that the client is still alive.
+        ///
+        /// @param connectionId Identifies the connection the client uses,
+        /// which other clients may share.
+        OSVR_CONNECTION_EXPORT void
+        setClientSubscriptions(std::string const &clientId,
+                               std::string const &connectionId,
+                               common::SourceSubscriptionList const &sources,
+                               util::time::TimeValue const &now);
+
+        /// @overload
+        ///
+        /// For a client with a connection of its own.
+        void setClientSubscriptions(
+            std::string const &clientId,
+            common::SourceSubscriptionList const &sources,
+            util::time::TimeValue const &now) {
+            setClientSubscriptions(clientId, clientId, sources, now);
+        }
+
+        /// @brief Forgets a client.
+        OSVR_CONNECTION_EXPORT void removeClient(std::string const &clientId);
+
+        /// @brief Forgets clients not heard from in more than `timeout`
+        /// seconds before `now`.
+        OSVR_CONNECTION_EXPORT void
+        expireClients(util::time::TimeValue const &now, double timeout);
+
+        /// @brief Records that a device on this server republishes data from
+        /// another: whatever is in use of the former marks the source as in
+        /// use too.
+        ///
+        /// If the source has no specific sensor, each sensor in use of the
+        /// device marks the same sensor of the source.
+        OSVR_CONNECTION_EXPORT void
+        setDependency(std::string const &device,
+                      common::SourceSubscription const &source);
+
+        /// @brief Removes any dependency recorded for a device.
+        OSVR_CONNECTION_EXPORT void
+        removeDependency(std::string const &device);
+
+        /// @brief Number of clients currently known.
+        std::size_t getNumClients() const { return m_clients.size(); }
+
+        /// @brief Number of connections with at least one client known.
+        std::size_t getNumReportedConnections() const {
+            return m_clientsPerConnection.size();
+        }
+
+        /// @brief Notes that a client connected, which may or may not go on
+        /// to report its sources.
+        OSVR_CONNECTION_EXPORT void addConnection();
+
+        /// @brief Notes that a client disconnected.
+        OSVR_CONNECTION_EXPORT void removeConnection();
+
+        /// @brief Is anything actually being filtered out?
+        bool isFiltering() const {
+            return m_enabled && getNumReportedConnections() >= m_connections;
+        }
+
+      private:
+        struct ClientEntry {
+            std::string connection;
+            common::SourceSubscriptionList sources;
+            util::time::TimeValue lastSeen;
+        };
+        typedef std::map<std::string, ClientEntry> ClientMap;
+        void m_recompute();
+        /// @brief Forgets a client, returning the iterator to the next.
+        ClientMap::iterator m_erase(ClientMap::iterator it);
+        void m_removeFromConnection(std::string const &connection);
+        void m_mark(common::SourceSubscription const &source,
+                    std::size_t depth);
+
+        bool m_enabled;
+        std::size_t m_connections;
+        std::map<std::string, DeviceSubscriptionPtr> m_devices;
+        ClientMap m_clients;
+        /// @brief Number of known clients using each connection.
+        std::map<std::string, std::size_t> m_clientsPerConnection;
+        std::map<std::string, common::SourceSubscription> m_dependencies;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_SubscriptionFilter_h_GUID_7809142B_EFCE_43D5_AE2C_4A8267A39C9D
@@ -29,6 +29,7 @@
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TrackerStateC.h>
 
 // Library/third-party includes
 // - none
@@ -56,6 +57,18 @@ namespace connection {
         virtual void sendReport(OSVR_PoseState const &val,
                                 OSVR_ChannelCount chan,
                                 util::time::TimeValue const &timestamp) = 0;
+
+        /// @brief Sends the complete state of a sensor: only the parts its
+        /// flags mark valid are reported to clients.
+        virtual void sendReport(OSVR_TrackerState const &val,
+                                OSVR_ChannelCount chan,
+                                util::time::TimeValue const &timestamp) = 0;
+
+        /// @brief Sends poses for sensors [0, chans), all sampled at the same
+        /// time, batched into as few messages as the transport allows.
+        virtual void sendReports(OSVR_PoseState const val[],
+                                 OSVR_ChannelCount chans,
+                                 util::time::TimeValue const &timestamp) = 0;
     };
 
 } // namespace connection
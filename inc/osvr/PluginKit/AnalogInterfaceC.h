@@ -33,6 +33,7 @@
 #include <osvr/PluginKit/DeviceInterfaceC.h>
 #include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/StdInt.h>
 
 /* Library/third-party includes */
 /* none */
@@ -59,8 +60,9 @@ typedef struct OSVR_AnalogDeviceInterfaceObject *OSVR_AnalogDeviceInterface;
     @param [out] iface An interface object you should retain with the same
    lifetime as the device token in order to send messages conforming to an
    analog interface.
-    @param numChan The number of channels you will be reporting. This parameter
-   may be subject to external limitations (presently 128).
+    @param numChan The number of channels you will be reporting. Unless you
+   also call osvrDeviceAnalogConfigureEncoding(), this parameter may be subject
+   to external limitations (presently 128).
 
 */
 OSVR_PLUGINKIT_EXPORT
@@ -70,6 +72,41 @@ osvrDeviceAnalogConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                           OSVR_IN OSVR_ChannelCount numChan)
     OSVR_FUNC_NONNULL((1, 2));
 
+/** @brief Type of an analog value encoding.
+    @see osvrDeviceAnalogConfigureEncoding()
+*/
+typedef uint8_t OSVR_AnalogEncoding;
+
+/** @brief Values are sent with full (double) precision. */
+#define OSVR_ANALOG_ENCODING_FLOAT64 (0)
+/** @brief Values are sent with single precision. */
+#define OSVR_ANALOG_ENCODING_FLOAT32 (1)
+/** @brief Values are sent as 16-bit multiples of a scale you supply. */
+#define OSVR_ANALOG_ENCODING_INT16 (2)
+
+/** @brief Request that your device's analog values be sent in a compact
+    message that supports any number of channels, and carries only the
+    channels that changed.
+
+    Only clients using the OSVR client libraries can receive these messages.
+    Devices with more than 128 channels use them even without calling this
+    function, in full precision.
+
+    @param opts The device init options object.
+    @param encoding One of the OSVR_ANALOG_ENCODING_ constants.
+    @param scale For OSVR_ANALOG_ENCODING_INT16, the value of one step:
+   values are rounded to the nearest multiple, and clamped to within 32767
+   steps of zero. Must be positive. Ignored for other encodings.
+
+    @returns OSVR_RETURN_FAILURE for an unknown encoding or invalid scale.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceAnalogConfigureEncoding(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
+                                  OSVR_IN OSVR_AnalogEncoding encoding,
+                                  OSVR_IN double scale)
+    OSVR_FUNC_NONNULL((1));
+
 /** @brief Report the value of a single channel.
 */
 OSVR_PLUGINKIT_EXPORT
@@ -90,6 +127,9 @@ OSVR_ReturnCode osvrDeviceAnalogSetValueTimestamped(
     OSVR_FUNC_NONNULL((1, 2, 5));
 
 /** @brief Report the value of multiple channels
+
+    Changes to all the channels are sent together: in a single message,
+    unless there are too many to fit.
 */
 OSVR_PLUGINKIT_EXPORT
 OSVR_ReturnCode osvrDeviceAnalogSetValues(OSVR_IN_PTR OSVR_DeviceToken dev,
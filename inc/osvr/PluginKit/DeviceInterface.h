@@ -175,7 +175,7 @@ namespace pluginkit {
         template <typename InterfaceType, typename MessageType>
         void send(InterfaceType &iface, MessageType const &msg) {
             OSVR_TimeValue timestamp;
-            util::time::getNow(timestamp);
+            util::time::getSteadyNow(timestamp);
             send(iface, msg, timestamp);
         }
 
@@ -33,6 +33,7 @@
 #include <osvr/PluginKit/DeviceInterfaceC.h>
 #include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/TrackerStateC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -130,6 +131,56 @@ OSVR_ReturnCode osvrDeviceTrackerSendOrientationTimestamped(
     OSVR_IN OSVR_ChannelCount chan, OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 3, 5));
 
+/** @brief Report the complete state of a sensor: its pose, and optionally
+    its velocity and acceleration, with flags saying which parts are valid.
+
+    Clients only get position or orientation reports for the parts of the
+    pose flagged valid, and use any velocity for pose prediction.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceTrackerSendState(OSVR_IN_PTR OSVR_DeviceToken dev,
+                           OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_TrackerState const *val,
+                           OSVR_IN OSVR_ChannelCount chan)
+    OSVR_FUNC_NONNULL((1, 2, 3));
+
+/** @brief Report the complete state of a sensor with the supplied timestamp.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSendStateTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_TrackerState const *val, OSVR_IN OSVR_ChannelCount chan,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 3, 5));
+
+/** @brief Report the full rigid body poses of sensors 0 through chans - 1,
+    all sampled at the same time.
+
+    Sent together in as few messages as possible, rather than one message per
+    sensor, so preferred for devices with many sensors, such as motion capture
+    rigid bodies.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceTrackerSendPoses(OSVR_IN_PTR OSVR_DeviceToken dev,
+                           OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_PoseState const val[],
+                           OSVR_IN OSVR_ChannelCount chans)
+    OSVR_FUNC_NONNULL((1, 2, 3));
+
+/** @brief Report the full rigid body poses of sensors 0 through chans - 1
+    with the supplied timestamp.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSendPosesTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_PoseState const val[], OSVR_IN OSVR_ChannelCount chans,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 3, 5));
+
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
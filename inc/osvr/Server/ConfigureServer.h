@@ -80,7 +80,22 @@ namespace server {
         ///
         /// `port` defaults to the assigned VRPN port (3883)
         ///
+        /// If `unixSocket` is `true` or a socket path, the server is local
+        /// only (ignoring the above) and sends device reports to clients on a
+        /// Unix domain socket, at the default path if `true`.
+        ///
+        /// If `inProcess` is `true` or a name, the server is local only and
+        /// hands device reports to client contexts in the same process that
+        /// connect to host `inproc:` followed by that name (empty if `true`).
+        ///
+        /// If `sharedMemory` is `true` or a region name, the server is local
+        /// only and publishes device reports in shared memory, for clients
+        /// that connect to host `shm:` followed by that name (or nothing for
+        /// the default region, if `true`).
+        ///
         /// @throws std::out_of_range if an invalid port (<1) is specified.
+        /// @throws std::runtime_error if a Unix domain socket or shared
+        /// memory region is requested but can't be created.
         OSVR_SERVER_EXPORT ServerPtr constructServer();
 
         /// @brief Container for plugin/driver names
@@ -140,8 +155,18 @@ namespace server {
         OSVR_SERVER_EXPORT ErrorList const &getFailedInstantiations() const;
         /// @}
 
+        /// @name Route handling
+        /// @{
+        /// @brief Adds the routes contained in an array with key `routes`.
+        ///
+        /// @returns true if any routes were added.
         OSVR_SERVER_EXPORT bool processRoutes();
 
+        /// @brief Get a reference to the list of routes processRoutes()
+        /// rejected, by destination, along with any exception text.
+        OSVR_SERVER_EXPORT ErrorList const &getFailedRoutes() const;
+        /// @}
+
         /// @brief Loads all plugins not marked for manual load.
         OSVR_SERVER_EXPORT void loadAutoPlugins();
 
@@ -164,6 +189,9 @@ namespace server {
         SuccessList m_successfulInstances;
         ErrorList m_failedInstances;
         /// @}
+
+        /// @brief Results data of processRoutes()
+        ErrorList m_failedRoutes;
     };
 } // namespace server
 } // namespace osvr
@@ -139,6 +139,13 @@ namespace server {
         }
 
         srvConfig.processRoutes();
+        if (!srvConfig.getFailedRoutes().empty()) {
+            out << "Route errors:" << endl;
+            for (auto const &error : srvConfig.getFailedRoutes()) {
+                out << " - " << error.first << "\t" << error.second << endl;
+            }
+            out << "\n";
+        }
 
         out << "Triggering a hardware detection..." << endl;
         ret->triggerHardwareDetect();
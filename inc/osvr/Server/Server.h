@@ -29,6 +29,7 @@
 #include <osvr/Server/Export.h>
 #include <osvr/Server/ServerPtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
+#include <osvr/Connection/ReportSuppression.h>
 #include <osvr/Util/UniquePtr.h>
 
 // Library/third-party includes
@@ -149,9 +150,21 @@ namespace server {
         /// If the server is running, this will trigger a re-transmission of
         /// routing directives to all clients.
         ///
+        /// If the directive has `"serverTransform": true` and its source is a
+        /// transformed tracker on this server, the server applies the
+        /// transform itself, publishing the result as a new device, and
+        /// clients are sent a directive routing from that device instead.
+        /// A `"serverFilter"` object (see common::TrackerFilter) does the
+        /// same, additionally smoothing the transformed poses.
+        ///
         /// @returns true if the route was new, or false if it replaced an
         /// existing route for that destination.
         ///
+        /// @throws std::runtime_error if the `"serverFilter"` is not a valid
+        /// filter description, or can't be applied because the source is not
+        /// a transformed tracker on this server (or the server has no VRPN
+        /// connection): the route is not added.
+        ///
         /// Safe to call from any thread, even when server is running.
         OSVR_SERVER_EXPORT bool addRoute(std::string const &routingDirective);
 
@@ -180,6 +193,53 @@ namespace server {
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT int getSleepTime() const;
 
+        /// @brief Sets whether the server skips packing device data that no
+        /// connected client has subscribed to. Off by default.
+        ///
+        /// Clients report what they use based on the interfaces they have
+        /// open, so data for other devices, sensors, and channels is not
+        /// sent at all. Plain VRPN clients and older OSVR clients never
+        /// report anything, so nothing is filtered while fewer clients have
+        /// reported than are connected. (The subscriptions of a client that
+        /// disconnects are kept for a few seconds, until they expire.)
+        ///
+        /// Safe to call from any thread, even when server is running.
+        OSVR_SERVER_EXPORT void setSubscriptionFiltering(bool enabled);
+
+        /// @brief Returns whether subscription filtering is enabled.
+        ///
+        /// Safe to call from any thread, even when server is running.
+        OSVR_SERVER_EXPORT bool getSubscriptionFiltering() const;
+
+        /// @brief Sets the settings for skipping analog and tracker reports
+        /// that change nothing, and for limiting their rate, given to devices
+        /// created from now on.
+        ///
+        /// Off by default. Set them just before instantiating a driver to
+        /// configure only the devices it creates.
+        ///
+        /// Safe to call from any thread, even when server is running.
+        OSVR_SERVER_EXPORT void setReportSuppression(
+            connection::ReportSuppressionSettings const &settings);
+
+        /// @brief Sets the most analog and tracker reports sent per second by
+        /// all devices together, on top of each device's own maximum rate: 0
+        /// (the default) for no limit. Reports over the limit are held back,
+        /// keeping only the newest.
+        ///
+        /// Safe to call from any thread, even when server is running.
+        OSVR_SERVER_EXPORT void setMaxConnectionReportRate(double maxRate);
+
+        /// @brief Get a JSON object with, for each device seen so far, the
+        /// number of analog and tracker reports sent (`sent`), skipped for
+        /// changing nothing (`suppressed`), and dropped for a newer report
+        /// while held back by the rate limit (`conflated`).
+        /// @param styled Pass `true` if you want the result pretty-printed.
+        ///
+        /// Safe to call from any thread, even when server is running.
+        OSVR_SERVER_EXPORT std::string
+        getReportSuppressionCounts(bool styled = false) const;
+
       private:
         unique_ptr<ServerImpl> m_impl;
     };
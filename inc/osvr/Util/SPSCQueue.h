@@ -0,0 +1,116 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SPSCQueue_h_GUID_327BD066_05A6_447B_8373_1AD0D49F682B
+#define INCLUDED_SPSCQueue_h_GUID_327BD066_05A6_447B_8373_1AD0D49F682B
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+namespace osvr {
+namespace util {
+    /// @brief A bounded, lock-free queue for handing values from exactly one
+    /// producer thread to exactly one consumer thread.
+    ///
+    /// Neither push() nor pop() ever blocks: push() fails if the queue is
+    /// full, and pop() fails if it is empty. Storage is allocated once, up
+    /// front.
+    ///
+    /// @tparam T A default-constructible, move-assignable type.
+    template <typename T> class SPSCQueue : boost::noncopyable {
+      public:
+        /// @brief Constructor
+        ///
+        /// @param capacity Maximum number of elements queued at once.
+        explicit SPSCQueue(std::size_t capacity)
+            : m_slots(capacity + 1), m_head(0), m_tail(0) {}
+
+        /// @brief Enqueues a value - producer thread only.
+        ///
+        /// @returns false (leaving the value untouched) if the queue is full.
+        bool push(T &&val) {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            const std::size_t next = m_next(tail);
+            if (next == m_head.load(std::memory_order_acquire)) {
+                return false;
+            }
+            m_slots[tail] = std::move(val);
+            m_tail.store(next, std::memory_order_release);
+            return true;
+        }
+
+        /// @overload
+        bool push(T const &val) {
+            T copy(val);
+            return push(std::move(copy));
+        }
+
+        /// @brief Dequeues a value - consumer thread only.
+        ///
+        /// @returns false if the queue is empty.
+        bool pop(T &val) {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            val = std::move(m_slots[head]);
+            /// Don't hold on to resources owned by the moved-from value.
+            m_slots[head] = T();
+            m_head.store(m_next(head), std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Is the queue empty? Only a snapshot if called from the
+        /// producer.
+        bool empty() const {
+            return m_head.load(std::memory_order_acquire) ==
+                   m_tail.load(std::memory_order_acquire);
+        }
+
+        /// @brief Maximum number of elements that can be queued at once.
+        std::size_t capacity() const { return m_slots.size() - 1; }
+
+      private:
+        std::size_t m_next(std::size_t i) const {
+            return (i + 1 == m_slots.size()) ? 0 : i + 1;
+        }
+        std::vector<T> m_slots;
+        /// @brief Next slot to read - written only by the consumer.
+        std::atomic<std::size_t> m_head;
+        /// @brief Next slot to write - written only by the producer.
+        std::atomic<std::size_t> m_tail;
+    };
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_SPSCQueue_h_GUID_327BD066_05A6_447B_8373_1AD0D49F682B
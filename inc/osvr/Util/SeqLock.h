@@ -0,0 +1,93 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SeqLock_h_GUID_8CA23C2A_04DF_4B16_BA58_FE337E4C744A
+#define INCLUDED_SeqLock_h_GUID_8CA23C2A_04DF_4B16_BA58_FE337E4C744A
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstdint>
+
+namespace osvr {
+namespace util {
+    /// @brief A value published by a single writer thread and readable from
+    /// any number of other threads without locking, using a sequence lock.
+    ///
+    /// The writer never blocks or waits. A reader only retries if it overlaps
+    /// a write in progress, which for small values is a handful of
+    /// instructions, so readers never stall behind the writer the way they
+    /// would on a mutex.
+    ///
+    /// @tparam T A trivially-copyable type: it may be copied while being
+    /// overwritten, and the torn copy discarded.
+    ///
+    /// @note Only one thread may call store() at a time.
+    template <typename T> class SeqLocked : boost::noncopyable {
+      public:
+        SeqLocked() : m_seq(0), m_val() {}
+
+        /// @brief Publishes a new value.
+        void store(T const &val) {
+            const uint32_t seq = m_seq.load(std::memory_order_relaxed);
+            /// Odd sequence numbers mark a write in progress.
+            m_seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_val = val;
+            m_seq.store(seq + 2, std::memory_order_release);
+        }
+
+        /// @brief Returns a consistent copy of the most recently published
+        /// value (or a default-constructed value if none).
+        T load() const {
+            T ret;
+            uint32_t before;
+            uint32_t after;
+            do {
+                before = m_seq.load(std::memory_order_acquire);
+                ret = m_val;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = m_seq.load(std::memory_order_relaxed);
+            } while ((before & 1) || before != after);
+            return ret;
+        }
+
+        /// @brief Has a value ever been published?
+        bool hasValue() const {
+            return m_seq.load(std::memory_order_acquire) != 0;
+        }
+
+      private:
+        std::atomic<uint32_t> m_seq;
+        T m_val;
+    };
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_SeqLock_h_GUID_8CA23C2A_04DF_4B16_BA58_FE337E4C744A
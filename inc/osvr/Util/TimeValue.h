@@ -47,6 +47,32 @@ namespace util {
 
         /// @brief Set the given TimeValue to the current time.
         inline void getNow(TimeValue &tv) { osvrTimeValueGetNow(&tv); }
+
+        /// @brief Set the given TimeValue to the current time, derived from
+        /// the monotonic clock but in the wall clock domain: preferred for
+        /// report timestamps.
+        inline void getSteadyNow(TimeValue &tv) {
+            osvrTimeValueGetSteadyNow(&tv);
+        }
+
+        /// @brief Set the given TimeValue to the current reading of the
+        /// monotonic clock (unspecified epoch).
+        inline void getMonotonicNow(TimeValue &tv) {
+            osvrTimeValueGetMonotonicNow(&tv);
+        }
+
+        /// @brief Get the duration `a - b` in seconds.
+        inline double duration(TimeValue const &a, TimeValue const &b) {
+            return osvrTimeValueDurationSeconds(&a, &b);
+        }
+
+        /// @brief Convert a monotonic clock reading to the corresponding wall
+        /// clock time.
+        inline TimeValue monotonicToWallClock(TimeValue const &src) {
+            TimeValue dest = src;
+            osvrTimeValueMonotonicToWallClock(&dest);
+            return dest;
+        }
 #ifdef OSVR_HAVE_STRUCT_TIMEVAL
         /// @brief Convert a TimeValue to a struct timeval
         inline void toStructTimeval(struct timeval &dest,
@@ -114,8 +114,45 @@ OSVR_UTIL_EXPORT void
 osvrStructTimevalToTimeValue(OSVR_OUT OSVR_TimeValue *dest,
                              OSVR_IN_PTR const struct timeval *src)
     OSVR_FUNC_NONNULL((1, 2));
+
+/** @brief Gets the current time in the TimeValue, derived from the monotonic
+    clock but expressed relative to the same epoch as osvrTimeValueGetNow().
+
+    The offset between the monotonic clock and the wall clock is captured once
+    per process, so successive results never step backwards or jump under NTP
+    or manual clock adjustments, while remaining directly comparable with wall
+    clock timestamps from other processes (to the accuracy of that one-time
+    offset). This is the recommended source for report timestamps, and is what
+    device tokens use when no timestamp is supplied.
+*/
+OSVR_UTIL_EXPORT void osvrTimeValueGetSteadyNow(OSVR_OUT OSVR_TimeValue *dest)
+    OSVR_FUNC_NONNULL((1));
+
+/** @brief Converts, in place, a time value from osvrTimeValueGetMonotonicNow()
+    into the wall clock domain used by osvrTimeValueGetNow() and the wire
+    format.
+
+    @param tv Address of a monotonic time value to convert in place.
+
+    If the given pointer is NULL, this function returns without doing anything.
+*/
+OSVR_UTIL_EXPORT void
+osvrTimeValueMonotonicToWallClock(OSVR_INOUT_PTR OSVR_TimeValue *tv)
+    OSVR_FUNC_NONNULL((1));
 #endif
 
+/** @brief Gets the current reading of a monotonic, high-resolution clock.
+
+    The epoch of this clock is unspecified (typically system boot), so the
+    result is only meaningful for computing intervals or when passed to
+    osvrTimeValueMonotonicToWallClock(). It is unaffected by changes to the
+    system wall clock. Uses `CLOCK_MONOTONIC` on POSIX systems,
+    `mach_absolute_time` on Mac OS X, and `QueryPerformanceCounter` on Windows.
+*/
+OSVR_UTIL_EXPORT void
+osvrTimeValueGetMonotonicNow(OSVR_OUT OSVR_TimeValue *dest)
+    OSVR_FUNC_NONNULL((1));
+
 /** @brief "Normalizes" a time value so that the absolute number of microseconds
     is less than 1,000,000, and that the sign of both components is the same.
 
@@ -156,6 +193,21 @@ osvrTimeValueDifference(OSVR_INOUT_PTR OSVR_TimeValue *tvA,
                         OSVR_IN_PTR const OSVR_TimeValue *tvB)
     OSVR_FUNC_NONNULL((1, 2));
 
+/** @brief Computes the difference between two time values, returning the
+    result in seconds as a double: effectively `*tvA - *tvB`.
+
+    @param tvA first source.
+    @param tvB second source
+
+    If a given pointer is NULL, this function returns 0.
+
+    Both parameters are expected to be in normalized form.
+*/
+OSVR_UTIL_EXPORT double
+osvrTimeValueDurationSeconds(OSVR_IN_PTR const OSVR_TimeValue *tvA,
+                             OSVR_IN_PTR const OSVR_TimeValue *tvB)
+    OSVR_FUNC_NONNULL((1, 2));
+
 /** @} */
 
 OSVR_EXTERN_C_END
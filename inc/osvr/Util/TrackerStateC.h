@@ -0,0 +1,106 @@
+/** @file
+    @brief Header
+
+    Must be c-safe!
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_TrackerStateC_h_GUID_1E6FA8A7_E93C_4C12_B799_C4EA2FDA78AE
+#define INCLUDED_TrackerStateC_h_GUID_1E6FA8A7_E93C_4C12_B799_C4EA2FDA78AE
+
+/* Internal Includes */
+#include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/Vec3C.h>
+#include <osvr/Util/StdInt.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+/* none */
+
+OSVR_EXTERN_C_BEGIN
+
+/** @addtogroup PluginKit
+    @{
+*/
+
+/** @name Tracker state flags
+    @{
+*/
+/** @brief Type of the flags in an OSVR_TrackerState */
+typedef uint32_t OSVR_TrackerStateFlags;
+
+/** @brief The translation of the pose is valid. */
+#define OSVR_TRACKER_POSITION_VALID (1u << 0)
+
+/** @brief The rotation of the pose is valid. */
+#define OSVR_TRACKER_ORIENTATION_VALID (1u << 1)
+
+/** @brief The linear velocity is valid. */
+#define OSVR_TRACKER_LINEAR_VELOCITY_VALID (1u << 2)
+
+/** @brief The angular velocity is valid. */
+#define OSVR_TRACKER_ANGULAR_VELOCITY_VALID (1u << 3)
+
+/** @brief The linear acceleration is valid. */
+#define OSVR_TRACKER_LINEAR_ACCELERATION_VALID (1u << 4)
+
+/** @brief The angular acceleration is valid. */
+#define OSVR_TRACKER_ANGULAR_ACCELERATION_VALID (1u << 5)
+
+/** @brief Send values as 32-bit floats: about half the size on the wire, at
+    roughly 7 significant digits of precision.
+*/
+#define OSVR_TRACKER_SINGLE_PRECISION (1u << 16)
+/** @} */
+
+/** @brief The complete state of a tracked sensor at one time: its pose, and
+    optionally its motion, with flags saying which parts are valid.
+
+    Velocities and accelerations are in the same frame as the pose. Angular
+    values are rotation vectors: axis scaled by radians per second (or per
+    second squared).
+*/
+typedef struct OSVR_TrackerState {
+    /** @brief Bitwise OR of OSVR_TRACKER_* flags. */
+    OSVR_TrackerStateFlags flags;
+    /** @brief The pose: parts not flagged valid are ignored. */
+    OSVR_PoseState pose;
+    /** @brief Units per second. */
+    OSVR_Vec3 linearVelocity;
+    /** @brief Radians per second, as a rotation vector. */
+    OSVR_Vec3 angularVelocity;
+    /** @brief Units per second squared. */
+    OSVR_Vec3 linearAcceleration;
+    /** @brief Radians per second squared, as a rotation vector. */
+    OSVR_Vec3 angularAcceleration;
+} OSVR_TrackerState;
+
+/** @} */
+
+OSVR_EXTERN_C_END
+
+#endif
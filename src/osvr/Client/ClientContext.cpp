@@ -26,33 +26,288 @@
 #include <osvr/Client/ClientContext.h>
 #include <osvr/Client/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
+#include <osvr/Util/Microsleep.h>
 
 // Library/third-party includes
 #include <boost/assert.hpp>
 
 // Standard includes
 #include <algorithm>
+#include <limits>
 
 using ::osvr::client::ClientInterfacePtr;
 using ::osvr::client::ClientInterface;
+using ::osvr::client::InterfaceCore;
+using ::osvr::client::InterfaceCorePtr;
 using ::osvr::make_shared;
 
+/// @brief Number of callback invocations the network thread can queue up
+/// between calls to update().
+static const std::size_t CALLBACK_QUEUE_CAPACITY = 4096;
+
+/// @brief Microseconds to sleep between passes when polling for messages.
+static const uint64_t POLL_SLEEP_TIME = 1000;
+
+/// @brief Budget passed internally for an unbudgeted update.
+static const uint64_t UNLIMITED_BUDGET = std::numeric_limits<uint64_t>::max();
+
 OSVR_ClientContextObject::OSVR_ClientContextObject(const char appId[])
-    : m_appId(appId) {
+    : m_appId(appId), m_coreGeneration(0), m_dispatchDepth(0),
+      m_runNetworkThread(false),
+      m_queueCallbacks(false), m_callbacksOnNetworkThread(false),
+      m_deferCallbacks(false), m_callbackQueue(CALLBACK_QUEUE_CAPACITY),
+      m_droppedCallbacks(0), m_reportCount(0) {
     OSVR_DEV_VERBOSE("Client context initialized for " << m_appId);
 }
 
-OSVR_ClientContextObject::~OSVR_ClientContextObject() {}
+OSVR_ClientContextObject::~OSVR_ClientContextObject() {
+    BOOST_ASSERT_MSG(!hasNetworkThread(), "Derived class destructor should "
+                                          "have stopped the network thread!");
+    stopNetworkThread();
+}
 
 std::string const &OSVR_ClientContextObject::getAppId() const {
     return m_appId;
 }
 
 void OSVR_ClientContextObject::update() {
-    m_update();
+    osvr::util::time::TimeValue start;
+    osvr::util::time::getMonotonicNow(start);
+    /// Anything left over from a budgeted update comes first.
+    m_deliverQueuedCallbacks(start, UNLIMITED_BUDGET, false);
+    if (!hasNetworkThread()) {
+        {
+            /// Held as on the network thread, so batch state queries from
+            /// other threads still see a consistent snapshot.
+            UpdateLock lock(m_updateMutex);
+            m_updateNow();
+        }
+        /// Coalesced callbacks deferred by the update just done.
+        m_deliverQueuedCallbacks(start, UNLIMITED_BUDGET, false);
+    }
+}
+
+void OSVR_ClientContextObject::updateWithBudget(uint64_t microseconds,
+                                                bool dropSuperseded) {
+    osvr::util::time::TimeValue start;
+    osvr::util::time::getMonotonicNow(start);
+    if (!hasNetworkThread()) {
+        UpdateLock lock(m_updateMutex);
+        m_deferCallbacks = true;
+        m_updateNow();
+        m_deferCallbacks = false;
+    }
+    m_deliverQueuedCallbacks(start, microseconds, dropSuperseded);
+}
+
+bool OSVR_ClientContextObject::waitForReport(ClientInterface const *iface,
+                                             uint64_t timeoutMicroseconds) {
+    auto reportCount = [&] {
+        return iface ? iface->getReportCount() : m_reportCount.load();
+    };
+    const uint64_t initialCount = reportCount();
+    osvr::util::time::TimeValue start;
+    osvr::util::time::getMonotonicNow(start);
+    while (reportCount() == initialCount) {
+        osvr::util::time::TimeValue now;
+        osvr::util::time::getMonotonicNow(now);
+        const double elapsed = osvr::util::time::duration(now, start) * 1.0e6;
+        if (elapsed >= timeoutMicroseconds) {
+            return false;
+        }
+        const uint64_t remaining =
+            timeoutMicroseconds - static_cast<uint64_t>(elapsed);
+        if (hasNetworkThread()) {
+            {
+                boost::unique_lock<boost::mutex> lock(m_reportWaitMutex);
+                if (reportCount() == initialCount) {
+                    m_reportDispatched.timed_wait(
+                        lock, boost::posix_time::microseconds(remaining));
+                }
+            }
+            /// A report may have been counted by a pass still in progress:
+            /// let it finish queueing callbacks, then deliver them.
+            { UpdateLock lock(m_updateMutex); }
+            update();
+        } else {
+            {
+                UpdateLock lock(m_updateMutex);
+                ++m_dispatchDepth;
+                m_waitForNetwork(remaining);
+                m_endDispatch();
+            }
+            update();
+        }
+    }
+    return true;
+}
+
+void OSVR_ClientContextObject::startNetworkThread(
+    bool callbacksOnNetworkThread) {
+    if (hasNetworkThread()) {
+        return;
+    }
+    OSVR_DEV_VERBOSE("Starting client network thread, delivering callbacks "
+                     << (callbacksOnNetworkThread ? "on that thread"
+                                                  : "from update()"));
+    m_queueCallbacks = !callbacksOnNetworkThread;
+    m_callbacksOnNetworkThread = callbacksOnNetworkThread;
+    m_runNetworkThread = true;
+    m_networkThread = boost::thread([&] { m_networkThreadLoop(); });
+}
+
+void OSVR_ClientContextObject::stopNetworkThread() {
+    if (!hasNetworkThread()) {
+        return;
+    }
+    m_runNetworkThread = false;
+    m_networkThread.join();
+    m_networkThread = boost::thread();
+    osvr::client::QueuedCallback discarded;
+    while (m_callbackQueue.pop(discarded)) {
+    }
+    /// Coalesced reports waiting on discarded callbacks must not stay
+    /// pending, or they would never be delivered again.
     for (auto const &iface : m_interfaces) {
-        iface->update();
+        iface->m_coalesced.clear();
     }
+    m_queueCallbacks = false;
+    m_callbacksOnNetworkThread = false;
+}
+
+bool OSVR_ClientContextObject::queueCallback(
+    osvr::client::QueuedCallback &&callback) {
+    if (!m_queueCallbacks) {
+        /// Deferred during an update on this thread.
+        m_addPendingCallback(std::move(callback));
+        return true;
+    }
+    if (!m_callbackQueue.push(std::move(callback))) {
+        ++m_droppedCallbacks;
+        return false;
+    }
+    return true;
+}
+
+void OSVR_ClientContextObject::m_updateNow() {
+    ++m_dispatchDepth;
+    m_update();
+    for (auto const &core : m_cores) {
+        core->update();
+    }
+    m_endDispatch();
+}
+
+void OSVR_ClientContextObject::m_endDispatch() {
+    BOOST_ASSERT(m_dispatchDepth > 0);
+    if (--m_dispatchDepth > 0) {
+        return;
+    }
+    const std::size_t before = m_cores.size();
+    m_cores.erase(std::remove_if(begin(m_cores), end(m_cores),
+                                 [](InterfaceCorePtr const &core) {
+                                     return !core->hasHandles();
+                                 }),
+                  end(m_cores));
+    const bool changed =
+        m_cores.size() != before || !m_coresAddedInDispatch.empty();
+    for (auto const &core : m_coresAddedInDispatch) {
+        if (core->hasHandles()) {
+            m_cores.push_back(core);
+        }
+    }
+    m_coresAddedInDispatch.clear();
+    if (changed) {
+        ++m_coreGeneration;
+    }
+}
+
+void OSVR_ClientContextObject::m_waitForNetwork(uint64_t microseconds) {
+    osvr::util::time::microsleep(
+        std::min(microseconds, POLL_SLEEP_TIME));
+}
+
+void OSVR_ClientContextObject::m_networkThreadLoop() {
+    while (m_runNetworkThread) {
+        const uint64_t before = m_reportCount;
+        {
+            UpdateLock lock(m_updateMutex);
+            m_updateNow();
+        }
+        if (m_reportCount != before) {
+            /// Taking the mutex ensures a waiter either saw the new count or
+            /// is already waiting.
+            { boost::lock_guard<boost::mutex> lock(m_reportWaitMutex); }
+            m_reportDispatched.notify_all();
+        }
+        osvr::util::time::microsleep(POLL_SLEEP_TIME);
+    }
+}
+
+void OSVR_ClientContextObject::m_deliverQueuedCallbacks(
+    osvr::util::time::TimeValue const &start, uint64_t budget,
+    bool dropSuperseded) {
+    {
+        osvr::client::QueuedCallback callback;
+        while (m_callbackQueue.pop(callback)) {
+            m_addPendingCallback(std::move(callback));
+        }
+    }
+    const double budgetSeconds = budget / 1000000.0;
+    while (!m_pendingCallbacks.empty()) {
+        osvr::client::QueuedCallback &front = m_pendingCallbacks.front();
+        const bool keyed = front.supersedable;
+        bool superseded = false;
+        if (keyed) {
+            auto it = m_pendingPerKey.find(front.key);
+            BOOST_ASSERT(it != m_pendingPerKey.end());
+            superseded = it->second > 1;
+        }
+        /// Skipping is cheap, so don't let the budget hold it up.
+        const bool skip = dropSuperseded && superseded;
+        if (!skip && budget != UNLIMITED_BUDGET) {
+            osvr::util::time::TimeValue now;
+            osvr::util::time::getMonotonicNow(now);
+            if (osvr::util::time::duration(now, start) >= budgetSeconds) {
+                break;
+            }
+        }
+        osvr::client::QueuedCallback callback(std::move(front));
+        m_pendingCallbacks.pop_front();
+        if (keyed) {
+            auto it = m_pendingPerKey.find(callback.key);
+            if (--(it->second) == 0) {
+                m_pendingPerKey.erase(it);
+            }
+        }
+        std::size_t skipped = 0;
+        if (keyed && !m_skippedPerKey.empty()) {
+            auto it = m_skippedPerKey.find(callback.key);
+            if (it != m_skippedPerKey.end()) {
+                skipped = it->second;
+                m_skippedPerKey.erase(it);
+            }
+        }
+        if (skip) {
+            /// Pass the count along to the report that supersedes this one.
+            m_skippedPerKey[callback.key] = skipped + 1;
+            continue;
+        }
+        callback.deliver(skipped);
+    }
+    const std::size_t dropped = m_droppedCallbacks.exchange(0);
+    if (dropped > 0) {
+        OSVR_DEV_VERBOSE("Callback queue full, dropped "
+                         << dropped << " callbacks: call update() more often!");
+    }
+}
+
+void OSVR_ClientContextObject::m_addPendingCallback(
+    osvr::client::QueuedCallback &&callback) {
+    if (callback.supersedable) {
+        ++m_pendingPerKey[callback.key];
+    }
+    m_pendingCallbacks.push_back(std::move(callback));
 }
 
 ClientInterfacePtr OSVR_ClientContextObject::getInterface(const char path[]) {
@@ -64,8 +319,35 @@ ClientInterfacePtr OSVR_ClientContextObject::getInterface(const char path[]) {
     if (p.empty()) {
         return ret;
     }
-    ret = make_shared<ClientInterface>(this, path,
+    UpdateLock lock(m_updateMutex);
+    auto samePath = [&](InterfaceCorePtr const &core) {
+        return core->getPath() == p;
+    };
+    InterfaceCorePtr core;
+    InterfaceCoreList::iterator it =
+        std::find_if(begin(m_cores), end(m_cores), samePath);
+    if (it != end(m_cores)) {
+        core = *it;
+    } else {
+        it = std::find_if(begin(m_coresAddedInDispatch),
+                          end(m_coresAddedInDispatch), samePath);
+        if (it != end(m_coresAddedInDispatch)) {
+            core = *it;
+        }
+    }
+    if (!core) {
+        core = make_shared<InterfaceCore>(this, p);
+        if (m_dispatchDepth > 0) {
+            /// Routers may be iterating m_cores: add it once they're done.
+            m_coresAddedInDispatch.push_back(core);
+        } else {
+            m_cores.push_back(core);
+            ++m_coreGeneration;
+        }
+    }
+    ret = make_shared<ClientInterface>(this, core,
                                        ClientInterface::PrivateConstructor());
+    core->addHandle(ret.get());
     m_interfaces.push_back(ret);
     return ret;
 }
@@ -76,6 +358,7 @@ OSVR_ClientContextObject::releaseInterface(ClientInterface *iface) {
     if (!iface) {
         return ret;
     }
+    UpdateLock lock(m_updateMutex);
     InterfaceList::iterator it =
         std::find_if(begin(m_interfaces), end(m_interfaces),
                      [&](ClientInterfacePtr const &ptr) {
@@ -91,12 +374,21 @@ OSVR_ClientContextObject::releaseInterface(ClientInterface *iface) {
     if (ret) {
         // Erase it from our list
         m_interfaces.erase(it);
+        InterfaceCorePtr const &core = ret->getCore();
+        core->removeHandle(iface);
+        /// If called from a callback, routers may be iterating m_cores (and
+        /// the core may be dispatching): m_endDispatch() removes it later.
+        if (!core->hasHandles() && m_dispatchDepth == 0) {
+            m_cores.erase(std::find(begin(m_cores), end(m_cores), core));
+            ++m_coreGeneration;
+        }
     }
     return ret;
 }
 
 std::string
 OSVR_ClientContextObject::getStringParameter(std::string const &path) const {
+    UpdateLock lock(m_updateMutex);
     auto it = m_params.find(path);
     std::string ret;
     if (it != m_params.end()) {
@@ -108,6 +400,7 @@ OSVR_ClientContextObject::getStringParameter(std::string const &path) const {
 void OSVR_ClientContextObject::setParameter(std::string const &path,
                                             std::string const &value) {
     OSVR_DEV_VERBOSE("Parameter set for " << path);
+    UpdateLock lock(m_updateMutex);
     m_params[path] = value;
 }
 
@@ -117,9 +410,16 @@ OSVR_ClientContextObject::getRoutes() const {
 }
 
 void OSVR_ClientContextObject::sendRoute(std::string const &route) {
+    UpdateLock lock(m_updateMutex);
     m_sendRoute(route);
 }
 
 bool OSVR_ClientContextObject::releaseObject(void *obj) {
+    UpdateLock lock(m_updateMutex);
     return m_ownedObjects.release(obj);
 }
+
+osvr::util::time::TimeValue OSVR_ClientContextObject::toClientTime(
+    osvr::util::time::TimeValue const &serverTime) const {
+    return m_clockOffset.toClientTime(serverTime);
+}
@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include <osvr/Client/ClientInterface.h>
+#include <osvr/Client/ClientContext.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -31,16 +32,93 @@
 
 // Standard includes
 #include <boost/range/algorithm.hpp>
+#include <algorithm>
 
 OSVR_ClientInterfaceObject::OSVR_ClientInterfaceObject(
-    ::osvr::client::ClientContext *ctx, std::string const &path,
+    ::osvr::client::ClientContext *ctx,
+    osvr::client::InterfaceCorePtr const &core,
     OSVR_ClientInterfaceObject::PrivateConstructor const &)
-    : m_ctx(ctx), m_path(path) {
-    OSVR_DEV_VERBOSE("Interface initialized for " << m_path);
+    : m_ctx(ctx), m_core(core), m_historyCapacity(0), m_coalesce(false),
+      m_skippedReports(0) {
+    OSVR_DEV_VERBOSE("Interface initialized for " << getPath());
 }
 
 std::string const &OSVR_ClientInterfaceObject::getPath() const {
-    return m_path;
+    return m_core->getPath();
 }
 
-void OSVR_ClientInterfaceObject::update() {}
+void OSVR_ClientInterfaceObject::setHistoryCapacity(std::size_t capacity) {
+    UpdateLock lock(m_getUpdateMutex());
+    m_historyCapacity = capacity;
+    m_core->updateHistoryCapacity();
+}
+
+bool OSVR_ClientInterfaceObject::getPredictedPoseState(
+    osvr::util::time::TimeValue const &target, OSVR_PoseState &state) const {
+    return m_core->getPredictedPoseState(target, state);
+}
+
+void OSVR_ClientInterfaceObject::setCoalesceCallbacks(bool coalesce) {
+    UpdateLock lock(m_getUpdateMutex());
+    m_coalesce = coalesce;
+}
+
+boost::recursive_mutex &OSVR_ClientInterfaceObject::m_getUpdateMutex() const {
+    return m_ctx->getUpdateMutex();
+}
+
+bool OSVR_ClientInterfaceObject::m_shouldQueueCallbacks() const {
+    return m_ctx->isQueueingCallbacks() ||
+           (m_coalesce && m_ctx->canDeferCallbacks());
+}
+
+bool OSVR_ClientInterfaceObject::m_queueCallback(
+    osvr::client::QueuedCallback &&callback) {
+    return m_ctx->queueCallback(std::move(callback));
+}
+
+namespace osvr {
+namespace client {
+    InterfaceCore::InterfaceCore(ClientContext *ctx, std::string const &path)
+        : m_ctx(ctx), m_path(path), m_reportCount(0), m_lostReports(0),
+          m_reorderedReports(0) {}
+
+    bool InterfaceCore::getPredictedPoseState(
+        util::time::TimeValue const &target, OSVR_PoseState &state) const {
+        return m_publishedPredictor.load().predict(target, state);
+    }
+
+    void InterfaceCore::addHandle(ClientInterface *handle) {
+        m_handles.push_back(handle);
+        updateHistoryCapacity();
+    }
+
+    void InterfaceCore::removeHandle(ClientInterface *handle) {
+        m_handles.erase(
+            std::remove(begin(m_handles), end(m_handles), handle),
+            end(m_handles));
+        updateHistoryCapacity();
+    }
+
+    void InterfaceCore::updateHistoryCapacity() {
+        std::size_t capacity = 0;
+        for (auto const &handle : m_handles) {
+            capacity = (std::max)(capacity, handle->getHistoryCapacity());
+        }
+        HistoryLock lock(m_historyMutex);
+        m_history.setCapacity(capacity);
+    }
+
+    void InterfaceCore::update() {}
+
+    OSVR_TimeValue
+    InterfaceCore::m_toClientTime(OSVR_TimeValue const &timestamp) const {
+        return m_ctx->toClientTime(timestamp);
+    }
+
+    void InterfaceCore::m_noteReport() {
+        ++m_reportCount;
+        m_ctx->noteReport();
+    }
+} // namespace client
+} // namespace osvr
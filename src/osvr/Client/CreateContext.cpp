@@ -26,19 +26,37 @@
 #include <osvr/Client/CreateContext.h>
 #include "VRPNContext.h"
 #include "PureClientContext.h"
+#include "UnixSocketContext.h"
+#include "InProcessContext.h"
+#include "SharedMemoryContext.h"
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/GetEnvironmentVariable.h>
+#include <osvr/Common/UnixSocketPath.h>
+#include <osvr/Common/InProcessReportHub.h>
+#include <osvr/Common/SharedMemoryReportRings.h>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
 #include <cstring>
+#include <string>
 
 static const char PATHTREE_ENV_VAR[] = "OSVR_PATHTREE";
 
 namespace osvr {
 namespace client {
+    /// @brief If the host string starts with the prefix, puts the rest of it
+    /// in rest and returns true.
+    static inline bool hostHasPrefix(const char host[], const char prefix[],
+                                     std::string &rest) {
+        const std::size_t len = std::strlen(prefix);
+        if (!host || std::strncmp(host, prefix, len) != 0) {
+            return false;
+        }
+        rest = host + len;
+        return true;
+    }
 
     ClientContext *createContext(const char appId[], const char host[]) {
         ClientContext *ret = nullptr;
@@ -48,7 +66,29 @@ namespace client {
             return ret;
         }
 
-        if (common::getEnvironmentVariable(PATHTREE_ENV_VAR).is_initialized()) {
+        std::string rest;
+        if (hostHasPrefix(host, common::getInProcessHostPrefix(), rest)) {
+            ret = new InProcessContext(appId, rest);
+        } else if (hostHasPrefix(host, common::getSharedMemoryHostPrefix(),
+                                 rest)) {
+            if (rest.empty()) {
+                rest = common::getDefaultSharedMemoryName();
+            }
+            ret = new SharedMemoryContext(appId, rest);
+        } else if (hostHasPrefix(host, common::getUnixSocketHostPrefix(),
+                                 rest)) {
+            if (rest.empty()) {
+                rest = common::getDefaultUnixSocketPath();
+            }
+#ifdef OSVR_HAVE_UNIX_SOCKETS
+            ret = new UnixSocketContext(appId, rest);
+#else
+            OSVR_DEV_VERBOSE("Unix domain sockets are not supported on this "
+                             "platform, connecting to localhost instead.");
+            ret = new VRPNContext(appId);
+#endif
+        } else if (common::getEnvironmentVariable(PATHTREE_ENV_VAR)
+                       .is_initialized()) {
             // that environment variable has something in it - turn on testing.
             OSVR_DEV_VERBOSE("Caution: creating experimental PureClientContext "
                              "using PathTree!");
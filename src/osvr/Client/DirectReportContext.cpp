@@ -0,0 +1,118 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DirectReportContext.h"
+#include "DirectRouter.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace client {
+    DirectReportContext::DirectReportContext(const char appId[])
+        : VRPNContext(appId, "localhost"), m_dispatchDirty(true) {}
+
+    void DirectReportContext::m_handlePacket(
+        common::DirectReportPacket const &packet) {
+        const uint32_t device = packet.getDevice();
+        if (packet.getKind() == common::DirectReportPacket::DEVICE_NAME) {
+            m_setDeviceName(device, packet.getDeviceName());
+            return;
+        }
+        if (device >= m_deviceNames.size() || m_deviceNames[device].empty()) {
+            std::string name;
+            if (!m_lookUpDeviceName(device, name)) {
+                return;
+            }
+            m_setDeviceName(device, name);
+        }
+        m_updateDispatch();
+        if (device >= m_routersByDevice.size()) {
+            return;
+        }
+        for (auto router : m_routersByDevice[device]) {
+            router->handle(packet);
+        }
+    }
+
+    void DirectReportContext::m_forgetDevices() {
+        m_deviceNames.clear();
+        m_dispatchDirty = true;
+        /// The server numbers reports afresh, too.
+        for (auto router : m_directRouters) {
+            router->resetSequence();
+        }
+    }
+
+    bool DirectReportContext::m_lookUpDeviceName(uint32_t, std::string &) {
+        return false;
+    }
+
+    void DirectReportContext::m_setDeviceName(uint32_t device,
+                                              std::string const &name) {
+        if (device >= m_deviceNames.size()) {
+            m_deviceNames.resize(device + 1);
+        }
+        m_deviceNames[device] = name;
+        m_dispatchDirty = true;
+    }
+
+    RouterEntryPtr DirectReportContext::m_createDirectRouter(
+        common::DirectReportPacket::Kind kind, std::string const &device,
+        int sensor, std::string const &dest, common::Transform const &xform) {
+        DirectRouter *router =
+            new DirectRouter(this, dest, kind, device, sensor, xform);
+        RouterEntryPtr ret(router);
+        m_directRouters.push_back(router);
+        m_dispatchDirty = true;
+        return ret;
+    }
+
+    void DirectReportContext::m_clearDirectRouters() {
+        m_directRouters.clear();
+        m_routersByDevice.clear();
+        m_dispatchDirty = true;
+    }
+
+    void DirectReportContext::m_updateDispatch() {
+        if (!m_dispatchDirty) {
+            return;
+        }
+        m_dispatchDirty = false;
+        m_routersByDevice.assign(m_deviceNames.size(),
+                                 std::vector<DirectRouter *>());
+        for (std::size_t i = 0; i < m_deviceNames.size(); ++i) {
+            for (auto router : m_directRouters) {
+                if (router->getDevice() == m_deviceNames[i]) {
+                    m_routersByDevice[i].push_back(router);
+                }
+            }
+        }
+    }
+} // namespace client
+} // namespace osvr
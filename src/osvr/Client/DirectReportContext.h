@@ -0,0 +1,89 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DirectReportContext_h_GUID_94BA0109_4A7E_49AA_B509_461113CA800D
+#define INCLUDED_DirectReportContext_h_GUID_94BA0109_4A7E_49AA_B509_461113CA800D
+
+// Internal Includes
+#include "VRPNContext.h"
+#include <osvr/Common/DirectReportPacket.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace client {
+    class DirectRouter;
+
+    /// @brief Base for client contexts whose server sends device reports as
+    /// DirectReportPacket objects over some transport other than VRPN.
+    ///
+    /// Analog, button, and tracker reports from the server's own devices are
+    /// routed from the packets derived classes pass to m_handlePacket();
+    /// everything else uses the VRPN connection to the server on localhost,
+    /// as in VRPNContext.
+    class DirectReportContext : public VRPNContext {
+      protected:
+        explicit DirectReportContext(const char appId[]);
+
+        /// @brief Handles a packet received from the server.
+        void m_handlePacket(common::DirectReportPacket const &packet);
+
+        /// @brief Forgets device numbers, such as when disconnected, since
+        /// the server numbers devices afresh for each connection.
+        void m_forgetDevices();
+
+        /// @brief Finds the name of a device number no DEVICE_NAME packet
+        /// has been seen for, if the transport has another way to.
+        virtual bool m_lookUpDeviceName(uint32_t device, std::string &name);
+
+        virtual RouterEntryPtr
+        m_createDirectRouter(common::DirectReportPacket::Kind kind,
+                             std::string const &device, int sensor,
+                             std::string const &dest,
+                             common::Transform const &xform);
+        virtual void m_clearDirectRouters();
+
+      private:
+        void m_setDeviceName(uint32_t device, std::string const &name);
+
+        /// @brief Rebuilds m_routersByDevice if devices or routes changed.
+        void m_updateDispatch();
+
+        /// @brief Server device names, indexed by the number in packets.
+        std::vector<std::string> m_deviceNames;
+        /// @brief Routers owned by the base class's router list.
+        std::vector<DirectRouter *> m_directRouters;
+        /// @brief Routers for each device number.
+        std::vector<std::vector<DirectRouter *> > m_routersByDevice;
+        bool m_dispatchDirty;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_DirectReportContext_h_GUID_94BA0109_4A7E_49AA_B509_461113CA800D
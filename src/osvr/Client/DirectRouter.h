@@ -0,0 +1,175 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DirectRouter_h_GUID_AE8125DC_A1EB_4E4A_93BB_0E32F493EABF
+#define INCLUDED_DirectRouter_h_GUID_AE8125DC_A1EB_4E4A_93BB_0E32F493EABF
+
+// Internal Includes
+#include "VRPNContext.h"
+#include <osvr/Client/ClientContext.h>
+#include <osvr/Client/ClientInterface.h>
+#include <osvr/Client/InterfaceCore.h>
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/DirectReportPacket.h>
+#include <osvr/Util/ClientReportTypesC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace client {
+    /// @brief Routes reports received as DirectReportPacket objects, rather
+    /// than as VRPN messages, to a path: the counterpart of the VRPN*Router
+    /// classes.
+    ///
+    /// Does nothing when called: the context hands it packets as they
+    /// arrive.
+    class DirectRouter : public RouterEntry {
+      public:
+        typedef common::DirectReportPacket Packet;
+
+        /// @param sensor Sensor or channel to route, or -1 for all.
+        DirectRouter(ClientContext *ctx, std::string const &dest,
+                     Packet::Kind kind, std::string const &device, int sensor,
+                     common::Transform const &xform)
+            : RouterEntry(ctx, dest), m_kind(kind), m_device(device),
+              m_sensor(sensor), m_transform(xform) {}
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /// @brief Name of the device on the server reports come from.
+        std::string const &getDevice() const { return m_device; }
+
+        void operator()() {}
+
+        /// @brief Handles a packet from the device this routes from.
+        void handle(Packet const &packet) {
+            if (packet.getKind() == Packet::TRACKER_STATE &&
+                m_kind == Packet::TRACKER) {
+                if (m_checkSequence(packet.getSequence()) &&
+                    (m_sensor < 0 || m_sensor == packet.getSensor())) {
+                    m_routeTrackerState(packet.getTimestamp(),
+                                        packet.getSensor(),
+                                        packet.getTrackerState(), m_transform);
+                }
+                return;
+            }
+            if (packet.getKind() != m_kind ||
+                !m_checkSequence(packet.getSequence())) {
+                return;
+            }
+            switch (m_kind) {
+            case Packet::TRACKER:
+                if (m_sensor >= 0) {
+                    if (packet.hasSensor(m_sensor)) {
+                        m_handleTracker(packet, m_sensor);
+                    }
+                } else {
+                    const int32_t end =
+                        packet.getSensor() + int32_t(packet.getCount());
+                    for (int32_t i = packet.getSensor(); i < end; ++i) {
+                        m_handleTracker(packet, i);
+                    }
+                }
+                break;
+            case Packet::ANALOG:
+                if (packet.hasSensor(m_sensor)) {
+                    OSVR_AnalogReport report;
+                    report.sensor = m_sensor;
+                    report.state = packet.getAnalog(m_sensor);
+                    m_trigger(packet.getTimestamp(), report);
+                }
+                break;
+            case Packet::BUTTON:
+                if (m_sensor >= 0) {
+                    if (packet.hasSensor(m_sensor)) {
+                        m_handleButton(packet, m_sensor);
+                    }
+                } else {
+                    const int32_t end =
+                        packet.getSensor() + int32_t(packet.getCount());
+                    for (int32_t i = packet.getSensor(); i < end; ++i) {
+                        m_handleButton(packet, i);
+                    }
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+      private:
+        template <typename ReportType>
+        void m_trigger(OSVR_TimeValue const &timestamp,
+                       ReportType const &report) {
+            for (auto const &core : getContext()->getInterfaceCores()) {
+                if (core->getPath() == getDest()) {
+                    core->triggerCallbacks(timestamp, report);
+                }
+            }
+        }
+
+        void m_handleTracker(Packet const &packet, int32_t sensor) {
+            OSVR_PoseReport report;
+            report.sensor = sensor;
+            report.pose = packet.getPose(sensor);
+            m_transform.apply(report.pose);
+            m_trigger(packet.getTimestamp(), report);
+
+            /// Same heuristic as VRPNTrackerRouter for "do we have position
+            /// data?": "is our position non-zero?"
+            if (util::vecMap(report.pose.translation) !=
+                Eigen::Vector3d::Zero()) {
+                OSVR_PositionReport positionReport;
+                positionReport.sensor = report.sensor;
+                positionReport.xyz = report.pose.translation;
+                m_trigger(packet.getTimestamp(), positionReport);
+            }
+
+            OSVR_OrientationReport oriReport;
+            oriReport.sensor = report.sensor;
+            oriReport.rotation = report.pose.rotation;
+            m_trigger(packet.getTimestamp(), oriReport);
+        }
+
+        void m_handleButton(Packet const &packet, int32_t button) {
+            OSVR_ButtonReport report;
+            report.sensor = button;
+            report.state = packet.getButton(button);
+            m_trigger(packet.getTimestamp(), report);
+        }
+
+        Packet::Kind m_kind;
+        std::string const m_device;
+        int m_sensor;
+        common::CompiledTransform m_transform;
+    };
+
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_DirectRouter_h_GUID_AE8125DC_A1EB_4E4A_93BB_0E32F493EABF
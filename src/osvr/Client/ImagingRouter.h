@@ -94,9 +94,9 @@ namespace client {
             report.sensor = data.sensor;
             report.state.metadata = data.metadata;
             report.state.data = data.buffer.get();
-            for (auto const &iface : getContext()->getInterfaces()) {
-                if (iface->getPath() == getDest()) {
-                    iface->triggerCallbacks(timestamp, report);
+            for (auto const &core : getContext()->getInterfaceCores()) {
+                if (core->getPath() == getDest()) {
+                    core->triggerCallbacks(timestamp, report, data.buffer);
                 }
             }
             if (passData) {
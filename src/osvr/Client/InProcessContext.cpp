@@ -0,0 +1,69 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "InProcessContext.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace client {
+    InProcessContext::InProcessContext(const char appId[],
+                                       std::string const &hubName)
+        : DirectReportContext(appId),
+          m_hub(common::InProcessReportHub::get(hubName)),
+          m_queue(m_hub->subscribe()) {}
+
+    InProcessContext::~InProcessContext() {
+        stopNetworkThread();
+        m_hub->unsubscribe(m_queue);
+    }
+
+    void InProcessContext::m_update() {
+        m_receivePackets();
+        DirectReportContext::m_update();
+    }
+
+    void InProcessContext::m_waitForNetwork(uint64_t microseconds) {
+        if (m_hub->waitForPackets(*m_queue, microseconds)) {
+            m_receivePackets();
+        }
+    }
+
+    bool InProcessContext::m_lookUpDeviceName(uint32_t device,
+                                              std::string &name) {
+        return m_hub->getDeviceName(device, name);
+    }
+
+    void InProcessContext::m_receivePackets() {
+        while (m_queue->pop(m_packet)) {
+            m_handlePacket(m_packet);
+        }
+    }
+} // namespace client
+} // namespace osvr
@@ -0,0 +1,67 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InProcessContext_h_GUID_D0048BEB_E87E_41FB_878F_A55926196385
+#define INCLUDED_InProcessContext_h_GUID_D0048BEB_E87E_41FB_878F_A55926196385
+
+// Internal Includes
+#include "DirectReportContext.h"
+#include <osvr/Common/InProcessReportHub.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace client {
+    /// @brief Client context for a server in the same process, taking
+    /// device reports straight from the server's InProcessReportHub.
+    class InProcessContext : public DirectReportContext {
+      public:
+        /// @param hubName Name the server's hub was created with.
+        InProcessContext(const char appId[], std::string const &hubName);
+        virtual ~InProcessContext();
+
+      protected:
+        virtual void m_update();
+        /// @brief Waits on the queue, since that is where nearly all reports
+        /// arrive: VRPN messages are handled by the next update.
+        virtual void m_waitForNetwork(uint64_t microseconds);
+        /// @brief Asks the hub, for a device not announced in the queue.
+        virtual bool m_lookUpDeviceName(uint32_t device, std::string &name);
+
+      private:
+        /// @brief Handles every packet waiting in the queue.
+        void m_receivePackets();
+
+        common::InProcessReportHubPtr m_hub;
+        common::InProcessReportHub::QueuePtr m_queue;
+        common::DirectReportPacket m_packet;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_InProcessContext_h_GUID_D0048BEB_E87E_41FB_878F_A55926196385
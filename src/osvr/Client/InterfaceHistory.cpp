@@ -0,0 +1,65 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Client/InterfaceHistory.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace client {
+    void interpolateState(OSVR_PoseState const &a, OSVR_PoseState const &b,
+                          double t, OSVR_PoseState &out) {
+        interpolateState(a.translation, b.translation, t, out.translation);
+        interpolateState(a.rotation, b.rotation, t, out.rotation);
+    }
+
+    void interpolateState(OSVR_PositionState const &a,
+                          OSVR_PositionState const &b, double t,
+                          OSVR_PositionState &out) {
+        util::vecMap(out) = (1 - t) * util::vecMap(a) + t * util::vecMap(b);
+    }
+
+    void interpolateState(OSVR_OrientationState const &a,
+                          OSVR_OrientationState const &b, double t,
+                          OSVR_OrientationState &out) {
+        util::toQuat(util::fromQuat(a).slerp(t, util::fromQuat(b)), out);
+    }
+
+    void interpolateState(OSVR_ButtonState const &a, OSVR_ButtonState const &b,
+                          double t, OSVR_ButtonState &out) {
+        out = (t < 0.5) ? a : b;
+    }
+
+    void interpolateState(OSVR_AnalogState const &a, OSVR_AnalogState const &b,
+                          double t, OSVR_AnalogState &out) {
+        out = (1 - t) * a + t * b;
+    }
+} // namespace client
+} // namespace osvr
@@ -0,0 +1,151 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Client/PosePredictor.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace client {
+    /// @brief Weight given to the newest velocity sample.
+    static const double VELOCITY_SMOOTHING = 0.5;
+    /// @brief Gap between reports, in seconds, beyond which the velocity
+    /// estimate is considered stale.
+    static const double MAX_SAMPLE_GAP = 0.25;
+    /// @brief Limit on how far we extrapolate, in seconds.
+    static const double MAX_PREDICTION = 0.1;
+
+    double PosePredictor::maxPredictionSeconds() { return MAX_PREDICTION; }
+
+    PosePredictor::PosePredictor() : m_hasPose(false), m_hasVelocity(false) {
+        util::vecMap(m_linearVelocity) = Eigen::Vector3d::Zero();
+        util::vecMap(m_angularVelocity) = Eigen::Vector3d::Zero();
+    }
+
+    void PosePredictor::addSample(util::time::TimeValue const &timestamp,
+                                  OSVR_PoseState const &pose) {
+        if (!m_hasPose) {
+            m_hasPose = true;
+            m_timestamp = timestamp;
+            m_pose = pose;
+            return;
+        }
+
+        const double dt = util::time::duration(timestamp, m_timestamp);
+        if (dt <= 0) {
+            /// Out of order or duplicate timestamp: can't estimate from this,
+            /// but keep the pose if it's not older.
+            if (dt == 0) {
+                m_pose = pose;
+            }
+            return;
+        }
+
+        if (dt > MAX_SAMPLE_GAP) {
+            m_hasVelocity = false;
+        } else {
+            Eigen::Vector3d linVel = (util::vecMap(pose.translation) -
+                                      util::vecMap(m_pose.translation)) /
+                                     dt;
+
+            /// Rotation taking the old orientation to the new one, expressed
+            /// in the base frame.
+            Eigen::Quaterniond delta =
+                util::fromQuat(pose.rotation) *
+                util::fromQuat(m_pose.rotation).inverse();
+            /// Take the short way around.
+            if (delta.w() < 0) {
+                delta.coeffs() *= -1;
+            }
+            Eigen::AngleAxisd deltaAA(delta.normalized());
+            Eigen::Vector3d angVel = deltaAA.axis() * (deltaAA.angle() / dt);
+
+            if (m_hasVelocity) {
+                util::vecMap(m_linearVelocity) =
+                    VELOCITY_SMOOTHING * linVel +
+                    (1 - VELOCITY_SMOOTHING) * util::vecMap(m_linearVelocity);
+                util::vecMap(m_angularVelocity) =
+                    VELOCITY_SMOOTHING * angVel +
+                    (1 - VELOCITY_SMOOTHING) * util::vecMap(m_angularVelocity);
+            } else {
+                util::vecMap(m_linearVelocity) = linVel;
+                util::vecMap(m_angularVelocity) = angVel;
+                m_hasVelocity = true;
+            }
+        }
+        m_timestamp = timestamp;
+        m_pose = pose;
+    }
+
+    void PosePredictor::setVelocity(OSVR_Vec3 const *linear,
+                                    OSVR_Vec3 const *angular) {
+        if (!m_hasPose || (!linear && !angular)) {
+            return;
+        }
+        if (!m_hasVelocity) {
+            util::vecMap(m_linearVelocity) = Eigen::Vector3d::Zero();
+            util::vecMap(m_angularVelocity) = Eigen::Vector3d::Zero();
+            m_hasVelocity = true;
+        }
+        if (linear) {
+            m_linearVelocity = *linear;
+        }
+        if (angular) {
+            m_angularVelocity = *angular;
+        }
+    }
+
+    bool PosePredictor::predict(util::time::TimeValue const &target,
+                                OSVR_PoseState &pose) const {
+        if (!m_hasPose) {
+            return false;
+        }
+        pose = m_pose;
+        if (!m_hasVelocity) {
+            return true;
+        }
+        const double dt =
+            std::max(-MAX_PREDICTION,
+                     std::min(MAX_PREDICTION,
+                              util::time::duration(target, m_timestamp)));
+
+        util::vecMap(pose.translation) += util::vecMap(m_linearVelocity) * dt;
+
+        Eigen::Vector3d rotVec = util::vecMap(m_angularVelocity) * dt;
+        const double angle = rotVec.norm();
+        if (angle > 0) {
+            Eigen::Quaterniond rot(Eigen::AngleAxisd(angle, rotVec / angle));
+            util::toQuat((rot * util::fromQuat(m_pose.rotation)).normalized(),
+                         pose.rotation);
+        }
+        return true;
+    }
+} // namespace client
+} // namespace osvr
@@ -56,7 +56,7 @@ namespace client {
                 &VRPNContext::m_handleRoutingMessage, static_cast<void *>(this));
 #endif
     }
-    PureClientContext::~PureClientContext() {}
+    PureClientContext::~PureClientContext() { stopNetworkThread(); }
     void PureClientContext::m_setupDummyTree() {
         m_pathTree.getNodeByPath("/org_opengoggles_bundled_Multiserver",
                                  common::elements::PluginElement());
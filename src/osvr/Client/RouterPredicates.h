@@ -56,6 +56,8 @@ namespace client {
             return info.button == m_sensor;
         }
 
+        vrpn_int32 getSensor() const { return m_sensor; }
+
       private:
         vrpn_int32 m_sensor;
     };
@@ -63,6 +65,18 @@ namespace client {
       public:
         template <typename T> bool operator()(T const &) { return true; }
     };
+
+    /// @brief Gets the sensor a predicate passes reports from, or -1 if it
+    /// may pass reports from any sensor.
+    inline int getPredicateSensor(SensorPredicate const &pred) {
+        return pred.getSensor();
+    }
+
+    /// @overload
+    template <typename Predicate>
+    inline int getPredicateSensor(Predicate const &) {
+        return -1;
+    }
 } // namespace client
 } // namespace osvr
 
@@ -0,0 +1,161 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SharedMemoryContext.h"
+#include <osvr/Util/Microsleep.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace client {
+    SharedMemoryContext::SharedMemoryContext(const char appId[],
+                                             std::string const &name)
+        : DirectReportContext(appId), m_name(name) {
+        m_lastOpenAttempt.seconds = 0;
+        m_lastOpenAttempt.microseconds = 0;
+        m_openIfDue();
+    }
+
+    SharedMemoryContext::~SharedMemoryContext() { stopNetworkThread(); }
+
+    void SharedMemoryContext::m_update() {
+        m_openIfDue();
+        m_receivePackets();
+        DirectReportContext::m_update();
+    }
+
+    /// @brief Microseconds between checks of the region while waiting.
+    static const uint64_t REGION_POLL_TIME = 100;
+
+    void SharedMemoryContext::m_waitForNetwork(uint64_t microseconds) {
+        if (!m_rings) {
+            DirectReportContext::m_waitForNetwork(microseconds);
+            return;
+        }
+        util::time::TimeValue start;
+        util::time::getMonotonicNow(start);
+        while (!m_hasNewReports()) {
+            util::time::TimeValue now;
+            util::time::getMonotonicNow(now);
+            const double elapsed = util::time::duration(now, start) * 1.0e6;
+            if (elapsed >= microseconds) {
+                return;
+            }
+            util::time::microsleep(std::min(
+                REGION_POLL_TIME,
+                microseconds - static_cast<uint64_t>(elapsed)));
+        }
+        m_receivePackets();
+    }
+
+    /// @brief Seconds between attempts to open the server's region, and
+    /// between checks that an open region is still live.
+    static const double OPEN_RETRY_INTERVAL = 1.0;
+
+    /// @brief Seconds without a heartbeat after which the server that
+    /// created a region is taken to have crashed or hung.
+    static const double HEARTBEAT_TIMEOUT = 5.0;
+
+    void SharedMemoryContext::m_openIfDue() {
+        util::time::TimeValue now;
+        util::time::getMonotonicNow(now);
+        if (util::time::duration(now, m_lastOpenAttempt) <
+            OPEN_RETRY_INTERVAL) {
+            return;
+        }
+        m_lastOpenAttempt = now;
+        if (m_rings) {
+            if (m_rings->getHeartbeatAge() < HEARTBEAT_TIMEOUT) {
+                return;
+            }
+            /// A restarted server replaces the region, so the one we have
+            /// will never be written again.
+            OSVR_DEV_VERBOSE("Server stopped updating shared memory region "
+                             << m_name);
+            m_close();
+        }
+        m_rings = common::SharedMemoryReportRings::open(m_name);
+        if (m_rings && (m_rings->isClosed() ||
+                        m_rings->getHeartbeatAge() >= HEARTBEAT_TIMEOUT)) {
+            m_rings.reset();
+        }
+        if (m_rings) {
+            OSVR_DEV_VERBOSE("Opened shared memory region " << m_name);
+        }
+    }
+
+    void SharedMemoryContext::m_close() {
+        OSVR_DEV_VERBOSE("Shared memory region " << m_name << " closed");
+        m_rings.reset();
+        m_nextReport.clear();
+        m_forgetDevices();
+    }
+
+    bool SharedMemoryContext::m_hasNewReports() const {
+        if (m_rings->isClosed() ||
+            m_rings->getNumDevices() != m_nextReport.size()) {
+            return true;
+        }
+        for (std::size_t i = 0; i < m_nextReport.size(); ++i) {
+            if (m_rings->getWritten(uint32_t(i)) != m_nextReport[i]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void SharedMemoryContext::m_receivePackets() {
+        if (!m_rings) {
+            return;
+        }
+        if (m_rings->isClosed()) {
+            m_close();
+            return;
+        }
+        /// Start new devices at their latest report rather than replaying
+        /// the history in their rings.
+        const uint32_t numDevices = m_rings->getNumDevices();
+        for (uint32_t i = uint32_t(m_nextReport.size()); i < numDevices;
+             ++i) {
+            m_packet.setDeviceName(i, m_rings->getDeviceName(i));
+            m_handlePacket(m_packet);
+            const uint64_t written = m_rings->getWritten(i);
+            m_nextReport.push_back(written == 0 ? 0 : written - 1);
+        }
+        for (uint32_t i = 0; i < numDevices; ++i) {
+            m_nextReport[i] = m_rings->read(
+                i, m_nextReport[i],
+                [&](common::DirectReportPacket const &packet) {
+                    m_handlePacket(packet);
+                });
+        }
+    }
+} // namespace client
+} // namespace osvr
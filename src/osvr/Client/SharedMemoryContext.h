@@ -0,0 +1,84 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SharedMemoryContext_h_GUID_23FE145C_2F58_4A97_9AE9_24C22995A55D
+#define INCLUDED_SharedMemoryContext_h_GUID_23FE145C_2F58_4A97_9AE9_24C22995A55D
+
+// Internal Includes
+#include "DirectReportContext.h"
+#include <osvr/Common/SharedMemoryReportRings.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace client {
+    /// @brief Client context for a server on the same machine that publishes
+    /// device reports in shared memory.
+    ///
+    /// Analog, button, and tracker reports from the server's own devices are
+    /// read straight out of the server's SharedMemoryReportRings region,
+    /// without any system call; everything else uses the VRPN connection to
+    /// the server on localhost.
+    class SharedMemoryContext : public DirectReportContext {
+      public:
+        /// @param name Name of the server's shared memory region.
+        SharedMemoryContext(const char appId[], std::string const &name);
+        virtual ~SharedMemoryContext();
+
+      protected:
+        virtual void m_update();
+        /// @brief Polls the region, since that is where nearly all reports
+        /// arrive: VRPN messages are handled by the next update.
+        virtual void m_waitForNetwork(uint64_t microseconds);
+
+      private:
+        /// @brief Periodically opens the region if we have none, or drops it
+        /// if its server has stopped beating its heartbeat.
+        void m_openIfDue();
+        void m_close();
+        /// @brief Has the server added devices or written reports we haven't
+        /// read yet?
+        bool m_hasNewReports() const;
+        /// @brief Handles every report written since the last call.
+        void m_receivePackets();
+
+        std::string const m_name;
+        common::SharedMemoryReportRingsPtr m_rings;
+        /// @brief Monotonic time of the last attempt to open the region, or
+        /// check on it.
+        util::time::TimeValue m_lastOpenAttempt;
+        /// @brief Position to read each device's ring from next.
+        std::vector<uint64_t> m_nextReport;
+        common::DirectReportPacket m_packet;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_SharedMemoryContext_h_GUID_23FE145C_2F58_4A97_9AE9_24C22995A55D
@@ -0,0 +1,153 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "UnixSocketContext.h"
+#include <osvr/Common/UnixSocketPath.h>
+#include <osvr/Util/Verbosity.h>
+
+#ifdef OSVR_HAVE_UNIX_SOCKETS
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+namespace osvr {
+namespace client {
+    UnixSocketContext::UnixSocketContext(const char appId[],
+                                         std::string const &path)
+        : DirectReportContext(appId), m_path(path), m_socket(-1),
+          m_buffer(common::DirectReportPacket::maxSize()) {
+        m_lastConnectAttempt.seconds = 0;
+        m_lastConnectAttempt.microseconds = 0;
+        m_connectIfDue();
+    }
+
+    UnixSocketContext::~UnixSocketContext() {
+        stopNetworkThread();
+        m_disconnect();
+    }
+
+    void UnixSocketContext::m_update() {
+        m_connectIfDue();
+        m_receivePackets();
+        DirectReportContext::m_update();
+    }
+
+    void UnixSocketContext::m_waitForNetwork(uint64_t microseconds) {
+        if (m_socket < 0) {
+            DirectReportContext::m_waitForNetwork(microseconds);
+            return;
+        }
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(m_socket, &readfds);
+        struct timeval timeout;
+        timeout.tv_sec = static_cast<long>(microseconds / 1000000);
+        timeout.tv_usec = static_cast<long>(microseconds % 1000000);
+        if (select(m_socket + 1, &readfds, nullptr, nullptr, &timeout) > 0) {
+            m_receivePackets();
+        }
+    }
+
+    /// @brief Seconds between attempts to connect to the server's socket.
+    static const double CONNECT_RETRY_INTERVAL = 1.0;
+
+    void UnixSocketContext::m_connectIfDue() {
+        if (m_socket >= 0) {
+            return;
+        }
+        util::time::TimeValue now;
+        util::time::getMonotonicNow(now);
+        if (util::time::duration(now, m_lastConnectAttempt) <
+            CONNECT_RETRY_INTERVAL) {
+            return;
+        }
+        m_lastConnectAttempt = now;
+
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (m_path.size() >= sizeof(addr.sun_path)) {
+            OSVR_DEV_VERBOSE("Unix domain socket path too long: " << m_path);
+            return;
+        }
+        std::strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        int sock = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+        if (sock < 0) {
+            return;
+        }
+        if (connect(sock, reinterpret_cast<sockaddr *>(&addr),
+                    sizeof(addr)) != 0) {
+            close(sock);
+            return;
+        }
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+        m_socket = sock;
+        OSVR_DEV_VERBOSE("Connected to Unix domain socket " << m_path);
+    }
+
+    void UnixSocketContext::m_disconnect() {
+        if (m_socket < 0) {
+            return;
+        }
+        close(m_socket);
+        m_socket = -1;
+        m_forgetDevices();
+    }
+
+    void UnixSocketContext::m_receivePackets() {
+        while (m_socket >= 0) {
+            auto ret = recv(m_socket, m_buffer.data(), m_buffer.size(), 0);
+            if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return;
+            }
+            if (ret <= 0) {
+                OSVR_DEV_VERBOSE("Lost Unix domain socket connection to "
+                                 << m_path);
+                m_disconnect();
+                return;
+            }
+            if (!m_packet.assign(m_buffer.data(), std::size_t(ret))) {
+                OSVR_DEV_VERBOSE("Dropping malformed packet from Unix domain "
+                                 "socket.");
+                continue;
+            }
+            m_handlePacket(m_packet);
+        }
+    }
+} // namespace client
+} // namespace osvr
+
+#endif // OSVR_HAVE_UNIX_SOCKETS
@@ -0,0 +1,76 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_UnixSocketContext_h_GUID_74180B67_5CFB_4197_871E_508CE7D021B4
+#define INCLUDED_UnixSocketContext_h_GUID_74180B67_5CFB_4197_871E_508CE7D021B4
+
+// Internal Includes
+#include "DirectReportContext.h"
+#include <osvr/Common/DirectReportPacket.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace client {
+    /// @brief Client context for a server on the same machine that sends
+    /// device reports over a Unix domain socket.
+    ///
+    /// Analog, button, and tracker reports from the server's own devices
+    /// arrive on the socket; everything else uses the VRPN connection to the
+    /// server on localhost.
+    class UnixSocketContext : public DirectReportContext {
+      public:
+        /// @param path Filesystem path of the server's socket.
+        UnixSocketContext(const char appId[], std::string const &path);
+        virtual ~UnixSocketContext();
+
+      protected:
+        virtual void m_update();
+        /// @brief Blocks on the socket, since that is where nearly all
+        /// traffic arrives: VRPN messages are handled by the next update.
+        virtual void m_waitForNetwork(uint64_t microseconds);
+
+      private:
+        void m_connectIfDue();
+        void m_disconnect();
+        /// @brief Handles every packet waiting on the socket.
+        void m_receivePackets();
+
+        std::string const m_path;
+        int m_socket;
+        /// @brief Monotonic time of the last connection attempt.
+        util::time::TimeValue m_lastConnectAttempt;
+        std::vector<char> m_buffer;
+        common::DirectReportPacket m_packet;
+    };
+} // namespace client
+} // namespace osvr
+
+#endif // INCLUDED_UnixSocketContext_h_GUID_74180B67_5CFB_4197_871E_508CE7D021B4
@@ -26,13 +26,15 @@
 #define INCLUDED_VRPNAnalogRouter_h_GUID_8247EACD_6ABF_4A87_59B8_AFD0722078A6
 
 // Internal Includes
-// - none
+#include <osvr/Common/AnalogFrameMessage.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
 
 // Library/third-party includes
 #include <vrpn_Analog.h>
 
 // Standard includes
-// - none
+#include <string>
 
 namespace osvr {
 namespace client {
@@ -44,37 +46,132 @@ namespace client {
                          Transform t, int channel)
             : RouterEntry(ctx, dest), m_channel(channel),
               m_remote(new vrpn_Analog_Remote(src, conn.get())), m_pred(p),
-              m_transform(t), m_conn(conn) {
-            m_remote->register_change_handler(this, &VRPNAnalogRouter::handle);
+              m_transform(t), m_conn(conn), m_messageType(0),
+              m_frameMessageType(0), m_sender(0) {
             m_remote->shutup = true;
+            /// Handle the messages directly, rather than through the remote's
+            /// callback, to get at the sequence number they carry.
+            vrpn_Connection *remoteConn = m_remote->connectionPtr();
+            if (remoteConn) {
+                const std::string name(src);
+                m_messageType =
+                    remoteConn->register_message_type("vrpn_Analog Channel");
+                m_sender = remoteConn->register_sender(
+                    name.substr(0, name.find('@')).c_str());
+                remoteConn->register_handler(m_messageType,
+                                             &VRPNAnalogRouter::handleMessage,
+                                             this, m_sender);
+                m_frameMessageType = remoteConn->register_message_type(
+                    common::AnalogFrameMessage::identifier());
+                remoteConn->register_handler(m_frameMessageType,
+                                             &VRPNAnalogRouter::handleFrame,
+                                             this, m_sender);
+            }
+        }
+
+        virtual ~VRPNAnalogRouter() {
+            vrpn_Connection *remoteConn = m_remote->connectionPtr();
+            if (remoteConn) {
+                remoteConn->unregister_handler(
+                    m_messageType, &VRPNAnalogRouter::handleMessage, this,
+                    m_sender);
+                remoteConn->unregister_handler(m_frameMessageType,
+                                               &VRPNAnalogRouter::handleFrame,
+                                               this, m_sender);
+            }
+        }
+
+        /// @brief Decodes a VRPN analog channel message: the channel count
+        /// and values, followed by a sequence number from OSVR servers.
+        static int VRPN_CALLBACK handleMessage(void *userdata,
+                                               vrpn_HANDLERPARAM p) {
+            VRPNAnalogRouter *self = static_cast<VRPNAnalogRouter *>(userdata);
+            auto bufwrap = common::ExternalBufferReadingWrapper<unsigned char>(
+                reinterpret_cast<unsigned char const *>(p.buffer),
+                p.payload_len);
+            auto reader = common::BufferReader<decltype(bufwrap)>(bufwrap);
+            if (reader.bytesRemaining() < sizeof(vrpn_float64)) {
+                return 0;
+            }
+            vrpn_ANALOGCB info;
+            info.msg_time = p.msg_time;
+            vrpn_float64 numChannels;
+            common::serialization::deserializeRaw(reader, numChannels);
+            info.num_channel = vrpn_int32(numChannels);
+            if (info.num_channel < 0 || info.num_channel > vrpn_CHANNEL_MAX ||
+                reader.bytesRemaining() <
+                    info.num_channel * sizeof(vrpn_float64)) {
+                return 0;
+            }
+            for (vrpn_int32 i = 0; i < info.num_channel; ++i) {
+                common::serialization::deserializeRaw(reader, info.channel[i]);
+            }
+            uint32_t sequence;
+            if (reader.bytesRemaining() >= sizeof(sequence)) {
+                common::serialization::deserializeRaw(reader, sequence);
+                if (!self->m_checkSequence(sequence)) {
+                    return 0;
+                }
+            }
+            handle(self, info);
+            return 0;
         }
 
-        static void VRPN_CALLBACK handle(void *userdata, vrpn_ANALOGCB info) {
+        /// @brief Decodes an AnalogFrameMessage, from devices with more
+        /// channels than VRPN messages carry or using a compact encoding.
+        ///
+        /// Whether the frame carries the channel stands in for the
+        /// predicate, which only deals in VRPN's own reports.
+        static int VRPN_CALLBACK handleFrame(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
             VRPNAnalogRouter *self = static_cast<VRPNAnalogRouter *>(userdata);
+            common::AnalogFrameMessage frame(p.buffer,
+                                             std::size_t(p.payload_len));
+            if (!frame.isValid() ||
+                !self->m_checkSequence(frame.getSequence())) {
+                return 0;
+            }
+            OSVR_AnalogState state;
+            if (frame.getValue(self->m_channel, state)) {
+                OSVR_TimeValue timestamp;
+                osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+                self->m_handle(timestamp, state);
+            }
+            return 0;
+        }
+
+        static void handle(VRPNAnalogRouter *self, vrpn_ANALOGCB const &info) {
             if (self->m_pred(info)) {
                 OSVR_TimeValue timestamp;
                 osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+                self->m_handle(timestamp, info.channel[self->m_channel]);
+            }
+        }
+        void operator()() { m_remote->mainloop(); }
 
-                OSVR_AnalogReport report;
-                report.sensor = self->m_channel;
-                report.state = info.channel[self->m_channel];
-                self->m_transform(report);
+      private:
+        void m_handle(OSVR_TimeValue const &timestamp,
+                      OSVR_AnalogState state) {
+            OSVR_AnalogReport report;
+            report.sensor = m_channel;
+            report.state = state;
+            m_transform(report);
 
-                for (auto const &iface : self->getContext()->getInterfaces()) {
-                    if (iface->getPath() == self->getDest()) {
-                        iface->triggerCallbacks(timestamp, report);
-                    }
+            for (auto const &core : getContext()->getInterfaceCores()) {
+                if (core->getPath() == getDest()) {
+                    core->triggerCallbacks(timestamp, report);
                 }
             }
         }
-        void operator()() { m_remote->mainloop(); }
 
-      private:
         int m_channel;
         unique_ptr<vrpn_Analog_Remote> m_remote;
         Predicate m_pred;
         Transform m_transform;
         vrpn_ConnectionPtr m_conn;
+        vrpn_int32 m_messageType;
+        vrpn_int32 m_frameMessageType;
+        vrpn_int32 m_sender;
     };
 
 } // namespace client
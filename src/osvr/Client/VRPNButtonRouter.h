@@ -55,9 +55,10 @@ namespace client {
                 report.state = static_cast<uint8_t>(info.state);
                 OSVR_TimeValue timestamp;
                 osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-                for (auto const &iface : self->getContext()->getInterfaces()) {
-                    if (iface->getPath() == self->getDest()) {
-                        iface->triggerCallbacks(timestamp, report);
+                for (auto const &core :
+                     self->getContext()->getInterfaceCores()) {
+                    if (core->getPath() == self->getDest()) {
+                        core->triggerCallbacks(timestamp, report);
                     }
                 }
             }
@@ -33,6 +33,7 @@
 #include <osvr/Util/ClientCallbackTypesC.h>
 #include <osvr/Client/ClientContext.h>
 #include <osvr/Client/ClientInterface.h>
+#include <osvr/Client/InterfaceCore.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/JSONTransformVisitor.h>
 #include <osvr/Common/ChangeOfBasis.h>
@@ -51,13 +52,104 @@
 
 // Standard includes
 #include <cstring>
+#include <algorithm>
+#include <random>
+#include <sstream>
 
 namespace osvr {
 namespace client {
     RouterEntry::~RouterEntry() {}
 
+    bool RouterEntry::m_checkSequence(uint32_t sequence) {
+        const uint64_t lost = m_sequence.getLost();
+        const uint64_t reordered = m_sequence.getReordered();
+        const bool ret = m_sequence.check(sequence);
+        const int64_t lostChange = int64_t(m_sequence.getLost() - lost);
+        const uint64_t reorderedChange = m_sequence.getReordered() - reordered;
+        if (lostChange != 0 || reorderedChange != 0) {
+            for (auto const &core : getContext()->getInterfaceCores()) {
+                if (core->getPath() == getDest()) {
+                    core->addSequenceStats(lostChange, reorderedChange);
+                }
+            }
+        }
+        return ret;
+    }
+
+    void RouterEntry::m_routeTrackerState(
+        OSVR_TimeValue const &timestamp, int32_t sensor,
+        OSVR_TrackerState const &state,
+        common::CompiledTransform const &xform) {
+        const bool hasPosition =
+            (state.flags & OSVR_TRACKER_POSITION_VALID) != 0;
+        const bool hasOrientation =
+            (state.flags & OSVR_TRACKER_ORIENTATION_VALID) != 0;
+        if (!hasPosition && !hasOrientation) {
+            return;
+        }
+        OSVR_PoseReport report;
+        report.sensor = sensor;
+        report.pose = state.pose;
+        xform.apply(report.pose);
+
+        OSVR_Vec3 linear = state.linearVelocity;
+        OSVR_Vec3 angular = state.angularVelocity;
+        OSVR_Vec3 *linearPtr =
+            (state.flags & OSVR_TRACKER_LINEAR_VELOCITY_VALID) ? &linear
+                                                               : nullptr;
+        OSVR_Vec3 *angularPtr =
+            (state.flags & OSVR_TRACKER_ANGULAR_VELOCITY_VALID) ? &angular
+                                                                : nullptr;
+        const bool hasVelocity =
+            (linearPtr || angularPtr) &&
+            xform.applyToVelocity(state.pose.rotation, linearPtr, angularPtr);
+
+        for (auto const &core : getContext()->getInterfaceCores()) {
+            if (core->getPath() != getDest()) {
+                continue;
+            }
+            core->triggerCallbacks(timestamp, report);
+            if (hasPosition) {
+                OSVR_PositionReport positionReport;
+                positionReport.sensor = sensor;
+                positionReport.xyz = report.pose.translation;
+                core->triggerCallbacks(timestamp, positionReport);
+            }
+            if (hasOrientation) {
+                OSVR_OrientationReport oriReport;
+                oriReport.sensor = sensor;
+                oriReport.rotation = report.pose.rotation;
+                core->triggerCallbacks(timestamp, oriReport);
+            }
+            if (hasVelocity) {
+                core->setReportedVelocity(linearPtr, angularPtr);
+            }
+        }
+    }
+
+    /// @brief Makes an identifier for a client context, unique with high
+    /// probability.
+    static inline std::string makeClientId(const char appId[]) {
+        std::random_device rd;
+        std::ostringstream os;
+        os << appId << "/" << std::hex << rd() << rd();
+        return os.str();
+    }
+
+    /// @brief Makes an identifier for a VRPN connection, the same for every
+    /// client context in this process using it, and unique with high
+    /// probability.
+    static inline std::string makeConnectionId(vrpn_Connection *conn) {
+        static const std::string process = makeClientId("process");
+        std::ostringstream os;
+        os << process << "/" << static_cast<void *>(conn);
+        return os.str();
+    }
+
     VRPNContext::VRPNContext(const char appId[], const char host[])
-        : ::OSVR_ClientContextObject(appId), m_host(host) {
+        : ::OSVR_ClientContextObject(appId), m_host(host),
+          m_clientId(makeClientId(appId)), m_routesChanged(true),
+          m_subscribedGeneration(0) {
 
         std::string sysDeviceName =
             std::string(common::SystemComponent::deviceName()) + "@" + m_host;
@@ -66,6 +158,15 @@ namespace client {
             vrpn_get_connection_by_name(sysDeviceName.c_str(), nullptr, nullptr,
                                         nullptr, nullptr, nullptr, true);
         m_conn->removeReference(); // Remove extra reference.
+        m_connectionId = makeConnectionId(m_conn.get());
+        m_conn->register_handler(
+            m_conn->register_message_type(vrpn_got_connection),
+            &VRPNContext::m_handleConnectionChange, static_cast<void *>(this),
+            vrpn_ANY_SENDER);
+        m_conn->register_handler(
+            m_conn->register_message_type(vrpn_dropped_connection),
+            &VRPNContext::m_handleConnectionChange, static_cast<void *>(this),
+            vrpn_ANY_SENDER);
 
         /// Create the system client device.
         m_systemDevice = common::createClientDevice(sysDeviceName, m_conn);
@@ -73,12 +174,21 @@ namespace client {
             m_systemDevice->addComponent(common::SystemComponent::create());
         m_systemComponent->registerRoutesHandler(
             &VRPNContext::m_handleRoutingMessage, static_cast<void *>(this));
+        m_systemComponent->registerClockPongHandler(
+            [this](common::ClockSyncTimestamps const &timestamps,
+                util::time::TimeValue const &received) {
+                m_clockOffset.addResponse(timestamps, received);
+            });
+        m_lastClockPing.seconds = 0;
+        m_lastClockPing.microseconds = 0;
+        m_lastSubscriptions.seconds = 0;
+        m_lastSubscriptions.microseconds = 0;
 
         setParameter("/display",
                      std::string(display_json, sizeof(display_json)));
     }
 
-    VRPNContext::~VRPNContext() {}
+    VRPNContext::~VRPNContext() { stopNetworkThread(); }
 
     int VRPNContext::m_handleRoutingMessage(void *userdata,
                                             vrpn_HANDLERPARAM p) {
@@ -89,13 +199,31 @@ namespace client {
         return 0;
     }
 
+    int VRPNContext::m_handleConnectionChange(void *userdata,
+                                              vrpn_HANDLERPARAM) {
+        VRPNContext *self = static_cast<VRPNContext *>(userdata);
+        OSVR_DEV_VERBOSE("Connection to the server changed: resetting the "
+                         "clock offset and the sequence numbers of "
+                         << self->m_routers.size() << " routes.");
+        for (auto const &router : self->m_routers) {
+            router->resetSequence();
+        }
+        /// A new server has its own clock: ping it again right away.
+        self->m_clockOffset.reset();
+        self->m_lastClockPing.seconds = 0;
+        self->m_lastClockPing.microseconds = 0;
+        return 0;
+    }
+
     void
     VRPNContext::m_replaceRoutes(common::RouteContainer const &newDirectives) {
         OSVR_DEV_VERBOSE("Replacing routing directives: had "
                          << m_routingDirectives.size() << ", received "
                          << newDirectives.size());
 
+        m_clearDirectRouters();
         m_routers.clear();
+        m_routesChanged = true;
         m_routingDirectives = newDirectives;
         Json::Reader reader;
         for (auto const &routeString : newDirectives.getRouteList()) {
@@ -185,8 +313,8 @@ namespace client {
             return;
         }
 
-        std::string deviceName =
-            components[0] + "/" + components[1] + "@" + m_host;
+        std::string const source = components[0] + "/" + components[1];
+        std::string deviceName = source + "@" + m_host;
         std::reverse(begin(components), end(components));
         components.pop_back();
         components.pop_back();
@@ -197,6 +325,7 @@ namespace client {
             OSVR_DEV_VERBOSE("Adding imaging route for " << dest);
             m_routers.emplace_back(
                 new ImagingRouter(this, m_conn, deviceName, components, dest));
+            m_routers.back()->setSource(common::SourceSubscription(source));
         } else {
             OSVR_DEV_VERBOSE(
                 "Could not handle route message for interface type "
@@ -214,6 +343,8 @@ namespace client {
         m_conn->mainloop();
         // Mainloop the system device
         m_systemDevice->update();
+        m_pingClockIfDue();
+        m_sendSubscriptionsIfDue();
 
         // Process each of the routers.
         for (auto const &p : m_routers) {
@@ -221,22 +352,124 @@ namespace client {
         }
     }
 
+    void VRPNContext::m_waitForNetwork(uint64_t microseconds) {
+        if (!m_conn->connected()) {
+            /// Nothing to block on yet.
+            ::OSVR_ClientContextObject::m_waitForNetwork(microseconds);
+            return;
+        }
+        struct timeval timeout;
+        timeout.tv_sec = static_cast<long>(microseconds / 1000000);
+        timeout.tv_usec = static_cast<long>(microseconds % 1000000);
+        /// Blocks in select() until a message arrives or the timeout expires,
+        /// then handles whatever arrived.
+        m_conn->mainloop(&timeout);
+    }
+
+    /// @brief Seconds between clock pings once we have an offset estimate.
+    static const double CLOCK_PING_INTERVAL = 1.0;
+    /// @brief Seconds between clock pings until we have an offset estimate.
+    static const double CLOCK_PING_INTERVAL_INITIAL = 0.1;
+
+    void VRPNContext::m_pingClockIfDue() {
+        if (!m_conn->connected()) {
+            return;
+        }
+        util::time::TimeValue now;
+        util::time::getMonotonicNow(now);
+        const double interval = m_clockOffset.hasEstimate()
+                                    ? CLOCK_PING_INTERVAL
+                                    : CLOCK_PING_INTERVAL_INITIAL;
+        if (util::time::duration(now, m_lastClockPing) < interval) {
+            return;
+        }
+        m_lastClockPing = now;
+        util::time::TimeValue sent;
+        util::time::getSteadyNow(sent);
+        m_systemComponent->sendClockPing(m_clockOffset.startExchange(sent),
+                                         sent);
+    }
+
+    /// @brief Seconds between re-sending unchanged subscriptions, keeping
+    /// them from expiring on the server.
+    static const double SUBSCRIPTION_REFRESH_INTERVAL = 1.0;
+
+    void VRPNContext::m_sendSubscriptionsIfDue() {
+        if (!m_conn->connected()) {
+            return;
+        }
+        util::time::TimeValue now;
+        util::time::getMonotonicNow(now);
+        const uint64_t generation = m_getInterfaceCoreGeneration();
+        if (!m_routesChanged && generation == m_subscribedGeneration &&
+            util::time::duration(now, m_lastSubscriptions) <
+                SUBSCRIPTION_REFRESH_INTERVAL) {
+            return;
+        }
+        m_routesChanged = false;
+        m_subscribedGeneration = generation;
+        m_lastSubscriptions = now;
+
+        /// Subscribe to the sources of routes to paths with interfaces open.
+        common::SourceSubscriptionList sources;
+        auto const &cores = getInterfaceCores();
+        for (auto const &router : m_routers) {
+            if (router->getSource().device.empty()) {
+                continue;
+            }
+            auto const &dest = router->getDest();
+            if (std::any_of(begin(cores), end(cores),
+                            [&](InterfaceCorePtr const &core) {
+                                return core->getPath() == dest;
+                            })) {
+                sources.push_back(router->getSource());
+            }
+        }
+        m_systemComponent->sendClientSubscriptions(m_clientId, m_connectionId,
+                                                   sources);
+    }
+
+    RouterEntryPtr VRPNContext::m_createDirectRouter(
+        common::DirectReportPacket::Kind, std::string const &, int,
+        std::string const &, common::Transform const &) {
+        return RouterEntryPtr();
+    }
+
+    void VRPNContext::m_clearDirectRouters() {}
+
     void VRPNContext::m_addAnalogRouter(const char *src, const char *dest,
                                         int channel) {
         OSVR_DEV_VERBOSE("Adding analog route for " << dest);
 
-        m_routers.emplace_back(
-            new VRPNAnalogRouter<SensorPredicate, NullTransform>(
-                this, m_conn, (src + ("@" + m_host)).c_str(), dest,
-                SensorPredicate(channel), NullTransform(), channel));
+        RouterEntryPtr direct =
+            m_createDirectRouter(common::DirectReportPacket::ANALOG, src,
+                                 channel, dest, common::Transform());
+        if (direct) {
+            m_routers.push_back(std::move(direct));
+        } else {
+            m_routers.emplace_back(
+                new VRPNAnalogRouter<SensorPredicate, NullTransform>(
+                    this, m_conn, (src + ("@" + m_host)).c_str(), dest,
+                    SensorPredicate(channel), NullTransform(), channel));
+        }
+        m_routers.back()->setSource(common::SourceSubscription(src, channel));
     }
 
     template <typename Predicate>
     void VRPNContext::m_addButtonRouter(const char *src, const char *dest,
                                         Predicate pred) {
         OSVR_DEV_VERBOSE("Adding button route for " << dest);
-        m_routers.emplace_back(new VRPNButtonRouter<Predicate>(
-            this, m_conn, (src + ("@" + m_host)).c_str(), dest, pred));
+        const int sensor = getPredicateSensor(pred);
+        RouterEntryPtr direct =
+            m_createDirectRouter(common::DirectReportPacket::BUTTON, src,
+                                 sensor, dest, common::Transform());
+        if (direct) {
+            m_routers.push_back(std::move(direct));
+        } else {
+            m_routers.emplace_back(new VRPNButtonRouter<Predicate>(
+                this, m_conn, (src + ("@" + m_host)).c_str(), dest, pred));
+        }
+        m_routers.back()->setSource(common::SourceSubscription(src, sensor));
     }
 
     void VRPNContext::m_addTrackerRouter(const char *src, const char *dest,
@@ -252,9 +485,20 @@ namespace client {
                 this, vrpn_ConnectionPtr(), src, sensor, dest, xform));
         } else {
             // No @: assume to be at the same location as the context.
-            m_routers.emplace_back(new VRPNTrackerRouter(
-                this, m_conn, (src + ("@" + m_host)).c_str(), sensor, dest,
-                xform));
+            const int sensorOrAll =
+                sensor.get_value_or(common::SourceSubscription::ALL_SENSORS);
+            RouterEntryPtr direct =
+                m_createDirectRouter(common::DirectReportPacket::TRACKER,
+                                     source, sensorOrAll, dest, xform);
+            if (direct) {
+                m_routers.push_back(std::move(direct));
+            } else {
+                m_routers.emplace_back(new VRPNTrackerRouter(
+                    this, m_conn, (src + ("@" + m_host)).c_str(), sensor,
+                    dest, xform));
+            }
+            m_routers.back()->setSource(
+                common::SourceSubscription(source, sensorOrAll));
         }
     }
 
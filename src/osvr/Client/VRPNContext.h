@@ -28,10 +28,16 @@
 // Internal Includes
 #include <osvr/Client/ClientContext.h>
 #include <osvr/Common/Transform.h>
+#include <osvr/Common/CompiledTransform.h>
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Common/BaseDevicePtr.h>
 #include <osvr/Common/SystemComponent_fwd.h>
 #include <osvr/Common/RouteContainer.h>
+#include <osvr/Common/SourceSubscription.h>
+#include <osvr/Common/DirectReportPacket.h>
+#include <osvr/Common/ReportSequence.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/TrackerStateC.h>
 
 // Library/third-party includes
 #include <vrpn_ConnectionPtr.h>
@@ -51,13 +57,43 @@ namespace client {
         virtual ~RouterEntry();
         virtual void operator()() = 0;
 
+        /// @brief The device on the server this route reads from, if any:
+        /// device is empty for sources on other hosts.
+        common::SourceSubscription const &getSource() const {
+            return m_source;
+        }
+        void setSource(common::SourceSubscription const &source) {
+            m_source = source;
+        }
+
+        /// @brief Forgets the sequence numbers seen so far, such as when
+        /// the server may have restarted.
+        void resetSequence() { m_sequence.reset(); }
+
       protected:
         RouterEntry(ClientContext *ctx, std::string const &dest)
             : m_ctx(ctx), m_dest(dest) {}
 
+        /// @brief Checks the sequence number of a report from the server,
+        /// adding any loss or reordering to the stats of the interfaces on
+        /// the destination path.
+        ///
+        /// @returns false if the report is older than one already routed,
+        /// and should be discarded.
+        bool m_checkSequence(uint32_t sequence);
+
+        /// @brief Routes the complete state of a tracker sensor: a pose
+        /// report, position and orientation reports for only the parts
+        /// flagged valid, and any velocity for pose prediction.
+        void m_routeTrackerState(OSVR_TimeValue const &timestamp,
+                                 int32_t sensor, OSVR_TrackerState const &state,
+                                 common::CompiledTransform const &xform);
+
       private:
         ClientContext *m_ctx;
         const std::string m_dest;
+        common::SourceSubscription m_source;
+        common::ReportSequenceChecker m_sequence;
     };
 
     typedef unique_ptr<RouterEntry> RouterEntryPtr;
@@ -67,12 +103,39 @@ namespace client {
         VRPNContext(const char appId[], const char host[] = "localhost");
         virtual ~VRPNContext();
 
+      protected:
+        virtual void m_update();
+        virtual void m_waitForNetwork(uint64_t microseconds);
+
+        /// @brief Lets derived contexts that receive device reports some
+        /// other way route them: returns null (the default) to route from
+        /// VRPN messages instead.
+        ///
+        /// @param device Name of the device on the server.
+        /// @param sensor Sensor or channel to route, or -1 for all.
+        virtual RouterEntryPtr
+        m_createDirectRouter(common::DirectReportPacket::Kind kind,
+                             std::string const &device, int sensor,
+                             std::string const &dest,
+                             common::Transform const &xform);
+
+        /// @brief Called before routers are destroyed, so derived contexts
+        /// can forget any returned by m_createDirectRouter().
+        virtual void m_clearDirectRouters();
+
       private:
         static int VRPN_CALLBACK
         m_handleRoutingMessage(void *userdata, vrpn_HANDLERPARAM p);
+        /// @brief Forgets the sequence numbers every router has seen when the
+        /// connection to the server is made or lost, so reports from a
+        /// restarted server aren't discarded as reordered, and the clock
+        /// offset estimated for the old server.
+        static int VRPN_CALLBACK
+        m_handleConnectionChange(void *userdata, vrpn_HANDLERPARAM);
         void m_replaceRoutes(common::RouteContainer const &newDirectives);
         virtual void m_sendRoute(std::string const &route);
-        virtual void m_update();
+        void m_pingClockIfDue();
+        void m_sendSubscriptionsIfDue();
 
         void m_handleTrackerRouteEntry(std::string const &dest,
                                        Json::Value src);
@@ -92,6 +155,20 @@ namespace client {
 
         common::BaseDevicePtr m_systemDevice;
         common::SystemComponent *m_systemComponent;
+        /// @brief Monotonic time of the last clock ping sent.
+        util::time::TimeValue m_lastClockPing;
+
+        /// @brief Identifies this context's subscriptions to the server.
+        std::string const m_clientId;
+        /// @brief Identifies m_conn to the server, which can't tell which
+        /// client contexts share it.
+        std::string m_connectionId;
+        /// @brief Set when routes change, requiring a new subscription list.
+        bool m_routesChanged;
+        /// @brief Interface core generation the last subscriptions reflected.
+        uint64_t m_subscribedGeneration;
+        /// @brief Monotonic time subscriptions were last sent.
+        util::time::TimeValue m_lastSubscriptions;
     };
 } // namespace client
 } // namespace osvr
@@ -31,14 +31,19 @@
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Client/ClientContext.h>
 #include <osvr/Client/ClientInterface.h>
-#include <osvr/Common/Transform.h>
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/ReportSequence.h>
+#include <osvr/Common/PoseBatchMessage.h>
+#include <osvr/Common/TrackerStateMessage.h>
 
 // Library/third-party includes
 #include <vrpn_Tracker.h>
 #include <boost/optional.hpp>
 
 // Standard includes
-// - none
+#include <string>
 
 namespace osvr {
 namespace client {
@@ -49,30 +54,167 @@ namespace client {
                           const char *dest, common::Transform const &t)
             : RouterEntry(ctx, dest),
               m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_conn(conn) {
-            m_remote->register_change_handler(this, &VRPNTrackerRouter::handle,
-                                              sensor.get_value_or(-1));
+              m_sensor(sensor.get_value_or(-1)), m_transform(t), m_conn(conn),
+              m_messageType(0), m_batchMessageType(0), m_stateMessageType(0),
+              m_sender(0) {
             m_remote->shutup = true;
+            /// Handle the messages directly, rather than through the remote's
+            /// callback, to get at the sequence number they carry.
+            vrpn_Connection *remoteConn = m_remote->connectionPtr();
+            if (remoteConn) {
+                const std::string name(src);
+                m_messageType =
+                    remoteConn->register_message_type("vrpn_Tracker Pos_Quat");
+                m_sender = remoteConn->register_sender(
+                    name.substr(0, name.find('@')).c_str());
+                remoteConn->register_handler(m_messageType,
+                                             &VRPNTrackerRouter::handleMessage,
+                                             this, m_sender);
+                m_batchMessageType = remoteConn->register_message_type(
+                    common::PoseBatchMessage::identifier());
+                remoteConn->register_handler(m_batchMessageType,
+                                             &VRPNTrackerRouter::handleBatch,
+                                             this, m_sender);
+                m_stateMessageType = remoteConn->register_message_type(
+                    common::TrackerStateMessage::identifier());
+                remoteConn->register_handler(m_stateMessageType,
+                                             &VRPNTrackerRouter::handleState,
+                                             this, m_sender);
+            }
+        }
+
+        virtual ~VRPNTrackerRouter() {
+            vrpn_Connection *remoteConn = m_remote->connectionPtr();
+            if (remoteConn) {
+                remoteConn->unregister_handler(
+                    m_messageType, &VRPNTrackerRouter::handleMessage, this,
+                    m_sender);
+                remoteConn->unregister_handler(m_batchMessageType,
+                                               &VRPNTrackerRouter::handleBatch,
+                                               this, m_sender);
+                remoteConn->unregister_handler(m_stateMessageType,
+                                               &VRPNTrackerRouter::handleState,
+                                               this, m_sender);
+            }
         }
 
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
-        static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
+        /// @brief Decodes a VRPN tracker position message: the sensor, a
+        /// padding word (holding a sequence number from OSVR servers), then
+        /// position and orientation.
+        static int VRPN_CALLBACK handleMessage(void *userdata,
+                                               vrpn_HANDLERPARAM p) {
+            VRPNTrackerRouter *self =
+                static_cast<VRPNTrackerRouter *>(userdata);
+            const std::size_t messageSize =
+                2 * sizeof(vrpn_int32) + 7 * sizeof(vrpn_float64);
+            if (p.payload_len != vrpn_int32(messageSize)) {
+                return 0;
+            }
+            auto bufwrap = common::ExternalBufferReadingWrapper<unsigned char>(
+                reinterpret_cast<unsigned char const *>(p.buffer),
+                p.payload_len);
+            auto reader = common::BufferReader<decltype(bufwrap)>(bufwrap);
+            vrpn_TRACKERCB info;
+            info.msg_time = p.msg_time;
+            uint32_t padding;
+            common::serialization::deserializeRaw(reader, info.sensor);
+            common::serialization::deserializeRaw(reader, padding);
+            if ((padding & common::getTrackerSequenceMarker()) &&
+                !self->m_checkSequence(padding)) {
+                return 0;
+            }
+            if (self->m_sensor >= 0 && info.sensor != self->m_sensor) {
+                return 0;
+            }
+            for (auto &val : info.pos) {
+                common::serialization::deserializeRaw(reader, val);
+            }
+            for (auto &val : info.quat) {
+                common::serialization::deserializeRaw(reader, val);
+            }
+            handle(self, info);
+            return 0;
+        }
+
+        /// @brief Decodes a PoseBatchMessage: only the pose of the sensor
+        /// routed, unless routing all of them.
+        static int VRPN_CALLBACK handleBatch(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+            VRPNTrackerRouter *self =
+                static_cast<VRPNTrackerRouter *>(userdata);
+            const common::PoseBatchMessage msg(p.buffer,
+                                               std::size_t(p.payload_len));
+            if (!msg.isValid() || !self->m_checkSequence(msg.getSequence())) {
+                return 0;
+            }
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+            OSVR_PoseReport report;
+            if (self->m_sensor >= 0) {
+                if (msg.hasSensor(self->m_sensor)) {
+                    report.sensor = self->m_sensor;
+                    report.pose = msg.getPose(self->m_sensor);
+                    self->m_handle(timestamp, report);
+                }
+                return 0;
+            }
+            const int32_t end = msg.getFirst() + int32_t(msg.getCount());
+            for (int32_t i = msg.getFirst(); i < end; ++i) {
+                report.sensor = i;
+                report.pose = msg.getPose(i);
+                self->m_handle(timestamp, report);
+            }
+            return 0;
+        }
+
+        /// @brief Decodes a TrackerStateMessage.
+        static int VRPN_CALLBACK handleState(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
             VRPNTrackerRouter *self =
                 static_cast<VRPNTrackerRouter *>(userdata);
+            uint32_t sequence;
+            int32_t sensor;
+            OSVR_TrackerState state;
+            if (!common::TrackerStateMessage::decode(
+                    p.buffer, std::size_t(p.payload_len), sequence, sensor,
+                    state) ||
+                !self->m_checkSequence(sequence)) {
+                return 0;
+            }
+            if (self->m_sensor >= 0 && sensor != self->m_sensor) {
+                return 0;
+            }
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+            self->m_routeTrackerState(timestamp, sensor, state,
+                                      self->m_transform);
+            return 0;
+        }
+
+        static void handle(VRPNTrackerRouter *self,
+                           vrpn_TRACKERCB const &info) {
             OSVR_PoseReport report;
             report.sensor = info.sensor;
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
             osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
             osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
-            Eigen::Matrix4d pose = self->m_transform.transform(
-                util::fromPose(report.pose).matrix());
-            util::toPose(pose, report.pose);
+            self->m_handle(timestamp, report);
+        }
+        void operator()() { m_remote->mainloop(); }
 
-            for (auto const &iface : self->getContext()->getInterfaces()) {
-                if (iface->getPath() == self->getDest()) {
-                    iface->triggerCallbacks(timestamp, report);
+      private:
+        /// @brief Transforms a pose and passes it on as pose, position, and
+        /// orientation reports.
+        void m_handle(OSVR_TimeValue const &timestamp,
+                      OSVR_PoseReport &report) {
+            m_transform.apply(report.pose);
+
+            for (auto const &core : getContext()->getInterfaceCores()) {
+                if (core->getPath() == getDest()) {
+                    core->triggerCallbacks(timestamp, report);
                 }
             }
 
@@ -81,11 +223,11 @@ namespace client {
             if (util::vecMap(report.pose.translation) !=
                 Eigen::Vector3d::Zero()) {
                 OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
+                positionReport.sensor = report.sensor;
                 positionReport.xyz = report.pose.translation;
-                for (auto const &iface : self->getContext()->getInterfaces()) {
-                    if (iface->getPath() == self->getDest()) {
-                        iface->triggerCallbacks(timestamp, positionReport);
+                for (auto const &core : getContext()->getInterfaceCores()) {
+                    if (core->getPath() == getDest()) {
+                        core->triggerCallbacks(timestamp, positionReport);
                     }
                 }
             }
@@ -93,21 +235,24 @@ namespace client {
             /// @todo check to see if rotation is useful/provided
             {
                 OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
+                oriReport.sensor = report.sensor;
                 oriReport.rotation = report.pose.rotation;
-                for (auto const &iface : self->getContext()->getInterfaces()) {
-                    if (iface->getPath() == self->getDest()) {
-                        iface->triggerCallbacks(timestamp, oriReport);
+                for (auto const &core : getContext()->getInterfaceCores()) {
+                    if (core->getPath() == getDest()) {
+                        core->triggerCallbacks(timestamp, oriReport);
                     }
                 }
             }
         }
-        void operator()() { m_remote->mainloop(); }
 
-      private:
         unique_ptr<vrpn_Tracker_Remote> m_remote;
-        common::Transform m_transform;
+        int m_sensor;
+        common::CompiledTransform m_transform;
         vrpn_ConnectionPtr m_conn;
+        vrpn_int32 m_messageType;
+        vrpn_int32 m_batchMessageType;
+        vrpn_int32 m_stateMessageType;
+        vrpn_int32 m_sender;
     };
 
 } // namespace client
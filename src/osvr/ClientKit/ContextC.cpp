@@ -25,6 +25,7 @@
 // Internal Includes
 #include <osvr/ClientKit/ContextC.h>
 #include <osvr/Client/ClientContext.h>
+#include <osvr/Client/ClientInterface.h>
 #include <osvr/Client/CreateContext.h>
 #include <osvr/Common/GetEnvironmentVariable.h>
 #include <osvr/Util/Verbosity.h>
@@ -37,8 +38,8 @@
 
 static const char HOST_ENV_VAR[] = "OSVR_HOST";
 
-OSVR_ClientContext osvrClientInit(const char applicationIdentifier[],
-                                  uint32_t /*flags*/) {
+static OSVR_ClientContext
+createContextFromEnvironment(const char applicationIdentifier[]) {
     auto host = osvr::common::getEnvironmentVariable(HOST_ENV_VAR);
     if (host.is_initialized()) {
         OSVR_DEV_VERBOSE("Connecting to non-default host " << *host);
@@ -49,11 +50,53 @@ OSVR_ClientContext osvrClientInit(const char applicationIdentifier[],
         return ::osvr::client::createContext(applicationIdentifier);
     }
 }
+
+OSVR_ClientContext osvrClientInit(const char applicationIdentifier[],
+                                  uint32_t flags) {
+    OSVR_ClientContext ctx =
+        createContextFromEnvironment(applicationIdentifier);
+    if (ctx && (flags & OSVR_CLIENT_INIT_CALLBACKS_ON_NETWORK_THREAD)) {
+        ctx->startNetworkThread(true);
+    } else if (ctx && (flags & OSVR_CLIENT_INIT_NETWORK_THREAD)) {
+        ctx->startNetworkThread(false);
+    }
+    return ctx;
+}
+
 OSVR_ReturnCode osvrClientUpdate(OSVR_ClientContext ctx) {
     ctx->update();
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode osvrClientUpdateWithBudget(OSVR_ClientContext ctx,
+                                           uint64_t microseconds,
+                                           uint32_t flags) {
+    ctx->updateWithBudget(microseconds,
+                          (flags & OSVR_CLIENT_UPDATE_DROP_SUPERSEDED) != 0);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientWaitForReport(OSVR_ClientContext ctx,
+                                        OSVR_ClientInterface iface,
+                                        uint64_t timeoutMicroseconds) {
+    if (nullptr == ctx || nullptr == iface) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return ctx->waitForReport(iface, timeoutMicroseconds)
+               ? OSVR_RETURN_SUCCESS
+               : OSVR_RETURN_FAILURE;
+}
+
+OSVR_ReturnCode osvrClientWaitForAnyReport(OSVR_ClientContext ctx,
+                                           uint64_t timeoutMicroseconds) {
+    if (nullptr == ctx) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return ctx->waitForReport(nullptr, timeoutMicroseconds)
+               ? OSVR_RETURN_SUCCESS
+               : OSVR_RETURN_FAILURE;
+}
+
 OSVR_ReturnCode osvrClientShutdown(OSVR_ClientContext ctx) {
     delete ctx;
     return OSVR_RETURN_SUCCESS;
@@ -69,3 +69,49 @@ OSVR_ReturnCode osvrClientFreeInterface(OSVR_ClientContext ctx,
     }
     return OSVR_RETURN_SUCCESS;
 }
+
+OSVR_ReturnCode
+osvrClientSetInterfaceHistoryCapacity(OSVR_ClientInterface iface,
+                                      uint32_t capacity) {
+    if (nullptr == iface) {
+        /// Return failure if given a null interface
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->setHistoryCapacity(capacity);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrClientSetInterfaceCallbackCoalescing(OSVR_ClientInterface iface,
+                                         OSVR_CBool coalesce) {
+    if (nullptr == iface) {
+        /// Return failure if given a null interface
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->setCoalesceCallbacks(coalesce != OSVR_FALSE);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetSkippedReportCount(OSVR_ClientInterface iface,
+                                                uint32_t *count) {
+    if (nullptr == iface || nullptr == count) {
+        return OSVR_RETURN_FAILURE;
+    }
+    *count = static_cast<uint32_t>(iface->getSkippedReportCount());
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetInterfaceSequenceStats(OSVR_ClientInterface iface,
+                                                    uint64_t *lost,
+                                                    uint64_t *reordered) {
+    if (nullptr == iface) {
+        return OSVR_RETURN_FAILURE;
+    }
+    if (lost) {
+        *lost = iface->getLostReportCount();
+    }
+    if (reordered) {
+        *reordered = iface->getReorderedReportCount();
+    }
+    return OSVR_RETURN_SUCCESS;
+}
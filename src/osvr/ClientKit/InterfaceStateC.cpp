@@ -25,6 +25,7 @@
 // Internal Includes
 #include <osvr/ClientKit/InterfaceStateC.h>
 #include <osvr/Client/ClientInterface.h>
+#include <osvr/Client/ClientContext.h>
 
 // Library/third-party includes
 // - none
@@ -36,6 +37,9 @@
     OSVR_ReturnCode osvrGet##TYPE##State(OSVR_ClientInterface iface,           \
                                          struct OSVR_TimeValue *timestamp,     \
                                          OSVR_##TYPE##State *state) {          \
+        if (!iface || !timestamp || !state) {                                  \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
         bool hasState =                                                        \
             iface->getState<OSVR_##TYPE##Report>(*timestamp, *state);          \
         return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;           \
@@ -48,3 +52,77 @@ OSVR_CALLBACK_METHODS(Button)
 OSVR_CALLBACK_METHODS(Analog)
 
 #undef OSVR_CALLBACK_METHODS
+
+template <typename ReportType, typename StateType>
+static OSVR_ReturnCode getStates(OSVR_ClientContext ctx, uint32_t count,
+                                 OSVR_ClientInterface const *ifaces,
+                                 OSVR_TimeValue *timestamps, StateType *states,
+                                 OSVR_CBool *valid) {
+    if (!ctx || (count > 0 && (!ifaces || !timestamps || !states))) {
+        return OSVR_RETURN_FAILURE;
+    }
+    bool all = true;
+    /// Message processing (on the network thread or in update()) holds this
+    /// for a whole pass over incoming messages, so holding it here makes the
+    /// reads one snapshot.
+    OSVR_ClientContextObject::UpdateLock lock(ctx->getUpdateMutex());
+    for (uint32_t i = 0; i < count; ++i) {
+        bool hasState = (nullptr != ifaces[i]) &&
+                        ifaces[i]->getState<ReportType>(timestamps[i],
+                                                        states[i]);
+        if (valid) {
+            valid[i] = hasState ? OSVR_TRUE : OSVR_FALSE;
+        }
+        all = all && hasState;
+    }
+    return all ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
+
+#define OSVR_BATCH_METHODS(TYPE)                                               \
+    OSVR_ReturnCode osvrGet##TYPE##States(                                     \
+        OSVR_ClientContext ctx, uint32_t count,                                \
+        OSVR_ClientInterface const *ifaces, struct OSVR_TimeValue *timestamps, \
+        OSVR_##TYPE##State *states, OSVR_CBool *valid) {                       \
+        return getStates<OSVR_##TYPE##Report>(ctx, count, ifaces, timestamps,  \
+                                              states, valid);                  \
+    }
+
+OSVR_BATCH_METHODS(Pose)
+OSVR_BATCH_METHODS(Position)
+OSVR_BATCH_METHODS(Orientation)
+OSVR_BATCH_METHODS(Button)
+OSVR_BATCH_METHODS(Analog)
+
+#undef OSVR_BATCH_METHODS
+
+#define OSVR_HISTORY_METHODS(TYPE)                                             \
+    OSVR_ReturnCode osvrGet##TYPE##StateAtTime(                                \
+        OSVR_ClientInterface iface, struct OSVR_TimeValue const *time,         \
+        OSVR_CBool interpolate, struct OSVR_TimeValue *timestamp,              \
+        OSVR_##TYPE##State *state) {                                           \
+        if (!iface || !time || !timestamp || !state) {                         \
+            return OSVR_RETURN_FAILURE;                                        \
+        }                                                                      \
+        bool hasState = iface->getStateAt<OSVR_##TYPE##Report>(                \
+            *time, interpolate != OSVR_FALSE, *timestamp, *state);             \
+        return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;           \
+    }
+
+OSVR_HISTORY_METHODS(Pose)
+OSVR_HISTORY_METHODS(Position)
+OSVR_HISTORY_METHODS(Orientation)
+OSVR_HISTORY_METHODS(Button)
+OSVR_HISTORY_METHODS(Analog)
+
+#undef OSVR_HISTORY_METHODS
+
+OSVR_ReturnCode
+osvrGetPredictedPoseState(OSVR_ClientInterface iface,
+                          struct OSVR_TimeValue const *targetTime,
+                          OSVR_PoseState *state) {
+    if (!iface || !targetTime || !state) {
+        return OSVR_RETURN_FAILURE;
+    }
+    bool hasState = iface->getPredictedPoseState(*targetTime, *state);
+    return hasState ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
@@ -0,0 +1,147 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ClockSync.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    static const int64_t USEC_PER_SEC = 1000000;
+
+    /// @brief Pings older than this many unanswered ones are assumed lost.
+    static const std::size_t MAX_OUTSTANDING_PINGS = 8;
+
+    static inline int64_t toMicroseconds(util::time::TimeValue const &tv) {
+        return tv.seconds * USEC_PER_SEC + tv.microseconds;
+    }
+
+    static inline util::time::TimeValue fromMicroseconds(int64_t usec) {
+        util::time::TimeValue ret;
+        ret.seconds = usec / USEC_PER_SEC;
+        ret.microseconds =
+            static_cast<OSVR_TimeValue_Microseconds>(usec % USEC_PER_SEC);
+        osvrTimeValueNormalize(&ret);
+        return ret;
+    }
+
+    ClockOffsetEstimator::ClockOffsetEstimator(std::size_t windowSize)
+        : m_windowSize(std::max(windowSize, std::size_t(1))),
+          m_nonces(std::random_device()()) {
+        m_best.offset = 0;
+        m_best.roundTrip = 0;
+    }
+
+    uint32_t ClockOffsetEstimator::startExchange(
+        util::time::TimeValue const &clientSent) {
+        Ping ping;
+        ping.nonce = static_cast<uint32_t>(m_nonces());
+        ping.clientSent = clientSent;
+        m_outstanding.push_back(ping);
+        while (m_outstanding.size() > MAX_OUTSTANDING_PINGS) {
+            m_outstanding.pop_front();
+        }
+        return ping.nonce;
+    }
+
+    bool ClockOffsetEstimator::addResponse(
+        ClockSyncTimestamps const &timestamps,
+        util::time::TimeValue const &clientReceived) {
+        auto it = std::find_if(
+            begin(m_outstanding), end(m_outstanding), [&](Ping const &ping) {
+                return ping.nonce == timestamps.nonce &&
+                       toMicroseconds(ping.clientSent) ==
+                           toMicroseconds(timestamps.clientSent);
+            });
+        if (it == end(m_outstanding)) {
+            return false;
+        }
+        m_outstanding.erase(it);
+        addSample(timestamps, clientReceived);
+        return true;
+    }
+
+    void ClockOffsetEstimator::addSample(
+        ClockSyncTimestamps const &timestamps,
+        util::time::TimeValue const &clientReceived) {
+        const int64_t t0 = toMicroseconds(timestamps.clientSent);
+        const int64_t t1 = toMicroseconds(timestamps.serverReceived);
+        const int64_t t2 = toMicroseconds(timestamps.serverSent);
+        const int64_t t3 = toMicroseconds(clientReceived);
+
+        Sample s;
+        s.roundTrip = (t3 - t0) - (t2 - t1);
+        if (s.roundTrip < 0) {
+            /// Can't be a genuine exchange - discard it.
+            return;
+        }
+        s.offset = ((t1 - t0) + (t2 - t3)) / 2;
+
+        m_samples.push_back(s);
+        while (m_samples.size() > m_windowSize) {
+            m_samples.pop_front();
+        }
+        m_updateBest();
+    }
+
+    bool ClockOffsetEstimator::hasEstimate() const {
+        return !m_samples.empty();
+    }
+
+    util::time::TimeValue ClockOffsetEstimator::getOffset() const {
+        return fromMicroseconds(m_best.offset);
+    }
+
+    util::time::TimeValue ClockOffsetEstimator::getRoundTripTime() const {
+        return fromMicroseconds(m_best.roundTrip);
+    }
+
+    util::time::TimeValue ClockOffsetEstimator::toClientTime(
+        util::time::TimeValue const &serverTime) const {
+        if (!hasEstimate()) {
+            return serverTime;
+        }
+        return fromMicroseconds(toMicroseconds(serverTime) - m_best.offset);
+    }
+
+    void ClockOffsetEstimator::reset() {
+        m_samples.clear();
+        m_outstanding.clear();
+        m_best.offset = 0;
+        m_best.roundTrip = 0;
+    }
+
+    void ClockOffsetEstimator::m_updateBest() {
+        m_best = *std::min_element(begin(m_samples), end(m_samples),
+                                   [](Sample const &a, Sample const &b) {
+                                       return a.roundTrip < b.roundTrip;
+                                   });
+    }
+} // namespace common
+} // namespace osvr
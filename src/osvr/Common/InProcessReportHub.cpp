@@ -0,0 +1,223 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InProcessReportHub.h>
+
+// Library/third-party includes
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread_time.hpp>
+
+// Standard includes
+#include <map>
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    /// @brief Packets each subscriber can have waiting: enough to ride out
+    /// a slow frame or two of a busy server.
+    static const std::size_t QUEUE_CAPACITY = 1024;
+
+    typedef boost::lock_guard<boost::mutex> HubLock;
+
+    /// @brief Can a packet of this kind be dropped from a full queue? Only
+    /// if it carries the latest state of continuously changing data: every
+    /// button change and device name must arrive, in order.
+    static inline bool isDroppable(DirectReportPacket::Kind kind) {
+        return kind == DirectReportPacket::TRACKER ||
+               kind == DirectReportPacket::TRACKER_STATE ||
+               kind == DirectReportPacket::ANALOG;
+    }
+
+    InProcessReportHub::Queue::Queue(std::size_t capacity)
+        : m_queue(capacity), m_overflowing(false) {}
+
+    bool InProcessReportHub::Queue::pop(DirectReportPacket &packet) {
+        /// Anything in the queue is older than the overflow list, since
+        /// nothing is queued while that is in use.
+        if (m_queue.pop(packet)) {
+            return true;
+        }
+        if (!m_overflowing) {
+            return false;
+        }
+        HubLock lock(m_overflowMutex);
+        if (m_overflow.empty()) {
+            return false;
+        }
+        packet = m_overflow.front();
+        m_overflow.pop_front();
+        if (m_overflow.empty()) {
+            m_overflowing = false;
+        }
+        return true;
+    }
+
+    bool InProcessReportHub::Queue::empty() const {
+        if (!m_queue.empty()) {
+            return false;
+        }
+        if (!m_overflowing) {
+            return true;
+        }
+        HubLock lock(m_overflowMutex);
+        return m_overflow.empty();
+    }
+
+    bool
+    InProcessReportHub::Queue::m_push(DirectReportPacket const &packet) {
+        if (!m_overflowing && m_queue.push(packet)) {
+            return true;
+        }
+        if (isDroppable(packet.getKind())) {
+            return false;
+        }
+        HubLock lock(m_overflowMutex);
+        m_overflow.push_back(packet);
+        m_overflowing = true;
+        return true;
+    }
+
+    InProcessReportHubPtr InProcessReportHub::get(std::string const &name) {
+        static boost::mutex registryMutex;
+        static std::map<std::string, weak_ptr<InProcessReportHub> > registry;
+        HubLock lock(registryMutex);
+        InProcessReportHubPtr ret = registry[name].lock();
+        if (!ret) {
+            ret = make_shared<InProcessReportHub>();
+            registry[name] = ret;
+        }
+        return ret;
+    }
+
+    InProcessReportHub::InProcessReportHub()
+        : m_hasServer(false), m_queues(make_shared<QueueList>()),
+          m_dropped(0), m_waiters(0) {}
+
+    bool InProcessReportHub::attachServer() {
+        HubLock lock(m_mutex);
+        if (m_hasServer) {
+            return false;
+        }
+        m_hasServer = true;
+        return true;
+    }
+
+    void InProcessReportHub::detachServer() {
+        HubLock lock(m_mutex);
+        m_hasServer = false;
+    }
+
+    uint32_t InProcessReportHub::addDevice(std::string const &name) {
+        uint32_t device;
+        {
+            HubLock lock(m_mutex);
+            device = uint32_t(m_deviceNames.size());
+            m_deviceNames.push_back(name);
+            DirectReportPacket packet;
+            packet.setDeviceName(device, name);
+            for (auto const &queue : *m_queues) {
+                m_push(*queue, packet);
+            }
+        }
+        m_wake();
+        return device;
+    }
+
+    bool InProcessReportHub::getDeviceName(uint32_t device,
+                                           std::string &name) {
+        HubLock lock(m_mutex);
+        if (device >= m_deviceNames.size()) {
+            return false;
+        }
+        name = m_deviceNames[device];
+        return true;
+    }
+
+    void InProcessReportHub::publish(DirectReportPacket const &packet) {
+        shared_ptr<const QueueList> queues = std::atomic_load(&m_queues);
+        for (auto const &queue : *queues) {
+            m_push(*queue, packet);
+        }
+        m_wake();
+    }
+
+    InProcessReportHub::QueuePtr InProcessReportHub::subscribe() {
+        QueuePtr queue = make_shared<Queue>(QUEUE_CAPACITY);
+        HubLock lock(m_mutex);
+        DirectReportPacket packet;
+        for (std::size_t i = 0; i < m_deviceNames.size(); ++i) {
+            packet.setDeviceName(uint32_t(i), m_deviceNames[i]);
+            m_push(*queue, packet);
+        }
+        auto queues = make_shared<QueueList>(*m_queues);
+        queues->push_back(queue);
+        std::atomic_store(&m_queues, shared_ptr<const QueueList>(queues));
+        return queue;
+    }
+
+    void InProcessReportHub::unsubscribe(QueuePtr const &queue) {
+        HubLock lock(m_mutex);
+        auto queues = make_shared<QueueList>(*m_queues);
+        queues->erase(std::remove(begin(*queues), end(*queues), queue),
+                      end(*queues));
+        std::atomic_store(&m_queues, shared_ptr<const QueueList>(queues));
+    }
+
+    bool InProcessReportHub::waitForPackets(Queue const &queue,
+                                            uint64_t microseconds) {
+        const boost::system_time deadline =
+            boost::get_system_time() +
+            boost::posix_time::microseconds(int64_t(microseconds));
+        boost::unique_lock<boost::mutex> lock(m_waitMutex);
+        ++m_waiters;
+        /// Pairs with the fence in m_wake(): either the publisher sees this
+        /// waiter, or this sees the packet.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (queue.empty()) {
+            if (!m_published.timed_wait(lock, deadline)) {
+                break;
+            }
+        }
+        --m_waiters;
+        return !queue.empty();
+    }
+
+    void InProcessReportHub::m_wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiters.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        HubLock lock(m_waitMutex);
+        m_published.notify_all();
+    }
+
+    void InProcessReportHub::m_push(Queue &queue,
+                                    DirectReportPacket const &packet) {
+        if (!queue.m_push(packet)) {
+            ++m_dropped;
+        }
+    }
+} // namespace common
+} // namespace osvr
@@ -40,6 +40,10 @@ namespace common {
         const char *source() { return "source"; }
 
         const char *child() { return "child"; }
+
+        const char *serverTransform() { return "serverTransform"; }
+
+        const char *serverFilter() { return "serverFilter"; }
     } // namespace routing_keys
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,294 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/SharedMemoryReportRings.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/static_assert.hpp>
+#include <boost/interprocess/exceptions.hpp>
+
+// Standard includes
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace osvr {
+namespace common {
+    namespace ipc = boost::interprocess;
+
+    /// @brief Identifies a region as ours ("OSVR").
+    static const uint32_t REGION_MAGIC = 0x5256534f;
+    /// @brief Bumped whenever the layout below changes.
+    static const uint32_t REGION_VERSION = 2;
+
+    /// The atomics below are shared between processes, so must not be
+    /// implemented with a lock private to each.
+    BOOST_STATIC_ASSERT_MSG(ATOMIC_INT_LOCK_FREE == 2 &&
+                                sizeof(uint32_t) == sizeof(int),
+                            "32-bit atomics must be lock-free");
+    BOOST_STATIC_ASSERT_MSG(ATOMIC_LLONG_LOCK_FREE == 2 &&
+                                sizeof(uint64_t) == sizeof(long long),
+                            "64-bit atomics must be lock-free");
+
+    static inline uint64_t monotonicMicroseconds() {
+        util::time::TimeValue now;
+        util::time::getMonotonicNow(now);
+        return uint64_t(now.seconds) * 1000000 + uint64_t(now.microseconds);
+    }
+
+    /// @brief Attempts at reading a slot before giving up, in case the
+    /// server died partway through writing it.
+    static const int MAX_READ_ATTEMPTS = 1000;
+
+    /// @brief Region layout parameters, checked by clients. Cache-line
+    /// sized, like the other structures in the region, so each starts on a
+    /// cache line.
+    struct SharedMemoryReportRings::Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t maxDevices;
+        uint32_t history;
+        uint32_t slotSize;
+        uint32_t reserved0;
+        std::atomic<uint32_t> numDevices;
+        std::atomic<uint32_t> closed;
+        /// @brief Monotonic clock reading, in microseconds, of the server's
+        /// last heartbeat.
+        std::atomic<uint64_t> heartbeat;
+        uint32_t reserved[6];
+    };
+
+    /// @brief A device's name and the number of reports written to its ring.
+    struct SharedMemoryReportRings::DeviceEntry {
+        std::atomic<uint64_t> written;
+        uint32_t nameLength;
+        char name[244];
+    };
+
+    /// @brief One report, guarded by a sequence lock: odd sequence numbers
+    /// mark a write in progress.
+    struct SharedMemoryReportRings::Slot {
+        std::atomic<uint32_t> seq;
+        uint32_t size;
+        /// @brief Position in the device's stream of reports, to detect a
+        /// slot overwritten by a later report.
+        uint64_t index;
+        unsigned char bytes[1072];
+    };
+
+    std::size_t SharedMemoryReportRings::s_slotsOffset() {
+        return sizeof(Header) + MAX_DEVICES * sizeof(DeviceEntry);
+    }
+
+    std::size_t SharedMemoryReportRings::s_regionSize() {
+        return s_slotsOffset() + MAX_DEVICES * HISTORY * sizeof(Slot);
+    }
+
+    SharedMemoryReportRingsPtr
+    SharedMemoryReportRings::create(std::string const &name) {
+        try {
+            return SharedMemoryReportRingsPtr(
+                new SharedMemoryReportRings(name, true));
+        } catch (ipc::interprocess_exception &e) {
+            throw std::runtime_error("Could not create shared memory " +
+                                     name + ": " + e.what());
+        }
+    }
+
+    SharedMemoryReportRingsPtr
+    SharedMemoryReportRings::open(std::string const &name) {
+        SharedMemoryReportRingsPtr ret;
+        try {
+            ret.reset(new SharedMemoryReportRings(name, false));
+        } catch (ipc::interprocess_exception &) {
+            return ret;
+        }
+        Header const &header = ret->m_header();
+        if (ret->m_region.get_size() < s_regionSize() ||
+            header.magic != REGION_MAGIC || header.version != REGION_VERSION ||
+            header.maxDevices != MAX_DEVICES || header.history != HISTORY ||
+            header.slotSize != sizeof(Slot)) {
+            ret.reset();
+        }
+        return ret;
+    }
+
+    SharedMemoryReportRings::SharedMemoryReportRings(std::string const &name,
+                                                     bool owner)
+        : m_name(name), m_owner(owner), m_lost(0) {
+        BOOST_STATIC_ASSERT(sizeof(Header) == 64);
+        BOOST_STATIC_ASSERT(sizeof(DeviceEntry) == 256);
+        BOOST_STATIC_ASSERT(sizeof(Slot) % 64 == 0);
+        BOOST_STATIC_ASSERT(sizeof(DirectReportPacket) <=
+                            sizeof(((Slot *)nullptr)->bytes));
+        if (!m_owner) {
+            ipc::shared_memory_object shm(ipc::open_only, m_name.c_str(),
+                                          ipc::read_only);
+            m_shm.swap(shm);
+            ipc::mapped_region region(m_shm, ipc::read_only);
+            m_region.swap(region);
+            return;
+        }
+        /// Remove any region left behind by a server that did not exit
+        /// cleanly: clients still holding it will see it was never closed,
+        /// but also never written again.
+        ipc::shared_memory_object::remove(m_name.c_str());
+        ipc::shared_memory_object shm(ipc::create_only, m_name.c_str(),
+                                      ipc::read_write);
+        m_shm.swap(shm);
+        m_shm.truncate(ipc::offset_t(s_regionSize()));
+        ipc::mapped_region region(m_shm, ipc::read_write);
+        m_region.swap(region);
+
+        /// New shared memory is zero-filled: just fill in the header.
+        Header &header = *new (m_region.get_address()) Header;
+        header.magic = REGION_MAGIC;
+        header.version = REGION_VERSION;
+        header.maxDevices = MAX_DEVICES;
+        header.history = HISTORY;
+        header.slotSize = sizeof(Slot);
+        header.closed.store(0, std::memory_order_relaxed);
+        header.heartbeat.store(monotonicMicroseconds(),
+                               std::memory_order_relaxed);
+        header.numDevices.store(0, std::memory_order_release);
+    }
+
+    SharedMemoryReportRings::~SharedMemoryReportRings() {
+        if (m_owner) {
+            m_header().closed.store(1, std::memory_order_release);
+            ipc::shared_memory_object::remove(m_name.c_str());
+        }
+    }
+
+    bool SharedMemoryReportRings::addDevice(std::string const &name,
+                                            uint32_t &device) {
+        Header &header = m_header();
+        const uint32_t n = header.numDevices.load(std::memory_order_relaxed);
+        if (n >= MAX_DEVICES) {
+            return false;
+        }
+        DeviceEntry &entry = *new (&m_device(n)) DeviceEntry;
+        entry.written.store(0, std::memory_order_relaxed);
+        entry.nameLength = uint32_t(std::min(name.size(), sizeof(entry.name)));
+        std::memcpy(entry.name, name.data(), entry.nameLength);
+        header.numDevices.store(n + 1, std::memory_order_release);
+        device = n;
+        return true;
+    }
+
+    void SharedMemoryReportRings::publish(DirectReportPacket const &packet) {
+        const uint32_t device = packet.getDevice();
+        if (device >= m_header().numDevices.load(std::memory_order_relaxed)) {
+            return;
+        }
+        DeviceEntry &entry = m_device(device);
+        const uint64_t index = entry.written.load(std::memory_order_relaxed);
+        Slot &slot = m_slot(device, index);
+        const uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.size = uint32_t(packet.size());
+        slot.index = index;
+        std::memcpy(slot.bytes, packet.data(), packet.size());
+        slot.seq.store(seq + 2, std::memory_order_release);
+        entry.written.store(index + 1, std::memory_order_release);
+    }
+
+    void SharedMemoryReportRings::heartbeat() {
+        m_header().heartbeat.store(monotonicMicroseconds(),
+                                   std::memory_order_relaxed);
+    }
+
+    double SharedMemoryReportRings::getHeartbeatAge() const {
+        const uint64_t beat =
+            m_header().heartbeat.load(std::memory_order_relaxed);
+        const uint64_t now = monotonicMicroseconds();
+        return now > beat ? double(now - beat) * 1.0e-6 : 0.0;
+    }
+
+    bool SharedMemoryReportRings::isClosed() const {
+        return m_header().closed.load(std::memory_order_acquire) != 0;
+    }
+
+    uint32_t SharedMemoryReportRings::getNumDevices() const {
+        return std::min(
+            m_header().numDevices.load(std::memory_order_acquire),
+            uint32_t(MAX_DEVICES));
+    }
+
+    std::string SharedMemoryReportRings::getDeviceName(uint32_t device) const {
+        DeviceEntry const &entry = m_device(device);
+        return std::string(entry.name,
+                           std::min(std::size_t(entry.nameLength),
+                                    sizeof(entry.name)));
+    }
+
+    uint64_t SharedMemoryReportRings::getWritten(uint32_t device) const {
+        return m_device(device).written.load(std::memory_order_acquire);
+    }
+
+    SharedMemoryReportRings::Header &
+    SharedMemoryReportRings::m_header() const {
+        return *static_cast<Header *>(m_region.get_address());
+    }
+
+    SharedMemoryReportRings::DeviceEntry &
+    SharedMemoryReportRings::m_device(uint32_t device) const {
+        return static_cast<DeviceEntry *>(
+            static_cast<void *>(&m_header() + 1))[device];
+    }
+
+    SharedMemoryReportRings::Slot &
+    SharedMemoryReportRings::m_slot(uint32_t device, uint64_t index) const {
+        Slot *slots = static_cast<Slot *>(static_cast<void *>(
+            static_cast<char *>(m_region.get_address()) + s_slotsOffset()));
+        return slots[device * HISTORY + index % HISTORY];
+    }
+
+    bool SharedMemoryReportRings::m_readSlot(uint32_t device, uint64_t index) {
+        Slot const &slot = m_slot(device, index);
+        for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+            const uint32_t before = slot.seq.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            const uint64_t slotIndex = slot.index;
+            const std::size_t size =
+                std::min(std::size_t(slot.size), sizeof(slot.bytes));
+            /// May be torn: only trusted once the sequence number checks out.
+            unsigned char bytes[sizeof(slot.bytes)];
+            std::memcpy(bytes, slot.bytes, size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != before) {
+                continue;
+            }
+            return slotIndex == index && m_packet.assign(bytes, size);
+        }
+        return false;
+    }
+} // namespace common
+} // namespace osvr
@@ -30,7 +30,10 @@
 #include <osvr/Common/Buffer.h>
 
 // Library/third-party includes
-// - none
+#include <vrpn_Connection.h>
+#include <json/value.h>
+#include <json/reader.h>
+#include <json/writer.h>
 
 // Standard includes
 // - none
@@ -73,6 +76,120 @@ namespace common {
         const char *ClientRouteToServer::identifier() {
             return "com.osvr.system.updateroutetoserver";
         }
+
+        class ClockPingToServer::MessageSerialization {
+          public:
+            MessageSerialization(uint32_t nonce,
+                                 util::time::TimeValue const &clientSent)
+                : m_nonce(nonce), m_clientSent(clientSent) {}
+            MessageSerialization() {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_nonce);
+                p(m_clientSent.seconds);
+                p(m_clientSent.microseconds);
+            }
+            uint32_t getNonce() const { return m_nonce; }
+            util::time::TimeValue const &getClientSent() const {
+                return m_clientSent;
+            }
+
+          private:
+            uint32_t m_nonce;
+            util::time::TimeValue m_clientSent;
+        };
+        const char *ClockPingToServer::identifier() {
+            return "com.osvr.system.clockping";
+        }
+
+        class ClockPongFromServer::MessageSerialization {
+          public:
+            MessageSerialization(ClockSyncTimestamps const &timestamps)
+                : m_timestamps(timestamps) {}
+            MessageSerialization() {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_timestamps.nonce);
+                p(m_timestamps.clientSent.seconds);
+                p(m_timestamps.clientSent.microseconds);
+                p(m_timestamps.serverReceived.seconds);
+                p(m_timestamps.serverReceived.microseconds);
+                p(m_timestamps.serverSent.seconds);
+                p(m_timestamps.serverSent.microseconds);
+            }
+            ClockSyncTimestamps const &getTimestamps() const {
+                return m_timestamps;
+            }
+
+          private:
+            ClockSyncTimestamps m_timestamps;
+        };
+        const char *ClockPongFromServer::identifier() {
+            return "com.osvr.system.clockpong";
+        }
+
+        /// @brief Carried as a JSON string: {"client": id, "connection": id,
+        /// "sources": [{"device": name, "sensor": n}, ...]}, with "sensor"
+        /// omitted for whole devices.
+        class ClientSubscriptionsToServer::MessageSerialization {
+          public:
+            MessageSerialization(std::string const &clientId,
+                                 std::string const &connectionId,
+                                 SourceSubscriptionList const &sources) {
+                Json::Value list(Json::arrayValue);
+                for (auto const &source : sources) {
+                    Json::Value entry(Json::objectValue);
+                    entry["device"] = source.device;
+                    if (source.sensor != SourceSubscription::ALL_SENSORS) {
+                        entry["sensor"] = source.sensor;
+                    }
+                    list.append(entry);
+                }
+                Json::Value val(Json::objectValue);
+                val["client"] = clientId;
+                val["connection"] = connectionId;
+                val["sources"] = list;
+                m_str = Json::FastWriter().write(val);
+            }
+            MessageSerialization() {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_str, serialization::StringOnlyMessageTag());
+            }
+
+            /// @brief Parses the received message.
+            ///
+            /// @returns false if the message was malformed.
+            bool parse(std::string &clientId, std::string &connectionId,
+                       SourceSubscriptionList &sources) const {
+                Json::Value val;
+                if (!Json::Reader().parse(m_str, val) || !val.isObject() ||
+                    !val["client"].isString() || !val["sources"].isArray() ||
+                    !val.get("connection", "").isString()) {
+                    return false;
+                }
+                clientId = val["client"].asString();
+                connectionId = val.get("connection", clientId).asString();
+                Json::Value const &list = val["sources"];
+                for (Json::ArrayIndex i = 0, e = list.size(); i < e; ++i) {
+                    Json::Value const &entry = list[i];
+                    if (!entry["device"].isString()) {
+                        return false;
+                    }
+                    sources.emplace_back(
+                        entry["device"].asString(),
+                        entry.get("sensor", SourceSubscription::ALL_SENSORS)
+                            .asInt());
+                }
+                return true;
+            }
+
+          private:
+            std::string m_str;
+        };
+        const char *ClientSubscriptionsToServer::identifier() {
+            return "com.osvr.system.subscriptions";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -110,10 +227,120 @@ namespace common {
         m_registerHandler(handler, userdata, routeIn.getMessageType());
     }
 
+    void SystemComponent::sendClockPing(
+        uint32_t nonce, util::time::TimeValue const &clientSent) {
+        Buffer<> buf;
+        messages::ClockPingToServer::MessageSerialization msg(nonce,
+                                                              clientSent);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, clockPing.getMessageType(), clientSent,
+                                  vrpn_CONNECTION_LOW_LATENCY);
+        m_getParent().sendPending();
+    }
+
+    void SystemComponent::respondToClockPings() {
+        m_registerHandler(&SystemComponent::m_handleClockPing, this,
+                          clockPing.getMessageType());
+    }
+
+    void SystemComponent::registerClockPongHandler(ClockPongHandler cb) {
+        if (m_clockPongCb.empty()) {
+            m_registerHandler(&SystemComponent::m_handleClockPong, this,
+                              clockPong.getMessageType());
+        }
+        m_clockPongCb.push_back(cb);
+    }
+
+    void SystemComponent::sendClientSubscriptions(
+        std::string const &clientId, std::string const &connectionId,
+        SourceSubscriptionList const &sources) {
+        Buffer<> buf;
+        messages::ClientSubscriptionsToServer::MessageSerialization msg(
+            clientId, connectionId, sources);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, subscriptionsIn.getMessageType());
+    }
+
+    void SystemComponent::registerClientSubscriptionsHandler(
+        ClientSubscriptionsHandler cb) {
+        if (m_subscriptionsCb.empty()) {
+            m_registerHandler(&SystemComponent::m_handleClientSubscriptions,
+                              this, subscriptionsIn.getMessageType());
+        }
+        m_subscriptionsCb.push_back(cb);
+    }
+
+    int VRPN_CALLBACK
+    SystemComponent::m_handleClockPing(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        ClockSyncTimestamps timestamps;
+        util::time::getSteadyNow(timestamps.serverReceived);
+
+        auto bufwrap = ExternalBufferReadingWrapper<unsigned char>(
+            reinterpret_cast<unsigned char const *>(p.buffer), p.payload_len);
+        auto bufReader = BufferReader<decltype(bufwrap)>(bufwrap);
+        messages::ClockPingToServer::MessageSerialization ping;
+        deserialize(bufReader, ping);
+        timestamps.nonce = ping.getNonce();
+        timestamps.clientSent = ping.getClientSent();
+
+        util::time::getSteadyNow(timestamps.serverSent);
+        Buffer<> buf;
+        messages::ClockPongFromServer::MessageSerialization pong(timestamps);
+        serialize(buf, pong);
+        self->m_getParent().packMessage(buf, self->clockPong.getMessageType(),
+                                        timestamps.serverSent,
+                                        vrpn_CONNECTION_LOW_LATENCY);
+        self->m_getParent().sendPending();
+        return 0;
+    }
+
+    int VRPN_CALLBACK
+    SystemComponent::m_handleClockPong(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        util::time::TimeValue received;
+        util::time::getSteadyNow(received);
+
+        auto bufwrap = ExternalBufferReadingWrapper<unsigned char>(
+            reinterpret_cast<unsigned char const *>(p.buffer), p.payload_len);
+        auto bufReader = BufferReader<decltype(bufwrap)>(bufwrap);
+        messages::ClockPongFromServer::MessageSerialization pong;
+        deserialize(bufReader, pong);
+
+        for (auto const &cb : self->m_clockPongCb) {
+            cb(pong.getTimestamps(), received);
+        }
+        return 0;
+    }
+
+    int VRPN_CALLBACK SystemComponent::m_handleClientSubscriptions(
+        void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufwrap = ExternalBufferReadingWrapper<unsigned char>(
+            reinterpret_cast<unsigned char const *>(p.buffer), p.payload_len);
+        auto bufReader = BufferReader<decltype(bufwrap)>(bufwrap);
+        messages::ClientSubscriptionsToServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+
+        std::string clientId;
+        std::string connectionId;
+        SourceSubscriptionList sources;
+        if (!msg.parse(clientId, connectionId, sources)) {
+            return 0;
+        }
+        for (auto const &cb : self->m_subscriptionsCb) {
+            cb(clientId, connectionId, sources);
+        }
+        return 0;
+    }
+
     void SystemComponent::m_parentSet() {
         m_getParent().registerMessageType(routesOut);
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
+        m_getParent().registerMessageType(clockPing);
+        m_getParent().registerMessageType(clockPong);
+        m_getParent().registerMessageType(subscriptionsIn);
     }
 } // namespace common
 } // namespace osvr
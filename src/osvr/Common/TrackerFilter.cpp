@@ -0,0 +1,304 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerFilter.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    namespace {
+        typedef Eigen::Array<double, 1, Eigen::Dynamic> SensorArray;
+
+        /// @brief Seconds assumed between samples of a sensor with the same
+        /// or out-of-order timestamps, and for a sensor's first sample.
+        static const double MIN_DT = 1e-4;
+
+        static const double PI = 3.14159265358979323846;
+
+        /// @brief Computes the weight given to a new sample by a
+        /// first-order low-pass filter, for each sensor.
+        ///
+        /// @param cutoff Cutoff frequency in Hz: a scalar, or one for each
+        /// sensor.
+        /// @param dt Seconds since the previous sample of each sensor.
+        /// @param alpha Where to write the weights: a block of existing
+        /// storage, so nothing is allocated.
+        template <typename Cutoff, typename Dt, typename Alpha>
+        inline void lowPassAlpha(Cutoff const &cutoff, Dt const &dt,
+                                 Eigen::ArrayBase<Alpha> const &alpha) {
+            const_cast<Eigen::ArrayBase<Alpha> &>(alpha) =
+                (1.0 + (2 * PI * cutoff * dt).inverse()).inverse();
+        }
+
+        /// @brief Reads a number from a filter description, checking that
+        /// it's within range.
+        inline double getParam(Json::Value const &config, const char *name,
+                               double defaultVal, double min, double max) {
+            const double ret = config.get(name, defaultVal).asDouble();
+            if (!(ret >= min && ret <= max)) {
+                throw std::runtime_error(
+                    std::string("Tracker filter parameter out of range: ") +
+                    name);
+            }
+            return ret;
+        }
+
+        static const double UNBOUNDED = 1e300;
+
+        class ExponentialFilter : public TrackerFilter {
+          public:
+            ExponentialFilter(double positionAlpha, double orientationAlpha)
+                : m_positionAlpha(positionAlpha),
+                  m_orientationAlpha(orientationAlpha) {}
+
+          private:
+            virtual void m_filter(std::size_t first, PoseMap &poses,
+                                  SensorArray const &) {
+                auto prev = m_previous().middleCols(first, poses.cols());
+                poses.topRows<3>() =
+                    prev.topRows<3>() +
+                    m_positionAlpha * (poses.topRows<3>() - prev.topRows<3>());
+                poses.bottomRows<4>() =
+                    prev.bottomRows<4>() +
+                    m_orientationAlpha *
+                        (poses.bottomRows<4>() - prev.bottomRows<4>());
+            }
+            virtual void m_resize(std::size_t) {}
+            virtual void m_resetSensor(std::size_t) {}
+
+            double m_positionAlpha;
+            double m_orientationAlpha;
+        };
+
+        struct OneEuroParams {
+            explicit OneEuroParams(Json::Value const &config)
+                : minCutoff(getParam(config, "minCutoff", 1, 1e-6, UNBOUNDED)),
+                  beta(getParam(config, "beta", 0, 0, UNBOUNDED)),
+                  derivativeCutoff(getParam(config, "derivativeCutoff", 1,
+                                            1e-6, UNBOUNDED)) {}
+            double minCutoff;
+            double beta;
+            double derivativeCutoff;
+        };
+
+        class OneEuroFilter : public TrackerFilter {
+          public:
+            OneEuroFilter(OneEuroParams const &position,
+                          OneEuroParams const &orientation)
+                : m_position(position), m_orientation(orientation) {}
+
+          private:
+            virtual void m_filter(std::size_t first, PoseMap &poses,
+                                  SensorArray const &dt) {
+                m_apply(0, 3, m_position, first, poses, dt);
+                m_apply(3, 4, m_orientation, first, poses, dt);
+            }
+
+            /// @brief Filters rows [row, row + rows) of each pose as a
+            /// vector: the cutoff adapts to the speed of the whole vector.
+            void m_apply(int row, int rows, OneEuroParams const &params,
+                         std::size_t first, PoseMap &poses,
+                         SensorArray const &dt) {
+                const auto n = poses.cols();
+                auto prev = m_previous().block(row, first, rows, n);
+                auto derivative = m_derivative.block(row, first, rows, n);
+                auto dx = m_dx.block(row, first, rows, n);
+                auto alpha = m_alpha.segment(first, n);
+                auto cutoff = m_cutoff.segment(first, n);
+                auto span = dt.segment(first, n);
+                auto x = poses.block(row, 0, rows, n);
+                dx = ((x - prev).array().rowwise() / span).matrix();
+                lowPassAlpha(params.derivativeCutoff, span, alpha);
+                derivative +=
+                    ((dx - derivative).array().rowwise() * alpha).matrix();
+                cutoff = params.minCutoff +
+                         params.beta * derivative.colwise().norm().array();
+                lowPassAlpha(cutoff, span, alpha);
+                x = prev + ((x - prev).array().rowwise() * alpha).matrix();
+            }
+
+            virtual void m_resize(std::size_t sensors) {
+                const auto old = m_derivative.cols();
+                m_derivative.conservativeResize(Eigen::NoChange, sensors);
+                m_derivative.rightCols(sensors - old).setZero();
+                m_dx.resize(Eigen::NoChange, sensors);
+                m_alpha.resize(sensors);
+                m_cutoff.resize(sensors);
+            }
+
+            virtual void m_resetSensor(std::size_t sensor) {
+                m_derivative.col(sensor).setZero();
+            }
+
+            OneEuroParams m_position;
+            OneEuroParams m_orientation;
+            /// @brief Filtered rate of change of each sensor's pose.
+            PoseMatrix m_derivative;
+            /// @brief Scratch space: the latest rate of change, and the
+            /// weight and cutoff frequency of each sensor.
+            PoseMatrix m_dx;
+            SensorArray m_alpha;
+            SensorArray m_cutoff;
+        };
+
+        class KalmanOrientationFilter : public TrackerFilter {
+          public:
+            KalmanOrientationFilter(double processNoise,
+                                    double measurementNoise)
+                : m_processNoise(processNoise),
+                  m_measurementNoise(measurementNoise) {}
+
+          private:
+            virtual void m_filter(std::size_t first, PoseMap &poses,
+                                  SensorArray const &dt) {
+                const auto n = poses.cols();
+                auto prev = m_previous().middleCols(first, n);
+                auto variance = m_variance.segment(first, n);
+                auto predicted = m_predicted.segment(first, n);
+                auto gain = m_gain.segment(first, n);
+                /// Predict (the orientation staying put, but less certainly
+                /// so), then correct.
+                predicted = variance + m_processNoise * dt.segment(first, n);
+                gain = predicted / (predicted + m_measurementNoise);
+                poses.bottomRows<4>() =
+                    prev.bottomRows<4>() +
+                    ((poses.bottomRows<4>() - prev.bottomRows<4>())
+                         .array()
+                         .rowwise() *
+                     gain).matrix();
+                variance = (1 - gain) * predicted;
+            }
+
+            virtual void m_resize(std::size_t sensors) {
+                const auto old = m_variance.size();
+                m_variance.conservativeResize(sensors);
+                m_variance.tail(sensors - old).setConstant(m_measurementNoise);
+                m_predicted.resize(sensors);
+                m_gain.resize(sensors);
+            }
+
+            virtual void m_resetSensor(std::size_t sensor) {
+                m_variance[sensor] = m_measurementNoise;
+            }
+
+            double m_processNoise;
+            double m_measurementNoise;
+            /// @brief Variance of each sensor's orientation estimate.
+            SensorArray m_variance;
+            /// @brief Scratch space: the predicted variance and the gain of
+            /// each sensor.
+            SensorArray m_predicted;
+            SensorArray m_gain;
+        };
+    } // namespace
+
+    unique_ptr<TrackerFilter> TrackerFilter::create(Json::Value const &config) {
+        const std::string type = config.get("type", "").asString();
+        unique_ptr<TrackerFilter> ret;
+        if (type == "exponential") {
+            const double alpha = getParam(config, "alpha", 0.5, 1e-6, 1);
+            ret.reset(new ExponentialFilter(
+                getParam(config, "positionAlpha", alpha, 1e-6, 1),
+                getParam(config, "orientationAlpha", alpha, 1e-6, 1)));
+        } else if (type == "oneEuro") {
+            ret.reset(new OneEuroFilter(OneEuroParams(config["position"]),
+                                        OneEuroParams(config["orientation"])));
+        } else if (type == "kalmanOrientation") {
+            ret.reset(new KalmanOrientationFilter(
+                getParam(config, "processNoise", 1, 0, UNBOUNDED),
+                getParam(config, "measurementNoise", 0.01, 1e-12,
+                         UNBOUNDED)));
+        } else {
+            throw std::runtime_error("Unknown tracker filter type: " + type);
+        }
+        return ret;
+    }
+
+    TrackerFilter::TrackerFilter() {}
+
+    TrackerFilter::~TrackerFilter() {}
+
+    void TrackerFilter::filter(util::time::TimeValue const &timestamp,
+                               OSVR_ChannelCount first, OSVR_PoseState poses[],
+                               OSVR_ChannelCount count) {
+        static_assert(sizeof(OSVR_PoseState) == 7 * sizeof(double),
+                      "Poses must be packed to filter them as a matrix");
+        if (count == 0) {
+            return;
+        }
+        const std::size_t end = std::size_t(first) + count;
+        if (end > m_valid.size()) {
+            m_prev.conservativeResize(Eigen::NoChange, end);
+            m_times.resize(end);
+            m_valid.resize(end, false);
+            m_dt.conservativeResize(end);
+            m_scratch.resize(end);
+            m_resize(end);
+        }
+        PoseMap samples(poses[0].translation.data, 7, count);
+        for (OSVR_ChannelCount i = 0; i < count; ++i) {
+            const std::size_t sensor = first + i;
+            if (m_valid[sensor]) {
+                m_dt[sensor] = std::max(
+                    util::time::duration(timestamp, m_times[sensor]), MIN_DT);
+            } else {
+                /// Nothing to smooth with: passes through unchanged.
+                m_prev.col(sensor) = samples.col(i);
+                m_resetSensor(sensor);
+                m_valid[sensor] = true;
+                m_dt[sensor] = MIN_DT;
+            }
+            m_times[sensor] = timestamp;
+        }
+
+        /// q and -q are the same orientation: use whichever is nearer the
+        /// previous one.
+        auto prev = m_prev.middleCols(first, count);
+        auto scratch = m_scratch.segment(first, count);
+        scratch = samples.bottomRows<4>()
+                      .cwiseProduct(prev.bottomRows<4>())
+                      .colwise()
+                      .sum()
+                      .array();
+        scratch = 1 - 2 * (scratch < 0).cast<double>();
+        samples.bottomRows<4>().array().rowwise() *= scratch;
+
+        m_filter(first, samples, m_dt);
+
+        scratch = samples.bottomRows<4>().colwise().norm().array();
+        samples.bottomRows<4>().array().rowwise() /= scratch;
+        prev = samples;
+    }
+
+    void TrackerFilter::reset() { m_valid.assign(m_valid.size(), false); }
+} // namespace common
+} // namespace osvr
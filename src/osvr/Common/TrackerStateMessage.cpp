@@ -0,0 +1,129 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerStateMessage.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Endianness.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+
+namespace osvr {
+namespace common {
+    class TrackerStateMessage::MessageSerialization {
+      public:
+        MessageSerialization(uint32_t sequence, int32_t sensor,
+                             OSVR_TrackerState const &state)
+            : m_sequence(sequence), m_sensor(sensor), m_state(state) {}
+
+        MessageSerialization() : m_sequence(0), m_sensor(0) {
+            m_state.flags = 0;
+            osvrPose3SetIdentity(&m_state.pose);
+            osvrVec3Zero(&m_state.linearVelocity);
+            osvrVec3Zero(&m_state.angularVelocity);
+            osvrVec3Zero(&m_state.linearAcceleration);
+            osvrVec3Zero(&m_state.angularAcceleration);
+        }
+
+        template <typename T> void processMessage(T &p) {
+            p(m_sequence);
+            p(m_sensor);
+            p(m_state.flags);
+            m_process(p, OSVR_TRACKER_POSITION_VALID,
+                      m_state.pose.translation.data);
+            m_process(p, OSVR_TRACKER_ORIENTATION_VALID,
+                      m_state.pose.rotation.data);
+            m_process(p, OSVR_TRACKER_LINEAR_VELOCITY_VALID,
+                      m_state.linearVelocity.data);
+            m_process(p, OSVR_TRACKER_ANGULAR_VELOCITY_VALID,
+                      m_state.angularVelocity.data);
+            m_process(p, OSVR_TRACKER_LINEAR_ACCELERATION_VALID,
+                      m_state.linearAcceleration.data);
+            m_process(p, OSVR_TRACKER_ANGULAR_ACCELERATION_VALID,
+                      m_state.angularAcceleration.data);
+        }
+
+        uint32_t getSequence() const { return m_sequence; }
+        int32_t getSensor() const { return m_sensor; }
+        OSVR_TrackerState const &getState() const { return m_state; }
+
+      private:
+        /// @brief Processes the values of one part of the state, if the
+        /// flags mark it valid.
+        template <typename T, std::size_t N>
+        void m_process(T &p, OSVR_TrackerStateFlags flag, double(&vals)[N]) {
+            if (!(m_state.flags & flag)) {
+                return;
+            }
+            const bool single =
+                (m_state.flags & OSVR_TRACKER_SINGLE_PRECISION) != 0;
+            for (auto &val : vals) {
+                if (single) {
+                    /// Sent as the bits of the float, since Endianness.h
+                    /// doesn't byte-swap floats themselves.
+                    uint32_t bits = serialization::safe_pun<uint32_t>(
+                        static_cast<float>(val));
+                    p(bits);
+                    val = serialization::safe_pun<float>(bits);
+                } else {
+                    p(val);
+                }
+            }
+        }
+
+        uint32_t m_sequence;
+        int32_t m_sensor;
+        OSVR_TrackerState m_state;
+    };
+
+    void TrackerStateMessage::encode(Buffer<> &buf, uint32_t sequence,
+                                     int32_t sensor,
+                                     OSVR_TrackerState const &state) {
+        buf.getContents().clear();
+        MessageSerialization msg(sequence, sensor, state);
+        serialize(buf, msg);
+    }
+
+    bool TrackerStateMessage::decode(char const *buf, std::size_t len,
+                                     uint32_t &sequence, int32_t &sensor,
+                                     OSVR_TrackerState &state) {
+        auto bufwrap = ExternalBufferReadingWrapper<char>(buf, len);
+        auto reader = BufferReader<decltype(bufwrap)>(bufwrap);
+        MessageSerialization msg;
+        try {
+            deserialize(reader, msg);
+        } catch (std::runtime_error &) {
+            return false;
+        }
+        sequence = msg.getSequence();
+        sensor = msg.getSensor();
+        state = msg.getState();
+        return true;
+    }
+} // namespace common
+} // namespace osvr
@@ -29,15 +29,19 @@
 #include <osvr/PluginHost/RegistrationContext.h>
 #include <osvr/Connection/MessageType.h>
 #include "VrpnBasedConnection.h"
+#include "UnixSocketConnection.h"
+#include "InProcessConnection.h"
+#include "SharedMemoryConnection.h"
 #include "GenericConnectionDevice.h"
 #include <osvr/Util/Verbosity.h>
+#include <osvr/Common/UnixSocketPath.h>
 
 // Library/third-party includes
 #include <boost/range/algorithm.hpp>
 #include <boost/assert.hpp>
 
 // Standard includes
-// - none
+#include <stdexcept>
 
 namespace osvr {
 namespace connection {
@@ -55,6 +59,36 @@ namespace connection {
         return conn;
     }
 
+    ConnectionPtr Connection::createUnixSocketConnection(
+        boost::optional<std::string const &> path) {
+#ifdef OSVR_HAVE_UNIX_SOCKETS
+        ConnectionPtr conn(make_shared<UnixSocketConnection>(
+            (path && !path->empty()) ? *path
+                                     : common::getDefaultUnixSocketPath()));
+        return conn;
+#else
+        (void)path;
+        throw std::runtime_error(
+            "Unix domain socket connections are not supported on this "
+            "platform.");
+#endif
+    }
+
+    ConnectionPtr Connection::createInProcessConnection(
+        boost::optional<std::string const &> name) {
+        ConnectionPtr conn(
+            make_shared<InProcessConnection>(name ? *name : std::string()));
+        return conn;
+    }
+
+    ConnectionPtr Connection::createSharedMemoryConnection(
+        boost::optional<std::string const &> name) {
+        ConnectionPtr conn(make_shared<SharedMemoryConnection>(
+            (name && !name->empty()) ? *name
+                                     : common::getDefaultSharedMemoryName()));
+        return conn;
+    }
+
     ConnectionPtr
     Connection::retrieveConnection(const pluginhost::RegistrationContext &ctx) {
         ConnectionPtr ret;
@@ -127,9 +161,19 @@ namespace connection {
                 OSVR_DEV_VERBOSE(" - " << name);
             }
         }
+        device->setSubscription(
+            m_subscriptions.getDevice(device->getName()));
         m_devices.push_back(device);
     }
 
+    SubscriptionFilter &Connection::getSubscriptionFilter() {
+        return m_subscriptions;
+    }
+
+    ReportSuppression &Connection::getReportSuppression() {
+        return m_reportSuppression;
+    }
+
     void Connection::process() {
         // Process the connection first.
         m_process();
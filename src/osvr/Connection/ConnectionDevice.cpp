@@ -57,6 +57,9 @@ namespace connection {
                                     MessageType *type, const char *bytestream,
                                     size_t len) {
         BOOST_ASSERT(type);
+        if (m_subscription && !m_subscription->wantsAny()) {
+            return;
+        }
         m_sendData(timestamp, type, bytestream, len);
     }
 
@@ -65,6 +68,11 @@ namespace connection {
         m_token = &token;
     }
 
+    void ConnectionDevice::setSubscription(
+        DeviceSubscriptionPtr const &subscription) {
+        m_subscription = subscription;
+    }
+
     bool ConnectionDevice::m_hasDeviceToken() const {
         return m_token != nullptr;
     }
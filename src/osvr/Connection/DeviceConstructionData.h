@@ -33,7 +33,8 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
-// - none
+#include <vector>
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -47,6 +48,10 @@ namespace connection {
         DeviceInitObject &obj;
         vrpn_Connection *conn;
         vrpn_BaseFlexServer *flexServer;
+        /// @brief Functions, added by the servers, that send any reports
+        /// held back by rate limiting whose time has come: for the
+        /// connection device to call each time through the server loop.
+        std::vector<std::function<void()> > heldReportFlushers;
     };
 } // namespace connection
 } // namespace osvr
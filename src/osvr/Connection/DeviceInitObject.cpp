@@ -38,11 +38,12 @@ using osvr::connection::Connection;
 OSVR_DeviceInitObject::OSVR_DeviceInitObject(OSVR_PluginRegContext ctx)
     : m_context(&PluginSpecificRegistrationContext::get(ctx)),
       m_conn(Connection::retrieveConnection(m_context->getParent())),
-      m_analogIface(nullptr), m_buttonIface(nullptr), m_tracker(false) {}
+      m_analogIface(nullptr), m_analogScale(1), m_buttonIface(nullptr),
+      m_tracker(false) {}
 
 OSVR_DeviceInitObject::OSVR_DeviceInitObject(
     osvr::connection::ConnectionPtr conn)
-    : m_context(nullptr), m_conn(conn), m_tracker(false) {}
+    : m_context(nullptr), m_conn(conn), m_analogScale(1), m_tracker(false) {}
 
 void OSVR_DeviceInitObject::setName(std::string const &n) {
     m_name = n;
@@ -73,6 +74,12 @@ void OSVR_DeviceInitObject::setAnalogs(
     }
 }
 
+void OSVR_DeviceInitObject::setAnalogEncoding(
+    osvr::common::AnalogFrameMessage::Encoding encoding, double scale) {
+    m_analogEncoding = encoding;
+    m_analogScale = scale;
+}
+
 void OSVR_DeviceInitObject::returnAnalogInterface(
     osvr::connection::AnalogServerInterface &iface) {
     *m_analogIface = &iface;
@@ -64,7 +64,12 @@ OSVR_DeviceTokenObject::createVirtualDevice(std::string const &name,
                                             ConnectionPtr const &conn) {
     DeviceInitObject init(conn);
     init.setName(name);
-    DeviceTokenPtr ret(new VirtualDeviceToken(name));
+    return createVirtualDevice(init);
+}
+
+DeviceTokenPtr
+OSVR_DeviceTokenObject::createVirtualDevice(DeviceInitObject &init) {
+    DeviceTokenPtr ret(new VirtualDeviceToken(init.getQualifiedName()));
     ret->m_sharedInit(init);
     return ret;
 }
@@ -79,7 +84,7 @@ std::string const &OSVR_DeviceTokenObject::getName() const { return m_name; }
 void OSVR_DeviceTokenObject::sendData(MessageType *type, const char *bytestream,
                                       size_t len) {
     osvr::util::time::TimeValue tv;
-    osvr::util::time::getNow(tv);
+    osvr::util::time::getSteadyNow(tv);
     m_sendData(tv, type, bytestream, len);
 }
 void OSVR_DeviceTokenObject::sendData(
@@ -0,0 +1,88 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DirectReportConnectionDevice_h_GUID_428E58D2_26AC_4180_9043_3D30346DA6C2
+#define INCLUDED_DirectReportConnectionDevice_h_GUID_428E58D2_26AC_4180_9043_3D30346DA6C2
+
+// Internal Includes
+#include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Util/UniquePtr.h>
+#include "DirectReportServer.h"
+#include "DeviceConstructionData.h"
+#include "VrpnBaseFlexServer.h"
+#include "VrpnMessageType.h"
+
+// Library/third-party includes
+#include <vrpn_ConnectionPtr.h>
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace connection {
+    /// @brief ConnectionDevice implementation for connections that pass
+    /// analog, button, and tracker reports straight to clients on the same
+    /// machine: device components and other messages still use VRPN.
+    class DirectReportConnectionDevice : public ConnectionDevice {
+      public:
+        DirectReportConnectionDevice(DeviceInitObject &init,
+                                     vrpn_ConnectionPtr const &vrpnConn,
+                                     uint32_t device,
+                                     DirectReportServer::Sink const &sink)
+            : ConnectionDevice(init.getQualifiedName()) {
+            DeviceConstructionData data(init, vrpnConn.get());
+            m_baseobj.reset(new vrpn_BaseFlexServer(data));
+            for (auto const &component : init.getComponents()) {
+                m_baseobj->addComponent(component);
+            }
+            ConnectionPtr conn = init.getConnection();
+            m_reports.reset(new DirectReportServer(
+                init, device, conn->getSubscriptionFilter().getDevice(
+                                  init.getQualifiedName()),
+                conn->getReportSuppression().getDevice(init.getQualifiedName()),
+                sink));
+        }
+        virtual ~DirectReportConnectionDevice() {}
+        virtual void m_process() {
+            m_getDeviceToken().connectionInteract();
+            m_reports->flushHeld();
+            m_baseobj->mainloop();
+        }
+        virtual void m_sendData(util::time::TimeValue const &timestamp,
+                                MessageType *type, const char *bytestream,
+                                size_t len) {
+            VrpnMessageType *msgtype = static_cast<VrpnMessageType *>(type);
+            m_baseobj->sendData(timestamp, msgtype->getID(), bytestream, len);
+        }
+
+      private:
+        unique_ptr<vrpn_BaseFlexServer> m_baseobj;
+        unique_ptr<DirectReportServer> m_reports;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_DirectReportConnectionDevice_h_GUID_428E58D2_26AC_4180_9043_3D30346DA6C2
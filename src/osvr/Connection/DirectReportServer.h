@@ -0,0 +1,383 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DirectReportServer_h_GUID_B16A66A5_BE9C_4D74_A9F5_15911C2F6E5F
+#define INCLUDED_DirectReportServer_h_GUID_B16A66A5_BE9C_4D74_A9F5_15911C2F6E5F
+
+// Internal Includes
+#include <osvr/Connection/AnalogServerInterface.h>
+#include <osvr/Connection/ButtonServerInterface.h>
+#include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/SubscriptionFilter.h>
+#include <osvr/Connection/ReportSuppression.h>
+#include <osvr/Common/DirectReportPacket.h>
+#include <osvr/Common/ReportSequence.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <functional>
+#include <vector>
+#include <algorithm>
+
+namespace osvr {
+namespace connection {
+    /// @brief Implements the analog, button, and tracker server interfaces
+    /// of a device by handing reports, as DirectReportPacket objects, to a
+    /// transport for clients on the same machine.
+    ///
+    /// Like the VRPN servers, analogs and buttons are only reported when
+    /// they change, and only sensors/channels some client uses are reported.
+    class DirectReportServer : public AnalogServerInterface,
+                               public ButtonServerInterface,
+                               public TrackerServerInterface,
+                               boost::noncopyable {
+      public:
+        /// @brief Function called to transport each packet.
+        typedef std::function<void(common::DirectReportPacket const &)> Sink;
+
+        /// @brief Constructor: returns the interfaces requested by the init
+        /// object.
+        ///
+        /// @param device The number identifying this device in packets.
+        DirectReportServer(DeviceInitObject &init, uint32_t device,
+                           DeviceSubscriptionPtr const &subscription,
+                           DeviceReportSuppressionPtr const &suppression,
+                           Sink const &sink)
+            : m_device(device), m_subscription(subscription),
+              m_suppression(suppression), m_sink(sink), m_analogSent(false),
+              m_heldAnalogs(suppression), m_poses(suppression),
+              m_heldPoses(suppression), m_heldStates(suppression),
+              m_heldBatches(suppression) {
+            if (init.getAnalogs()) {
+                m_analogs.resize(*init.getAnalogs());
+                m_latestAnalogs.resize(*init.getAnalogs());
+                init.returnAnalogInterface(*this);
+            }
+            if (init.getButtons()) {
+                m_buttons.resize(*init.getButtons());
+                init.returnButtonInterface(*this);
+            }
+            if (init.getTracker()) {
+                init.returnTrackerInterface(*this);
+            }
+        }
+
+        virtual bool setValue(OSVR_AnalogState val, OSVR_ChannelCount chan,
+                              util::time::TimeValue const &timestamp) {
+            if (chan >= m_analogs.size()) {
+                return false;
+            }
+            m_latestAnalogs[chan] = val;
+            const bool wasHeld = m_heldAnalogs.isHolding();
+            if (m_heldAnalogs.hold(0, timestamp)) {
+                return true;
+            }
+            if (wasHeld) {
+                /// Other channels may have changed while held back.
+                m_sendAnalogs(timestamp);
+                return true;
+            }
+            if (!m_analogKeepAliveDue(timestamp) &&
+                m_suppression->isUnchanged(m_analogs[chan], val)) {
+                if (m_suppression->isSuppressed(m_analogs[chan], val) &&
+                    m_subscription->wants(chan)) {
+                    m_suppression->countSuppressed();
+                }
+                return true;
+            }
+            m_analogs[chan] = val;
+            if (m_subscription->wants(chan)) {
+                m_packet.setAnalogs(m_device, chan, timestamp, &val, 1);
+                m_packet.setSequence(m_analogSequence.next());
+                m_sink(m_packet);
+                m_noteAnalogSent(timestamp);
+            }
+            return true;
+        }
+
+        virtual void setValues(OSVR_AnalogState val[],
+                               OSVR_ChannelCount chans,
+                               util::time::TimeValue const &timestamp) {
+            chans = std::min(chans, OSVR_ChannelCount(m_analogs.size()));
+            std::copy(val, val + chans, m_latestAnalogs.begin());
+            if (m_heldAnalogs.hold(0, timestamp)) {
+                /// Too soon: m_latestAnalogs keeps the newest values until
+                /// they may be sent.
+                return;
+            }
+            m_sendAnalogs(timestamp);
+        }
+
+        virtual bool setValue(OSVR_ButtonState val, OSVR_ChannelCount chan,
+                              util::time::TimeValue const &timestamp) {
+            if (chan >= m_buttons.size()) {
+                return false;
+            }
+            m_setButton(val, chan, timestamp);
+            return true;
+        }
+
+        virtual void setValues(OSVR_ButtonState val[],
+                               OSVR_ChannelCount chans,
+                               util::time::TimeValue const &timestamp) {
+            chans = std::min(chans, OSVR_ChannelCount(m_buttons.size()));
+            for (OSVR_ChannelCount i = 0; i < chans; ++i) {
+                m_setButton(val[i], i, timestamp);
+            }
+        }
+
+        virtual void sendReport(OSVR_PositionState const &val,
+                                OSVR_ChannelCount chan,
+                                util::time::TimeValue const &timestamp) {
+            OSVR_PoseState pose;
+            pose.translation = val;
+            pose.rotation.data[0] = 1;
+            pose.rotation.data[1] = 0;
+            pose.rotation.data[2] = 0;
+            pose.rotation.data[3] = 0;
+            sendReport(pose, chan, timestamp);
+        }
+
+        virtual void sendReport(OSVR_OrientationState const &val,
+                                OSVR_ChannelCount chan,
+                                util::time::TimeValue const &timestamp) {
+            OSVR_PoseState pose;
+            pose.translation.data[0] = 0;
+            pose.translation.data[1] = 0;
+            pose.translation.data[2] = 0;
+            pose.rotation = val;
+            sendReport(pose, chan, timestamp);
+        }
+
+        virtual void sendReport(OSVR_PoseState const &val,
+                                OSVR_ChannelCount chan,
+                                util::time::TimeValue const &timestamp) {
+            if (!m_subscription->wants(chan)) {
+                return;
+            }
+            if (auto held = m_heldPoses.hold(chan, timestamp)) {
+                *held = val;
+                return;
+            }
+            m_sendPose(val, chan, timestamp);
+        }
+
+        virtual void sendReport(OSVR_TrackerState const &val,
+                                OSVR_ChannelCount chan,
+                                util::time::TimeValue const &timestamp) {
+            if (!m_subscription->wants(chan)) {
+                return;
+            }
+            if (auto held = m_heldStates.hold(chan, timestamp)) {
+                *held = val;
+                return;
+            }
+            m_sendState(val, chan, timestamp);
+        }
+
+        virtual void sendReports(OSVR_PoseState const val[],
+                                 OSVR_ChannelCount chans,
+                                 util::time::TimeValue const &timestamp) {
+            const OSVR_ChannelCount perPacket =
+                OSVR_ChannelCount(common::DirectReportPacket::maxPoses());
+            for (OSVR_ChannelCount first = 0; first < chans;
+                 first += perPacket) {
+                const OSVR_ChannelCount count =
+                    std::min(chans - first, perPacket);
+                if (!m_subscription->wantsAnyOf(first, count)) {
+                    continue;
+                }
+                /// Batches are held back as a whole.
+                if (auto held =
+                        m_heldBatches.hold(first / perPacket, timestamp)) {
+                    held->assign(val + first, val + first + count);
+                    continue;
+                }
+                m_sendPoses(first, val + first, count, timestamp);
+            }
+        }
+
+        /// @brief Sends the reports held back by the rate limit whose time
+        /// has come: to call each time through the server loop.
+        void flushHeld() {
+            m_heldAnalogs.flush([&](OSVR_ChannelCount,
+                                    util::time::TimeValue const &timestamp) {
+                m_sendAnalogs(timestamp);
+            });
+            m_heldPoses.flush([&](OSVR_ChannelCount chan,
+                                  OSVR_PoseState const &pose,
+                                  util::time::TimeValue const &timestamp) {
+                m_sendPose(pose, chan, timestamp);
+            });
+            m_heldStates.flush([&](OSVR_ChannelCount chan,
+                                   OSVR_TrackerState const &state,
+                                   util::time::TimeValue const &timestamp) {
+                m_sendState(state, chan, timestamp);
+            });
+            const OSVR_ChannelCount perPacket =
+                OSVR_ChannelCount(common::DirectReportPacket::maxPoses());
+            m_heldBatches.flush([&](OSVR_ChannelCount batch,
+                                    std::vector<OSVR_PoseState> const &poses,
+                                    util::time::TimeValue const &timestamp) {
+                m_sendPoses(batch * perPacket, poses.data(),
+                            OSVR_ChannelCount(poses.size()), timestamp);
+            });
+        }
+
+      private:
+        void m_sendPose(OSVR_PoseState const &val, OSVR_ChannelCount chan,
+                        util::time::TimeValue const &timestamp) {
+            if (!m_poses.shouldSend(chan, val, timestamp)) {
+                return;
+            }
+            m_packet.setPose(m_device, chan, timestamp, val);
+            m_packet.setSequence(m_trackerSequence.next());
+            m_sink(m_packet);
+        }
+
+        void m_sendState(OSVR_TrackerState const &val,
+                         OSVR_ChannelCount chan,
+                         util::time::TimeValue const &timestamp) {
+            m_packet.setTrackerState(m_device, chan, timestamp, val);
+            m_packet.setSequence(m_trackerSequence.next());
+            m_sink(m_packet);
+        }
+
+        void m_sendPoses(OSVR_ChannelCount first, OSVR_PoseState const val[],
+                         OSVR_ChannelCount count,
+                         util::time::TimeValue const &timestamp) {
+            if (!m_poses.shouldSend(first, val, count, timestamp)) {
+                return;
+            }
+            m_packet.setPoses(m_device, first, timestamp, val, count);
+            m_packet.setSequence(m_trackerSequence.next());
+            m_sink(m_packet);
+        }
+
+        /// @brief Sends the range of channels spanning those in use that
+        /// changed since last sent, in as many packets as it takes.
+        void m_sendAnalogs(util::time::TimeValue const &timestamp) {
+            OSVR_AnalogState const *val = m_latestAnalogs.data();
+            const OSVR_ChannelCount chans =
+                OSVR_ChannelCount(m_latestAnalogs.size());
+            const bool keepAlive = m_analogKeepAliveDue(timestamp);
+            OSVR_ChannelCount first = chans;
+            OSVR_ChannelCount end = 0;
+            bool suppressed = false;
+            for (OSVR_ChannelCount i = 0; i < chans; ++i) {
+                if (!keepAlive &&
+                    m_suppression->isUnchanged(m_analogs[i], val[i])) {
+                    suppressed = suppressed ||
+                                 (m_suppression->isSuppressed(m_analogs[i],
+                                                              val[i]) &&
+                                  m_subscription->wants(i));
+                    continue;
+                }
+                if (m_subscription->wants(i)) {
+                    first = std::min(first, i);
+                    end = i + 1;
+                } else {
+                    m_analogs[i] = val[i];
+                }
+            }
+            if (first >= end) {
+                if (suppressed) {
+                    m_suppression->countSuppressed();
+                }
+                return;
+            }
+            std::copy(val + first, val + end, m_analogs.begin() + first);
+            const OSVR_ChannelCount perPacket =
+                OSVR_ChannelCount(common::DirectReportPacket::maxValues());
+            for (; first < end; first += perPacket) {
+                m_packet.setAnalogs(m_device, first, timestamp, val + first,
+                                    std::min(end - first, perPacket));
+                m_packet.setSequence(m_analogSequence.next());
+                m_sink(m_packet);
+            }
+            m_noteAnalogSent(timestamp);
+        }
+
+        bool m_analogKeepAliveDue(util::time::TimeValue const &timestamp) {
+            return m_analogSent &&
+                   m_suppression->isKeepAliveDue(m_lastAnalogSent, timestamp);
+        }
+
+        void m_noteAnalogSent(util::time::TimeValue const &timestamp) {
+            m_analogSent = true;
+            m_lastAnalogSent = timestamp;
+            m_suppression->countSent();
+        }
+
+        void m_setButton(OSVR_ButtonState val, OSVR_ChannelCount chan,
+                         util::time::TimeValue const &timestamp) {
+            if (m_buttons[chan] == val) {
+                return;
+            }
+            m_buttons[chan] = val;
+            if (m_subscription->wants(chan)) {
+                m_packet.setButtons(m_device, chan, timestamp, &val, 1);
+                m_packet.setSequence(m_buttonSequence.next());
+                m_sink(m_packet);
+            }
+        }
+
+        uint32_t m_device;
+        DeviceSubscriptionPtr m_subscription;
+        DeviceReportSuppressionPtr m_suppression;
+        Sink m_sink;
+        /// @brief Analog values as last sent, or as last set for channels
+        /// not in use.
+        std::vector<OSVR_AnalogState> m_analogs;
+        /// @brief Analog values as last set.
+        std::vector<OSVR_AnalogState> m_latestAnalogs;
+        bool m_analogSent;
+        util::time::TimeValue m_lastAnalogSent;
+        /// @brief Holds back analog reports that come faster than the
+        /// device's maximum rate, for the device as a whole.
+        ReportRateLimiter m_heldAnalogs;
+        PoseSuppressor m_poses;
+        /// @brief Hold back tracker reports that come faster than the
+        /// device's maximum rate.
+        ReportConflator<OSVR_PoseState> m_heldPoses;
+        ReportConflator<OSVR_TrackerState> m_heldStates;
+        /// @brief Indexed by packet: first sensor divided by maxPoses().
+        ReportConflator<std::vector<OSVR_PoseState> > m_heldBatches;
+        std::vector<OSVR_ButtonState> m_buttons;
+        /// @brief Each kind of report is numbered separately, since clients
+        /// route each kind separately.
+        common::ReportSequenceCounter m_analogSequence;
+        common::ReportSequenceCounter m_buttonSequence;
+        common::ReportSequenceCounter m_trackerSequence;
+        /// @brief Scratch packet, to avoid a large object on the stack for
+        /// each report.
+        common::DirectReportPacket m_packet;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_DirectReportServer_h_GUID_B16A66A5_BE9C_4D74_A9F5_15911C2F6E5F
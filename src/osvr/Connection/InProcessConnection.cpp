@@ -0,0 +1,63 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "InProcessConnection.h"
+#include "DirectReportConnectionDevice.h"
+#include "VrpnConnectionKind.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+
+namespace osvr {
+namespace connection {
+    InProcessConnection::InProcessConnection(std::string const &hubName)
+        : VrpnBasedConnection(VRPN_LOCAL_ONLY),
+          m_hub(common::InProcessReportHub::get(hubName)) {
+        if (!m_hub->attachServer()) {
+            throw std::runtime_error("An in-process server named \"" +
+                                     hubName + "\" is already running.");
+        }
+    }
+
+    InProcessConnection::~InProcessConnection() { m_hub->detachServer(); }
+
+    const char *InProcessConnection::getConnectionKindID() {
+        return getInProcessConnectionKindID();
+    }
+
+    ConnectionDevicePtr
+    InProcessConnection::m_createConnectionDevice(DeviceInitObject &init) {
+        uint32_t device = m_hub->addDevice(init.getQualifiedName());
+        common::InProcessReportHubPtr hub = m_hub;
+        ConnectionDevicePtr ret = make_shared<DirectReportConnectionDevice>(
+            init, m_getVrpnConnection(), device,
+            [hub](common::DirectReportPacket const &p) { hub->publish(p); });
+        return ret;
+    }
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,69 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InProcessConnection_h_GUID_D257BE9C_C10F_4AB1_8BE7_EA8B96D291B5
+#define INCLUDED_InProcessConnection_h_GUID_D257BE9C_C10F_4AB1_8BE7_EA8B96D291B5
+
+// Internal Includes
+#include "VrpnBasedConnection.h"
+#include <osvr/Common/InProcessReportHub.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace connection {
+    /// @brief A local-only VRPN connection that hands analog, button, and
+    /// tracker reports to client contexts in the same process through an
+    /// InProcessReportHub, without sockets or serialization.
+    ///
+    /// Everything else (system messages, device components, and other
+    /// messages) still goes over the VRPN connection.
+    class InProcessConnection : public VrpnBasedConnection {
+      public:
+        /// @brief Constructor
+        ///
+        /// @param hubName Name clients use to find this connection's hub.
+        ///
+        /// @throws std::runtime_error if another connection in this process
+        /// already publishes to the hub.
+        explicit InProcessConnection(std::string const &hubName);
+        virtual ~InProcessConnection();
+
+        virtual const char *getConnectionKindID();
+
+      protected:
+        virtual ConnectionDevicePtr
+        m_createConnectionDevice(DeviceInitObject &init);
+
+      private:
+        common::InProcessReportHubPtr m_hub;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_InProcessConnection_h_GUID_D257BE9C_C10F_4AB1_8BE7_EA8B96D291B5
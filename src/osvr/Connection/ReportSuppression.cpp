@@ -0,0 +1,131 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/ReportSuppression.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace connection {
+    bool DeviceReportSuppression::isUnchanged(OSVR_PoseState const &a,
+                                              OSVR_PoseState const &b) const {
+        if (!m_settings.enabled) {
+            return false;
+        }
+        for (int i = 0; i < 3; ++i) {
+            if (!(std::abs(a.translation.data[i] - b.translation.data[i]) <=
+                  m_settings.epsilon)) {
+                return false;
+            }
+        }
+        for (int i = 0; i < 4; ++i) {
+            if (!(std::abs(a.rotation.data[i] - b.rotation.data[i]) <=
+                  m_settings.epsilon)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool PoseSuppressor::shouldSend(OSVR_ChannelCount sensor,
+                                    OSVR_PoseState const &pose,
+                                    util::time::TimeValue const &timestamp) {
+        if (m_isUnchanged(sensor, pose, timestamp)) {
+            m_device->countSuppressed();
+            return false;
+        }
+        m_record(sensor, pose, timestamp);
+        m_device->countSent();
+        return true;
+    }
+
+    bool PoseSuppressor::shouldSend(OSVR_ChannelCount first,
+                                    OSVR_PoseState const poses[],
+                                    OSVR_ChannelCount count,
+                                    util::time::TimeValue const &timestamp) {
+        bool send = false;
+        for (OSVR_ChannelCount i = 0; i < count && !send; ++i) {
+            send = !m_isUnchanged(first + i, poses[i], timestamp);
+        }
+        if (!send) {
+            m_device->countSuppressed();
+            return false;
+        }
+        for (OSVR_ChannelCount i = 0; i < count; ++i) {
+            m_record(first + i, poses[i], timestamp);
+        }
+        m_device->countSent();
+        return true;
+    }
+
+    bool PoseSuppressor::m_isUnchanged(
+        OSVR_ChannelCount sensor, OSVR_PoseState const &pose,
+        util::time::TimeValue const &timestamp) const {
+        if (sensor >= m_entries.size()) {
+            return false;
+        }
+        Entry const &entry = m_entries[sensor];
+        return entry.valid && m_device->isUnchanged(entry.pose, pose) &&
+               !m_device->isKeepAliveDue(entry.sent, timestamp);
+    }
+
+    void PoseSuppressor::m_record(OSVR_ChannelCount sensor,
+                                  OSVR_PoseState const &pose,
+                                  util::time::TimeValue const &timestamp) {
+        if (!m_device->getSettings().enabled) {
+            /// Nothing will be compared with it.
+            return;
+        }
+        if (sensor >= m_entries.size()) {
+            m_entries.resize(sensor + 1);
+        }
+        Entry &entry = m_entries[sensor];
+        entry.valid = true;
+        entry.pose = pose;
+        entry.sent = timestamp;
+    }
+
+    DeviceReportSuppressionPtr
+    ReportSuppression::getDevice(std::string const &device) {
+        auto &ret = m_devices[device];
+        if (!ret) {
+            ret = make_shared<DeviceReportSuppression>();
+            ret->m_settings = m_defaults;
+            ret->m_connectionBudget = m_budget;
+        }
+        return ret;
+    }
+
+    void
+    ReportSuppression::setDevice(std::string const &device,
+                                 ReportSuppressionSettings const &settings) {
+        getDevice(device)->m_settings = settings;
+    }
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,72 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SharedMemoryConnection.h"
+#include "DirectReportConnectionDevice.h"
+#include "VrpnConnectionKind.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+
+namespace osvr {
+namespace connection {
+    SharedMemoryConnection::SharedMemoryConnection(std::string const &name)
+        : VrpnBasedConnection(VRPN_LOCAL_ONLY),
+          m_rings(common::SharedMemoryReportRings::create(name)) {}
+
+    SharedMemoryConnection::~SharedMemoryConnection() {}
+
+    const char *SharedMemoryConnection::getConnectionKindID() {
+        return getSharedMemoryConnectionKindID();
+    }
+
+    ConnectionDevicePtr
+    SharedMemoryConnection::m_createConnectionDevice(DeviceInitObject &init) {
+        uint32_t device = 0;
+        if (!m_rings->addDevice(init.getQualifiedName(), device)) {
+            throw std::runtime_error(
+                "Shared memory region is full: can't add device " +
+                init.getQualifiedName());
+        }
+        /// Async devices send while the main thread is held at a safe point,
+        /// so only one thread publishes at a time.
+        common::SharedMemoryReportRings *rings = m_rings.get();
+        ConnectionDevicePtr ret = make_shared<DirectReportConnectionDevice>(
+            init, m_getVrpnConnection(), device,
+            [rings](common::DirectReportPacket const &p) {
+                rings->publish(p);
+            });
+        return ret;
+    }
+
+    void SharedMemoryConnection::m_process() {
+        m_rings->heartbeat();
+        VrpnBasedConnection::m_process();
+    }
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,71 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SharedMemoryConnection_h_GUID_5308A178_D5E0_458F_833D_C3A9462CA04C
+#define INCLUDED_SharedMemoryConnection_h_GUID_5308A178_D5E0_458F_833D_C3A9462CA04C
+
+// Internal Includes
+#include "VrpnBasedConnection.h"
+#include <osvr/Common/SharedMemoryReportRings.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace connection {
+    /// @brief A local-only VRPN connection that publishes analog, button,
+    /// and tracker reports to clients on the same machine through a
+    /// SharedMemoryReportRings region, so reading them needs no system call.
+    ///
+    /// Everything else (system messages, device components, and other
+    /// messages) still goes over the VRPN connection.
+    class SharedMemoryConnection : public VrpnBasedConnection {
+      public:
+        /// @brief Constructor
+        ///
+        /// @param name Name of the shared memory region to create.
+        /// @throws std::runtime_error if the region could not be created.
+        explicit SharedMemoryConnection(std::string const &name);
+        virtual ~SharedMemoryConnection();
+
+        virtual const char *getConnectionKindID();
+
+      protected:
+        /// @throws std::runtime_error if the region has no room for another
+        /// device.
+        virtual ConnectionDevicePtr
+        m_createConnectionDevice(DeviceInitObject &init);
+        /// @brief Beats the region's heartbeat.
+        virtual void m_process();
+
+      private:
+        common::SharedMemoryReportRingsPtr m_rings;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_SharedMemoryConnection_h_GUID_5308A178_D5E0_458F_833D_C3A9462CA04C
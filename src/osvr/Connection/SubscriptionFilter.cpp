@@ -0,0 +1,201 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/SubscriptionFilter.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <utility>
+
+namespace osvr {
+namespace connection {
+    /// @brief Limit on chains of dependencies followed, guarding against
+    /// cycles.
+    static const std::size_t MAX_DEPENDENCY_DEPTH = 8;
+
+    void DeviceSubscription::m_reset(bool wanted) {
+        m_all = wanted;
+        m_any = wanted;
+        m_sensors.clear();
+    }
+
+    void DeviceSubscription::m_add(int sensor) {
+        m_any = true;
+        if (sensor < 0) {
+            m_all = true;
+            return;
+        }
+        auto idx = static_cast<std::size_t>(sensor);
+        if (idx >= m_sensors.size()) {
+            m_sensors.resize(idx + 1, false);
+        }
+        m_sensors[idx] = true;
+    }
+
+    SubscriptionFilter::SubscriptionFilter()
+        : m_enabled(false), m_connections(0) {}
+
+    void SubscriptionFilter::setEnabled(bool enabled) {
+        if (enabled == m_enabled) {
+            return;
+        }
+        m_enabled = enabled;
+        m_recompute();
+    }
+
+    DeviceSubscriptionPtr
+    SubscriptionFilter::getDevice(std::string const &device) {
+        auto &ret = m_devices[device];
+        if (!ret) {
+            ret = make_shared<DeviceSubscription>();
+            ret->m_reset(!isFiltering());
+        }
+        return ret;
+    }
+
+    void SubscriptionFilter::setClientSubscriptions(
+        std::string const &clientId, std::string const &connectionId,
+        common::SourceSubscriptionList const &sources,
+        util::time::TimeValue const &now) {
+        auto inserted =
+            m_clients.insert(std::make_pair(clientId, ClientEntry()));
+        auto &client = inserted.first->second;
+        client.lastSeen = now;
+        if (!inserted.second && client.connection == connectionId &&
+            client.sources.size() == sources.size() &&
+            std::equal(begin(sources), end(sources),
+                       begin(client.sources))) {
+            return;
+        }
+        if (inserted.second || client.connection != connectionId) {
+            if (!inserted.second) {
+                /// Moved to another connection: count it only there.
+                m_removeFromConnection(client.connection);
+            }
+            client.connection = connectionId;
+            ++m_clientsPerConnection[connectionId];
+        }
+        client.sources = sources;
+        m_recompute();
+    }
+
+    void SubscriptionFilter::removeClient(std::string const &clientId) {
+        auto it = m_clients.find(clientId);
+        if (it != end(m_clients)) {
+            m_erase(it);
+            m_recompute();
+        }
+    }
+
+    void SubscriptionFilter::addConnection() {
+        ++m_connections;
+        m_recompute();
+    }
+
+    void SubscriptionFilter::removeConnection() {
+        if (m_connections > 0) {
+            --m_connections;
+            m_recompute();
+        }
+    }
+
+    void SubscriptionFilter::expireClients(util::time::TimeValue const &now,
+                                           double timeout) {
+        bool changed = false;
+        for (auto it = begin(m_clients); it != end(m_clients);) {
+            if (util::time::duration(now, it->second.lastSeen) > timeout) {
+                it = m_erase(it);
+                changed = true;
+            } else {
+                ++it;
+            }
+        }
+        if (changed) {
+            m_recompute();
+        }
+    }
+
+    void SubscriptionFilter::setDependency(
+        std::string const &device, common::SourceSubscription const &source) {
+        m_dependencies[device] = source;
+        m_recompute();
+    }
+
+    void SubscriptionFilter::removeDependency(std::string const &device) {
+        if (m_dependencies.erase(device) > 0) {
+            m_recompute();
+        }
+    }
+
+    SubscriptionFilter::ClientMap::iterator
+    SubscriptionFilter::m_erase(ClientMap::iterator it) {
+        m_removeFromConnection(it->second.connection);
+        return m_clients.erase(it);
+    }
+
+    void
+    SubscriptionFilter::m_removeFromConnection(std::string const &connection) {
+        auto it = m_clientsPerConnection.find(connection);
+        if (--it->second == 0) {
+            m_clientsPerConnection.erase(it);
+        }
+    }
+
+    void SubscriptionFilter::m_recompute() {
+        const bool filtering = isFiltering();
+        for (auto &dev : m_devices) {
+            dev.second->m_reset(!filtering);
+        }
+        if (!filtering) {
+            return;
+        }
+        for (auto const &client : m_clients) {
+            for (auto const &source : client.second.sources) {
+                m_mark(source, 0);
+            }
+        }
+    }
+
+    void SubscriptionFilter::m_mark(common::SourceSubscription const &source,
+                                    std::size_t depth) {
+        getDevice(source.device)->m_add(source.sensor);
+        if (depth >= MAX_DEPENDENCY_DEPTH) {
+            return;
+        }
+        auto dep = m_dependencies.find(source.device);
+        if (dep == end(m_dependencies)) {
+            return;
+        }
+        common::SourceSubscription upstream = dep->second;
+        if (upstream.sensor == common::SourceSubscription::ALL_SENSORS) {
+            upstream.sensor = source.sensor;
+        }
+        m_mark(upstream, depth + 1);
+    }
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,91 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "UnixSocketConnection.h"
+#include "DirectReportConnectionDevice.h"
+#include "VrpnConnectionKind.h"
+#include <osvr/Common/UnixSocketPath.h>
+
+#ifdef OSVR_HAVE_UNIX_SOCKETS
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace connection {
+    UnixSocketConnection::UnixSocketConnection(std::string const &path)
+        : VrpnBasedConnection(VRPN_LOCAL_ONLY), m_listener(path) {}
+
+    UnixSocketConnection::~UnixSocketConnection() {}
+
+    const char *UnixSocketConnection::getConnectionKindID() {
+        return getUnixSocketConnectionKindID();
+    }
+
+    ConnectionDevicePtr
+    UnixSocketConnection::m_createConnectionDevice(DeviceInitObject &init) {
+        uint32_t device = uint32_t(m_deviceNames.size());
+        m_deviceNames.push_back(init.getQualifiedName());
+
+        common::DirectReportPacket packet;
+        packet.setDeviceName(device, m_deviceNames.back());
+        m_listener.broadcast(packet);
+
+        /// Async devices send while the main thread is held at a safe point
+        /// outside of m_process(), so the listener needs no locking.
+        UnixSocketListener *listener = &m_listener;
+        ConnectionDevicePtr ret = make_shared<DirectReportConnectionDevice>(
+            init, m_getVrpnConnection(), device,
+            [listener](common::DirectReportPacket const &p) {
+                listener->broadcast(p);
+            });
+        return ret;
+    }
+
+    void UnixSocketConnection::m_process() {
+        m_listener.process(
+            [&](UnixSocketListener::ClientHandle client) {
+                m_sendDeviceNames(client);
+            });
+        VrpnBasedConnection::m_process();
+    }
+
+    void UnixSocketConnection::m_sendDeviceNames(
+        UnixSocketListener::ClientHandle client) {
+        common::DirectReportPacket packet;
+        for (std::size_t i = 0; i < m_deviceNames.size(); ++i) {
+            packet.setDeviceName(uint32_t(i), m_deviceNames[i]);
+            if (!m_listener.sendTo(client, packet)) {
+                return;
+            }
+        }
+    }
+} // namespace connection
+} // namespace osvr
+
+#endif // OSVR_HAVE_UNIX_SOCKETS
@@ -0,0 +1,73 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_UnixSocketConnection_h_GUID_DB2D358D_72F7_4D9E_97D6_AD722095CE88
+#define INCLUDED_UnixSocketConnection_h_GUID_DB2D358D_72F7_4D9E_97D6_AD722095CE88
+
+// Internal Includes
+#include "VrpnBasedConnection.h"
+#include "UnixSocketListener.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace connection {
+    /// @brief A local-only VRPN connection that sends analog, button, and
+    /// tracker reports to clients over a Unix domain socket, skipping VRPN
+    /// message handling and TCP/UDP loopback for the high-rate traffic.
+    ///
+    /// Everything else (system messages, device components, and other
+    /// messages) still goes over the VRPN connection, which clients connect
+    /// to as usual.
+    class UnixSocketConnection : public VrpnBasedConnection {
+      public:
+        /// @brief Constructor
+        ///
+        /// @param path Filesystem path of the socket.
+        explicit UnixSocketConnection(std::string const &path);
+        virtual ~UnixSocketConnection();
+
+        virtual const char *getConnectionKindID();
+
+      protected:
+        virtual ConnectionDevicePtr
+        m_createConnectionDevice(DeviceInitObject &init);
+        virtual void m_process();
+
+      private:
+        void m_sendDeviceNames(UnixSocketListener::ClientHandle client);
+
+        UnixSocketListener m_listener;
+        /// @brief Device names, indexed by the number used in packets.
+        std::vector<std::string> m_deviceNames;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_UnixSocketConnection_h_GUID_DB2D358D_72F7_4D9E_97D6_AD722095CE88
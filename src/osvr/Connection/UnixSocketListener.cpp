@@ -0,0 +1,258 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "UnixSocketListener.h"
+#include <osvr/Common/UnixSocketPath.h>
+#include <osvr/Util/Verbosity.h>
+
+#ifdef OSVR_HAVE_UNIX_SOCKETS
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace osvr {
+namespace connection {
+    /// @brief Most packets held for one client before it is considered too
+    /// far behind to catch up, and disconnected.
+    static const std::size_t MAX_HELD_PACKETS = 1024;
+
+    static inline void setNonBlocking(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    /// @brief Can a held packet of this kind be replaced by a newer one?
+    /// Only if it carries the latest state of continuously changing data:
+    /// every button change and device name must arrive, in order.
+    static inline bool isReplaceable(common::DirectReportPacket::Kind kind) {
+        return kind == common::DirectReportPacket::TRACKER ||
+               kind == common::DirectReportPacket::TRACKER_STATE ||
+               kind == common::DirectReportPacket::ANALOG;
+    }
+
+    UnixSocketListener::UnixSocketListener(std::string const &path)
+        : m_path(path), m_listenSocket(-1), m_dropped(0) {
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (m_path.size() >= sizeof(addr.sun_path)) {
+            throw std::runtime_error("Unix domain socket path too long: " +
+                                     m_path);
+        }
+        std::strncpy(addr.sun_path, m_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        m_listenSocket = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+        if (m_listenSocket < 0) {
+            throw std::runtime_error("Could not create Unix domain socket: " +
+                                     std::string(std::strerror(errno)));
+        }
+        /// Remove any socket left behind by a server that did not exit
+        /// cleanly - but nothing else.
+        struct stat existing;
+        if (lstat(m_path.c_str(), &existing) == 0) {
+            if (!S_ISSOCK(existing.st_mode)) {
+                close(m_listenSocket);
+                throw std::runtime_error(
+                    "Not replacing a file that is not a socket: " + m_path);
+            }
+            OSVR_DEV_VERBOSE("Removing existing Unix domain socket " << m_path);
+            unlink(m_path.c_str());
+        }
+        if (bind(m_listenSocket, reinterpret_cast<sockaddr *>(&addr),
+                 sizeof(addr)) != 0 ||
+            listen(m_listenSocket, SOMAXCONN) != 0) {
+            std::string err(std::strerror(errno));
+            close(m_listenSocket);
+            throw std::runtime_error("Could not listen on Unix domain socket " +
+                                     m_path + ": " + err);
+        }
+        setNonBlocking(m_listenSocket);
+        OSVR_DEV_VERBOSE("Listening on Unix domain socket " << m_path);
+    }
+
+    UnixSocketListener::~UnixSocketListener() {
+        for (auto const &client : m_clients) {
+            close(client.handle);
+        }
+        close(m_listenSocket);
+        unlink(m_path.c_str());
+    }
+
+    void UnixSocketListener::process(
+        std::function<void(ClientHandle)> const &onNewClient) {
+        /// Drop clients that have hung up: they never send anything, so
+        /// any readable state means end-of-file or an error.
+        for (std::size_t i = 0; i < m_clients.size();) {
+            char buf;
+            auto ret =
+                recv(m_clients[i].handle, &buf, sizeof(buf), MSG_DONTWAIT);
+            if (ret == 0 ||
+                (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK) ||
+                !m_sendHeld(m_clients[i])) {
+                m_close(m_clients[i].handle);
+            } else {
+                ++i;
+            }
+        }
+
+        while (true) {
+            int client = accept(m_listenSocket, nullptr, nullptr);
+            if (client < 0) {
+                break;
+            }
+            addClient(client);
+            onNewClient(client);
+        }
+    }
+
+    void UnixSocketListener::addClient(ClientHandle client) {
+        setNonBlocking(client);
+        m_clients.push_back(Client(client));
+        OSVR_DEV_VERBOSE("Unix domain socket client connected, now "
+                         << m_clients.size());
+    }
+
+    bool UnixSocketListener::sendTo(ClientHandle client,
+                                    common::DirectReportPacket const &packet) {
+        auto it = std::find_if(
+            begin(m_clients), end(m_clients),
+            [client](Client const &c) { return c.handle == client; });
+        if (it == end(m_clients)) {
+            return false;
+        }
+        if (!m_send(*it, packet)) {
+            m_close(client);
+            return false;
+        }
+        return true;
+    }
+
+    void UnixSocketListener::broadcast(
+        common::DirectReportPacket const &packet) {
+        for (std::size_t i = 0; i < m_clients.size();) {
+            if (m_send(m_clients[i], packet)) {
+                ++i;
+            } else {
+                m_close(m_clients[i].handle);
+            }
+        }
+    }
+
+    bool UnixSocketListener::m_send(Client &client,
+                                    common::DirectReportPacket const &packet) {
+        if (!client.held.empty()) {
+            /// Stay in order behind the packets already waiting.
+            return m_hold(client, packet);
+        }
+        const int ret = m_trySend(client.handle, packet);
+        if (ret == 0) {
+            return m_hold(client, packet);
+        }
+        return ret > 0;
+    }
+
+    bool UnixSocketListener::m_sendHeld(Client &client) {
+        while (!client.held.empty()) {
+            const int ret = m_trySend(client.handle, client.held.front());
+            if (ret <= 0) {
+                return ret == 0;
+            }
+            client.held.pop_front();
+        }
+        return true;
+    }
+
+    bool UnixSocketListener::m_hold(Client &client,
+                                    common::DirectReportPacket const &packet) {
+        /// A held packet for the same device, kind, and first channel, with
+        /// no more channels, is superseded: it is removed rather than
+        /// overwritten, so that packets stay in sequence order.
+        if (isReplaceable(packet.getKind())) {
+            for (auto it = begin(client.held), e = end(client.held); it != e;
+                 ++it) {
+                if (it->getKind() == packet.getKind() &&
+                    it->getDevice() == packet.getDevice() &&
+                    it->getSensor() == packet.getSensor() &&
+                    it->getCount() <= packet.getCount()) {
+                    client.held.erase(it);
+                    ++m_dropped;
+                    break;
+                }
+            }
+        }
+        if (client.held.size() >= MAX_HELD_PACKETS) {
+            /// Device names and button changes can't be dropped, so a client
+            /// that stops reading is disconnected instead.
+            OSVR_DEV_VERBOSE("Unix domain socket client is not keeping up, "
+                             "disconnecting it.");
+            return false;
+        }
+        client.held.push_back(packet);
+        return true;
+    }
+
+    int
+    UnixSocketListener::m_trySend(ClientHandle client,
+                                  common::DirectReportPacket const &packet) {
+        auto ret = send(client, packet.data(), packet.size(),
+                        MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (ret >= 0) {
+            return 1;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+            return 0;
+        }
+        return -1;
+    }
+
+    void UnixSocketListener::m_close(ClientHandle client) {
+        close(client);
+        m_clients.erase(
+            std::remove_if(
+                begin(m_clients), end(m_clients),
+                [client](Client const &c) { return c.handle == client; }),
+            end(m_clients));
+        OSVR_DEV_VERBOSE("Unix domain socket client disconnected, now "
+                         << m_clients.size());
+    }
+} // namespace connection
+} // namespace osvr
+
+#endif // OSVR_HAVE_UNIX_SOCKETS
@@ -0,0 +1,125 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_UnixSocketListener_h_GUID_895BB284_FB6A_456E_A7A7_DA1031C3A7E4
+#define INCLUDED_UnixSocketListener_h_GUID_895BB284_FB6A_456E_A7A7_DA1031C3A7E4
+
+// Internal Includes
+#include <osvr/Common/DirectReportPacket.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <cstddef>
+
+namespace osvr {
+namespace connection {
+    /// @brief Server end of a Unix domain (SOCK_SEQPACKET) socket, sending
+    /// packets to every connected client.
+    ///
+    /// Never blocks: packets that do not fit in a client's socket buffer are
+    /// held for that client until they do, a newer packet of the same kind
+    /// for the same device and channels replacing any held already. A slow
+    /// client thus gets the newest data as fast as it can take it, without
+    /// holding up the server or other clients. Only tracker and analog
+    /// packets are replaced: device names and button changes are always
+    /// held, in order, and a client that falls so far behind that too many
+    /// are waiting is disconnected.
+    class UnixSocketListener : boost::noncopyable {
+      public:
+        /// @brief Handle for a connected client.
+        typedef int ClientHandle;
+
+        /// @brief Creates the socket at the given path, replacing any stale
+        /// socket file there.
+        ///
+        /// @throws std::runtime_error if the socket could not be created, or
+        /// a file other than a socket is in the way.
+        explicit UnixSocketListener(std::string const &path);
+
+        /// @brief Closes all sockets and removes the socket file.
+        ~UnixSocketListener();
+
+        /// @brief Sends packets held for clients, accepts new clients,
+        /// calling the given function for each, and forgets clients that
+        /// have disconnected.
+        void process(std::function<void(ClientHandle)> const &onNewClient);
+
+        /// @brief Takes ownership of an already-connected socket as a client,
+        /// such as one end of a socketpair(). process() does this for each
+        /// client it accepts.
+        void addClient(ClientHandle client);
+
+        /// @brief Sends a packet to one client.
+        ///
+        /// @returns false if the client has gone away (and was forgotten).
+        bool sendTo(ClientHandle client,
+                    common::DirectReportPacket const &packet);
+
+        /// @brief Sends a packet to every client.
+        void broadcast(common::DirectReportPacket const &packet);
+
+        std::size_t getNumClients() const { return m_clients.size(); }
+
+        /// @brief Number of packets replaced by a newer one while held for a
+        /// client whose socket buffer was full.
+        std::size_t getDroppedPackets() const { return m_dropped; }
+
+      private:
+        struct Client {
+            explicit Client(ClientHandle h) : handle(h) {}
+            ClientHandle handle;
+            /// @brief Packets waiting for room in the socket buffer, oldest
+            /// first.
+            std::deque<common::DirectReportPacket> held;
+        };
+        /// @returns false if the client has gone away.
+        bool m_send(Client &client, common::DirectReportPacket const &packet);
+        /// @returns false if the client has gone away.
+        bool m_sendHeld(Client &client);
+        /// @returns false if the client is too far behind, and should be
+        /// disconnected.
+        bool m_hold(Client &client, common::DirectReportPacket const &packet);
+        /// @brief Sends a packet right away.
+        ///
+        /// @returns 1 if sent, 0 if the socket buffer is full, -1 if the
+        /// client has gone away.
+        static int m_trySend(ClientHandle client,
+                             common::DirectReportPacket const &packet);
+        void m_close(ClientHandle client);
+
+        std::string const m_path;
+        int m_listenSocket;
+        std::vector<Client> m_clients;
+        std::size_t m_dropped;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_UnixSocketListener_h_GUID_895BB284_FB6A_456E_A7A7_DA1031C3A7E4
@@ -28,25 +28,64 @@
 // Internal Includes
 #include "DeviceConstructionData.h"
 #include <osvr/Connection/AnalogServerInterface.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/SubscriptionFilter.h>
+#include <osvr/Connection/ReportSuppression.h>
+#include <osvr/Common/AnalogFrameMessage.h>
+#include <osvr/Common/Endianness.h>
+#include <osvr/Common/ReportSequence.h>
 
 // Library/third-party includes
 #include <vrpn_Analog.h>
 
 // Standard includes
-#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 namespace osvr {
 namespace connection {
+    /// @brief Sends analog reports as VRPN analog messages, or, for devices
+    /// with more channels than those can carry or that asked for a compact
+    /// encoding, as AnalogFrameMessage messages.
     class VrpnAnalogServer : public vrpn_Analog, public AnalogServerInterface {
       public:
         typedef vrpn_Analog Base;
+        typedef common::AnalogFrameMessage FrameMessage;
         VrpnAnalogServer(DeviceConstructionData &init)
-            : Base(init.getQualifiedName().c_str(), init.conn) {
+            : Base(init.getQualifiedName().c_str(), init.conn),
+              m_values(*init.obj.getAnalogs(), 0),
+              m_last(*init.obj.getAnalogs(), 0),
+              m_encoding(init.obj.getAnalogEncoding().get_value_or(
+                  FrameMessage::FLOAT64)),
+              m_scale(init.obj.getAnalogScale()),
+              m_native(init.obj.getAnalogEncoding() ||
+                       m_values.size() > vrpn_CHANNEL_MAX),
+              m_framesUntilFull(0), m_frameMessageType(0),
+              m_suppression(init.obj.getConnection()
+                                ->getReportSuppression()
+                                .getDevice(init.getQualifiedName())),
+              m_hasSent(false), m_held(m_suppression) {
             m_setNumChannels(std::min(*init.obj.getAnalogs(),
                                       OSVR_ChannelCount(vrpn_CHANNEL_MAX)));
             // Initialize data
             memset(Base::channel, 0, sizeof(Base::channel));
             memset(Base::last, 0, sizeof(Base::last));
+            if (m_native) {
+                m_frameMessageType = d_connection->register_message_type(
+                    FrameMessage::identifier());
+                m_frameBuffer.resize(FrameMessage::MAX_SIZE);
+                m_changed.reserve(m_values.size());
+            }
+            m_subscription = init.obj.getConnection()
+                                 ->getSubscriptionFilter()
+                                 .getDevice(init.getQualifiedName());
+            init.heldReportFlushers.push_back([&] {
+                m_held.flush([&](OSVR_ChannelCount,
+                                 util::time::TimeValue const &timestamp) {
+                    m_sendChanges(timestamp);
+                });
+            });
 
             // Report interface out.
             init.obj.returnAnalogInterface(*this);
@@ -56,36 +95,175 @@ namespace connection {
 
         virtual bool setValue(value_type val, OSVR_ChannelCount chan,
                               util::time::TimeValue const &timestamp) {
-            if (chan >= m_getNumChannels()) {
+            if (chan >= m_values.size()) {
                 return false;
             }
-            Base::channel[chan] = val;
+            m_values[chan] = val;
             m_reportChanges(timestamp);
             return true;
         }
         virtual void setValues(value_type val[], OSVR_ChannelCount chans,
                                util::time::TimeValue const &timestamp) {
-            if (chans > m_getNumChannels()) {
-                chans = m_getNumChannels();
-            }
-            for (OSVR_ChannelCount i = 0; i < chans; ++i) {
-                Base::channel[i] = val[i];
-            }
+            chans = std::min(chans, OSVR_ChannelCount(m_values.size()));
+            std::copy(val, val + chans, m_values.begin());
             m_reportChanges(timestamp);
         }
 
       private:
-        OSVR_ChannelCount m_getNumChannels() {
-            return static_cast<OSVR_ChannelCount>(Base::num_channel);
-        }
+        enum {
+            /// @brief Frames are sparse and unreliable, so every so often one
+            /// carries all the channels in use, so that a lost frame can't
+            /// leave a client with a stale value indefinitely.
+            FULL_FRAME_INTERVAL = 64
+        };
         void m_setNumChannels(OSVR_ChannelCount chans) {
             Base::num_channel = chans;
         }
         void m_reportChanges(util::time::TimeValue const &timestamp) {
-            struct timeval t;
-            util::time::toStructTimeval(t, timestamp);
-            Base::report_changes(CLASS_OF_SERVICE, t);
+            if (m_held.hold(0, timestamp)) {
+                /// Too soon: m_values keeps the newest values until they
+                /// may be sent.
+                return;
+            }
+            m_sendChanges(timestamp);
+        }
+        void m_sendChanges(util::time::TimeValue const &timestamp) {
+            util::time::toStructTimeval(Base::timestamp, timestamp);
+            const bool keepAlive =
+                m_hasSent && m_subscription->wantsAny() &&
+                m_suppression->isKeepAliveDue(m_lastSent, timestamp);
+            const bool sent =
+                m_native ? m_sendFrames(keepAlive) : m_sendVrpn(keepAlive);
+            if (sent) {
+                m_hasSent = true;
+                m_lastSent = timestamp;
+                m_suppression->countSent();
+            } else if (m_wantedChannelSuppressed()) {
+                m_suppression->countSuppressed();
+            }
+        }
+        /// @brief Does any channel a client is using differ from what was
+        /// last reported, by no more than the suppression settings ignore?
+        bool m_wantedChannelSuppressed() const {
+            for (std::size_t i = 0, e = m_values.size(); i < e; ++i) {
+                if (m_suppression->isSuppressed(m_values[i], m_last[i]) &&
+                    m_subscription->wants(OSVR_ChannelCount(i))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        /// @brief Does any channel a client is using differ from what was
+        /// last reported, by more than the suppression settings ignore?
+        bool m_wantedChannelChanged() const {
+            for (vrpn_int32 i = 0; i < Base::num_channel; ++i) {
+                if (!m_suppression->isUnchanged(m_values[i], m_last[i]) &&
+                    m_subscription->wants(i)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        bool m_sendVrpn(bool keepAlive) {
+            /// VRPN analog reports carry every channel, so only the decision
+            /// to send can be filtered.
+            if (!keepAlive && !m_wantedChannelChanged()) {
+                return false;
+            }
+            m_last = m_values;
+            std::copy(m_values.begin(), m_values.begin() + Base::num_channel,
+                      Base::channel);
+
+            /// Same as vrpn_Analog::report(), but with a sequence number
+            /// appended: VRPN's own clients ignore anything after the
+            /// channels.
+            char msgbuf[(vrpn_CHANNEL_MAX + 1) * sizeof(vrpn_float64) +
+                        sizeof(uint32_t)];
+            vrpn_int32 len = Base::encode_to(msgbuf);
+            const uint32_t sequence =
+                common::serialization::hton(m_sequence.next());
+            std::memcpy(msgbuf + len, &sequence, sizeof(sequence));
+            len += sizeof(sequence);
+            d_connection->pack_message(len, Base::timestamp,
+                                       Base::channel_m_id, Base::d_sender_id,
+                                       msgbuf, CLASS_OF_SERVICE);
+            return true;
+        }
+        /// @brief Sends the channels in use that changed, as dense frames
+        /// over the range they span or as sparse frames, whichever is
+        /// smaller.
+        bool m_sendFrames(bool keepAlive) {
+            const bool full = keepAlive || (m_framesUntilFull == 0);
+            m_changed.clear();
+            for (uint32_t i = 0, e = uint32_t(m_values.size()); i < e; ++i) {
+                if ((full ||
+                     !m_suppression->isUnchanged(m_values[i], m_last[i])) &&
+                    m_subscription->wants(i)) {
+                    m_changed.push_back(i);
+                }
+            }
+            if (m_changed.empty()) {
+                return false;
+            }
+            m_framesUntilFull =
+                (full ? FULL_FRAME_INTERVAL : m_framesUntilFull) - 1;
+
+            const uint32_t first = m_changed.front();
+            const std::size_t span = m_changed.back() - first + 1;
+            if (FrameMessage::denseSize(m_encoding, span) <=
+                FrameMessage::sparseSize(m_encoding, m_changed.size())) {
+                std::copy(m_values.begin() + first,
+                          m_values.begin() + first + span,
+                          m_last.begin() + first);
+                const std::size_t perFrame = FrameMessage::maxDense(m_encoding);
+                for (std::size_t i = 0; i < span; i += perFrame) {
+                    m_packFrame(FrameMessage::encodeDense(
+                        m_frameBuffer.data(), m_sequence.next(), m_encoding,
+                        m_scale, int32_t(first + i), &m_values[first + i],
+                        std::min(span - i, perFrame)));
+                }
+            } else {
+                for (auto chan : m_changed) {
+                    m_last[chan] = m_values[chan];
+                }
+                const std::size_t perFrame =
+                    FrameMessage::maxSparse(m_encoding);
+                for (std::size_t i = 0; i < m_changed.size(); i += perFrame) {
+                    m_packFrame(FrameMessage::encodeSparse(
+                        m_frameBuffer.data(), m_sequence.next(), m_encoding,
+                        m_scale, &m_changed[i], m_values.data(),
+                        std::min(m_changed.size() - i, perFrame)));
+                }
+            }
+            return true;
+        }
+        void m_packFrame(std::size_t len) {
+            d_connection->pack_message(
+                vrpn_uint32(len), Base::timestamp, m_frameMessageType,
+                Base::d_sender_id, m_frameBuffer.data(), CLASS_OF_SERVICE);
         }
+        std::vector<value_type> m_values;
+        /// @brief Values as last sent.
+        std::vector<value_type> m_last;
+        FrameMessage::Encoding m_encoding;
+        double m_scale;
+        /// @brief Send AnalogFrameMessage rather than VRPN messages?
+        bool m_native;
+        int m_framesUntilFull;
+        vrpn_int32 m_frameMessageType;
+        /// @brief Reused to avoid allocating for each report.
+        std::vector<char> m_frameBuffer;
+        std::vector<uint32_t> m_changed;
+        DeviceSubscriptionPtr m_subscription;
+        DeviceReportSuppressionPtr m_suppression;
+        bool m_hasSent;
+        util::time::TimeValue m_lastSent;
+        /// @brief Holds back reports that come faster than the device's
+        /// maximum rate, for the device as a whole.
+        ReportRateLimiter m_held;
+        /// @brief Shared by both kinds of message, which clients route
+        /// together.
+        common::ReportSequenceCounter m_sequence;
     };
 
 } // namespace connection
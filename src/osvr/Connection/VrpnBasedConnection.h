@@ -58,6 +58,16 @@ namespace connection {
         virtual const char *getConnectionKindID();
         virtual ~VrpnBasedConnection();
 
+      protected:
+        /// @brief Access for derived connections that add devices or
+        /// processing of their own.
+        vrpn_ConnectionPtr const &m_getVrpnConnection() const {
+            return m_vrpnConnection;
+        }
+        virtual ConnectionDevicePtr
+        m_createConnectionDevice(DeviceInitObject &init);
+        virtual void m_process();
+
       private:
         /// @brief Helper method to set up the VRPN server connection
         /// @param iface String specifying the interface to use. Null means all
@@ -68,10 +78,7 @@ namespace connection {
 
         virtual MessageTypePtr
         m_registerMessageType(std::string const &messageId);
-        virtual ConnectionDevicePtr
-        m_createConnectionDevice(DeviceInitObject &init);
         virtual void m_registerConnectionHandler(std::function<void()> handler);
-        virtual void m_process();
 
         static int VRPN_CALLBACK
         m_connectionHandler(void *userdata, vrpn_HANDLERPARAM);
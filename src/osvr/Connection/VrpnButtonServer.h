@@ -28,6 +28,8 @@
 // Internal includes
 #include "DeviceConstructionData.h"
 #include <osvr/Connection/ButtonServerInterface.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/SubscriptionFilter.h>
 
 // Library/third-party includes
 #include <vrpn_Button.h>
@@ -49,6 +51,9 @@ namespace connection {
             // Initialize data
             memset(Base::buttons, 0, sizeof(Base::buttons));
             memset(Base::lastbuttons, 0, sizeof(Base::lastbuttons));
+            m_subscription = init.obj.getConnection()
+                                 ->getSubscriptionFilter()
+                                 .getDevice(init.getQualifiedName());
 
             // Report interface out.
             init.obj.returnButtonInterface(*this);
@@ -83,9 +88,17 @@ namespace connection {
             Base::num_buttons = chans;
         }
         void m_reportChanges(util::time::TimeValue const &timestamp) {
+            /// Marking unused buttons as already reported keeps VRPN from
+            /// sending their changes.
+            for (vrpn_int32 i = 0; i < Base::num_buttons; ++i) {
+                if (!m_subscription->wants(i)) {
+                    Base::lastbuttons[i] = Base::buttons[i];
+                }
+            }
             util::time::toStructTimeval(Base::timestamp, timestamp);
             Base::report_changes();
         }
+        DeviceSubscriptionPtr m_subscription;
     };
 
 } // namespace connection
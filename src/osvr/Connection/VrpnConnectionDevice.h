@@ -37,6 +37,8 @@
 
 // Standard includes
 #include <string>
+#include <vector>
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -49,6 +51,7 @@ namespace connection {
             DeviceConstructionData data(init, vrpnConn.get());
             m_server.reset(generateVrpnDynamicServer(data));
             m_baseobj = data.flexServer;
+            m_heldReportFlushers.swap(data.heldReportFlushers);
             for (auto const &component : init.getComponents()) {
                 m_baseobj->addComponent(component);
             }
@@ -56,6 +59,9 @@ namespace connection {
         virtual ~VrpnConnectionDevice() {}
         virtual void m_process() {
             m_getDeviceToken().connectionInteract();
+            for (auto const &flush : m_heldReportFlushers) {
+                flush();
+            }
             m_server->mainloop();
             m_baseobj->mainloop();
         }
@@ -69,6 +75,7 @@ namespace connection {
       private:
         vrpn_BaseFlexServer *m_baseobj;
         unique_ptr<vrpn_MainloopObject> m_server;
+        std::vector<std::function<void()> > m_heldReportFlushers;
     };
 } // namespace connection
 } // namespace osvr
@@ -34,5 +34,14 @@
 namespace osvr {
 namespace connection {
     const char *getVRPNConnectionKindID() { return "org.opengoggles.vrpn"; }
+    const char *getUnixSocketConnectionKindID() {
+        return "com.osvr.vrpn.unixsocket";
+    }
+    const char *getInProcessConnectionKindID() {
+        return "com.osvr.vrpn.inprocess";
+    }
+    const char *getSharedMemoryConnectionKindID() {
+        return "com.osvr.vrpn.sharedmemory";
+    }
 } // namespace connection
 } // namespace osvr
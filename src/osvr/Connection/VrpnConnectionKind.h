@@ -37,6 +37,15 @@
 namespace osvr {
 namespace connection {
     OSVR_CONNECTION_EXPORT const char *getVRPNConnectionKindID();
+    /// @brief Kind ID of a VRPN connection whose device reports are sent to
+    /// clients over a Unix domain socket.
+    OSVR_CONNECTION_EXPORT const char *getUnixSocketConnectionKindID();
+    /// @brief Kind ID of a VRPN connection whose device reports are handed to
+    /// clients in the same process.
+    OSVR_CONNECTION_EXPORT const char *getInProcessConnectionKindID();
+    /// @brief Kind ID of a VRPN connection whose device reports are published
+    /// to clients through shared memory.
+    OSVR_CONNECTION_EXPORT const char *getSharedMemoryConnectionKindID();
 } // namespace connection
 } // namespace osvr
 
@@ -28,14 +28,24 @@
 // Internal Includes
 #include "DeviceConstructionData.h"
 #include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/SubscriptionFilter.h>
+#include <osvr/Connection/ReportSuppression.h>
+#include <osvr/Common/Endianness.h>
+#include <osvr/Common/ReportSequence.h>
+#include <osvr/Common/PoseBatchMessage.h>
+#include <osvr/Common/TrackerStateMessage.h>
 #include <osvr/Util/QuatlibInteropC.h>
+#include <osvr/Util/Pose3C.h>
 
 // Library/third-party includes
 #include <vrpn_Tracker.h>
 #include <quat.h>
 
 // Standard includes
-// - none
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 namespace osvr {
 namespace connection {
@@ -44,10 +54,23 @@ namespace connection {
       public:
         typedef vrpn_Tracker Base;
         VrpnTrackerServer(DeviceConstructionData &init)
-            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn) {
+            : vrpn_Tracker(init.getQualifiedName().c_str(), init.conn),
+              m_batchBuffer(common::PoseBatchMessage::maxSize()),
+              m_poses(m_getSuppression(init)),
+              m_heldPoses(m_getSuppression(init)),
+              m_heldStates(m_getSuppression(init)),
+              m_heldBatches(m_getSuppression(init)) {
             // Initialize data
             m_resetPos();
             m_resetQuat();
+            m_batchMessageType = d_connection->register_message_type(
+                common::PoseBatchMessage::identifier());
+            m_stateMessageType = d_connection->register_message_type(
+                common::TrackerStateMessage::identifier());
+            m_subscription = init.obj.getConnection()
+                                 ->getSubscriptionFilter()
+                                 .getDevice(init.getQualifiedName());
+            init.heldReportFlushers.push_back([&] { m_flushHeld(); });
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
         }
@@ -56,28 +79,72 @@ namespace connection {
         virtual void sendReport(OSVR_PositionState const &val,
                                 OSVR_ChannelCount chan,
                                 util::time::TimeValue const &timestamp) {
-            m_resetQuat();
-            osvrVec3ToQuatlib(Base::pos, &val);
-            m_sendPose(chan, timestamp);
+            OSVR_PoseState pose;
+            osvrPose3SetIdentity(&pose);
+            pose.translation = val;
+            m_sendPose(pose, chan, timestamp);
         }
 
         virtual void sendReport(OSVR_OrientationState const &val,
                                 OSVR_ChannelCount chan,
                                 util::time::TimeValue const &timestamp) {
-            m_resetPos();
-            osvrQuatToQuatlib(Base::d_quat, &val);
-            m_sendPose(chan, timestamp);
+            OSVR_PoseState pose;
+            osvrPose3SetIdentity(&pose);
+            pose.rotation = val;
+            m_sendPose(pose, chan, timestamp);
         }
 
         virtual void sendReport(OSVR_PoseState const &val,
                                 OSVR_ChannelCount chan,
                                 util::time::TimeValue const &timestamp) {
-            osvrQuatToQuatlib(Base::d_quat, &(val.rotation));
-            osvrVec3ToQuatlib(Base::pos, &(val.translation));
-            m_sendPose(chan, timestamp);
+            m_sendPose(val, chan, timestamp);
+        }
+
+        /// @brief Sends a TrackerStateMessage: like batches, only OSVR
+        /// clients understand it.
+        virtual void sendReport(OSVR_TrackerState const &val,
+                                OSVR_ChannelCount chan,
+                                util::time::TimeValue const &timestamp) {
+            if (!m_subscription->wants(chan)) {
+                return;
+            }
+            if (auto held = m_heldStates.hold(chan, timestamp)) {
+                *held = val;
+                return;
+            }
+            m_packState(val, chan, timestamp);
+        }
+
+        /// @brief Sends PoseBatchMessage messages rather than a VRPN
+        /// message per sensor: only OSVR clients understand them.
+        virtual void sendReports(OSVR_PoseState const val[],
+                                 OSVR_ChannelCount chans,
+                                 util::time::TimeValue const &timestamp) {
+            const OSVR_ChannelCount perMessage =
+                common::PoseBatchMessage::MAX_POSES;
+            for (OSVR_ChannelCount first = 0; first < chans;
+                 first += perMessage) {
+                const OSVR_ChannelCount count =
+                    std::min(chans - first, perMessage);
+                if (!m_subscription->wantsAnyOf(first, count)) {
+                    continue;
+                }
+                /// Batches are held back as a whole.
+                if (auto held =
+                        m_heldBatches.hold(first / perMessage, timestamp)) {
+                    held->assign(val + first, val + first + count);
+                    continue;
+                }
+                m_packBatch(first, val + first, count, timestamp);
+            }
         }
 
       private:
+        static DeviceReportSuppressionPtr
+        m_getSuppression(DeviceConstructionData &init) {
+            return init.obj.getConnection()->getReportSuppression().getDevice(
+                init.getQualifiedName());
+        }
         void m_resetVec3(vrpn_float64 vec[3]) {
             vec[0] = 0;
             vec[1] = 0;
@@ -91,17 +158,102 @@ namespace connection {
             quat[Q_Z] = 0;
         }
         void m_resetQuat() { m_resetQuat(d_quat); }
-        void m_sendPose(OSVR_ChannelCount chan,
+        void m_sendPose(OSVR_PoseState const &pose, OSVR_ChannelCount chan,
                         util::time::TimeValue const &ts) {
-
+            if (!m_subscription->wants(chan)) {
+                return;
+            }
+            if (auto held = m_heldPoses.hold(chan, ts)) {
+                *held = pose;
+                return;
+            }
+            m_packPose(pose, chan, ts);
+        }
+        void m_packPose(OSVR_PoseState const &pose, OSVR_ChannelCount chan,
+                        util::time::TimeValue const &ts) {
+            if (!m_poses.shouldSend(chan, pose, ts)) {
+                return;
+            }
+            osvrQuatToQuatlib(Base::d_quat, &(pose.rotation));
+            osvrVec3ToQuatlib(Base::pos, &(pose.translation));
             Base::d_sensor = chan;
             util::time::toStructTimeval(Base::timestamp, ts);
             char msgbuf[1000];
             vrpn_int32 len = Base::encode_to(msgbuf);
+            m_setSequence(msgbuf);
             d_connection->pack_message(len, Base::timestamp,
                                        Base::position_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
         }
+        void m_packState(OSVR_TrackerState const &val, OSVR_ChannelCount chan,
+                         util::time::TimeValue const &ts) {
+            util::time::toStructTimeval(Base::timestamp, ts);
+            common::TrackerStateMessage::encode(
+                m_stateBuffer, m_sequence.next(), int32_t(chan), val);
+            d_connection->pack_message(
+                vrpn_uint32(m_stateBuffer.size()), Base::timestamp,
+                m_stateMessageType, Base::d_sender_id, m_stateBuffer.data(),
+                CLASS_OF_SERVICE);
+        }
+        void m_packBatch(OSVR_ChannelCount first, OSVR_PoseState const val[],
+                         OSVR_ChannelCount count,
+                         util::time::TimeValue const &ts) {
+            if (!m_poses.shouldSend(first, val, count, ts)) {
+                return;
+            }
+            util::time::toStructTimeval(Base::timestamp, ts);
+            const std::size_t len = common::PoseBatchMessage::encode(
+                m_batchBuffer.data(), m_sequence.next(), first, val, count);
+            d_connection->pack_message(
+                vrpn_uint32(len), Base::timestamp, m_batchMessageType,
+                Base::d_sender_id, m_batchBuffer.data(), CLASS_OF_SERVICE);
+        }
+        /// @brief Sends the reports held back by the rate limit whose time
+        /// has come: called each time through the server loop.
+        void m_flushHeld() {
+            m_heldPoses.flush([&](OSVR_ChannelCount chan,
+                                  OSVR_PoseState const &pose,
+                                  util::time::TimeValue const &ts) {
+                m_packPose(pose, chan, ts);
+            });
+            m_heldStates.flush([&](OSVR_ChannelCount chan,
+                                   OSVR_TrackerState const &state,
+                                   util::time::TimeValue const &ts) {
+                m_packState(state, chan, ts);
+            });
+            m_heldBatches.flush([&](OSVR_ChannelCount batch,
+                                    std::vector<OSVR_PoseState> const &poses,
+                                    util::time::TimeValue const &ts) {
+                m_packBatch(batch * common::PoseBatchMessage::MAX_POSES,
+                            poses.data(),
+                            OSVR_ChannelCount(poses.size()), ts);
+            });
+        }
+        /// @brief Puts a sequence number in the padding word that follows
+        /// the sensor number, which VRPN's own clients ignore.
+        void m_setSequence(char *msgbuf) {
+            const uint32_t word = common::serialization::hton(
+                m_sequence.next() | common::getTrackerSequenceMarker());
+            std::memcpy(msgbuf + sizeof(vrpn_int32), &word, sizeof(word));
+        }
+        DeviceSubscriptionPtr m_subscription;
+        /// @brief Shared by all the kinds of tracker message, which clients
+        /// route together.
+        common::ReportSequenceCounter m_sequence;
+        vrpn_int32 m_batchMessageType;
+        std::vector<char> m_batchBuffer;
+        vrpn_int32 m_stateMessageType;
+        /// @brief Reused to avoid allocating for each message.
+        common::Buffer<> m_stateBuffer;
+        /// @brief Skips poses that change nothing, per the device's
+        /// suppression settings.
+        PoseSuppressor m_poses;
+        /// @brief Hold back reports that come faster than the device's
+        /// maximum rate.
+        ReportConflator<OSVR_PoseState> m_heldPoses;
+        ReportConflator<OSVR_TrackerState> m_heldStates;
+        /// @brief Indexed by batch: first sensor divided by MAX_POSES.
+        ReportConflator<std::vector<OSVR_PoseState> > m_heldBatches;
     };
 
 } // namespace connection
@@ -54,13 +54,37 @@ osvrDeviceAnalogConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode
+osvrDeviceAnalogConfigureEncoding(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
+                                  OSVR_IN OSVR_AnalogEncoding encoding,
+                                  OSVR_IN double scale) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAnalogConfigureEncoding", opts);
+    typedef osvr::common::AnalogFrameMessage Message;
+    switch (encoding) {
+    case OSVR_ANALOG_ENCODING_FLOAT64:
+        opts->setAnalogEncoding(Message::FLOAT64, 1);
+        return OSVR_RETURN_SUCCESS;
+    case OSVR_ANALOG_ENCODING_FLOAT32:
+        opts->setAnalogEncoding(Message::FLOAT32, 1);
+        return OSVR_RETURN_SUCCESS;
+    case OSVR_ANALOG_ENCODING_INT16:
+        if (!(scale > 0)) {
+            return OSVR_RETURN_FAILURE;
+        }
+        opts->setAnalogEncoding(Message::INT16, scale);
+        return OSVR_RETURN_SUCCESS;
+    default:
+        return OSVR_RETURN_FAILURE;
+    }
+}
+
 OSVR_ReturnCode osvrDeviceAnalogSetValue(OSVR_IN_PTR OSVR_DeviceToken dev,
                                          OSVR_IN_PTR OSVR_AnalogDeviceInterface
                                              iface,
                                          OSVR_IN OSVR_AnalogState val,
                                          OSVR_IN OSVR_ChannelCount chan) {
     OSVR_TimeValue now;
-    osvrTimeValueGetNow(&now);
+    osvrTimeValueGetSteadyNow(&now);
     return osvrDeviceAnalogSetValueTimestamped(dev, iface, val, chan, &now);
 }
 
@@ -90,7 +114,7 @@ OSVR_ReturnCode osvrDeviceAnalogSetValues(OSVR_INOUT_PTR OSVR_DeviceToken dev,
                                           OSVR_IN_PTR OSVR_AnalogState val[],
                                           OSVR_IN OSVR_ChannelCount chans) {
     OSVR_TimeValue now;
-    osvrTimeValueGetNow(&now);
+    osvrTimeValueGetSteadyNow(&now);
     return osvrDeviceAnalogSetValuesTimestamped(dev, iface, val, chans, &now);
 }
 
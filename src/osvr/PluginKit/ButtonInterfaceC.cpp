@@ -60,7 +60,7 @@ OSVR_ReturnCode osvrDeviceButtonSetValue(OSVR_IN_PTR OSVR_DeviceToken dev,
                                          OSVR_IN OSVR_ButtonState val,
                                          OSVR_IN OSVR_ChannelCount chan) {
     OSVR_TimeValue now;
-    osvrTimeValueGetNow(&now);
+    osvrTimeValueGetSteadyNow(&now);
     return osvrDeviceButtonSetValueTimestamped(dev, iface, val, chan, &now);
 }
 
@@ -90,7 +90,7 @@ OSVR_ReturnCode osvrDeviceButtonSetValues(OSVR_IN_PTR OSVR_DeviceToken dev,
                                           OSVR_IN_PTR OSVR_ButtonState val[],
                                           OSVR_IN OSVR_ChannelCount chans) {
     OSVR_TimeValue now;
-    osvrTimeValueGetNow(&now);
+    osvrTimeValueGetSteadyNow(&now);
     return osvrDeviceButtonSetValuesTimestamped(dev, iface, val, chans, &now);
 }
 
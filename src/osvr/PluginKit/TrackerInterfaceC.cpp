@@ -78,7 +78,7 @@ osvrDeviceTrackerSendPose(OSVR_IN_PTR OSVR_DeviceToken dev,
                           OSVR_IN_PTR OSVR_PoseState const *val,
                           OSVR_IN OSVR_ChannelCount chan) {
     OSVR_TimeValue now;
-    osvrTimeValueGetNow(&now);
+    osvrTimeValueGetSteadyNow(&now);
 
     return osvrDeviceTrackerSendPoseTimestamped(dev, iface, val, chan, &now);
 }
@@ -98,7 +98,7 @@ osvrDeviceTrackerSendPosition(OSVR_IN_PTR OSVR_DeviceToken dev,
                               OSVR_IN_PTR OSVR_PositionState const *val,
                               OSVR_IN OSVR_ChannelCount chan) {
     OSVR_TimeValue now;
-    osvrTimeValueGetNow(&now);
+    osvrTimeValueGetSteadyNow(&now);
 
     return osvrDeviceTrackerSendPositionTimestamped(dev, iface, val, chan,
                                                     &now);
@@ -119,7 +119,7 @@ osvrDeviceTrackerSendOrientation(OSVR_IN_PTR OSVR_DeviceToken dev,
                                  OSVR_IN_PTR OSVR_OrientationState const *val,
                                  OSVR_IN OSVR_ChannelCount chan) {
     OSVR_TimeValue now;
-    osvrTimeValueGetNow(&now);
+    osvrTimeValueGetSteadyNow(&now);
 
     return osvrDeviceTrackerSendOrientationTimestamped(dev, iface, val, chan,
                                                        &now);
@@ -134,3 +134,60 @@ OSVR_ReturnCode osvrDeviceTrackerSendOrientationTimestamped(
     return osvrTrackerSend("osvrDeviceTrackerSendPoseTimestamped", dev, iface,
                            val, chan, timestamp);
 }
+
+OSVR_ReturnCode
+osvrDeviceTrackerSendState(OSVR_IN_PTR OSVR_DeviceToken dev,
+                           OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_TrackerState const *val,
+                           OSVR_IN OSVR_ChannelCount chan) {
+    OSVR_TimeValue now;
+    osvrTimeValueGetSteadyNow(&now);
+
+    return osvrDeviceTrackerSendStateTimestamped(dev, iface, val, chan, &now);
+}
+
+OSVR_ReturnCode osvrDeviceTrackerSendStateTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_TrackerState const *val, OSVR_IN OSVR_ChannelCount chan,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    return osvrTrackerSend("osvrDeviceTrackerSendStateTimestamped", dev, iface,
+                           val, chan, timestamp);
+}
+
+OSVR_ReturnCode
+osvrDeviceTrackerSendPoses(OSVR_IN_PTR OSVR_DeviceToken dev,
+                           OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_PoseState const val[],
+                           OSVR_IN OSVR_ChannelCount chans) {
+    OSVR_TimeValue now;
+    osvrTimeValueGetSteadyNow(&now);
+
+    return osvrDeviceTrackerSendPosesTimestamped(dev, iface, val, chans, &now);
+}
+
+OSVR_ReturnCode osvrDeviceTrackerSendPosesTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_PoseState const val[], OSVR_IN OSVR_ChannelCount chans,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPosesTimestamped",
+                                    dev);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPosesTimestamped",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPosesTimestamped",
+                                    val);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceTrackerSendPosesTimestamped",
+                                    timestamp);
+
+    osvr::connection::DeviceToken *device =
+        static_cast<osvr::connection::DeviceToken *>(dev);
+
+    auto guard = device->getSendGuard();
+    if (guard->lock()) {
+        (*iface)->sendReports(val, chans, *timestamp);
+        return OSVR_RETURN_SUCCESS;
+    }
+
+    return OSVR_RETURN_FAILURE;
+}
@@ -26,7 +26,9 @@
 #include <osvr/Server/ConfigureServer.h>
 #include <osvr/Server/Server.h>
 #include <osvr/Connection/Connection.h>
+#include <osvr/Connection/ReportSuppression.h>
 #include <osvr/PluginHost/SearchPath.h>
+#include <osvr/Common/RoutingKeys.h>
 
 // Library/third-party includes
 #include <json/value.h>
@@ -73,6 +75,9 @@ namespace server {
         }
 
         Json::Value root;
+        /// @brief Report suppression and rate limit settings from the server
+        /// section, for drivers that don't have their own.
+        connection::ReportSuppressionSettings reportSuppression;
     };
 
     ConfigureServer::ConfigureServer() : m_data(new ConfigureServerData()) {}
@@ -93,6 +98,32 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    static const char SUBSCRIPTION_FILTERING_KEY[] = "subscriptionFiltering";
+    static const char UNIX_SOCKET_KEY[] = "unixSocket";
+    static const char IN_PROCESS_KEY[] = "inProcess";
+    static const char SHARED_MEMORY_KEY[] = "sharedMemory";
+    static const char REPORT_SUPPRESSION_KEY[] = "reportSuppression";
+    static const char ENABLED_KEY[] = "enabled";
+    static const char EPSILON_KEY[] = "epsilon";
+    static const char MAX_INTERVAL_KEY[] = "maxInterval";
+    static const char MAX_REPORT_RATE_KEY[] = "maxReportRate";
+    static const char MAX_CONNECTION_REPORT_RATE_KEY[] =
+        "maxConnectionReportRate";
+
+    /// @brief Reads report suppression settings: `true`, or an object,
+    /// which turns suppression on unless it has `"enabled": false`.
+    static connection::ReportSuppressionSettings
+    parseReportSuppression(Json::Value const &json) {
+        connection::ReportSuppressionSettings ret;
+        if (json.isBool()) {
+            ret.enabled = json.asBool();
+        } else if (json.isObject()) {
+            ret.enabled = json.get(ENABLED_KEY, true).asBool();
+            ret.epsilon = json.get(EPSILON_KEY, 0.0).asDouble();
+            ret.maxInterval = json.get(MAX_INTERVAL_KEY, 0.0).asDouble();
+        }
+        return ret;
+    }
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value &root(m_data->root);
@@ -100,6 +131,14 @@ namespace server {
         std::string iface;
         boost::optional<int> port;
         int sleepTime = 1000; // microseconds
+        bool subscriptionFiltering = false;
+        bool unixSocket = false;
+        std::string socketPath;
+        bool inProcess = false;
+        std::string hubName;
+        bool sharedMemory = false;
+        std::string regionName;
+        double maxConnectionReportRate = 0;
 
         /// Extract data from the JSON structure.
         if (root.isMember(SERVER_KEY)) {
@@ -131,11 +170,61 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            Json::Value jsonFiltering = jsonServer[SUBSCRIPTION_FILTERING_KEY];
+            if (jsonFiltering.isBool()) {
+                subscriptionFiltering = jsonFiltering.asBool();
+            }
+
+            Json::Value jsonUnixSocket = jsonServer[UNIX_SOCKET_KEY];
+            if (jsonUnixSocket.isString()) {
+                unixSocket = true;
+                socketPath = jsonUnixSocket.asString();
+            } else if (jsonUnixSocket.isBool()) {
+                unixSocket = jsonUnixSocket.asBool();
+            }
+
+            Json::Value jsonInProcess = jsonServer[IN_PROCESS_KEY];
+            if (jsonInProcess.isString()) {
+                inProcess = true;
+                hubName = jsonInProcess.asString();
+            } else if (jsonInProcess.isBool()) {
+                inProcess = jsonInProcess.asBool();
+            }
+
+            Json::Value jsonSharedMemory = jsonServer[SHARED_MEMORY_KEY];
+            if (jsonSharedMemory.isString()) {
+                sharedMemory = true;
+                regionName = jsonSharedMemory.asString();
+            } else if (jsonSharedMemory.isBool()) {
+                sharedMemory = jsonSharedMemory.asBool();
+            }
+
+            m_data->reportSuppression =
+                parseReportSuppression(jsonServer[REPORT_SUPPRESSION_KEY]);
+            m_data->reportSuppression.maxRate =
+                jsonServer.get(MAX_REPORT_RATE_KEY, 0.0).asDouble();
+            maxConnectionReportRate =
+                jsonServer.get(MAX_CONNECTION_REPORT_RATE_KEY, 0.0).asDouble();
         }
 
         /// Construct a server, or a connection then a server, based on the
         /// configuration we've extracted.
-        if (local && !port) {
+        if (inProcess) {
+            connection::ConnectionPtr connPtr(
+                connection::Connection::createInProcessConnection(hubName));
+            m_server = Server::create(connPtr);
+        } else if (sharedMemory) {
+            connection::ConnectionPtr connPtr(
+                connection::Connection::createSharedMemoryConnection(
+                    regionName));
+            m_server = Server::create(connPtr);
+        } else if (unixSocket) {
+            connection::ConnectionPtr connPtr(
+                connection::Connection::createUnixSocketConnection(
+                    socketPath));
+            m_server = Server::create(connPtr);
+        } else if (local && !port) {
             m_server = Server::createLocal();
         } else {
             connection::ConnectionPtr connPtr(
@@ -146,6 +235,10 @@ namespace server {
         if (sleepTime > 0.0)
             m_server->setSleepTime(sleepTime);
 
+        m_server->setSubscriptionFiltering(subscriptionFiltering);
+        m_server->setReportSuppression(m_data->reportSuppression);
+        m_server->setMaxConnectionReportRate(maxConnectionReportRate);
+
         return m_server;
     }
 
@@ -229,6 +322,22 @@ namespace server {
 
             const std::string driver = thisDriver[DRIVER_KEY].asString();
 
+            /// Settings of our own apply to the devices created while
+            /// instantiating this driver.
+            const Json::Value suppression = thisDriver[REPORT_SUPPRESSION_KEY];
+            const bool ownSettings = !suppression.isNull() ||
+                                     thisDriver.isMember(MAX_REPORT_RATE_KEY);
+            if (ownSettings) {
+                connection::ReportSuppressionSettings settings =
+                    suppression.isNull() ? m_data->reportSuppression
+                                         : parseReportSuppression(suppression);
+                settings.maxRate =
+                    thisDriver.get(MAX_REPORT_RATE_KEY,
+                                   m_data->reportSuppression.maxRate)
+                        .asDouble();
+                m_server->setReportSuppression(settings);
+            }
+
             try {
                 m_server->instantiateDriver(
                     plugin, driver, thisDriver[PARAMS_KEY].toStyledString());
@@ -239,6 +348,10 @@ namespace server {
                     std::make_pair(plugin + "/" + driver, e.what()));
                 success = false;
             }
+
+            if (ownSettings) {
+                m_server->setReportSuppression(m_data->reportSuppression);
+            }
         }
         return success;
     }
@@ -260,12 +373,23 @@ namespace server {
         const Json::Value routes = root[ROUTES_KEY];
         for (Json::ArrayIndex i = 0, e = routes.size(); i < e; ++i) {
             const Json::Value thisRoute = routes[i];
-            m_server->addRoute(thisRoute.toStyledString());
-            success = true;
+            try {
+                m_server->addRoute(thisRoute.toStyledString());
+                success = true;
+            } catch (std::exception &e) {
+                m_failedRoutes.push_back(std::make_pair(
+                    thisRoute.get(common::routing_keys::destination(), "?")
+                        .asString(),
+                    e.what()));
+            }
         }
         return success;
     }
 
+    ConfigureServer::ErrorList const &ConfigureServer::getFailedRoutes() const {
+        return m_failedRoutes;
+    }
+
     void ConfigureServer::loadAutoPlugins() { m_server->loadAutoPlugins(); }
 
 } // namespace server
@@ -94,6 +94,27 @@ namespace server {
 
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 
+    void Server::setSubscriptionFiltering(bool enabled) {
+        m_impl->setSubscriptionFiltering(enabled);
+    }
+
+    bool Server::getSubscriptionFiltering() const {
+        return m_impl->getSubscriptionFiltering();
+    }
+
+    void Server::setReportSuppression(
+        connection::ReportSuppressionSettings const &settings) {
+        m_impl->setReportSuppression(settings);
+    }
+
+    void Server::setMaxConnectionReportRate(double maxRate) {
+        m_impl->setMaxConnectionReportRate(maxRate);
+    }
+
+    std::string Server::getReportSuppressionCounts(bool styled) const {
+        return m_impl->getReportSuppressionCounts(styled);
+    }
+
     Server::Server(connection::ConnectionPtr const &conn,
                    private_constructor const &)
         : m_impl(new ServerImpl(conn)) {}
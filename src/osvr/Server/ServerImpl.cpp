@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include "ServerImpl.h"
+#include "TransformedTrackerDevice.h"
 #include <osvr/Connection/Connection.h>
 #include <osvr/PluginHost/RegistrationContext.h>
 #include <osvr/Util/MessageKeys.h>
@@ -32,21 +33,40 @@
 #include "../Connection/VrpnConnectionKind.h" /// @todo warning - cross-library internal header!
 #include <osvr/Util/Microsleep.h>
 #include <osvr/Common/SystemComponent.h>
+#include <osvr/Common/RoutingKeys.h>
+#include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Common/TrackerFilter.h>
+#include <osvr/Connection/SubscriptionFilter.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 #include <vrpn_ConnectionPtr.h>
+#include <json/value.h>
+#include <json/reader.h>
+#include <json/writer.h>
+#include <boost/optional.hpp>
 
 // Standard includes
 #include <stdexcept>
 #include <functional>
+#include <cctype>
 
 namespace osvr {
 namespace server {
+    /// @brief Are device reports on this connection sent as VRPN messages?
+    static bool
+    hasVRPNDeviceReports(connection::ConnectionPtr const &conn) {
+        return std::string(conn->getConnectionKindID()) ==
+               osvr::connection::getVRPNConnectionKindID();
+    }
     static vrpn_ConnectionPtr
     getVRPNConnection(connection::ConnectionPtr const &conn) {
         vrpn_ConnectionPtr ret;
-        if (std::string(conn->getConnectionKindID()) ==
-            osvr::connection::getVRPNConnectionKindID()) {
+        const std::string kind(conn->getConnectionKindID());
+        if (hasVRPNDeviceReports(conn) ||
+            kind == osvr::connection::getUnixSocketConnectionKindID() ||
+            kind == osvr::connection::getInProcessConnectionKindID() ||
+            kind == osvr::connection::getSharedMemoryConnectionKindID()) {
             ret = vrpn_ConnectionPtr(
                 static_cast<vrpn_Connection *>(conn->getUnderlyingObject()));
         }
@@ -70,6 +90,22 @@ namespace server {
             m_systemDevice->addComponent(common::SystemComponent::create());
         m_systemComponent->registerClientRouteUpdateHandler(
             &ServerImpl::m_handleUpdatedRoute, this);
+        m_systemComponent->respondToClockPings();
+        m_systemComponent->registerClientSubscriptionsHandler(
+            [this](std::string const &clientId,
+                   std::string const &connectionId,
+                   common::SourceSubscriptionList const &sources) {
+                util::time::TimeValue now;
+                util::time::getMonotonicNow(now);
+                m_conn->getSubscriptionFilter().setClientSubscriptions(
+                    clientId, connectionId, sources, now);
+            });
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_got_connection),
+            &ServerImpl::m_handleGotConnection, this, vrpn_ANY_SENDER);
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_dropped_connection),
+            &ServerImpl::m_handleDroppedConnection, this, vrpn_ANY_SENDER);
 
         // Things to do when we get a new incoming connection
         m_conn->registerConnectionHandler(
@@ -154,9 +190,13 @@ namespace server {
             boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
             m_conn->process();
             m_systemDevice->update();
+            for (auto const &tracker : m_transformedTrackers) {
+                tracker.second->update();
+            }
             for (auto &f : m_mainloopMethods) {
                 f();
             }
+            m_expireSubscriptions();
             shouldContinue = m_run.shouldContinue();
         }
 
@@ -187,6 +227,7 @@ namespace server {
     }
 
     void ServerImpl::m_orderedDestruction() {
+        m_transformedTrackers.clear();
         m_ctx.reset();
         m_systemComponent = nullptr; // non-owning pointer
         m_systemDevice.reset();
@@ -203,23 +244,239 @@ namespace server {
     int ServerImpl::m_handleUpdatedRoute(void *userdata, vrpn_HANDLERPARAM p) {
         auto self = static_cast<ServerImpl *>(userdata);
         OSVR_DEV_VERBOSE("Got an updated route from a client.");
-        self->m_addRoute(std::string(p.buffer, p.payload_len));
+        try {
+            self->m_addRoute(std::string(p.buffer, p.payload_len));
+        } catch (std::exception &e) {
+            /// There's no way to tell the client: the route is just not
+            /// added.
+            OSVR_DEV_VERBOSE("Rejected the route from the client: "
+                             << e.what());
+        }
+        return 0;
+    }
+
+    int ServerImpl::m_handleGotConnection(void *userdata,
+                                          vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        self->m_conn->getSubscriptionFilter().addConnection();
+        return 0;
+    }
+
+    int ServerImpl::m_handleDroppedConnection(void *userdata,
+                                              vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        self->m_conn->getSubscriptionFilter().removeConnection();
         return 0;
     }
 
     bool ServerImpl::m_addRoute(std::string const &routingDirective) {
-        bool wasNew = m_routes.addRoute(routingDirective);
+        bool wasNew = m_routes.addRoute(m_evaluateRoute(routingDirective));
         if (m_running) {
             m_sendRoutes();
         }
         return wasNew;
     }
 
+    static const char TRACKER_KEY[] = "tracker";
+    static const char SENSOR_KEY[] = "sensor";
+    static const char TRANSFORMED_DEVICE_PREFIX[] = "org_osvr_ServerRoute/";
+
+    /// @brief Makes a device name from a destination path, like
+    /// org_osvr_ServerRoute/me_head for /me/head
+    static inline std::string
+    transformedDeviceName(std::string const &destination) {
+        std::string ret(TRANSFORMED_DEVICE_PREFIX);
+        for (const char c : destination) {
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                ret.push_back(c);
+            } else if (ret.size() != sizeof(TRANSFORMED_DEVICE_PREFIX) - 1) {
+                ret.push_back('_');
+            }
+        }
+        return ret;
+    }
+
+    std::string
+    ServerImpl::m_evaluateRoute(std::string const &routingDirective) {
+        Json::Reader reader;
+        Json::Value route;
+        if (!reader.parse(routingDirective, route) || !route.isObject()) {
+            /// Let the route container report the problem.
+            return routingDirective;
+        }
+        const std::string dest =
+            route.get(common::routing_keys::destination(), "").asString();
+        Json::Value const &filterConfig =
+            route[common::routing_keys::serverFilter()];
+        /// A bad filter is a configuration error, not something to quietly
+        /// leave to the clients, which can't apply it: checked before
+        /// anything changes, so the route is rejected as a whole.
+        unique_ptr<common::TrackerFilter> filter;
+        if (!filterConfig.isNull()) {
+            try {
+                if (!filterConfig.isObject()) {
+                    throw std::runtime_error("not an object");
+                }
+                filter = common::TrackerFilter::create(filterConfig);
+            } catch (std::exception &e) {
+                throw std::runtime_error("Invalid server filter for route to " +
+                                         dest + ": " + e.what());
+            }
+        }
+        auto existing = m_transformedTrackers.find(dest);
+        /// Any previous route to this destination is being replaced.
+        auto clearExisting = [&] {
+            if (existing != end(m_transformedTrackers)) {
+                existing->second->clearSource();
+                m_conn->getSubscriptionFilter().removeDependency(
+                    existing->second->getName());
+            }
+        };
+        /// A filter is applied after the transform, so requesting one moves
+        /// the transform to the server as well.
+        if (!route.get(common::routing_keys::serverTransform(), false)
+                 .asBool() &&
+            !filter) {
+            clearExisting();
+            return routingDirective;
+        }
+        /// Clients can apply a transform just as well, but not a filter:
+        /// that is an error, so the route is rejected as a whole.
+        auto leaveToClients = [&](std::string const &reason) -> std::string {
+            if (filter) {
+                throw std::runtime_error(
+                    "Can't apply server filter for route to " + dest +
+                    ": " + reason);
+            }
+            OSVR_DEV_VERBOSE("Leaving the transform for route to "
+                             << dest << " to the clients: " << reason);
+            clearExisting();
+            return routingDirective;
+        };
+        Json::Value const &src = route[common::routing_keys::source()];
+        if (!src.isObject()) {
+            return leaveToClients("source is not a transform");
+        }
+        auto vrpnConn = getVRPNConnection(m_conn);
+        if (!vrpnConn || !hasVRPNDeviceReports(m_conn)) {
+            /// The transformed device listens for its source's reports as
+            /// VRPN messages.
+            return leaveToClients("server has no VRPN connection");
+        }
+
+        boost::optional<int> sensor;
+        std::string device;
+        common::Transform xform;
+        try {
+            common::JSONTransformVisitor xformParse(src);
+            Json::Value const &leaf = xformParse.getLeaf();
+            device = leaf[TRACKER_KEY].asString();
+            if (leaf.isMember(SENSOR_KEY)) {
+                sensor = leaf[SENSOR_KEY].asInt();
+            }
+            xform = xformParse.getTransform();
+        } catch (std::exception &e) {
+            return leaveToClients(std::string("could not parse transform: ") +
+                                  e.what());
+        }
+        if (device.size() < 2 || device[0] != '/' ||
+            device.find('@') != std::string::npos) {
+            /// Only devices on this server are handled here.
+            return leaveToClients("source is not a tracker on this server");
+        }
+        device.erase(begin(device)); // remove leading slash
+
+        clearExisting();
+        if (existing == end(m_transformedTrackers)) {
+            unique_ptr<TransformedTrackerDevice> tracker(
+                new TransformedTrackerDevice(m_conn, vrpnConn,
+                                             transformedDeviceName(dest)));
+            existing = m_transformedTrackers.insert(
+                std::make_pair(dest, std::move(tracker))).first;
+        }
+        TransformedTrackerDevice &tracker = *(existing->second);
+        tracker.setSource(device, sensor, xform, std::move(filter));
+        m_conn->getSubscriptionFilter().setDependency(
+            tracker.getName(),
+            common::SourceSubscription(
+                device, sensor.get_value_or(
+                            common::SourceSubscription::ALL_SENSORS)));
+
+        /// Clients now route straight from the transformed device.
+        Json::Value newSource(Json::objectValue);
+        newSource[TRACKER_KEY] = "/" + tracker.getName();
+        if (sensor) {
+            newSource[SENSOR_KEY] = *sensor;
+        }
+        route[common::routing_keys::source()] = newSource;
+        route.removeMember(common::routing_keys::serverTransform());
+        route.removeMember(common::routing_keys::serverFilter());
+        Json::FastWriter writer;
+        return writer.write(route);
+    }
+
     void ServerImpl::setSleepTime(int microseconds) {
         m_sleepTime = microseconds;
     }
 
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 
+    void ServerImpl::setSubscriptionFiltering(bool enabled) {
+        m_callControlled(
+            [&] { m_conn->getSubscriptionFilter().setEnabled(enabled); });
+    }
+
+    bool ServerImpl::getSubscriptionFiltering() const {
+        bool ret;
+        m_callControlled(
+            [&] { ret = m_conn->getSubscriptionFilter().isEnabled(); });
+        return ret;
+    }
+
+    void ServerImpl::setReportSuppression(
+        connection::ReportSuppressionSettings const &settings) {
+        m_callControlled(
+            [&] { m_conn->getReportSuppression().setDefaults(settings); });
+    }
+
+    void ServerImpl::setMaxConnectionReportRate(double maxRate) {
+        m_callControlled([&] {
+            m_conn->getReportSuppression().setMaxConnectionRate(maxRate);
+        });
+    }
+
+    std::string ServerImpl::getReportSuppressionCounts(bool styled) const {
+        Json::Value counts(Json::objectValue);
+        m_callControlled([&] {
+            for (auto const &device :
+                 m_conn->getReportSuppression().getDevices()) {
+                Json::Value &entry = counts[device.first];
+                entry["sent"] = Json::UInt64(device.second->getSentCount());
+                entry["suppressed"] =
+                    Json::UInt64(device.second->getSuppressedCount());
+                entry["conflated"] =
+                    Json::UInt64(device.second->getConflatedCount());
+            }
+        });
+        if (styled) {
+            return counts.toStyledString();
+        }
+        Json::FastWriter writer;
+        return writer.write(counts);
+    }
+
+    /// @brief Seconds a client's subscriptions last without being refreshed.
+    static const double SUBSCRIPTION_TIMEOUT = 5.0;
+
+    void ServerImpl::m_expireSubscriptions() {
+        auto &filter = m_conn->getSubscriptionFilter();
+        if (!filter.isEnabled() || filter.getNumClients() == 0) {
+            return;
+        }
+        util::time::TimeValue now;
+        util::time::getMonotonicNow(now);
+        filter.expireClients(now, SUBSCRIPTION_TIMEOUT);
+    }
+
 } // namespace server
 } // namespace osvr
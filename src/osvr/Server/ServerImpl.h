@@ -35,6 +35,7 @@
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/SystemComponent_fwd.h>
+#include <osvr/Util/UniquePtr.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -43,10 +44,12 @@
 #include <vrpn_Connection.h>
 
 // Standard includes
-// - none
+#include <string>
+#include <map>
 
 namespace osvr {
 namespace server {
+    class TransformedTrackerDevice;
 
     /// @brief Private implementation class for Server.
     class ServerImpl : boost::noncopyable {
@@ -101,6 +104,22 @@ namespace server {
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
 
+        /// @copydoc Server::setSubscriptionFiltering()
+        void setSubscriptionFiltering(bool enabled);
+
+        /// @copydoc Server::getSubscriptionFiltering()
+        bool getSubscriptionFiltering() const;
+
+        /// @copydoc Server::setReportSuppression()
+        void setReportSuppression(
+            connection::ReportSuppressionSettings const &settings);
+
+        /// @copydoc Server::setMaxConnectionReportRate()
+        void setMaxConnectionReportRate(double maxRate);
+
+        /// @copydoc Server::getReportSuppressionCounts()
+        std::string getReportSuppressionCounts(bool styled) const;
+
         /// @copydoc Server::instantiateDriver()
         void instantiateDriver(std::string const &plugin,
                                std::string const &driver,
@@ -129,10 +148,35 @@ namespace server {
         static int VRPN_CALLBACK
         m_handleUpdatedRoute(void *userdata, vrpn_HANDLERPARAM p);
 
+        /// @brief Counts connected clients for the subscription filter,
+        /// since not all of them will subscribe.
+        /// @{
+        static int VRPN_CALLBACK
+        m_handleGotConnection(void *userdata, vrpn_HANDLERPARAM);
+        static int VRPN_CALLBACK
+        m_handleDroppedConnection(void *userdata, vrpn_HANDLERPARAM);
+        /// @}
+
         /// @brief adds a route - assumes that you've handled ensuring this is
         /// the main server thread.
+        ///
+        /// @throws std::runtime_error as m_evaluateRoute() does.
         bool m_addRoute(std::string const &routingDirective);
 
+        /// @brief If a routing directive asks for its transform to be applied
+        /// on the server, sets up a device to do so and returns the directive
+        /// rewritten to route from that device. Otherwise, returns the
+        /// directive unchanged.
+        ///
+        /// @throws std::runtime_error if the directive has a server filter
+        /// that can't be created or applied on this server, leaving
+        /// everything unchanged.
+        std::string m_evaluateRoute(std::string const &routingDirective);
+
+        /// @brief Forgets the subscriptions of clients that have stopped
+        /// refreshing them.
+        void m_expireSubscriptions();
+
         /// @brief Connection ownership.
         connection::ConnectionPtr m_conn;
 
@@ -151,6 +195,11 @@ namespace server {
         /// @brief JSON routing directives
         common::RouteContainer m_routes;
 
+        /// @brief Devices applying route transforms on the server, by
+        /// destination.
+        std::map<std::string, unique_ptr<TransformedTrackerDevice> >
+            m_transformedTrackers;
+
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
 
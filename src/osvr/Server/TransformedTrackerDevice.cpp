@@ -0,0 +1,239 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TransformedTrackerDevice.h"
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Common/PoseBatchMessage.h>
+#include <osvr/Common/TrackerStateMessage.h>
+#include <osvr/Util/QuatlibInteropC.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace server {
+    /// @brief Sensors a transformed tracker handles: reports for any others
+    /// are malformed, and would have the filter keep state for that many.
+    static const int32_t MAX_SENSORS = 1024;
+
+    static inline bool isValidSensor(int32_t sensor) {
+        return sensor >= 0 && sensor < MAX_SENSORS;
+    }
+
+    TransformedTrackerDevice::TransformedTrackerDevice(
+        connection::ConnectionPtr const &conn,
+        vrpn_ConnectionPtr const &vrpnConn, std::string const &name)
+        : m_name(name), m_vrpnConn(vrpnConn), m_tracker(nullptr),
+          m_sensor(-1), m_sourceSender(0) {
+        connection::DeviceInitObject init(conn);
+        init.setName(m_name);
+        init.setTracker(&m_tracker);
+        m_token = connection::DeviceToken::createVirtualDevice(init);
+        m_batchMessageType = m_vrpnConn->register_message_type(
+            common::PoseBatchMessage::identifier());
+        m_stateMessageType = m_vrpnConn->register_message_type(
+            common::TrackerStateMessage::identifier());
+    }
+
+    TransformedTrackerDevice::~TransformedTrackerDevice() {
+        m_unregisterNative();
+    }
+
+    void TransformedTrackerDevice::setSource(std::string const &device,
+                                             boost::optional<int> sensor,
+                                             common::Transform const &xform,
+                                             unique_ptr<common::TrackerFilter>
+                                                 filter) {
+        OSVR_DEV_VERBOSE("Applying route transform on the server: "
+                         << device << " => " << m_name);
+        m_unregisterNative();
+        m_transform = common::CompiledTransform(xform);
+        m_filter = std::move(filter);
+        m_sensor = sensor.get_value_or(-1);
+        m_remote.reset(
+            new vrpn_Tracker_Remote(device.c_str(), m_vrpnConn.get()));
+        m_remote->register_change_handler(
+            this, &TransformedTrackerDevice::m_handle, m_sensor);
+        m_remote->shutup = true;
+        m_sourceSender = m_vrpnConn->register_sender(device.c_str());
+        m_vrpnConn->register_handler(m_batchMessageType,
+                                     &TransformedTrackerDevice::m_handleBatch,
+                                     this, m_sourceSender);
+        m_vrpnConn->register_handler(m_stateMessageType,
+                                     &TransformedTrackerDevice::m_handleState,
+                                     this, m_sourceSender);
+    }
+
+    void TransformedTrackerDevice::clearSource() {
+        m_unregisterNative();
+        m_remote.reset();
+    }
+
+    void TransformedTrackerDevice::update() {
+        if (m_remote) {
+            m_remote->mainloop();
+        }
+    }
+
+    void TransformedTrackerDevice::m_handle(void *userdata,
+                                            vrpn_TRACKERCB info) {
+        auto self = static_cast<TransformedTrackerDevice *>(userdata);
+        if (!self->m_tracker || !isValidSensor(info.sensor)) {
+            return;
+        }
+        OSVR_PoseState pose;
+        osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+        osvrVec3FromQuatlib(&(pose.translation), info.pos);
+        util::time::TimeValue timestamp;
+        osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
+        self->m_process(timestamp, OSVR_ChannelCount(info.sensor), &pose, 1);
+        self->m_tracker->sendReport(pose, info.sensor, timestamp);
+    }
+
+    int TransformedTrackerDevice::m_handleBatch(void *userdata,
+                                                vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TransformedTrackerDevice *>(userdata);
+        const common::PoseBatchMessage msg(p.buffer,
+                                           std::size_t(p.payload_len));
+        if (!self->m_tracker || !msg.isValid()) {
+            return 0;
+        }
+        util::time::TimeValue timestamp;
+        osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+        if (self->m_sensor >= 0) {
+            if (isValidSensor(self->m_sensor) &&
+                msg.hasSensor(self->m_sensor)) {
+                OSVR_PoseState pose = msg.getPose(self->m_sensor);
+                self->m_process(timestamp, OSVR_ChannelCount(self->m_sensor),
+                                &pose, 1);
+                self->m_tracker->sendReport(pose, self->m_sensor, timestamp);
+            }
+            return 0;
+        }
+        if (!isValidSensor(msg.getFirst()) ||
+            msg.getFirst() + int32_t(msg.getCount()) > MAX_SENSORS) {
+            return 0;
+        }
+        const int32_t end = msg.getFirst() + int32_t(msg.getCount());
+        self->m_poses.resize(msg.getCount());
+        for (int32_t i = msg.getFirst(); i < end; ++i) {
+            self->m_poses[i - msg.getFirst()] = msg.getPose(i);
+        }
+        self->m_process(timestamp, OSVR_ChannelCount(msg.getFirst()),
+                        self->m_poses.data(),
+                        OSVR_ChannelCount(msg.getCount()));
+        if (msg.getFirst() == 0) {
+            self->m_tracker->sendReports(self->m_poses.data(),
+                                         OSVR_ChannelCount(msg.getCount()),
+                                         timestamp);
+            return 0;
+        }
+        /// sendReports() always starts from the first sensor, so later
+        /// batches of a large device go out one sensor at a time.
+        for (int32_t i = msg.getFirst(); i < end; ++i) {
+            self->m_tracker->sendReport(self->m_poses[i - msg.getFirst()], i,
+                                        timestamp);
+        }
+        return 0;
+    }
+
+    int TransformedTrackerDevice::m_handleState(void *userdata,
+                                                vrpn_HANDLERPARAM p) {
+        auto self = static_cast<TransformedTrackerDevice *>(userdata);
+        uint32_t sequence;
+        int32_t sensor;
+        OSVR_TrackerState state;
+        if (!self->m_tracker ||
+            !common::TrackerStateMessage::decode(p.buffer,
+                                                 std::size_t(p.payload_len),
+                                                 sequence, sensor, state) ||
+            !isValidSensor(sensor)) {
+            return 0;
+        }
+        if (self->m_sensor >= 0 && sensor != self->m_sensor) {
+            return 0;
+        }
+        /// Velocities are transformed with the pose, or dropped if they
+        /// can't be; accelerations are always dropped.
+        const OSVR_TrackerStateFlags linear =
+            state.flags & OSVR_TRACKER_LINEAR_VELOCITY_VALID;
+        const OSVR_TrackerStateFlags angular =
+            state.flags & OSVR_TRACKER_ANGULAR_VELOCITY_VALID;
+        const bool velocity =
+            (linear || angular) &&
+            self->m_transform.applyToVelocity(
+                state.pose.rotation, linear ? &state.linearVelocity : nullptr,
+                angular ? &state.angularVelocity : nullptr);
+        state.flags &= ~(OSVR_TRACKER_LINEAR_ACCELERATION_VALID |
+                         OSVR_TRACKER_ANGULAR_ACCELERATION_VALID);
+        if (!velocity) {
+            state.flags &= ~(OSVR_TRACKER_LINEAR_VELOCITY_VALID |
+                             OSVR_TRACKER_ANGULAR_VELOCITY_VALID);
+        }
+        self->m_transform.apply(state.pose);
+        util::time::TimeValue timestamp;
+        osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+        const OSVR_TrackerStateFlags poseValid =
+            OSVR_TRACKER_POSITION_VALID | OSVR_TRACKER_ORIENTATION_VALID;
+        if (self->m_filter && (state.flags & poseValid) == poseValid) {
+            self->m_filter->filter(timestamp, OSVR_ChannelCount(sensor),
+                                   &state.pose, 1);
+        }
+        self->m_tracker->sendReport(state, sensor, timestamp);
+        return 0;
+    }
+
+    void TransformedTrackerDevice::m_process(
+        util::time::TimeValue const &timestamp, OSVR_ChannelCount first,
+        OSVR_PoseState poses[], OSVR_ChannelCount count) {
+        for (OSVR_ChannelCount i = 0; i < count; ++i) {
+            m_transform.apply(poses[i]);
+        }
+        if (m_filter) {
+            /// One call for the whole batch, so the filter steps through all
+            /// the sensors at once.
+            m_filter->filter(timestamp, first, poses, count);
+        }
+    }
+
+    void TransformedTrackerDevice::m_unregisterNative() {
+        if (m_remote) {
+            m_vrpnConn->unregister_handler(
+                m_batchMessageType, &TransformedTrackerDevice::m_handleBatch,
+                this, m_sourceSender);
+            m_vrpnConn->unregister_handler(
+                m_stateMessageType, &TransformedTrackerDevice::m_handleState,
+                this, m_sourceSender);
+        }
+    }
+
+} // namespace server
+} // namespace osvr
@@ -0,0 +1,122 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TransformedTrackerDevice_h_GUID_2CCF8FA5_F2B6_452F_8198_C7A3114D0FF0
+#define INCLUDED_TransformedTrackerDevice_h_GUID_2CCF8FA5_F2B6_452F_8198_C7A3114D0FF0
+
+// Internal Includes
+#include <osvr/Connection/ConnectionPtr.h>
+#include <osvr/Connection/DeviceTokenPtr.h>
+#include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/TrackerFilter.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <vrpn_ConnectionPtr.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace server {
+
+    /// @brief A virtual tracker device that republishes the reports of
+    /// another tracker device on the server with a route transform applied,
+    /// so that clients routed to it need not each apply the transform - and
+    /// optionally smoothed by a TrackerFilter, once for all clients.
+    class TransformedTrackerDevice : boost::noncopyable {
+      public:
+        /// @brief Creates the device on the connection.
+        ///
+        /// Devices can't be removed from a connection, so the server keeps
+        /// this object for as long as the connection, and retargets it if the
+        /// route changes.
+        TransformedTrackerDevice(connection::ConnectionPtr const &conn,
+                                 vrpn_ConnectionPtr const &vrpnConn,
+                                 std::string const &name);
+
+        ~TransformedTrackerDevice();
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /// @brief Gets the name of the device.
+        std::string const &getName() const { return m_name; }
+
+        /// @brief Starts (or restarts) republishing reports from a tracker
+        /// device on the same connection.
+        ///
+        /// @param device Name of the source device
+        /// @param sensor Source sensor, if only one should be republished.
+        /// @param xform Transform to apply to each report.
+        /// @param filter Filter to apply to each report after the transform,
+        /// if any.
+        void setSource(std::string const &device, boost::optional<int> sensor,
+                       common::Transform const &xform,
+                       unique_ptr<common::TrackerFilter> filter =
+                           unique_ptr<common::TrackerFilter>());
+
+        /// @brief Stops republishing reports.
+        void clearSource();
+
+        /// @brief Called from the server mainloop.
+        void update();
+
+      private:
+        static void VRPN_CALLBACK m_handle(void *userdata, vrpn_TRACKERCB info);
+        static int VRPN_CALLBACK m_handleBatch(void *userdata,
+                                               vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK m_handleState(void *userdata,
+                                               vrpn_HANDLERPARAM p);
+        /// @brief Stops handling the source's tracker messages that the VRPN
+        /// remote doesn't understand.
+        void m_unregisterNative();
+        /// @brief Applies the transform, then the filter if any, to the
+        /// poses of sensors [first, first + count).
+        void m_process(util::time::TimeValue const &timestamp,
+                       OSVR_ChannelCount first, OSVR_PoseState poses[],
+                       OSVR_ChannelCount count);
+        std::string const m_name;
+        vrpn_ConnectionPtr m_vrpnConn;
+        connection::DeviceTokenPtr m_token;
+        connection::TrackerServerInterface *m_tracker;
+        unique_ptr<vrpn_Tracker_Remote> m_remote;
+        int m_sensor;
+        vrpn_int32 m_batchMessageType;
+        vrpn_int32 m_stateMessageType;
+        vrpn_int32 m_sourceSender;
+        /// @brief Scratch space for republishing batched poses.
+        std::vector<OSVR_PoseState> m_poses;
+        common::CompiledTransform m_transform;
+        unique_ptr<common::TrackerFilter> m_filter;
+    };
+
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_TransformedTrackerDevice_h_GUID_2CCF8FA5_F2B6_452F_8198_C7A3114D0FF0
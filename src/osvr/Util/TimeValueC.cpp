@@ -39,7 +39,16 @@ typedef long tv_seconds_type;
 typedef long tv_microseconds_type;
 #endif
 
-#define OSVR_USEC_PER_SEC 1000000;
+#if defined(OSVR_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(OSVR_MACOSX)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+#define OSVR_USEC_PER_SEC 1000000
 
 void osvrTimeValueNormalize(OSVR_INOUT_PTR OSVR_TimeValue *tv) {
     if (!tv) {
@@ -80,8 +89,83 @@ void osvrTimeValueDifference(OSVR_INOUT_PTR OSVR_TimeValue *tvA,
     osvrTimeValueNormalize(tvA);
 }
 
+double osvrTimeValueDurationSeconds(OSVR_IN_PTR const OSVR_TimeValue *tvA,
+                                    OSVR_IN_PTR const OSVR_TimeValue *tvB) {
+    if (!tvA || !tvB) {
+        return 0;
+    }
+    return double(tvA->seconds - tvB->seconds) +
+           double(tvA->microseconds - tvB->microseconds) / OSVR_USEC_PER_SEC;
+}
+
+void osvrTimeValueGetMonotonicNow(OSVR_OUT OSVR_TimeValue *dest) {
+    if (!dest) {
+        return;
+    }
+#if defined(OSVR_WINDOWS)
+    static const LONGLONG freq = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return f.QuadPart;
+    }();
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    dest->seconds = count.QuadPart / freq;
+    dest->microseconds = OSVR_TimeValue_Microseconds(
+        (count.QuadPart % freq) * OSVR_USEC_PER_SEC / freq);
+#elif defined(OSVR_MACOSX)
+    static const mach_timebase_info_data_t timebase = [] {
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        return info;
+    }();
+    const uint64_t ticks = mach_absolute_time();
+    // Split the scaling to avoid overflowing with large tick counts.
+    const uint64_t nanos = (ticks / timebase.denom) * timebase.numer +
+                           (ticks % timebase.denom) * timebase.numer /
+                               timebase.denom;
+    dest->seconds = OSVR_TimeValue_Seconds(nanos / 1000000000);
+    dest->microseconds =
+        OSVR_TimeValue_Microseconds((nanos % 1000000000) / 1000);
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    dest->seconds = ts.tv_sec;
+    dest->microseconds = OSVR_TimeValue_Microseconds(ts.tv_nsec / 1000);
+#endif
+}
+
 #ifdef OSVR_HAVE_STRUCT_TIMEVAL
 
+/// @brief Captures the offset that, added to a monotonic reading, yields wall
+/// clock time. Computed once so that mapped values can never step backwards.
+static OSVR_TimeValue const &getMonotonicToWallClockOffset() {
+    static const OSVR_TimeValue offset = [] {
+        OSVR_TimeValue mono;
+        osvrTimeValueGetMonotonicNow(&mono);
+        OSVR_TimeValue wall;
+        osvrTimeValueGetNow(&wall);
+        osvrTimeValueDifference(&wall, &mono);
+        return wall;
+    }();
+    return offset;
+}
+
+void osvrTimeValueMonotonicToWallClock(OSVR_INOUT_PTR OSVR_TimeValue *tv) {
+    if (!tv) {
+        return;
+    }
+    osvrTimeValueSum(tv, &getMonotonicToWallClockOffset());
+}
+
+void osvrTimeValueGetSteadyNow(OSVR_OUT OSVR_TimeValue *dest) {
+    if (!dest) {
+        return;
+    }
+    osvrTimeValueGetMonotonicNow(dest);
+    osvrTimeValueMonotonicToWallClock(dest);
+}
+
 void osvrTimeValueGetNow(OSVR_INOUT_PTR OSVR_TimeValue *dest) {
     timeval tv;
     vrpn_gettimeofday(&tv, nullptr);
@@ -0,0 +1,102 @@
+/** @file
+    @brief Implementation of a benchmark of callback dispatch throughput
+    through InterfaceCallbacks, compared to the previous storage of std::bind
+    results in std::function objects.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Client/InterfaceCallbacks.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+static const std::size_t LISTENER_COUNTS[] = {1, 10, 100};
+
+/// @brief Total callback calls per measurement.
+static const std::uint64_t CALLS_PER_RUN = 20000000;
+
+static void countingCallback(void *userdata, const OSVR_TimeValue *,
+                             const OSVR_PoseReport *report) {
+    *static_cast<volatile std::uint64_t *>(userdata) += report->sensor;
+}
+
+template <typename F>
+static double callsPerSecond(std::size_t listeners, F &&dispatch) {
+    const std::uint64_t dispatches = CALLS_PER_RUN / listeners;
+    OSVR_TimeValue start;
+    OSVR_TimeValue end;
+    osvr::util::time::getMonotonicNow(start);
+    for (std::uint64_t i = 0; i < dispatches; ++i) {
+        dispatch();
+    }
+    osvr::util::time::getMonotonicNow(end);
+    return (dispatches * listeners) / osvr::util::time::duration(end, start);
+}
+
+int main() {
+    OSVR_TimeValue timestamp;
+    osvr::util::time::getNow(timestamp);
+    OSVR_PoseReport report;
+    report.sensor = 1;
+    osvrPose3SetIdentity(&report.pose);
+    volatile std::uint64_t sink = 0;
+    void *userdata = const_cast<std::uint64_t *>(&sink);
+
+    std::cout << std::setw(10) << "Listeners" << std::setw(24)
+              << "InterfaceCallbacks" << std::setw(24) << "std::function"
+              << "    (callbacks/sec)" << std::endl;
+    for (auto listeners : LISTENER_COUNTS) {
+        osvr::client::InterfaceCallbacks callbacks;
+        typedef std::function<void(const OSVR_TimeValue *,
+                                   const OSVR_PoseReport *)> Function;
+        std::vector<Function> functions;
+        for (std::size_t i = 0; i < listeners; ++i) {
+            callbacks.addCallback(&countingCallback, userdata);
+            using namespace std::placeholders;
+            functions.push_back(
+                std::bind(&countingCallback, userdata, _1, _2));
+        }
+
+        const double direct = callsPerSecond(
+            listeners,
+            [&] { callbacks.triggerCallbacks(timestamp, report); });
+        const double bound = callsPerSecond(listeners, [&] {
+            for (auto const &f : functions) {
+                f(&timestamp, &report);
+            }
+        });
+        std::cout << std::setw(10) << listeners << std::setw(24)
+                  << std::fixed << std::setprecision(0) << direct
+                  << std::setw(24) << bound << std::endl;
+    }
+    return 0;
+}
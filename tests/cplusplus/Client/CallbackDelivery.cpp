@@ -0,0 +1,643 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Client/ClientContext.h>
+#include <osvr/Client/ClientInterface.h>
+#include <osvr/ClientKit/InterfaceStateC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+#include <vector>
+
+using osvr::client::ClientInterfacePtr;
+
+/// @brief Context that "receives" a burst of button reports and a burst of
+/// pose reports for every interface each time it is updated.
+class MockContext : public ::OSVR_ClientContextObject {
+  public:
+    MockContext(int posesPerUpdate = 1, int buttonsPerUpdate = 1)
+        : ::OSVR_ClientContextObject("org.osvr.test"), sending(true),
+          updates(0), m_posesPerUpdate(posesPerUpdate),
+          m_buttonsPerUpdate(buttonsPerUpdate) {}
+    virtual ~MockContext() { stopNetworkThread(); }
+
+    /// @brief Whether updates "receive" any reports.
+    std::atomic<bool> sending;
+    /// @brief Number of updates so far, on whatever thread.
+    std::atomic<int> updates;
+
+  private:
+    virtual void m_update() {
+        ++updates;
+        if (!sending) {
+            return;
+        }
+        OSVR_ButtonReport report;
+        report.sensor = 0;
+        report.state = OSVR_BUTTON_PRESSED;
+        OSVR_TimeValue now;
+        osvrTimeValueGetNow(&now);
+        for (auto const &core : getInterfaceCores()) {
+            for (int i = 0; i < m_buttonsPerUpdate; ++i) {
+                core->triggerCallbacks(now, report);
+            }
+            for (int i = 0; i < m_posesPerUpdate; ++i) {
+                OSVR_PoseReport pose;
+                pose.sensor = 0;
+                osvrPose3SetIdentity(&pose.pose);
+                osvrVec3SetX(&pose.pose.translation, i);
+                core->triggerCallbacks(now, pose);
+            }
+        }
+    }
+    int m_posesPerUpdate;
+    int m_buttonsPerUpdate;
+    virtual void m_sendRoute(std::string const &) {}
+};
+
+struct CallbackRecord {
+    CallbackRecord() : count(0) {}
+    std::atomic<int> count;
+    boost::thread::id thread;
+};
+
+static void buttonCallback(void *userdata, const OSVR_TimeValue *,
+                           const OSVR_ButtonReport *) {
+    auto record = static_cast<CallbackRecord *>(userdata);
+    record->thread = boost::this_thread::get_id();
+    ++record->count;
+}
+
+static void poseCallback(void *userdata, const OSVR_TimeValue *,
+                         const OSVR_PoseReport *report) {
+    auto poses = static_cast<std::vector<double> *>(userdata);
+    OSVR_Vec3 translation = report->pose.translation;
+    poses->push_back(osvrVec3GetX(&translation));
+}
+
+struct CoalescedRecord {
+    CoalescedRecord() : iface(nullptr), calls(0), skipped(0), lastX(-1) {}
+    OSVR_ClientInterface iface;
+    int calls;
+    std::size_t skipped;
+    double lastX;
+};
+
+static void coalescedPoseCallback(void *userdata, const OSVR_TimeValue *,
+                                  const OSVR_PoseReport *report) {
+    auto record = static_cast<CoalescedRecord *>(userdata);
+    OSVR_Vec3 translation = report->pose.translation;
+    record->lastX = osvrVec3GetX(&translation);
+    record->skipped += record->iface->getSkippedReportCount();
+    ++record->calls;
+}
+
+static void waitForState(ClientInterfacePtr const &iface) {
+    osvr::util::time::TimeValue timestamp;
+    OSVR_ButtonState state;
+    while (!iface->getState<OSVR_ButtonReport>(timestamp, state)) {
+        boost::this_thread::yield();
+    }
+}
+
+TEST(NetworkThread, WithoutThreadUpdateCallsDirectly) {
+    MockContext ctx;
+    CallbackRecord record;
+    auto iface = ctx.getInterface("/button");
+    iface->registerCallback(&buttonCallback, &record);
+    ASSERT_FALSE(ctx.hasNetworkThread());
+    ctx.update();
+    ASSERT_EQ(1, record.count);
+    ASSERT_EQ(boost::this_thread::get_id(), record.thread);
+}
+
+TEST(NetworkThread, QueuedCallbacksDeliveredByUpdate) {
+    MockContext ctx;
+    CallbackRecord record;
+    auto iface = ctx.getInterface("/button");
+    iface->registerCallback(&buttonCallback, &record);
+    ctx.startNetworkThread(false);
+    ASSERT_TRUE(ctx.isQueueingCallbacks());
+    waitForState(iface);
+    ASSERT_EQ(0, record.count);
+    ctx.update();
+    ASSERT_GT(record.count, 0);
+    ASSERT_EQ(boost::this_thread::get_id(), record.thread);
+    ctx.stopNetworkThread();
+    ASSERT_FALSE(ctx.hasNetworkThread());
+}
+
+TEST(NetworkThread, CallbacksOnNetworkThread) {
+    MockContext ctx;
+    CallbackRecord record;
+    auto iface = ctx.getInterface("/button");
+    iface->registerCallback(&buttonCallback, &record);
+    ctx.startNetworkThread(true);
+    ASSERT_FALSE(ctx.isQueueingCallbacks());
+    while (record.count == 0) {
+        boost::this_thread::yield();
+    }
+    ctx.stopNetworkThread();
+    ASSERT_NE(boost::this_thread::get_id(), record.thread);
+}
+
+TEST(NetworkThread, QueuedCallbacksSkippedForFreedInterface) {
+    MockContext ctx;
+    CallbackRecord record;
+    auto iface = ctx.getInterface("/button");
+    iface->registerCallback(&buttonCallback, &record);
+    ctx.startNetworkThread(false);
+    waitForState(iface);
+    ctx.releaseInterface(iface.get());
+    iface.reset();
+    ctx.update();
+    ASSERT_EQ(0, record.count);
+}
+
+TEST(UpdateWithBudget, ZeroBudgetDefersCallbacks) {
+    MockContext ctx(3);
+    std::vector<double> poses;
+    auto iface = ctx.getInterface("/tracker");
+    iface->registerCallback(&poseCallback, &poses);
+    ctx.updateWithBudget(0, false);
+    ASSERT_TRUE(poses.empty());
+    osvr::util::time::TimeValue timestamp;
+    OSVR_PoseState state;
+    ASSERT_TRUE(iface->getState<OSVR_PoseReport>(timestamp, state));
+    ASSERT_EQ(2, osvrVec3GetX(&state.translation));
+
+    /// Leftovers are delivered first, in order.
+    ctx.update();
+    ASSERT_EQ(6u, poses.size());
+    ASSERT_EQ(0, poses[0]);
+    ASSERT_EQ(2, poses[2]);
+    ASSERT_EQ(0, poses[3]);
+}
+
+TEST(UpdateWithBudget, AmpleBudgetDeliversEverything) {
+    MockContext ctx(5);
+    std::vector<double> poses;
+    auto iface = ctx.getInterface("/tracker");
+    iface->registerCallback(&poseCallback, &poses);
+    ctx.updateWithBudget(1000000, false);
+    ASSERT_EQ(5u, poses.size());
+}
+
+TEST(UpdateWithBudget, DropSupersededKeepsNewest) {
+    MockContext ctx(5);
+    std::vector<double> poses;
+    CallbackRecord buttons;
+    auto iface = ctx.getInterface("/tracker");
+    iface->registerCallback(&poseCallback, &poses);
+    iface->registerCallback(&buttonCallback, &buttons);
+    ctx.updateWithBudget(1000000, true);
+    ASSERT_EQ(1u, poses.size());
+    ASSERT_EQ(4, poses[0]);
+    ASSERT_EQ(1, buttons.count);
+}
+
+TEST(UpdateWithBudget, DropSupersededEvenWithoutBudget) {
+    MockContext ctx(5);
+    std::vector<double> poses;
+    auto iface = ctx.getInterface("/tracker");
+    iface->registerCallback(&poseCallback, &poses);
+    ctx.updateWithBudget(0, false);
+    ctx.updateWithBudget(0, true);
+    /// Everything but the newest pose from the second burst is superseded.
+    ASSERT_TRUE(poses.empty());
+    ctx.updateWithBudget(1000000, true);
+    ASSERT_EQ(1u, poses.size());
+    ASSERT_EQ(4, poses[0]);
+}
+
+TEST(CoalesceCallbacks, OneCallPerUpdate) {
+    MockContext ctx(5);
+    auto iface = ctx.getInterface("/imu");
+    CoalescedRecord record;
+    record.iface = iface.get();
+    CallbackRecord buttons;
+    iface->registerCallback(&coalescedPoseCallback, &record);
+    iface->registerCallback(&buttonCallback, &buttons);
+    iface->setCoalesceCallbacks(true);
+
+    ctx.update();
+    ASSERT_EQ(1, record.calls);
+    ASSERT_EQ(4, record.lastX);
+    ASSERT_EQ(4u, record.skipped);
+    ASSERT_EQ(1, buttons.count);
+    ASSERT_EQ(0u, iface->getSkippedReportCount());
+
+    ctx.update();
+    ASSERT_EQ(2, record.calls);
+    ASSERT_EQ(8u, record.skipped);
+}
+
+TEST(CoalesceCallbacks, NeverForButtons) {
+    MockContext ctx(5, 3);
+    auto iface = ctx.getInterface("/imu");
+    CoalescedRecord record;
+    record.iface = iface.get();
+    CallbackRecord buttons;
+    iface->registerCallback(&coalescedPoseCallback, &record);
+    iface->registerCallback(&buttonCallback, &buttons);
+    iface->setCoalesceCallbacks(true);
+    ctx.update();
+    ASSERT_EQ(1, record.calls);
+    ASSERT_EQ(3, buttons.count);
+}
+
+TEST(CoalesceCallbacks, AcrossDeferredUpdates) {
+    MockContext ctx(5);
+    auto iface = ctx.getInterface("/imu");
+    CoalescedRecord record;
+    record.iface = iface.get();
+    iface->registerCallback(&coalescedPoseCallback, &record);
+    iface->setCoalesceCallbacks(true);
+    ctx.updateWithBudget(0, false);
+    ctx.updateWithBudget(0, false);
+    ASSERT_EQ(0, record.calls);
+    ctx.update();
+    /// The callback left pending by the first update delivers the newest of
+    /// both bursts, then this update's burst gets a call of its own.
+    ASSERT_EQ(2, record.calls);
+    ASSERT_EQ(4, record.lastX);
+    ASSERT_EQ(9u + 4u, record.skipped);
+}
+
+TEST(CoalesceCallbacks, DisabledByDefault) {
+    MockContext ctx(5);
+    auto iface = ctx.getInterface("/imu");
+    CoalescedRecord record;
+    record.iface = iface.get();
+    iface->registerCallback(&coalescedPoseCallback, &record);
+    ctx.update();
+    ASSERT_EQ(5, record.calls);
+    ASSERT_EQ(0u, record.skipped);
+}
+
+TEST(CoalesceCallbacks, WithQueuedNetworkThread) {
+    MockContext ctx(5);
+    auto iface = ctx.getInterface("/imu");
+    CoalescedRecord record;
+    record.iface = iface.get();
+    iface->registerCallback(&coalescedPoseCallback, &record);
+    iface->setCoalesceCallbacks(true);
+    ctx.startNetworkThread(false);
+    while (record.calls == 0) {
+        ctx.update();
+        boost::this_thread::yield();
+    }
+    for (int i = 0; i < 10; ++i) {
+        const int before = record.calls;
+        ctx.update();
+        ASSERT_LE(record.calls - before, 1);
+        boost::this_thread::yield();
+    }
+    ctx.stopNetworkThread();
+    ASSERT_EQ(4, record.lastX);
+    ASSERT_GT(record.skipped, 0u);
+}
+
+static void waitForUpdates(MockContext &ctx, int count) {
+    const int target = ctx.updates + count;
+    while (ctx.updates < target) {
+        boost::this_thread::yield();
+    }
+}
+
+TEST(CoalesceCallbacks, RecoversFromFullQueue) {
+    /// Enough button callbacks to fill the queue in a few updates.
+    MockContext ctx(1, 1000);
+    auto filler = ctx.getInterface("/button");
+    CallbackRecord buttons;
+    filler->registerCallback(&buttonCallback, &buttons);
+    auto iface = ctx.getInterface("/imu");
+    iface->setCoalesceCallbacks(true);
+    ctx.startNetworkThread(false);
+    waitForUpdates(ctx, 6);
+    CoalescedRecord record;
+    record.iface = iface.get();
+    iface->registerCallback(&coalescedPoseCallback, &record);
+    /// Its first coalesced callback finds the queue full.
+    waitForUpdates(ctx, 2);
+    for (int i = 0; i < 1000 && record.calls == 0; ++i) {
+        ctx.update();
+        waitForUpdates(ctx, 1);
+    }
+    ctx.update();
+    ctx.stopNetworkThread();
+    ASSERT_GT(record.calls, 0);
+}
+
+TEST(CoalesceCallbacks, RecoversFromDiscardedQueue) {
+    MockContext ctx;
+    auto iface = ctx.getInterface("/imu");
+    CoalescedRecord record;
+    record.iface = iface.get();
+    iface->registerCallback(&coalescedPoseCallback, &record);
+    iface->setCoalesceCallbacks(true);
+    ctx.startNetworkThread(false);
+    waitForUpdates(ctx, 2);
+    /// Discards the queued coalesced callback.
+    ctx.stopNetworkThread();
+    ASSERT_EQ(0, record.calls);
+    ctx.update();
+    ASSERT_EQ(1, record.calls);
+}
+
+TEST(WaitForReport, ReturnsOnReport) {
+    MockContext ctx;
+    CallbackRecord record;
+    auto iface = ctx.getInterface("/button");
+    iface->registerCallback(&buttonCallback, &record);
+    ASSERT_TRUE(ctx.waitForReport(iface.get(), 1000000));
+    ASSERT_GT(record.count, 0);
+}
+
+TEST(WaitForReport, TimesOut) {
+    MockContext ctx;
+    ctx.sending = false;
+    auto iface = ctx.getInterface("/button");
+    osvr::util::time::TimeValue start;
+    osvr::util::time::TimeValue end;
+    osvr::util::time::getMonotonicNow(start);
+    ASSERT_FALSE(ctx.waitForReport(iface.get(), 20000));
+    ASSERT_FALSE(ctx.waitForReport(nullptr, 0));
+    osvr::util::time::getMonotonicNow(end);
+    ASSERT_GE(osvr::util::time::duration(end, start), 0.02);
+}
+
+TEST(WaitForReport, WakesForNetworkThread) {
+    MockContext ctx;
+    ctx.sending = false;
+    CallbackRecord record;
+    auto iface = ctx.getInterface("/button");
+    iface->registerCallback(&buttonCallback, &record);
+    ctx.startNetworkThread(false);
+    boost::thread sender([&] {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+        ctx.sending = true;
+    });
+    ASSERT_TRUE(ctx.waitForReport(nullptr, 5000000));
+    sender.join();
+    /// Queued callbacks were delivered on this thread.
+    ASSERT_GT(record.count, 0);
+    ASSERT_EQ(boost::this_thread::get_id(), record.thread);
+}
+
+TEST(SharedInterfaces, SamePathSharesState) {
+    MockContext ctx;
+    CallbackRecord first;
+    CallbackRecord second;
+    auto a = ctx.getInterface("/button");
+    auto b = ctx.getInterface("/button");
+    auto other = ctx.getInterface("/tracker");
+    ASSERT_NE(a, b);
+    ASSERT_EQ(a->getCore(), b->getCore());
+    ASSERT_NE(a->getCore(), other->getCore());
+    ASSERT_EQ(2u, ctx.getInterfaceCores().size());
+    a->registerCallback(&buttonCallback, &first);
+    b->registerCallback(&buttonCallback, &second);
+    ctx.update();
+    /// Each report reaches both, but is only dispatched once.
+    ASSERT_EQ(1, first.count);
+    ASSERT_EQ(1, second.count);
+    ASSERT_EQ(2u, a->getReportCount());
+    ASSERT_EQ(a->getReportCount(), b->getReportCount());
+    osvr::util::time::TimeValue timestamp;
+    OSVR_ButtonState state;
+    ASSERT_TRUE(b->getState<OSVR_ButtonReport>(timestamp, state));
+}
+
+TEST(SharedInterfaces, ReleasingOneKeepsTheOther) {
+    MockContext ctx;
+    CallbackRecord first;
+    CallbackRecord second;
+    auto a = ctx.getInterface("/button");
+    auto b = ctx.getInterface("/button");
+    a->registerCallback(&buttonCallback, &first);
+    b->registerCallback(&buttonCallback, &second);
+    ctx.releaseInterface(a.get());
+    a.reset();
+    ASSERT_EQ(1u, ctx.getInterfaceCores().size());
+    ctx.update();
+    ASSERT_EQ(0, first.count);
+    ASSERT_EQ(1, second.count);
+    ctx.releaseInterface(b.get());
+    ASSERT_TRUE(ctx.getInterfaceCores().empty());
+}
+
+/// @brief Userdata for a callback that frees its own interface object, as
+/// osvrClientFreeInterface would.
+struct SelfReleasingRecord {
+    SelfReleasingRecord() : ctx(nullptr), count(0) {}
+    MockContext *ctx;
+    ClientInterfacePtr iface;
+    int count;
+};
+
+static void releasingCallback(void *userdata, const OSVR_TimeValue *,
+                              const OSVR_ButtonReport *) {
+    auto record = static_cast<SelfReleasingRecord *>(userdata);
+    ++record->count;
+    if (record->iface) {
+        record->ctx->releaseInterface(record->iface.get());
+        record->iface.reset();
+    }
+}
+
+TEST(SharedInterfaces, ReleaseInCallbackSkipsNoOthers) {
+    MockContext ctx;
+    SelfReleasingRecord releasing;
+    releasing.ctx = &ctx;
+    releasing.iface = ctx.getInterface("/button");
+    CallbackRecord second;
+    CallbackRecord third;
+    auto b = ctx.getInterface("/button");
+    auto c = ctx.getInterface("/button");
+    releasing.iface->registerCallback(&releasingCallback, &releasing);
+    b->registerCallback(&buttonCallback, &second);
+    c->registerCallback(&buttonCallback, &third);
+    ctx.update();
+    ASSERT_EQ(1, releasing.count);
+    ASSERT_FALSE(releasing.iface);
+    ASSERT_EQ(1, second.count);
+    ASSERT_EQ(1, third.count);
+    ctx.update();
+    ASSERT_EQ(1, releasing.count);
+    ASSERT_EQ(2, second.count);
+    ASSERT_EQ(2, third.count);
+}
+
+TEST(SharedInterfaces, ReleaseLastInCallbackDuringDispatch) {
+    MockContext ctx;
+    SelfReleasingRecord releasing;
+    releasing.ctx = &ctx;
+    releasing.iface = ctx.getInterface("/first");
+    CallbackRecord other;
+    auto b = ctx.getInterface("/second");
+    releasing.iface->registerCallback(&releasingCallback, &releasing);
+    b->registerCallback(&buttonCallback, &other);
+    /// The mock, like the routers, is iterating the core list when the
+    /// callback releases the only interface object for its path.
+    ctx.update();
+    ASSERT_EQ(1, releasing.count);
+    ASSERT_EQ(1, other.count);
+    ASSERT_EQ(1u, ctx.getInterfaceCores().size());
+    ctx.update();
+    ASSERT_EQ(1, releasing.count);
+    ASSERT_EQ(2, other.count);
+}
+
+TEST(SharedInterfaces, HistoryUsesLargestCapacity) {
+    MockContext ctx(3);
+    auto a = ctx.getInterface("/tracker");
+    auto b = ctx.getInterface("/tracker");
+    a->setHistoryCapacity(8);
+    b->setHistoryCapacity(0);
+    ctx.update();
+    osvr::util::time::TimeValue now;
+    osvr::util::time::getNow(now);
+    osvr::util::time::TimeValue timestamp;
+    OSVR_PoseState state;
+    ASSERT_TRUE(b->getStateAt<OSVR_PoseReport>(now, false, timestamp, state));
+    ctx.releaseInterface(a.get());
+    ASSERT_FALSE(b->getStateAt<OSVR_PoseReport>(now, false, timestamp, state));
+}
+
+TEST(GetStates, ValidFlags) {
+    MockContext ctx;
+    auto a = ctx.getInterface("/a");
+    auto b = ctx.getInterface("/b");
+    ctx.update();
+    auto c = ctx.getInterface("/c");
+    OSVR_ClientInterface ifaces[] = {a.get(), b.get(), c.get(), nullptr};
+    OSVR_TimeValue timestamps[4];
+    OSVR_PoseState states[4];
+    OSVR_CBool valid[4];
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseStates(&ctx, 4, ifaces, timestamps, states, valid));
+    ASSERT_EQ(OSVR_TRUE, valid[0]);
+    ASSERT_EQ(OSVR_TRUE, valid[1]);
+    ASSERT_EQ(OSVR_FALSE, valid[2]);
+    ASSERT_EQ(OSVR_FALSE, valid[3]);
+
+    ASSERT_EQ(OSVR_RETURN_SUCCESS,
+              osvrGetPoseStates(&ctx, 2, ifaces, timestamps, states, nullptr));
+    ASSERT_EQ(OSVR_RETURN_SUCCESS,
+              osvrGetPoseStates(&ctx, 0, nullptr, nullptr, nullptr, nullptr));
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseStates(nullptr, 2, ifaces, timestamps, states, valid));
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseStates(&ctx, 2, ifaces, nullptr, states, valid));
+}
+
+TEST(GetState, NullArguments) {
+    MockContext ctx;
+    auto iface = ctx.getInterface("/a");
+    iface->setHistoryCapacity(4);
+    ctx.update();
+    OSVR_TimeValue timestamp;
+    OSVR_PoseState state;
+    ASSERT_EQ(OSVR_RETURN_SUCCESS,
+              osvrGetPoseState(iface.get(), &timestamp, &state));
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseState(nullptr, &timestamp, &state));
+    ASSERT_EQ(OSVR_RETURN_FAILURE, osvrGetPoseState(iface.get(), nullptr,
+                                                    &state));
+    ASSERT_EQ(OSVR_RETURN_FAILURE, osvrGetPoseState(iface.get(), &timestamp,
+                                                    nullptr));
+
+    const OSVR_TimeValue target = timestamp;
+    ASSERT_EQ(OSVR_RETURN_SUCCESS,
+              osvrGetPoseStateAtTime(iface.get(), &target, OSVR_FALSE,
+                                     &timestamp, &state));
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseStateAtTime(nullptr, &target, OSVR_FALSE,
+                                     &timestamp, &state));
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseStateAtTime(iface.get(), nullptr, OSVR_FALSE,
+                                     &timestamp, &state));
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseStateAtTime(iface.get(), &target, OSVR_FALSE,
+                                     nullptr, &state));
+    ASSERT_EQ(OSVR_RETURN_FAILURE,
+              osvrGetPoseStateAtTime(iface.get(), &target, OSVR_FALSE,
+                                     &timestamp, nullptr));
+}
+
+/// @brief Reads poses of several interfaces in batches while another thread
+/// updates, checking each batch came from a single update: the mock context
+/// stamps every interface's reports in an update with the same time.
+static void checkSnapshots(MockContext &ctx) {
+    static const uint32_t COUNT = 3;
+    ClientInterfacePtr held[] = {ctx.getInterface("/a"),
+                                 ctx.getInterface("/b"),
+                                 ctx.getInterface("/c")};
+    OSVR_ClientInterface ifaces[] = {held[0].get(), held[1].get(),
+                                     held[2].get()};
+    OSVR_TimeValue timestamps[COUNT];
+    OSVR_PoseState states[COUNT];
+    while (OSVR_RETURN_SUCCESS !=
+           osvrGetPoseStates(&ctx, COUNT, ifaces, timestamps, states,
+                             nullptr)) {
+        boost::this_thread::yield();
+    }
+    for (int i = 0; i < 2000; ++i) {
+        ASSERT_EQ(OSVR_RETURN_SUCCESS,
+                  osvrGetPoseStates(&ctx, COUNT, ifaces, timestamps, states,
+                                    nullptr));
+        for (uint32_t j = 1; j < COUNT; ++j) {
+            ASSERT_EQ(timestamps[0].seconds, timestamps[j].seconds);
+            ASSERT_EQ(timestamps[0].microseconds, timestamps[j].microseconds);
+        }
+    }
+}
+
+TEST(GetStates, SnapshotWhileUpdatingOnAnotherThread) {
+    MockContext ctx(20);
+    std::atomic<bool> run(true);
+    boost::thread updater([&] {
+        while (run) {
+            ctx.update();
+        }
+    });
+    checkSnapshots(ctx);
+    run = false;
+    updater.join();
+}
+
+TEST(GetStates, SnapshotWithNetworkThread) {
+    MockContext ctx(20);
+    ctx.startNetworkThread(false);
+    checkSnapshots(ctx);
+    ctx.stopNetworkThread();
+}
@@ -0,0 +1,115 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Client/InterfaceCallbacks.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::client::InterfaceCallbacks;
+
+static void recordButton(void *userdata, const OSVR_TimeValue *,
+                         const OSVR_ButtonReport *report) {
+    static_cast<std::vector<OSVR_ChannelCount> *>(userdata)
+        ->push_back(report->sensor);
+}
+
+static void recordAnalog(void *userdata, const OSVR_TimeValue *,
+                         const OSVR_AnalogReport *report) {
+    *static_cast<double *>(userdata) = report->state;
+}
+
+/// @brief Userdata for recordOrder: which callback this is, and where to
+/// log calls.
+struct OrderRecord {
+    std::vector<std::size_t> *order;
+    std::size_t index;
+};
+
+static void recordOrder(void *userdata, const OSVR_TimeValue *,
+                        const OSVR_ButtonReport *) {
+    auto record = static_cast<OrderRecord *>(userdata);
+    record->order->push_back(record->index);
+}
+
+static OSVR_ButtonReport makeButton(OSVR_ChannelCount sensor) {
+    OSVR_ButtonReport ret;
+    ret.sensor = sensor;
+    ret.state = OSVR_BUTTON_PRESSED;
+    return ret;
+}
+
+TEST(InterfaceCallbacks, NoCallbacks) {
+    InterfaceCallbacks callbacks;
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    ASSERT_NO_THROW(callbacks.triggerCallbacks(now, makeButton(0)));
+}
+
+TEST(InterfaceCallbacks, OnlyMatchingReportType) {
+    InterfaceCallbacks callbacks;
+    std::vector<OSVR_ChannelCount> buttons;
+    double analog = 0;
+    callbacks.addCallback(&recordButton, &buttons);
+    callbacks.addCallback(&recordAnalog, &analog);
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    callbacks.triggerCallbacks(now, makeButton(3));
+    ASSERT_EQ(1u, buttons.size());
+    ASSERT_EQ(3u, buttons[0]);
+    ASSERT_EQ(0, analog);
+
+    OSVR_AnalogReport report;
+    report.sensor = 0;
+    report.state = 0.5;
+    callbacks.triggerCallbacks(now, report);
+    ASSERT_EQ(0.5, analog);
+    ASSERT_EQ(1u, buttons.size());
+}
+
+TEST(InterfaceCallbacks, ManyCallbacksInRegistrationOrder) {
+    InterfaceCallbacks callbacks;
+    /// Enough to spill past the inline storage.
+    static const std::size_t COUNT = 20;
+    std::vector<std::size_t> order;
+    std::vector<OrderRecord> records(COUNT);
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        records[i].order = &order;
+        records[i].index = i;
+        callbacks.addCallback(&recordOrder, &records[i]);
+    }
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    callbacks.triggerCallbacks(now, makeButton(1));
+    callbacks.triggerCallbacks(now, makeButton(2));
+    ASSERT_EQ(2 * COUNT, order.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        ASSERT_EQ(i % COUNT, order[i]);
+    }
+}
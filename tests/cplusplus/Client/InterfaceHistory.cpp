@@ -0,0 +1,131 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MakeTime.h"
+#include <osvr/Client/InterfaceHistory.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::client::InterfaceHistory;
+using osvr::util::time::TimeValue;
+
+static OSVR_AnalogReport makeAnalog(double val) {
+    OSVR_AnalogReport ret;
+    ret.sensor = 0;
+    ret.state = val;
+    return ret;
+}
+
+static OSVR_OrientationReport makeYaw(double angle) {
+    OSVR_OrientationReport ret;
+    ret.sensor = 0;
+    osvrQuatSetW(&ret.rotation, std::cos(angle / 2));
+    osvrQuatSetX(&ret.rotation, 0);
+    osvrQuatSetY(&ret.rotation, std::sin(angle / 2));
+    osvrQuatSetZ(&ret.rotation, 0);
+    return ret;
+}
+
+TEST(InterfaceHistory, DisabledByDefault) {
+    InterfaceHistory hist;
+    hist.addReport(makeTime(1, 0), makeAnalog(1));
+    ASSERT_FALSE(hist.hasHistory<OSVR_AnalogReport>());
+    TimeValue ts;
+    OSVR_AnalogState state;
+    ASSERT_FALSE(hist.getStateAt<OSVR_AnalogReport>(makeTime(1, 0), false,
+                                                    ts, state));
+}
+
+TEST(InterfaceHistory, NearestAndClamping) {
+    InterfaceHistory hist;
+    hist.setCapacity(4);
+    hist.addReport(makeTime(1, 0), makeAnalog(1));
+    hist.addReport(makeTime(1, 100000), makeAnalog(2));
+    hist.addReport(makeTime(1, 200000), makeAnalog(3));
+
+    TimeValue ts;
+    OSVR_AnalogState state;
+    ASSERT_TRUE(hist.getStateAt<OSVR_AnalogReport>(makeTime(1, 120000),
+                                                   false, ts, state));
+    ASSERT_EQ(2, state);
+    ASSERT_EQ(100000, ts.microseconds);
+
+    ASSERT_TRUE(hist.getStateAt<OSVR_AnalogReport>(makeTime(0, 0), false, ts,
+                                                   state));
+    ASSERT_EQ(1, state);
+    ASSERT_TRUE(hist.getStateAt<OSVR_AnalogReport>(makeTime(9, 0), true, ts,
+                                                   state));
+    ASSERT_EQ(3, state);
+    ASSERT_EQ(200000, ts.microseconds);
+}
+
+TEST(InterfaceHistory, LinearInterpolation) {
+    InterfaceHistory hist;
+    hist.setCapacity(4);
+    hist.addReport(makeTime(1, 0), makeAnalog(0));
+    hist.addReport(makeTime(1, 100000), makeAnalog(10));
+    TimeValue ts;
+    OSVR_AnalogState state;
+    ASSERT_TRUE(hist.getStateAt<OSVR_AnalogReport>(makeTime(1, 25000), true,
+                                                   ts, state));
+    ASSERT_NEAR(2.5, state, 1e-9);
+    ASSERT_EQ(25000, ts.microseconds);
+}
+
+TEST(InterfaceHistory, Slerp) {
+    InterfaceHistory hist;
+    hist.setCapacity(4);
+    hist.addReport(makeTime(1, 0), makeYaw(0));
+    hist.addReport(makeTime(1, 100000), makeYaw(1));
+    TimeValue ts;
+    OSVR_OrientationState state;
+    ASSERT_TRUE(hist.getStateAt<OSVR_OrientationReport>(makeTime(1, 50000),
+                                                        true, ts, state));
+    OSVR_OrientationReport expected = makeYaw(0.5);
+    ASSERT_NEAR(osvrQuatGetW(&expected.rotation), osvrQuatGetW(&state), 1e-9);
+    ASSERT_NEAR(osvrQuatGetY(&expected.rotation), osvrQuatGetY(&state), 1e-9);
+}
+
+TEST(InterfaceHistory, CapacityAndOrdering) {
+    InterfaceHistory hist;
+    hist.setCapacity(2);
+    hist.addReport(makeTime(1, 0), makeAnalog(1));
+    hist.addReport(makeTime(3, 0), makeAnalog(3));
+    // Out of order: lands in the middle, pushing out the oldest.
+    hist.addReport(makeTime(2, 0), makeAnalog(2));
+    TimeValue ts;
+    OSVR_AnalogState state;
+    ASSERT_TRUE(hist.getStateAt<OSVR_AnalogReport>(makeTime(0, 0), false, ts,
+                                                   state));
+    ASSERT_EQ(2, state);
+    ASSERT_TRUE(hist.getStateAt<OSVR_AnalogReport>(makeTime(9, 0), false, ts,
+                                                   state));
+    ASSERT_EQ(3, state);
+}
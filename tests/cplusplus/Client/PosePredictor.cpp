@@ -0,0 +1,123 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MakeTime.h"
+#include <osvr/Client/PosePredictor.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::client::PosePredictor;
+using osvr::util::time::TimeValue;
+
+/// @brief Pose at the given position, rotated by angle about the z axis.
+static OSVR_PoseState makePose(double x, double y, double z, double angle) {
+    OSVR_PoseState ret;
+    ret.translation.data[0] = x;
+    ret.translation.data[1] = y;
+    ret.translation.data[2] = z;
+    osvrQuatSetW(&ret.rotation, std::cos(angle / 2));
+    osvrQuatSetX(&ret.rotation, 0);
+    osvrQuatSetY(&ret.rotation, 0);
+    osvrQuatSetZ(&ret.rotation, std::sin(angle / 2));
+    return ret;
+}
+
+TEST(PosePredictor, NoPose) {
+    PosePredictor pred;
+    OSVR_PoseState pose;
+    ASSERT_FALSE(pred.hasPose());
+    ASSERT_FALSE(pred.predict(makeTime(1, 0), pose));
+}
+
+TEST(PosePredictor, SingleSampleIsReturnedUnchanged) {
+    PosePredictor pred;
+    pred.addSample(makeTime(1, 0), makePose(1, 2, 3, 0.5));
+    ASSERT_TRUE(pred.hasPose());
+    ASSERT_FALSE(pred.hasVelocity());
+    OSVR_PoseState pose;
+    ASSERT_TRUE(pred.predict(makeTime(1, 50000), pose));
+    ASSERT_DOUBLE_EQ(1, pose.translation.data[0]);
+    ASSERT_DOUBLE_EQ(std::cos(0.25), osvrQuatGetW(&pose.rotation));
+}
+
+TEST(PosePredictor, ConstantVelocity) {
+    PosePredictor pred;
+    // 1 unit/s along x, 1 rad/s about z, sampled at 100 Hz.
+    for (int i = 0; i <= 10; ++i) {
+        pred.addSample(makeTime(1, i * 10000),
+                       makePose(i * 0.01, 0, 0, i * 0.01));
+    }
+    ASSERT_TRUE(pred.hasVelocity());
+    ASSERT_NEAR(1, pred.getLinearVelocity().data[0], 1e-9);
+    ASSERT_NEAR(1, pred.getAngularVelocity().data[2], 1e-9);
+
+    OSVR_PoseState pose;
+    ASSERT_TRUE(pred.predict(makeTime(1, 150000), pose));
+    OSVR_PoseState expected = makePose(0.15, 0, 0, 0.15);
+    ASSERT_NEAR(expected.translation.data[0], pose.translation.data[0], 1e-9);
+    ASSERT_NEAR(osvrQuatGetW(&expected.rotation), osvrQuatGetW(&pose.rotation),
+                1e-9);
+    ASSERT_NEAR(osvrQuatGetZ(&expected.rotation), osvrQuatGetZ(&pose.rotation),
+                1e-9);
+}
+
+TEST(PosePredictor, PredictionIsClamped) {
+    PosePredictor pred;
+    pred.addSample(makeTime(1, 0), makePose(0, 0, 0, 0));
+    pred.addSample(makeTime(1, 10000), makePose(0.01, 0, 0, 0));
+    OSVR_PoseState pose;
+    ASSERT_TRUE(pred.predict(makeTime(10, 0), pose));
+    ASSERT_NEAR(0.01 + PosePredictor::maxPredictionSeconds(),
+                pose.translation.data[0], 1e-9);
+}
+
+TEST(PosePredictor, StaleVelocityIsDiscarded) {
+    PosePredictor pred;
+    pred.addSample(makeTime(1, 0), makePose(0, 0, 0, 0));
+    pred.addSample(makeTime(1, 10000), makePose(0.01, 0, 0, 0));
+    ASSERT_TRUE(pred.hasVelocity());
+    pred.addSample(makeTime(5, 0), makePose(2, 0, 0, 0));
+    ASSERT_FALSE(pred.hasVelocity());
+    OSVR_PoseState pose;
+    ASSERT_TRUE(pred.predict(makeTime(5, 50000), pose));
+    ASSERT_DOUBLE_EQ(2, pose.translation.data[0]);
+}
+
+TEST(PosePredictor, ReportedVelocityReplacesEstimate) {
+    PosePredictor pred;
+    pred.addSample(makeTime(1, 0), makePose(0, 0, 0, 0));
+    OSVR_Vec3 linear = {{0, 2, 0}};
+    pred.setVelocity(&linear, nullptr);
+    ASSERT_TRUE(pred.hasVelocity());
+    ASSERT_DOUBLE_EQ(0, pred.getAngularVelocity().data[2]);
+    OSVR_PoseState pose;
+    ASSERT_TRUE(pred.predict(makeTime(1, 50000), pose));
+    ASSERT_NEAR(0.1, pose.translation.data[1], 1e-9);
+}
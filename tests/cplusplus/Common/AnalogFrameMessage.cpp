@@ -0,0 +1,142 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/AnalogFrameMessage.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::common::AnalogFrameMessage;
+
+TEST(AnalogFrameMessage, DenseRoundTrip) {
+    std::vector<OSVR_AnalogState> vals;
+    for (int i = 0; i < 300; ++i) {
+        vals.push_back(i * 0.25 - 10);
+    }
+    std::vector<char> buf(AnalogFrameMessage::MAX_SIZE);
+    const std::size_t len = AnalogFrameMessage::encodeDense(
+        buf.data(), 7, AnalogFrameMessage::FLOAT32, 1, 150, &vals[150], 100);
+    ASSERT_EQ(AnalogFrameMessage::denseSize(AnalogFrameMessage::FLOAT32, 100),
+              len);
+
+    AnalogFrameMessage msg(buf.data(), len);
+    ASSERT_TRUE(msg.isValid());
+    ASSERT_EQ(7u, msg.getSequence());
+    ASSERT_FALSE(msg.isSparse());
+    ASSERT_EQ(100u, msg.getCount());
+    OSVR_AnalogState val;
+    ASSERT_FALSE(msg.getValue(149, val));
+    ASSERT_FALSE(msg.getValue(250, val));
+    for (int i = 150; i < 250; ++i) {
+        ASSERT_TRUE(msg.getValue(i, val));
+        /// Exactly representable in single precision.
+        ASSERT_EQ(vals[i], val);
+    }
+}
+
+TEST(AnalogFrameMessage, SparseRoundTrip) {
+    std::vector<OSVR_AnalogState> vals(1000);
+    for (std::size_t i = 0; i < vals.size(); ++i) {
+        vals[i] = 1.0 / (i + 1);
+    }
+    const uint32_t channels[] = {0, 3, 500, 998, 999};
+    std::vector<char> buf(AnalogFrameMessage::MAX_SIZE);
+    const std::size_t len = AnalogFrameMessage::encodeSparse(
+        buf.data(), 1, AnalogFrameMessage::FLOAT64, 1, channels, vals.data(),
+        5);
+    ASSERT_EQ(AnalogFrameMessage::sparseSize(AnalogFrameMessage::FLOAT64, 5),
+              len);
+
+    AnalogFrameMessage msg(buf.data(), len);
+    ASSERT_TRUE(msg.isValid());
+    ASSERT_TRUE(msg.isSparse());
+    OSVR_AnalogState val;
+    for (auto chan : channels) {
+        ASSERT_TRUE(msg.getValue(chan, val));
+        ASSERT_EQ(vals[chan], val);
+    }
+    ASSERT_FALSE(msg.getValue(1, val));
+    ASSERT_FALSE(msg.getValue(501, val));
+    ASSERT_FALSE(msg.getValue(-1, val));
+}
+
+TEST(AnalogFrameMessage, Int16Scale) {
+    const OSVR_AnalogState vals[] = {0.0, 0.26, -1.0, 1000.0, -1000.0};
+    const double scale = 0.01;
+    std::vector<char> buf(AnalogFrameMessage::MAX_SIZE);
+    const std::size_t len = AnalogFrameMessage::encodeDense(
+        buf.data(), 0, AnalogFrameMessage::INT16, scale, 0, vals, 5);
+    ASSERT_EQ(AnalogFrameMessage::denseSize(AnalogFrameMessage::INT16, 5),
+              len);
+
+    AnalogFrameMessage msg(buf.data(), len);
+    ASSERT_TRUE(msg.isValid());
+    OSVR_AnalogState val;
+    ASSERT_TRUE(msg.getValue(0, val));
+    ASSERT_EQ(0.0, val);
+    ASSERT_TRUE(msg.getValue(1, val));
+    ASSERT_NEAR(0.26, val, scale / 2);
+    ASSERT_TRUE(msg.getValue(2, val));
+    ASSERT_NEAR(-1.0, val, scale / 2);
+    /// Out of range values are clamped.
+    ASSERT_TRUE(msg.getValue(3, val));
+    ASSERT_NEAR(327.67, val, scale / 2);
+    ASSERT_TRUE(msg.getValue(4, val));
+    ASSERT_NEAR(-327.67, val, scale / 2);
+}
+
+TEST(AnalogFrameMessage, LimitsValuesPerMessage) {
+    const auto encoding = AnalogFrameMessage::INT16;
+    std::vector<OSVR_AnalogState> vals(2000, 1);
+    std::vector<char> buf(AnalogFrameMessage::MAX_SIZE);
+    const std::size_t len = AnalogFrameMessage::encodeDense(
+        buf.data(), 0, encoding, 1, 0, vals.data(), vals.size());
+    ASSERT_LE(len, std::size_t(AnalogFrameMessage::MAX_SIZE));
+    AnalogFrameMessage msg(buf.data(), len);
+    ASSERT_TRUE(msg.isValid());
+    ASSERT_EQ(AnalogFrameMessage::maxDense(encoding), msg.getCount());
+}
+
+TEST(AnalogFrameMessage, RejectsMalformed) {
+    const OSVR_AnalogState vals[] = {1, 2};
+    std::vector<char> buf(AnalogFrameMessage::MAX_SIZE);
+    std::size_t len = AnalogFrameMessage::encodeDense(
+        buf.data(), 0, AnalogFrameMessage::FLOAT64, 1, 0, vals, 2);
+    /// Truncated
+    ASSERT_FALSE(AnalogFrameMessage(buf.data(), len - 1).isValid());
+    /// Too short for a header
+    AnalogFrameMessage empty(buf.data(), 4);
+    ASSERT_FALSE(empty.isValid());
+    OSVR_AnalogState val;
+    ASSERT_FALSE(empty.getValue(0, val));
+    /// Scaled encoding without a usable scale
+    len = AnalogFrameMessage::encodeDense(
+        buf.data(), 0, AnalogFrameMessage::INT16, 0, 0, vals, 2);
+    ASSERT_FALSE(AnalogFrameMessage(buf.data(), len).isValid());
+}
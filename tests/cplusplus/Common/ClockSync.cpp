@@ -0,0 +1,158 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MakeTime.h"
+#include <osvr/Common/ClockSync.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::ClockOffsetEstimator;
+using osvr::common::ClockSyncTimestamps;
+using osvr::util::time::TimeValue;
+
+/// @brief Simulates an exchange with a server clock `offsetUsec` ahead of the
+/// client, with the given one-way delays.
+static void exchange(ClockOffsetEstimator &est, int64_t clientStartUsec,
+                     int64_t offsetUsec, int64_t upUsec, int64_t downUsec) {
+    ClockSyncTimestamps ts;
+    const int64_t t0 = clientStartUsec;
+    const int64_t t1 = t0 + upUsec + offsetUsec;
+    const int64_t t2 = t1 + 50;
+    const int64_t t3 = t2 - offsetUsec + downUsec;
+    ts.clientSent = makeTime(t0 / 1000000, t0 % 1000000);
+    ts.serverReceived = makeTime(t1 / 1000000, t1 % 1000000);
+    ts.serverSent = makeTime(t2 / 1000000, t2 % 1000000);
+    est.addSample(ts, makeTime(t3 / 1000000, t3 % 1000000));
+}
+
+TEST(ClockOffsetEstimator, NoEstimatePassesThrough) {
+    ClockOffsetEstimator est;
+    ASSERT_FALSE(est.hasEstimate());
+    TimeValue t = makeTime(100, 5);
+    TimeValue out = est.toClientTime(t);
+    ASSERT_EQ(t.seconds, out.seconds);
+    ASSERT_EQ(t.microseconds, out.microseconds);
+}
+
+TEST(ClockOffsetEstimator, SymmetricDelay) {
+    ClockOffsetEstimator est;
+    exchange(est, 1000000000, 2500000, 400, 400);
+    ASSERT_TRUE(est.hasEstimate());
+    TimeValue offset = est.getOffset();
+    ASSERT_EQ(2, offset.seconds);
+    ASSERT_EQ(500000, offset.microseconds);
+    TimeValue rtt = est.getRoundTripTime();
+    ASSERT_EQ(0, rtt.seconds);
+    ASSERT_EQ(800, rtt.microseconds);
+
+    TimeValue local = est.toClientTime(makeTime(12, 600000));
+    ASSERT_EQ(10, local.seconds);
+    ASSERT_EQ(100000, local.microseconds);
+}
+
+TEST(ClockOffsetEstimator, NegativeOffset) {
+    ClockOffsetEstimator est;
+    exchange(est, 1000000000, -1250000, 100, 100);
+    TimeValue offset = est.getOffset();
+    ASSERT_EQ(-1, offset.seconds);
+    ASSERT_EQ(-250000, offset.microseconds);
+}
+
+TEST(ClockOffsetEstimator, PrefersLowestRoundTrip) {
+    ClockOffsetEstimator est(4);
+    exchange(est, 1000000000, 0, 5000, 100); // asymmetric, high RTT
+    exchange(est, 1001000000, 0, 100, 100);  // symmetric, low RTT
+    exchange(est, 1002000000, 0, 100, 9000); // asymmetric, high RTT
+    TimeValue offset = est.getOffset();
+    ASSERT_EQ(0, offset.seconds);
+    ASSERT_EQ(0, offset.microseconds);
+}
+
+TEST(ClockOffsetEstimator, WindowExpiresOldSamples) {
+    ClockOffsetEstimator est(2);
+    exchange(est, 1000000000, 0, 10, 10);
+    exchange(est, 1001000000, 1000, 300, 300);
+    exchange(est, 1002000000, 1000, 200, 200);
+    TimeValue offset = est.getOffset();
+    ASSERT_EQ(1000, offset.microseconds);
+    est.reset();
+    ASSERT_FALSE(est.hasEstimate());
+}
+
+TEST(ClockOffsetEstimator, IgnoresOtherClientsPongs) {
+    // Two clients on one host share a connection, so each sees both pongs.
+    // The server is one second ahead, 400us away each way.
+    ClockOffsetEstimator a;
+    ClockOffsetEstimator b;
+
+    ClockSyncTimestamps pongA;
+    pongA.clientSent = makeTime(1000, 0);
+    pongA.nonce = a.startExchange(pongA.clientSent);
+    ClockSyncTimestamps pongB;
+    pongB.clientSent = makeTime(1000, 300);
+    pongB.nonce = b.startExchange(pongB.clientSent);
+
+    pongA.serverReceived = makeTime(1001, 400);
+    pongA.serverSent = makeTime(1001, 450);
+    pongB.serverReceived = makeTime(1001, 700);
+    pongB.serverSent = makeTime(1001, 750);
+    const TimeValue arrivedA = makeTime(1000, 850);
+    const TimeValue arrivedB = makeTime(1000, 1150);
+
+    // B's pong arrives at A 1150us after A's ping, but only 400us after B's
+    // pong left the server: accepting it would give A a bogus 100us RTT.
+    ASSERT_FALSE(a.addResponse(pongB, arrivedB));
+    ASSERT_FALSE(b.addResponse(pongA, arrivedA));
+    ASSERT_FALSE(a.hasEstimate());
+    ASSERT_FALSE(b.hasEstimate());
+
+    ASSERT_TRUE(a.addResponse(pongA, arrivedA));
+    ASSERT_TRUE(b.addResponse(pongB, arrivedB));
+    for (auto est : {&a, &b}) {
+        ASSERT_EQ(800, est->getRoundTripTime().microseconds);
+        ASSERT_EQ(1, est->getOffset().seconds);
+        ASSERT_EQ(0, est->getOffset().microseconds);
+    }
+
+    // A repeated pong no longer matches an outstanding ping.
+    ASSERT_FALSE(a.addResponse(pongA, arrivedA));
+}
+
+TEST(ClockOffsetEstimator, RequiresMatchingSendTime) {
+    ClockOffsetEstimator est;
+    ClockSyncTimestamps ts;
+    ts.clientSent = makeTime(10, 0);
+    ts.nonce = est.startExchange(ts.clientSent);
+    ts.serverReceived = makeTime(10, 100);
+    ts.serverSent = makeTime(10, 150);
+    ts.clientSent = makeTime(10, 50);
+    ASSERT_FALSE(est.addResponse(ts, makeTime(10, 250)));
+    ASSERT_FALSE(est.hasEstimate());
+}
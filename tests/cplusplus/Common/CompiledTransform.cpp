@@ -0,0 +1,171 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/ChangeOfBasis.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::common::CompiledTransform;
+using osvr::common::Transform;
+
+static OSVR_Pose3 samplePose() {
+    Eigen::Isometry3d xform(
+        Eigen::AngleAxisd(0.3, Eigen::Vector3d(1, 2, 3).normalized()));
+    xform.translation() = Eigen::Vector3d(0.5, -1, 2);
+    OSVR_Pose3 pose;
+    osvr::util::toPose(xform, pose);
+    return pose;
+}
+
+static Eigen::Matrix4d rigid(double angle, Eigen::Vector3d const &axis,
+                             Eigen::Vector3d const &translation) {
+    Eigen::Isometry3d xform(Eigen::AngleAxisd(angle, axis.normalized()));
+    xform.translation() = translation;
+    return xform.matrix();
+}
+
+/// @brief Checks a compiled transform against applying the matrices.
+static void checkMatches(Transform const &xform) {
+    const OSVR_Pose3 input = samplePose();
+    OSVR_Pose3 expected;
+    osvr::util::toPose(
+        xform.transform(osvr::util::fromPose(input).matrix()), expected);
+    OSVR_Pose3 actual = input;
+    CompiledTransform(xform).apply(actual);
+    ASSERT_TRUE(osvr::util::vecMap(actual.translation)
+                    .isApprox(osvr::util::vecMap(expected.translation)));
+    /// q and -q are the same rotation.
+    ASSERT_NEAR(1.0,
+                std::abs(osvr::util::fromQuat(actual.rotation)
+                             .dot(osvr::util::fromQuat(expected.rotation))),
+                1e-9);
+}
+
+TEST(CompiledTransform, Identity) {
+    Transform xform;
+    ASSERT_EQ(CompiledTransform::IDENTITY, CompiledTransform(xform).getKind());
+    checkMatches(xform);
+}
+
+TEST(CompiledTransform, RotationOnly) {
+    Transform xform;
+    xform.concatPost(osvr::common::rotate(90, Eigen::Vector3d::UnitY()));
+    xform.concatPre(osvr::common::rotate(-30, Eigen::Vector3d::UnitX()));
+    ASSERT_EQ(CompiledTransform::ROTATION, CompiledTransform(xform).getKind());
+    checkMatches(xform);
+}
+
+TEST(CompiledTransform, TranslationOnly) {
+    Transform xform;
+    xform.concatPost(rigid(0, Eigen::Vector3d::UnitZ(), {1, 2, 3}));
+    xform.concatPre(rigid(0, Eigen::Vector3d::UnitZ(), {0, 0, -0.1}));
+    ASSERT_EQ(CompiledTransform::TRANSLATION,
+              CompiledTransform(xform).getKind());
+    checkMatches(xform);
+}
+
+TEST(CompiledTransform, Rigid) {
+    Transform xform;
+    xform.concatPost(rigid(1.2, {0, 1, 1}, {1, 2, 3}));
+    xform.concatPre(rigid(-0.4, {1, 0, 0}, {0.2, 0, -0.1}));
+    ASSERT_EQ(CompiledTransform::RIGID, CompiledTransform(xform).getKind());
+    checkMatches(xform);
+}
+
+TEST(CompiledTransform, ChangeOfBasis) {
+    osvr::common::ChangeOfBasis cb;
+    cb.setNewX(Eigen::Vector3d::UnitY());
+    cb.setNewY(Eigen::Vector3d::UnitZ());
+    cb.setNewZ(Eigen::Vector3d::UnitX());
+    Transform xform;
+    xform.transform(cb.get());
+    ASSERT_EQ(CompiledTransform::ROTATION, CompiledTransform(xform).getKind());
+    checkMatches(xform);
+}
+
+TEST(CompiledTransform, MirroringFallsBackToMatrices) {
+    osvr::common::ChangeOfBasis cb;
+    cb.setNewX(-Eigen::Vector3d::UnitX());
+    cb.setNewY(Eigen::Vector3d::UnitY());
+    cb.setNewZ(Eigen::Vector3d::UnitZ());
+    Transform xform;
+    xform.transform(cb.get());
+    ASSERT_EQ(CompiledTransform::GENERAL, CompiledTransform(xform).getKind());
+    checkMatches(xform);
+}
+
+TEST(CompiledTransform, VelocityMatchesPoses) {
+    Transform xform;
+    xform.concatPost(rigid(1.2, {0, 1, 1}, {1, 2, 3}));
+    xform.concatPre(rigid(-0.4, {1, 0, 0}, {0.2, 0, -0.1}));
+    const CompiledTransform compiled(xform);
+
+    /// Move a pose a short time along known velocities, and compare the
+    /// change in the transformed poses with the transformed velocities.
+    const double dt = 1e-6;
+    const OSVR_Pose3 before = samplePose();
+    OSVR_Vec3 linear = {{0.3, -0.2, 1}};
+    OSVR_Vec3 angular = {{0.5, 1, -0.25}};
+    OSVR_Pose3 after = before;
+    osvr::util::vecMap(after.translation) += osvr::util::vecMap(linear) * dt;
+    const Eigen::Vector3d rotVec = osvr::util::vecMap(angular) * dt;
+    osvr::util::toQuat(
+        Eigen::Quaterniond(
+            Eigen::AngleAxisd(rotVec.norm(), rotVec.normalized())) *
+            osvr::util::fromQuat(before.rotation),
+        after.rotation);
+
+    OSVR_Pose3 xformedBefore = before;
+    OSVR_Pose3 xformedAfter = after;
+    compiled.apply(xformedBefore);
+    compiled.apply(xformedAfter);
+    const Eigen::Vector3d expected =
+        (osvr::util::vecMap(xformedAfter.translation) -
+         osvr::util::vecMap(xformedBefore.translation)) /
+        dt;
+
+    ASSERT_TRUE(compiled.applyToVelocity(before.rotation, &linear, &angular));
+    ASSERT_TRUE(osvr::util::vecMap(linear).isApprox(expected, 1e-4));
+}
+
+TEST(CompiledTransform, VelocityNeedsRigidTransform) {
+    osvr::common::ChangeOfBasis cb;
+    cb.setNewX(-Eigen::Vector3d::UnitX());
+    cb.setNewY(Eigen::Vector3d::UnitY());
+    cb.setNewZ(Eigen::Vector3d::UnitZ());
+    Transform xform;
+    xform.transform(cb.get());
+    OSVR_Vec3 linear = {{1, 0, 0}};
+    ASSERT_FALSE(CompiledTransform(xform).applyToVelocity(
+        samplePose().rotation, &linear, nullptr));
+    ASSERT_EQ(1, linear.data[0]);
+}
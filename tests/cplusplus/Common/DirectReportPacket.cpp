@@ -0,0 +1,181 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MakeTime.h"
+#include <osvr/Common/DirectReportPacket.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+#include <cstring>
+
+using osvr::common::DirectReportPacket;
+
+/// @brief Copies a packet as if sent through a transport.
+inline DirectReportPacket roundTrip(DirectReportPacket const &packet) {
+    std::vector<char> bytes(
+        static_cast<char const *>(packet.data()),
+        static_cast<char const *>(packet.data()) + packet.size());
+    DirectReportPacket ret;
+    EXPECT_TRUE(ret.assign(bytes.data(), bytes.size()));
+    return ret;
+}
+
+TEST(DirectReportPacket, DefaultIsInvalid) {
+    DirectReportPacket packet;
+    ASSERT_EQ(DirectReportPacket::INVALID, packet.getKind());
+}
+
+TEST(DirectReportPacket, DeviceName) {
+    DirectReportPacket packet;
+    packet.setDeviceName(3, "com_osvr_Example/Tracker");
+    auto received = roundTrip(packet);
+    ASSERT_EQ(DirectReportPacket::DEVICE_NAME, received.getKind());
+    ASSERT_EQ(3u, received.getDevice());
+    ASSERT_EQ("com_osvr_Example/Tracker", received.getDeviceName());
+}
+
+TEST(DirectReportPacket, Pose) {
+    OSVR_PoseState pose;
+    pose.translation.data[0] = 1;
+    pose.translation.data[1] = 2;
+    pose.translation.data[2] = 3;
+    pose.rotation.data[0] = 0.5;
+    pose.rotation.data[1] = 0.5;
+    pose.rotation.data[2] = -0.5;
+    pose.rotation.data[3] = 0.5;
+    DirectReportPacket packet;
+    packet.setPose(1, 4, makeTime(10, 20), pose);
+
+    auto received = roundTrip(packet);
+    ASSERT_EQ(DirectReportPacket::TRACKER, received.getKind());
+    ASSERT_EQ(4, received.getSensor());
+    ASSERT_EQ(10, received.getTimestamp().seconds);
+    ASSERT_EQ(20, received.getTimestamp().microseconds);
+    auto got = received.getPose();
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(pose.translation.data[i], got.translation.data[i]);
+    }
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(pose.rotation.data[i], got.rotation.data[i]);
+    }
+}
+
+TEST(DirectReportPacket, Poses) {
+    OSVR_PoseState poses[3];
+    for (int i = 0; i < 3; ++i) {
+        poses[i].translation.data[0] = i;
+        poses[i].translation.data[1] = 0;
+        poses[i].translation.data[2] = -i;
+        poses[i].rotation.data[0] = 1;
+        poses[i].rotation.data[1] = 0;
+        poses[i].rotation.data[2] = 0;
+        poses[i].rotation.data[3] = 0;
+    }
+    DirectReportPacket packet;
+    packet.setPoses(1, 2, makeTime(0, 0), poses, 3);
+    auto received = roundTrip(packet);
+    ASSERT_EQ(DirectReportPacket::TRACKER, received.getKind());
+    ASSERT_EQ(3u, received.getCount());
+    ASSERT_FALSE(received.hasSensor(1));
+    ASSERT_TRUE(received.hasSensor(4));
+    ASSERT_FALSE(received.hasSensor(5));
+    ASSERT_EQ(0, received.getPose().translation.data[0]);
+    ASSERT_EQ(2, received.getPose(4).translation.data[0]);
+    ASSERT_EQ(-1, received.getPose(3).translation.data[2]);
+}
+
+TEST(DirectReportPacket, TrackerState) {
+    OSVR_TrackerState state;
+    std::memset(&state, 0, sizeof(state));
+    state.flags = OSVR_TRACKER_ORIENTATION_VALID |
+                  OSVR_TRACKER_ANGULAR_VELOCITY_VALID;
+    state.pose.rotation.data[0] = 1;
+    state.angularVelocity.data[1] = 0.5;
+    DirectReportPacket packet;
+    packet.setTrackerState(1, 2, makeTime(0, 0), state);
+    auto received = roundTrip(packet);
+    ASSERT_EQ(DirectReportPacket::TRACKER_STATE, received.getKind());
+    ASSERT_EQ(2, received.getSensor());
+    auto got = received.getTrackerState();
+    ASSERT_EQ(state.flags, got.flags);
+    ASSERT_EQ(0.5, got.angularVelocity.data[1]);
+}
+
+TEST(DirectReportPacket, Analogs) {
+    OSVR_AnalogState vals[] = {0.25, -1.5, 3.0};
+    DirectReportPacket packet;
+    packet.setAnalogs(2, 5, makeTime(0, 0), vals, 3);
+    auto received = roundTrip(packet);
+    ASSERT_EQ(DirectReportPacket::ANALOG, received.getKind());
+    ASSERT_FALSE(received.hasSensor(4));
+    ASSERT_TRUE(received.hasSensor(5));
+    ASSERT_TRUE(received.hasSensor(7));
+    ASSERT_FALSE(received.hasSensor(8));
+    ASSERT_EQ(0.25, received.getAnalog(5));
+    ASSERT_EQ(-1.5, received.getAnalog(6));
+    ASSERT_EQ(3.0, received.getAnalog(7));
+}
+
+TEST(DirectReportPacket, Buttons) {
+    OSVR_ButtonState vals[] = {1, 0};
+    DirectReportPacket packet;
+    packet.setButtons(0, 0, makeTime(0, 0), vals, 2);
+    auto received = roundTrip(packet);
+    ASSERT_EQ(DirectReportPacket::BUTTON, received.getKind());
+    ASSERT_EQ(2u, received.getCount());
+    ASSERT_EQ(1, received.getButton(0));
+    ASSERT_EQ(0, received.getButton(1));
+}
+
+TEST(DirectReportPacket, RejectsMalformed) {
+    OSVR_AnalogState vals[] = {1.0, 2.0};
+    DirectReportPacket packet;
+    packet.setAnalogs(0, 0, makeTime(0, 0), vals, 2);
+    DirectReportPacket received;
+    /// Truncated
+    ASSERT_FALSE(received.assign(packet.data(), packet.size() - 1));
+    ASSERT_EQ(DirectReportPacket::INVALID, received.getKind());
+    /// Too short for a header
+    ASSERT_FALSE(received.assign(packet.data(), 4));
+}
+
+TEST(DirectReportPacket, CopyReplacesContents) {
+    OSVR_AnalogState vals[] = {0.5, 1.5};
+    DirectReportPacket analogs;
+    analogs.setAnalogs(1, 2, makeTime(3, 4), vals, 2);
+    DirectReportPacket copy;
+    copy.setDeviceName(0, "a much longer device name than the analogs");
+    copy = analogs;
+    ASSERT_EQ(DirectReportPacket::ANALOG, copy.getKind());
+    ASSERT_EQ(analogs.size(), copy.size());
+    ASSERT_EQ(1.5, copy.getAnalog(3));
+    DirectReportPacket constructed(copy);
+    ASSERT_EQ(3, constructed.getTimestamp().seconds);
+    ASSERT_EQ(0.5, constructed.getAnalog(2));
+}
@@ -0,0 +1,185 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/InProcessReportHub.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <string>
+
+using osvr::common::InProcessReportHub;
+using osvr::common::DirectReportPacket;
+
+inline DirectReportPacket buttonPacket(uint32_t device,
+                                       OSVR_ButtonState state) {
+    DirectReportPacket packet;
+    packet.setButtons(device, 0, OSVR_TimeValue(), &state, 1);
+    return packet;
+}
+
+inline DirectReportPacket posePacket(uint32_t device) {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    DirectReportPacket packet;
+    packet.setPose(device, 0, OSVR_TimeValue(), pose);
+    return packet;
+}
+
+TEST(InProcessReportHub, SameNameSameHub) {
+    auto hub = InProcessReportHub::get("test-same");
+    ASSERT_EQ(hub, InProcessReportHub::get("test-same"));
+    ASSERT_NE(hub, InProcessReportHub::get("test-other"));
+}
+
+TEST(InProcessReportHub, NewSubscriberGetsDeviceNames) {
+    auto hub = InProcessReportHub::get("test-names");
+    ASSERT_EQ(0u, hub->addDevice("com_osvr_Test/First"));
+    ASSERT_EQ(1u, hub->addDevice("com_osvr_Test/Second"));
+    auto queue = hub->subscribe();
+    DirectReportPacket packet;
+    ASSERT_TRUE(queue->pop(packet));
+    ASSERT_EQ(DirectReportPacket::DEVICE_NAME, packet.getKind());
+    ASSERT_EQ(0u, packet.getDevice());
+    ASSERT_EQ("com_osvr_Test/First", packet.getDeviceName());
+    ASSERT_TRUE(queue->pop(packet));
+    ASSERT_EQ("com_osvr_Test/Second", packet.getDeviceName());
+    ASSERT_FALSE(queue->pop(packet));
+}
+
+TEST(InProcessReportHub, ExistingSubscriberGetsNewDevices) {
+    auto hub = InProcessReportHub::get("test-new-device");
+    auto queue = hub->subscribe();
+    hub->addDevice("com_osvr_Test/Late");
+    DirectReportPacket packet;
+    ASSERT_TRUE(queue->pop(packet));
+    ASSERT_EQ(DirectReportPacket::DEVICE_NAME, packet.getKind());
+    ASSERT_EQ("com_osvr_Test/Late", packet.getDeviceName());
+}
+
+TEST(InProcessReportHub, PublishReachesSubscribers) {
+    auto hub = InProcessReportHub::get("test-publish");
+    auto first = hub->subscribe();
+    auto second = hub->subscribe();
+    hub->publish(buttonPacket(0, 1));
+    hub->unsubscribe(second);
+    hub->publish(buttonPacket(0, 0));
+
+    DirectReportPacket packet;
+    ASSERT_TRUE(first->pop(packet));
+    ASSERT_EQ(1, packet.getButton(0));
+    ASSERT_TRUE(first->pop(packet));
+    ASSERT_EQ(0, packet.getButton(0));
+    ASSERT_FALSE(first->pop(packet));
+
+    ASSERT_TRUE(second->pop(packet));
+    ASSERT_EQ(1, packet.getButton(0));
+    ASSERT_FALSE(second->pop(packet));
+}
+
+TEST(InProcessReportHub, FullQueueDropsAndCounts) {
+    auto hub = InProcessReportHub::get("test-full");
+    auto queue = hub->subscribe();
+    const std::size_t extra = 3;
+    for (std::size_t i = 0; i < queue->capacity() + extra; ++i) {
+        hub->publish(posePacket(0));
+    }
+    ASSERT_EQ(extra, hub->getDroppedPackets());
+}
+
+TEST(InProcessReportHub, FullQueueKeepsButtonsAndNames) {
+    auto hub = InProcessReportHub::get("test-full-names");
+    auto queue = hub->subscribe();
+    for (std::size_t i = 0; i < queue->capacity(); ++i) {
+        hub->publish(posePacket(0));
+    }
+    hub->publish(buttonPacket(0, 1));
+    const uint32_t device = hub->addDevice("com_osvr_Test/Late");
+    /// Dropped, unlike the buttons and name around it.
+    hub->publish(posePacket(0));
+    hub->publish(buttonPacket(0, 0));
+    ASSERT_EQ(1u, hub->getDroppedPackets());
+    std::string name;
+    ASSERT_TRUE(hub->getDeviceName(device, name));
+    ASSERT_EQ("com_osvr_Test/Late", name);
+    ASSERT_FALSE(hub->getDeviceName(device + 1, name));
+
+    DirectReportPacket packet;
+    for (std::size_t i = 0; i < queue->capacity(); ++i) {
+        ASSERT_TRUE(queue->pop(packet));
+        ASSERT_EQ(DirectReportPacket::TRACKER, packet.getKind());
+    }
+    ASSERT_TRUE(queue->pop(packet));
+    ASSERT_EQ(DirectReportPacket::BUTTON, packet.getKind());
+    ASSERT_EQ(1, packet.getButton(0));
+    ASSERT_TRUE(queue->pop(packet));
+    ASSERT_EQ(DirectReportPacket::DEVICE_NAME, packet.getKind());
+    ASSERT_EQ("com_osvr_Test/Late", packet.getDeviceName());
+    ASSERT_FALSE(queue->empty());
+    ASSERT_TRUE(queue->pop(packet));
+    ASSERT_EQ(DirectReportPacket::BUTTON, packet.getKind());
+    ASSERT_EQ(0, packet.getButton(0));
+    ASSERT_TRUE(queue->empty());
+    ASSERT_FALSE(queue->pop(packet));
+
+    /// Once caught up, the queue is used again.
+    hub->publish(posePacket(0));
+    ASSERT_TRUE(queue->pop(packet));
+    ASSERT_EQ(DirectReportPacket::TRACKER, packet.getKind());
+    ASSERT_EQ(1u, hub->getDroppedPackets());
+}
+
+TEST(InProcessReportHub, OneServerPerHub) {
+    auto hub = InProcessReportHub::get("test-server");
+    ASSERT_TRUE(hub->attachServer());
+    ASSERT_FALSE(hub->attachServer());
+    ASSERT_TRUE(InProcessReportHub::get("test-other-server")->attachServer());
+    hub->detachServer();
+    ASSERT_TRUE(hub->attachServer());
+    hub->detachServer();
+}
+
+TEST(InProcessReportHub, WaitForPackets) {
+    auto hub = InProcessReportHub::get("test-wait");
+    auto queue = hub->subscribe();
+    ASSERT_FALSE(hub->waitForPackets(*queue, 1000));
+    hub->publish(buttonPacket(0, 1));
+    ASSERT_TRUE(hub->waitForPackets(*queue, 0));
+}
+
+TEST(InProcessReportHub, WaitWakesOnPublish) {
+    auto hub = InProcessReportHub::get("test-wake");
+    auto queue = hub->subscribe();
+    boost::thread server([&] {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+        hub->publish(buttonPacket(0, 1));
+    });
+    /// Far longer than the publish takes, so only a missed wakeup fails.
+    ASSERT_TRUE(hub->waitForPackets(*queue, 10000000));
+    server.join();
+}
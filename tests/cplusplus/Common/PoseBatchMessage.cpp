@@ -0,0 +1,102 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PoseBatchMessage.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::common::PoseBatchMessage;
+
+inline OSVR_PoseState makePose(double x) {
+    OSVR_PoseState ret;
+    ret.translation.data[0] = x;
+    ret.translation.data[1] = 2 * x;
+    ret.translation.data[2] = 3 * x;
+    ret.rotation.data[0] = 0.5;
+    ret.rotation.data[1] = -0.5;
+    ret.rotation.data[2] = 0.5;
+    ret.rotation.data[3] = x;
+    return ret;
+}
+
+TEST(PoseBatchMessage, RoundTrip) {
+    std::vector<OSVR_PoseState> poses;
+    for (int i = 0; i < 5; ++i) {
+        poses.push_back(makePose(i));
+    }
+    std::vector<char> buf(PoseBatchMessage::maxSize());
+    const std::size_t len =
+        PoseBatchMessage::encode(buf.data(), 42, 3, poses.data(), 5);
+    ASSERT_EQ(PoseBatchMessage::size(5), len);
+
+    PoseBatchMessage msg(buf.data(), len);
+    ASSERT_TRUE(msg.isValid());
+    ASSERT_EQ(42u, msg.getSequence());
+    ASSERT_EQ(3, msg.getFirst());
+    ASSERT_EQ(5u, msg.getCount());
+    ASSERT_FALSE(msg.hasSensor(2));
+    ASSERT_TRUE(msg.hasSensor(3));
+    ASSERT_TRUE(msg.hasSensor(7));
+    ASSERT_FALSE(msg.hasSensor(8));
+    for (int i = 0; i < 5; ++i) {
+        auto got = msg.getPose(3 + i);
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_EQ(poses[i].translation.data[j], got.translation.data[j]);
+        }
+        for (int j = 0; j < 4; ++j) {
+            ASSERT_EQ(poses[i].rotation.data[j], got.rotation.data[j]);
+        }
+    }
+}
+
+TEST(PoseBatchMessage, LimitsPosesPerMessage) {
+    std::vector<OSVR_PoseState> poses(PoseBatchMessage::MAX_POSES + 5,
+                                      makePose(1));
+    std::vector<char> buf(PoseBatchMessage::maxSize());
+    const std::size_t len = PoseBatchMessage::encode(
+        buf.data(), 0, 0, poses.data(), poses.size());
+    ASSERT_EQ(PoseBatchMessage::maxSize(), len);
+    PoseBatchMessage msg(buf.data(), len);
+    ASSERT_TRUE(msg.isValid());
+    ASSERT_EQ(std::size_t(PoseBatchMessage::MAX_POSES), msg.getCount());
+}
+
+TEST(PoseBatchMessage, RejectsMalformed) {
+    OSVR_PoseState poses[] = {makePose(1), makePose(2)};
+    std::vector<char> buf(PoseBatchMessage::maxSize());
+    const std::size_t len =
+        PoseBatchMessage::encode(buf.data(), 0, 0, poses, 2);
+    /// Truncated
+    ASSERT_FALSE(PoseBatchMessage(buf.data(), len - 1).isValid());
+    /// Too short for a header
+    ASSERT_FALSE(PoseBatchMessage(buf.data(), 4).isValid());
+    PoseBatchMessage empty(buf.data(), 4);
+    ASSERT_FALSE(empty.hasSensor(0));
+}
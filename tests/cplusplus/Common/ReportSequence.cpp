@@ -0,0 +1,101 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ReportSequence.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::ReportSequenceCounter;
+using osvr::common::ReportSequenceChecker;
+using osvr::common::getReportSequenceMask;
+
+TEST(ReportSequenceCounter, CountsUp) {
+    ReportSequenceCounter counter;
+    ASSERT_EQ(0u, counter.next());
+    ASSERT_EQ(1u, counter.next());
+    for (uint32_t i = 2; i < 10; ++i) {
+        counter.next();
+    }
+    ASSERT_EQ(10u, counter.next());
+}
+
+TEST(ReportSequenceChecker, InOrderAccepted) {
+    ReportSequenceChecker checker;
+    for (uint32_t i = 100; i < 110; ++i) {
+        ASSERT_TRUE(checker.check(i));
+    }
+    ASSERT_EQ(0u, checker.getLost());
+    ASSERT_EQ(0u, checker.getReordered());
+}
+
+TEST(ReportSequenceChecker, GapCountedAsLost) {
+    ReportSequenceChecker checker;
+    ASSERT_TRUE(checker.check(1));
+    ASSERT_TRUE(checker.check(5));
+    ASSERT_EQ(3u, checker.getLost());
+    ASSERT_EQ(0u, checker.getReordered());
+}
+
+TEST(ReportSequenceChecker, LateReportDiscarded) {
+    ReportSequenceChecker checker;
+    ASSERT_TRUE(checker.check(1));
+    ASSERT_TRUE(checker.check(3));
+    ASSERT_EQ(1u, checker.getLost());
+    ASSERT_FALSE(checker.check(2));
+    ASSERT_EQ(0u, checker.getLost());
+    ASSERT_EQ(1u, checker.getReordered());
+    ASSERT_TRUE(checker.check(4));
+}
+
+TEST(ReportSequenceChecker, WrapAroundIsInOrder) {
+    ReportSequenceChecker checker;
+    ASSERT_TRUE(checker.check(getReportSequenceMask() - 1));
+    ASSERT_TRUE(checker.check(getReportSequenceMask()));
+    ASSERT_TRUE(checker.check(0));
+    ASSERT_TRUE(checker.check(1));
+    ASSERT_EQ(0u, checker.getLost());
+}
+
+TEST(ReportSequenceChecker, LargeJumpBackIsRestart) {
+    ReportSequenceChecker checker;
+    ASSERT_TRUE(checker.check(100000));
+    ASSERT_TRUE(checker.check(0));
+    ASSERT_TRUE(checker.check(1));
+    ASSERT_EQ(0u, checker.getLost());
+    ASSERT_EQ(0u, checker.getReordered());
+}
+
+TEST(ReportSequenceChecker, ResetForgetsStream) {
+    ReportSequenceChecker checker;
+    ASSERT_TRUE(checker.check(50));
+    checker.reset();
+    ASSERT_TRUE(checker.check(10));
+    ASSERT_EQ(0u, checker.getReordered());
+}
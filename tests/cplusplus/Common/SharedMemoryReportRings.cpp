@@ -0,0 +1,141 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/SharedMemoryReportRings.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <vector>
+
+using osvr::common::SharedMemoryReportRings;
+using osvr::common::DirectReportPacket;
+
+inline DirectReportPacket buttonPacket(uint32_t device,
+                                       OSVR_ButtonState state) {
+    DirectReportPacket packet;
+    packet.setButtons(device, 0, OSVR_TimeValue(), &state, 1);
+    return packet;
+}
+
+/// @brief Collects the button state of each report read.
+class ButtonCollector {
+  public:
+    ButtonCollector(std::vector<OSVR_ButtonState> &states)
+        : m_states(states) {}
+    void operator()(DirectReportPacket const &packet) {
+        m_states.push_back(packet.getButton(0));
+    }
+
+  private:
+    std::vector<OSVR_ButtonState> &m_states;
+};
+
+TEST(SharedMemoryReportRings, OpenMissingRegionFails) {
+    ASSERT_TRUE(SharedMemoryReportRings::open("osvr_test_missing") ==
+                nullptr);
+}
+
+TEST(SharedMemoryReportRings, ClientSeesDevices) {
+    auto server = SharedMemoryReportRings::create("osvr_test_devices");
+    auto client = SharedMemoryReportRings::open("osvr_test_devices");
+    ASSERT_TRUE(client != nullptr);
+    ASSERT_EQ(0u, client->getNumDevices());
+    uint32_t device = 0;
+    ASSERT_TRUE(server->addDevice("com_osvr_Test/First", device));
+    ASSERT_EQ(0u, device);
+    ASSERT_TRUE(server->addDevice("com_osvr_Test/Second", device));
+    ASSERT_EQ(1u, device);
+    ASSERT_EQ(2u, client->getNumDevices());
+    ASSERT_EQ("com_osvr_Test/First", client->getDeviceName(0));
+    ASSERT_EQ("com_osvr_Test/Second", client->getDeviceName(1));
+}
+
+TEST(SharedMemoryReportRings, ReadsReportsInOrder) {
+    auto server = SharedMemoryReportRings::create("osvr_test_read");
+    auto client = SharedMemoryReportRings::open("osvr_test_read");
+    uint32_t device = 0;
+    server->addDevice("com_osvr_Test/Device", device);
+    server->publish(buttonPacket(device, 1));
+    server->publish(buttonPacket(device, 0));
+
+    std::vector<OSVR_ButtonState> states;
+    uint64_t next = client->read(device, 0, ButtonCollector(states));
+    ASSERT_EQ(2u, next);
+    ASSERT_EQ(2u, states.size());
+    ASSERT_EQ(1, states[0]);
+    ASSERT_EQ(0, states[1]);
+
+    states.clear();
+    ASSERT_EQ(next, client->read(device, next, ButtonCollector(states)));
+    ASSERT_TRUE(states.empty());
+    ASSERT_EQ(0u, client->getLostReports());
+}
+
+TEST(SharedMemoryReportRings, SlowReaderLosesOldest) {
+    auto server = SharedMemoryReportRings::create("osvr_test_lost");
+    auto client = SharedMemoryReportRings::open("osvr_test_lost");
+    uint32_t device = 0;
+    server->addDevice("com_osvr_Test/Device", device);
+    const uint64_t extra = 5;
+    const uint64_t total = SharedMemoryReportRings::HISTORY + extra;
+    for (uint64_t i = 0; i < total; ++i) {
+        server->publish(buttonPacket(device, i == total - 1 ? 1 : 0));
+    }
+
+    std::vector<OSVR_ButtonState> states;
+    ASSERT_EQ(total, client->read(device, 0, ButtonCollector(states)));
+    ASSERT_EQ(std::size_t(SharedMemoryReportRings::HISTORY), states.size());
+    ASSERT_EQ(1, states.back());
+    ASSERT_EQ(extra, client->getLostReports());
+}
+
+TEST(SharedMemoryReportRings, ClientSeesServerClose) {
+    auto server = SharedMemoryReportRings::create("osvr_test_close");
+    auto client = SharedMemoryReportRings::open("osvr_test_close");
+    ASSERT_FALSE(client->isClosed());
+    server.reset();
+    ASSERT_TRUE(client->isClosed());
+    ASSERT_TRUE(SharedMemoryReportRings::open("osvr_test_close") == nullptr);
+}
+
+TEST(SharedMemoryReportRings, ClientSeesHeartbeat) {
+    auto server = SharedMemoryReportRings::create("osvr_test_heartbeat");
+    auto client = SharedMemoryReportRings::open("osvr_test_heartbeat");
+    server->heartbeat();
+    ASSERT_LE(0.0, client->getHeartbeatAge());
+    ASSERT_GT(1.0, client->getHeartbeatAge());
+}
+
+TEST(SharedMemoryReportRings, FullRegionRefusesDevices) {
+    auto server = SharedMemoryReportRings::create("osvr_test_full");
+    uint32_t device = 0;
+    for (uint32_t i = 0; i < SharedMemoryReportRings::MAX_DEVICES; ++i) {
+        ASSERT_TRUE(server->addDevice("com_osvr_Test/Device", device));
+    }
+    ASSERT_FALSE(server->addDevice("com_osvr_Test/Extra", device));
+}
@@ -0,0 +1,140 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerFilter.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/reader.h>
+
+// Standard includes
+#include <stdexcept>
+#include <cmath>
+
+using osvr::common::TrackerFilter;
+using osvr::util::time::TimeValue;
+
+inline Json::Value parse(const char *json) {
+    Json::Value ret;
+    Json::Reader reader;
+    reader.parse(json, ret);
+    return ret;
+}
+
+inline TimeValue at(OSVR_TimeValue_Microseconds usec) {
+    TimeValue ret = {0, usec};
+    return ret;
+}
+
+inline OSVR_PoseState pose(double x, double w, double z) {
+    const double norm = std::sqrt(w * w + z * z);
+    OSVR_PoseState ret = {{{x, 0, 0}}, {{w / norm, 0, 0, z / norm}}};
+    return ret;
+}
+
+TEST(TrackerFilter, RejectsUnknownType) {
+    ASSERT_THROW(TrackerFilter::create(parse(R"({"type": "magic"})")),
+                 std::runtime_error);
+    ASSERT_THROW(
+        TrackerFilter::create(parse(R"({"type": "exponential", "alpha": 2})")),
+        std::runtime_error);
+}
+
+TEST(TrackerFilter, FirstSamplePassesThrough) {
+    auto filter = TrackerFilter::create(parse(R"({"type": "oneEuro"})"));
+    OSVR_PoseState p = pose(1, 1, 0.5);
+    OSVR_PoseState const orig = p;
+    filter->filter(at(0), 0, &p, 1);
+    ASSERT_DOUBLE_EQ(orig.translation.data[0], p.translation.data[0]);
+    ASSERT_DOUBLE_EQ(orig.rotation.data[3], p.rotation.data[3]);
+}
+
+TEST(TrackerFilter, ExponentialSmoothsHalfway) {
+    auto filter = TrackerFilter::create(parse(R"({"type": "exponential"})"));
+    OSVR_PoseState p = pose(0, 1, 0);
+    filter->filter(at(0), 0, &p, 1);
+    p = pose(2, 1, 0);
+    filter->filter(at(10000), 0, &p, 1);
+    ASSERT_DOUBLE_EQ(1, p.translation.data[0]);
+}
+
+TEST(TrackerFilter, ConstantInputUnchanged) {
+    auto filter = TrackerFilter::create(parse(
+        R"({"type": "oneEuro", "position": {"beta": 0.5}})"));
+    for (int i = 0; i < 10; ++i) {
+        OSVR_PoseState p = pose(3, 1, 1);
+        filter->filter(at(i * 10000), 0, &p, 1);
+        ASSERT_NEAR(3, p.translation.data[0], 1e-9);
+        ASSERT_NEAR(std::sqrt(0.5), p.rotation.data[0], 1e-9);
+    }
+}
+
+TEST(TrackerFilter, BatchMatchesSeparateSensors) {
+    const char *config = R"({"type": "oneEuro", "position": {"beta": 2}})";
+    auto batched = TrackerFilter::create(parse(config));
+    auto separate = TrackerFilter::create(parse(config));
+    for (int i = 0; i < 5; ++i) {
+        OSVR_PoseState poses[] = {pose(i, 1, 0.1 * i), pose(-2. * i, 1, 0)};
+        OSVR_PoseState expected[] = {poses[0], poses[1]};
+        batched->filter(at(i * 10000), 1, poses, 2);
+        separate->filter(at(i * 10000), 1, &expected[0], 1);
+        separate->filter(at(i * 10000), 2, &expected[1], 1);
+        for (int s = 0; s < 2; ++s) {
+            for (int j = 0; j < 3; ++j) {
+                ASSERT_DOUBLE_EQ(expected[s].translation.data[j],
+                                 poses[s].translation.data[j]);
+            }
+            for (int j = 0; j < 4; ++j) {
+                ASSERT_DOUBLE_EQ(expected[s].rotation.data[j],
+                                 poses[s].rotation.data[j]);
+            }
+        }
+    }
+}
+
+TEST(TrackerFilter, NegatedQuaternionIsSameOrientation) {
+    auto filter = TrackerFilter::create(parse(R"({"type": "exponential"})"));
+    OSVR_PoseState p = pose(0, 1, 0.2);
+    OSVR_PoseState const orig = p;
+    filter->filter(at(0), 0, &p, 1);
+    p = pose(0, -1, -0.2);
+    filter->filter(at(10000), 0, &p, 1);
+    ASSERT_NEAR(orig.rotation.data[0], p.rotation.data[0], 1e-9);
+    ASSERT_NEAR(orig.rotation.data[3], p.rotation.data[3], 1e-9);
+}
+
+TEST(TrackerFilter, KalmanOrientationLeavesPosition) {
+    auto filter =
+        TrackerFilter::create(parse(R"({"type": "kalmanOrientation"})"));
+    OSVR_PoseState p = pose(0, 1, 0);
+    filter->filter(at(0), 0, &p, 1);
+    p = pose(5, 1, 1);
+    filter->filter(at(10000), 0, &p, 1);
+    ASSERT_DOUBLE_EQ(5, p.translation.data[0]);
+    /// Partway from the old orientation to the new.
+    ASSERT_GT(p.rotation.data[3], 0);
+    ASSERT_LT(p.rotation.data[3], std::sqrt(0.5));
+}
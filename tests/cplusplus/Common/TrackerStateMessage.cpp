@@ -0,0 +1,128 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerStateMessage.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cstring>
+
+using osvr::common::TrackerStateMessage;
+
+inline OSVR_TrackerState makeState(OSVR_TrackerStateFlags flags) {
+    OSVR_TrackerState ret;
+    std::memset(&ret, 0, sizeof(ret));
+    ret.flags = flags;
+    ret.pose.translation.data[0] = 1.25;
+    ret.pose.rotation.data[0] = 0.5;
+    ret.pose.rotation.data[1] = 0.5;
+    ret.pose.rotation.data[2] = 0.5;
+    ret.pose.rotation.data[3] = 0.5;
+    ret.linearVelocity.data[1] = -3;
+    ret.angularVelocity.data[2] = 0.1;
+    ret.linearAcceleration.data[0] = 9.8;
+    ret.angularAcceleration.data[1] = 2;
+    return ret;
+}
+
+TEST(TrackerStateMessage, RoundTrip) {
+    const OSVR_TrackerStateFlags all =
+        OSVR_TRACKER_POSITION_VALID | OSVR_TRACKER_ORIENTATION_VALID |
+        OSVR_TRACKER_LINEAR_VELOCITY_VALID |
+        OSVR_TRACKER_ANGULAR_VELOCITY_VALID |
+        OSVR_TRACKER_LINEAR_ACCELERATION_VALID |
+        OSVR_TRACKER_ANGULAR_ACCELERATION_VALID;
+    const OSVR_TrackerState state = makeState(all);
+    osvr::common::Buffer<> buf;
+    TrackerStateMessage::encode(buf, 12, 3, state);
+
+    uint32_t sequence;
+    int32_t sensor;
+    OSVR_TrackerState got;
+    ASSERT_TRUE(TrackerStateMessage::decode(buf.data(), buf.size(), sequence,
+                                            sensor, got));
+    ASSERT_EQ(12u, sequence);
+    ASSERT_EQ(3, sensor);
+    ASSERT_EQ(all, got.flags);
+    ASSERT_EQ(1.25, got.pose.translation.data[0]);
+    ASSERT_EQ(0.5, got.pose.rotation.data[3]);
+    ASSERT_EQ(-3, got.linearVelocity.data[1]);
+    ASSERT_EQ(0.1, got.angularVelocity.data[2]);
+    ASSERT_EQ(9.8, got.linearAcceleration.data[0]);
+    ASSERT_EQ(2, got.angularAcceleration.data[1]);
+}
+
+TEST(TrackerStateMessage, OnlyValidPartsAreSent) {
+    osvr::common::Buffer<> buf;
+    TrackerStateMessage::encode(
+        buf, 0, 0, makeState(OSVR_TRACKER_ORIENTATION_VALID |
+                             OSVR_TRACKER_POSITION_VALID));
+    const std::size_t poseSize = buf.size();
+    TrackerStateMessage::encode(buf, 0, 0,
+                                makeState(OSVR_TRACKER_ORIENTATION_VALID));
+    ASSERT_EQ(poseSize - 3 * sizeof(double), buf.size());
+
+    uint32_t sequence;
+    int32_t sensor;
+    OSVR_TrackerState got;
+    ASSERT_TRUE(TrackerStateMessage::decode(buf.data(), buf.size(), sequence,
+                                            sensor, got));
+    ASSERT_EQ(0, got.pose.translation.data[0]);
+    ASSERT_EQ(0, got.linearVelocity.data[1]);
+}
+
+TEST(TrackerStateMessage, SinglePrecision) {
+    const OSVR_TrackerStateFlags flags = OSVR_TRACKER_POSITION_VALID |
+                                         OSVR_TRACKER_ORIENTATION_VALID |
+                                         OSVR_TRACKER_ANGULAR_VELOCITY_VALID;
+    osvr::common::Buffer<> buf;
+    TrackerStateMessage::encode(buf, 0, 0, makeState(flags));
+    const std::size_t doubleSize = buf.size();
+    TrackerStateMessage::encode(
+        buf, 0, 0, makeState(flags | OSVR_TRACKER_SINGLE_PRECISION));
+    ASSERT_LT(buf.size(), doubleSize);
+
+    uint32_t sequence;
+    int32_t sensor;
+    OSVR_TrackerState got;
+    ASSERT_TRUE(TrackerStateMessage::decode(buf.data(), buf.size(), sequence,
+                                            sensor, got));
+    ASSERT_EQ(1.25, got.pose.translation.data[0]);
+    ASSERT_FLOAT_EQ(0.1f, float(got.angularVelocity.data[2]));
+}
+
+TEST(TrackerStateMessage, RejectsTruncated) {
+    osvr::common::Buffer<> buf;
+    TrackerStateMessage::encode(buf, 0, 0,
+                                makeState(OSVR_TRACKER_POSITION_VALID));
+    uint32_t sequence;
+    int32_t sensor;
+    OSVR_TrackerState got;
+    ASSERT_FALSE(TrackerStateMessage::decode(buf.data(), buf.size() - 1,
+                                             sequence, sensor, got));
+}
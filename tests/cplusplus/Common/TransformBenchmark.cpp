@@ -0,0 +1,116 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/ChangeOfBasis.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdint>
+
+using osvr::common::CompiledTransform;
+using osvr::common::Transform;
+
+/// @brief Reports transformed per measurement.
+static const std::uint64_t REPORTS_PER_RUN = 5000000;
+
+/// @brief Average time to transform one pose, in nanoseconds.
+template <typename F> static double nanosPerReport(F &&apply) {
+    OSVR_Pose3 pose;
+    osvrPose3SetIdentity(&pose);
+    OSVR_TimeValue start;
+    OSVR_TimeValue end;
+    osvr::util::time::getMonotonicNow(start);
+    for (std::uint64_t i = 0; i < REPORTS_PER_RUN; ++i) {
+        osvrVec3SetX(&pose.translation, static_cast<double>(i & 0xff));
+        apply(pose);
+    }
+    osvr::util::time::getMonotonicNow(end);
+    /// Keep the work from being optimized away.
+    volatile double sink = osvrVec3GetX(&pose.translation);
+    (void)sink;
+    return osvr::util::time::duration(end, start) * 1e9 / REPORTS_PER_RUN;
+}
+
+static void measure(std::string const &name, Transform const &xform) {
+    const CompiledTransform compiled(xform);
+    const double matrix = nanosPerReport([&](OSVR_Pose3 &pose) {
+        osvr::util::toPose(
+            xform.transform(osvr::util::fromPose(pose).matrix()), pose);
+    });
+    const double fast =
+        nanosPerReport([&](OSVR_Pose3 &pose) { compiled.apply(pose); });
+    std::cout << std::setw(16) << name << std::setw(16) << std::fixed
+              << std::setprecision(1) << matrix << std::setw(16) << fast
+              << std::endl;
+}
+
+static Eigen::Matrix4d rigid(double angle, Eigen::Vector3d const &axis,
+                             Eigen::Vector3d const &translation) {
+    Eigen::Isometry3d xform(Eigen::AngleAxisd(angle, axis.normalized()));
+    xform.translation() = translation;
+    return xform.matrix();
+}
+
+int main() {
+    std::cout << std::setw(16) << "Transform" << std::setw(16) << "Matrix"
+              << std::setw(16) << "Compiled"
+              << "    (ns/report)" << std::endl;
+    measure("identity", Transform());
+    {
+        Transform xform;
+        xform.concatPost(osvr::common::rotate(90, Eigen::Vector3d::UnitY()));
+        measure("rotation", xform);
+    }
+    {
+        Transform xform;
+        xform.concatPost(rigid(0, Eigen::Vector3d::UnitZ(), {0, 1.5, 0}));
+        measure("translation", xform);
+    }
+    {
+        Transform xform;
+        xform.concatPost(rigid(1.2, {0, 1, 1}, {1, 2, 3}));
+        xform.concatPre(rigid(-0.4, {1, 0, 0}, {0.2, 0, -0.1}));
+        measure("rigid", xform);
+    }
+    {
+        osvr::common::ChangeOfBasis cb;
+        cb.setNewX(-Eigen::Vector3d::UnitX());
+        cb.setNewY(Eigen::Vector3d::UnitY());
+        cb.setNewZ(Eigen::Vector3d::UnitZ());
+        Transform xform;
+        xform.transform(cb.get());
+        measure("general", xform);
+    }
+    return 0;
+}
@@ -0,0 +1,285 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/ReportSuppression.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::connection::ReportSuppression;
+using osvr::connection::ReportSuppressionSettings;
+using osvr::connection::PoseSuppressor;
+using osvr::connection::ReportConflator;
+using osvr::connection::ReportRateLimiter;
+using osvr::util::time::TimeValue;
+
+static const char TRACKER[] = "com_osvr_Example/Tracker";
+static const char ANALOG[] = "com_osvr_Example/Analog";
+
+inline TimeValue milliseconds(int ms) {
+    TimeValue ret;
+    ret.seconds = ms / 1000;
+    ret.microseconds = (ms % 1000) * 1000;
+    return ret;
+}
+
+inline OSVR_PoseState makePose(double x) {
+    OSVR_PoseState ret;
+    osvrPose3SetIdentity(&ret);
+    ret.translation.data[0] = x;
+    return ret;
+}
+
+inline ReportSuppressionSettings makeSettings(double epsilon,
+                                              double maxInterval) {
+    ReportSuppressionSettings ret;
+    ret.enabled = true;
+    ret.epsilon = epsilon;
+    ret.maxInterval = maxInterval;
+    return ret;
+}
+
+TEST(ReportSuppression, DisabledByDefault) {
+    ReportSuppression suppression;
+    auto dev = suppression.getDevice(ANALOG);
+    ASSERT_FALSE(dev->getSettings().enabled);
+    /// Only exact repeats of analog values are unchanged.
+    ASSERT_TRUE(dev->isUnchanged(1.0, 1.0));
+    ASSERT_FALSE(dev->isUnchanged(1.0, 1.0001));
+    ASSERT_FALSE(dev->isUnchanged(makePose(1), makePose(1)));
+    ASSERT_FALSE(dev->isKeepAliveDue(milliseconds(0), milliseconds(5000)));
+}
+
+TEST(ReportSuppression, DefaultsApplyToNewDevices) {
+    ReportSuppression suppression;
+    auto before = suppression.getDevice(ANALOG);
+    suppression.setDefaults(makeSettings(0.1, 0));
+    auto after = suppression.getDevice(TRACKER);
+    ASSERT_FALSE(before->getSettings().enabled);
+    ASSERT_TRUE(after->getSettings().enabled);
+    /// Changing a device's settings updates pointers already handed out.
+    suppression.setDevice(ANALOG, makeSettings(0.5, 0));
+    ASSERT_TRUE(before->getSettings().enabled);
+    ASSERT_EQ(0.5, before->getSettings().epsilon);
+    ASSERT_EQ(2u, suppression.getDevices().size());
+}
+
+TEST(ReportSuppression, Deadband) {
+    ReportSuppression suppression;
+    suppression.setDefaults(makeSettings(0.1, 0));
+    auto dev = suppression.getDevice(ANALOG);
+    ASSERT_TRUE(dev->isUnchanged(1.0, 1.05));
+    ASSERT_FALSE(dev->isUnchanged(1.0, 1.2));
+    ASSERT_TRUE(dev->isUnchanged(makePose(1), makePose(1.05)));
+    ASSERT_FALSE(dev->isUnchanged(makePose(1), makePose(1.2)));
+}
+
+TEST(ReportSuppression, OnlyDeadbandCountsAsSuppressed) {
+    ReportSuppression suppression;
+    auto disabled = suppression.getDevice(TRACKER);
+    ASSERT_FALSE(disabled->isSuppressed(1.0, 1.0));
+    ASSERT_FALSE(disabled->isSuppressed(1.0, 1.05));
+    suppression.setDevice(ANALOG, makeSettings(0.1, 0));
+    auto dev = suppression.getDevice(ANALOG);
+    ASSERT_TRUE(dev->isSuppressed(1.0, 1.05));
+    /// Exact repeats aren't reported even without suppression.
+    ASSERT_FALSE(dev->isSuppressed(1.0, 1.0));
+    ASSERT_FALSE(dev->isSuppressed(1.0, 1.2));
+}
+
+TEST(ReportSuppression, PoseSuppressor) {
+    ReportSuppression suppression;
+    suppression.setDefaults(makeSettings(0, 1.0));
+    auto dev = suppression.getDevice(TRACKER);
+    PoseSuppressor poses(dev);
+    /// First pose of each sensor is always sent.
+    ASSERT_TRUE(poses.shouldSend(0, makePose(1), milliseconds(0)));
+    ASSERT_TRUE(poses.shouldSend(1, makePose(1), milliseconds(0)));
+    ASSERT_FALSE(poses.shouldSend(0, makePose(1), milliseconds(100)));
+    ASSERT_TRUE(poses.shouldSend(0, makePose(2), milliseconds(200)));
+    /// Keep-alive, measured from the last pose sent.
+    ASSERT_FALSE(poses.shouldSend(0, makePose(2), milliseconds(1100)));
+    ASSERT_TRUE(poses.shouldSend(0, makePose(2), milliseconds(1200)));
+    ASSERT_EQ(4u, dev->getSentCount());
+    ASSERT_EQ(2u, dev->getSuppressedCount());
+}
+
+TEST(ReportSuppression, PoseSuppressorBatches) {
+    ReportSuppression suppression;
+    suppression.setDefaults(makeSettings(0, 0));
+    auto dev = suppression.getDevice(TRACKER);
+    PoseSuppressor poses(dev);
+    OSVR_PoseState batch[] = {makePose(1), makePose(2), makePose(3)};
+    ASSERT_TRUE(poses.shouldSend(0, batch, 3, milliseconds(0)));
+    ASSERT_FALSE(poses.shouldSend(0, batch, 3, milliseconds(10)));
+    /// Any change sends the whole batch.
+    batch[2] = makePose(4);
+    ASSERT_TRUE(poses.shouldSend(0, batch, 3, milliseconds(20)));
+    ASSERT_FALSE(poses.shouldSend(2, makePose(4), milliseconds(30)));
+}
+
+TEST(ReportSuppression, PoseSuppressorDisabled) {
+    ReportSuppression suppression;
+    auto dev = suppression.getDevice(TRACKER);
+    PoseSuppressor poses(dev);
+    ASSERT_TRUE(poses.shouldSend(0, makePose(1), milliseconds(0)));
+    ASSERT_TRUE(poses.shouldSend(0, makePose(1), milliseconds(0)));
+    ASSERT_EQ(0u, dev->getSuppressedCount());
+}
+
+TEST(ReportSuppression, RateLimit) {
+    ReportSuppression suppression;
+    ReportSuppressionSettings settings;
+    settings.maxRate = 100;
+    suppression.setDevice(TRACKER, settings);
+    auto dev = suppression.getDevice(TRACKER);
+    /// Rate limiting doesn't need suppression enabled.
+    ASSERT_FALSE(dev->getSettings().enabled);
+    ASSERT_TRUE(dev->isRateLimited(milliseconds(0), milliseconds(5)));
+    ASSERT_FALSE(dev->isRateLimited(milliseconds(0), milliseconds(10)));
+}
+
+TEST(ReportSuppression, ConflatorWithoutLimit) {
+    ReportSuppression suppression;
+    ReportConflator<double> held(suppression.getDevice(TRACKER));
+    ASSERT_EQ(nullptr, held.hold(0, milliseconds(0)));
+    ASSERT_EQ(nullptr, held.hold(0, milliseconds(0)));
+    ASSERT_FALSE(held.isHolding());
+}
+
+TEST(ReportSuppression, ConflatorKeepsNewest) {
+    ReportSuppression suppression;
+    ReportSuppressionSettings settings;
+    settings.maxRate = 20;
+    suppression.setDevice(TRACKER, settings);
+    auto dev = suppression.getDevice(TRACKER);
+    ReportConflator<double> held(dev);
+
+    /// Timestamps and the times of sending are the same here.
+    ASSERT_EQ(nullptr, held.hold(0, milliseconds(0), milliseconds(0)));
+    /// Other sensors are limited separately.
+    ASSERT_EQ(nullptr, held.hold(1, milliseconds(0), milliseconds(0)));
+    double *slot = held.hold(0, milliseconds(1), milliseconds(1));
+    ASSERT_NE(nullptr, slot);
+    *slot = 1;
+    slot = held.hold(0, milliseconds(2), milliseconds(2));
+    ASSERT_NE(nullptr, slot);
+    *slot = 2;
+    ASSERT_EQ(1u, dev->getConflatedCount());
+    ASSERT_TRUE(held.isHolding());
+
+    int calls = 0;
+    auto check = [&](OSVR_ChannelCount sensor, double report,
+                     TimeValue const &timestamp) {
+        ++calls;
+        ASSERT_EQ(0u, sensor);
+        ASSERT_EQ(2, report);
+        ASSERT_EQ(2000, timestamp.microseconds);
+    };
+    /// Not yet: 20 per second is one every 50 ms.
+    held.flush(check, milliseconds(49));
+    ASSERT_EQ(0, calls);
+
+    held.flush(check, milliseconds(50));
+    ASSERT_EQ(1, calls);
+    ASSERT_FALSE(held.isHolding());
+    held.flush(check, milliseconds(200));
+    ASSERT_EQ(1, calls);
+    /// Limited from the time the held report was sent.
+    ASSERT_NE(nullptr, held.hold(0, milliseconds(60), milliseconds(60)));
+}
+
+TEST(ReportSuppression, ConnectionBudgetSharedByDevices) {
+    ReportSuppression suppression;
+    /// Saves up at most a tenth of a second's worth: 2 reports.
+    suppression.setMaxConnectionRate(20);
+    auto tracker = suppression.getDevice(TRACKER);
+    auto analog = suppression.getDevice(ANALOG);
+    ReportConflator<double> poses(tracker);
+    ReportRateLimiter analogs(analog);
+
+    /// No device limits of their own.
+    ASSERT_EQ(nullptr, poses.hold(0, milliseconds(0), milliseconds(0)));
+    ASSERT_FALSE(analogs.hold(0, milliseconds(0), milliseconds(0)));
+    double *slot = poses.hold(1, milliseconds(1), milliseconds(1));
+    ASSERT_NE(nullptr, slot);
+    *slot = 1;
+    ASSERT_TRUE(analogs.hold(0, milliseconds(1), milliseconds(1)));
+
+    /// One report's worth every 50 ms, to whoever flushes first.
+    int calls = 0;
+    auto countPose = [&](OSVR_ChannelCount sensor, double report,
+                         TimeValue const &) {
+        ++calls;
+        ASSERT_EQ(1u, sensor);
+        ASSERT_EQ(1, report);
+    };
+    auto countAnalog = [&](OSVR_ChannelCount, TimeValue const &) {
+        ++calls;
+    };
+    poses.flush(countPose, milliseconds(40));
+    analogs.flush(countAnalog, milliseconds(40));
+    ASSERT_EQ(0, calls);
+    poses.flush(countPose, milliseconds(60));
+    analogs.flush(countAnalog, milliseconds(60));
+    ASSERT_EQ(1, calls);
+    ASSERT_FALSE(poses.isHolding());
+    ASSERT_TRUE(analogs.isHolding());
+    analogs.flush(countAnalog, milliseconds(110));
+    ASSERT_EQ(2, calls);
+    ASSERT_FALSE(analogs.isHolding());
+
+    /// Removing the limit lets everything through.
+    suppression.setMaxConnectionRate(0);
+    ASSERT_EQ(nullptr, poses.hold(0, milliseconds(111), milliseconds(111)));
+    ASSERT_EQ(nullptr, poses.hold(0, milliseconds(112), milliseconds(112)));
+}
+
+TEST(ReportSuppression, RateLimiterHoldsNoReports) {
+    ReportSuppression suppression;
+    ReportSuppressionSettings settings;
+    settings.maxRate = 20;
+    suppression.setDevice(ANALOG, settings);
+    auto dev = suppression.getDevice(ANALOG);
+    ReportRateLimiter held(dev);
+
+    ASSERT_FALSE(held.hold(0, milliseconds(0), milliseconds(0)));
+    ASSERT_TRUE(held.hold(0, milliseconds(10), milliseconds(10)));
+    ASSERT_TRUE(held.hold(0, milliseconds(20), milliseconds(20)));
+    ASSERT_EQ(1u, dev->getConflatedCount());
+
+    int calls = 0;
+    held.flush([&](OSVR_ChannelCount sensor, TimeValue const &timestamp) {
+        ++calls;
+        ASSERT_EQ(0u, sensor);
+        ASSERT_EQ(20000, timestamp.microseconds);
+    }, milliseconds(50));
+    ASSERT_EQ(1, calls);
+    ASSERT_FALSE(held.isHolding());
+}
@@ -0,0 +1,278 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/DirectReportPacket.h>
+#include <osvr/Common/UnixSocketPath.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/thread/thread.hpp>
+#include <vrpn_ConnectionPtr.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#ifdef OSVR_HAVE_UNIX_SOCKETS
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using osvr::common::DirectReportPacket;
+
+/// @brief Round trips per measurement.
+static const std::size_t ROUND_TRIPS = 20000;
+
+/// @brief Port for the VRPN comparison: not the default, so that a running
+/// server doesn't get in the way.
+static const int VRPN_PORT = 3895;
+
+/// @brief A connected pair of sockets: one for the sender, one for the
+/// echoing peer.
+struct SocketPair {
+    int local;
+    int peer;
+};
+
+static SocketPair unixSeqpacketPair() {
+    int fds[2];
+    socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds);
+    return SocketPair{fds[0], fds[1]};
+}
+
+static sockaddr_in loopback(unsigned short port) {
+    sockaddr_in addr = sockaddr_in();
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    return addr;
+}
+
+static unsigned short boundPort(int sock) {
+    sockaddr_in addr = loopback(0);
+    bind(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    socklen_t len = sizeof(addr);
+    getsockname(sock, reinterpret_cast<sockaddr *>(&addr), &len);
+    return ntohs(addr.sin_port);
+}
+
+static SocketPair tcpLoopbackPair() {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    const unsigned short port = boundPort(listener);
+    listen(listener, 1);
+    int local = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = loopback(port);
+    connect(local, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+    int peer = accept(listener, nullptr, nullptr);
+    close(listener);
+    int one = 1;
+    setsockopt(local, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(peer, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return SocketPair{local, peer};
+}
+
+static SocketPair udpLoopbackPair() {
+    int local = socket(AF_INET, SOCK_DGRAM, 0);
+    int peer = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in localAddr = loopback(boundPort(local));
+    sockaddr_in peerAddr = loopback(boundPort(peer));
+    connect(local, reinterpret_cast<sockaddr *>(&peerAddr), sizeof(peerAddr));
+    connect(peer, reinterpret_cast<sockaddr *>(&localAddr),
+            sizeof(localAddr));
+    return SocketPair{local, peer};
+}
+
+/// @brief Receives exactly len bytes - a single call except on streams.
+static bool receiveAll(int sock, char *buf, std::size_t len) {
+    std::size_t got = 0;
+    while (got < len) {
+        auto ret = recv(sock, buf + got, len - got, 0);
+        if (ret <= 0) {
+            return false;
+        }
+        got += std::size_t(ret);
+    }
+    return true;
+}
+
+static DirectReportPacket trackerPacket() {
+    DirectReportPacket packet;
+    OSVR_PoseState pose = OSVR_PoseState();
+    pose.rotation.data[0] = 1;
+    packet.setPose(0, 0, OSVR_TimeValue(), pose);
+    return packet;
+}
+
+/// @brief Measures round trips of a tracker report, returning one-way
+/// latencies (half of each round trip) in microseconds, sorted.
+static std::vector<double> measure(SocketPair sockets) {
+    const DirectReportPacket packet = trackerPacket();
+    const std::size_t len = packet.size();
+
+    boost::thread echo([&] {
+        std::vector<char> buf(len);
+        for (std::size_t i = 0; i < ROUND_TRIPS; ++i) {
+            if (!receiveAll(sockets.peer, buf.data(), len)) {
+                return;
+            }
+            send(sockets.peer, buf.data(), len, 0);
+        }
+    });
+
+    std::vector<char> buf(len);
+    std::vector<double> latencies;
+    latencies.reserve(ROUND_TRIPS);
+    for (std::size_t i = 0; i < ROUND_TRIPS; ++i) {
+        OSVR_TimeValue start;
+        OSVR_TimeValue end;
+        osvr::util::time::getMonotonicNow(start);
+        send(sockets.local, packet.data(), len, 0);
+        if (!receiveAll(sockets.local, buf.data(), len)) {
+            break;
+        }
+        osvr::util::time::getMonotonicNow(end);
+        latencies.push_back(osvr::util::time::duration(end, start) * 0.5e6);
+    }
+    echo.join();
+    close(sockets.local);
+    close(sockets.peer);
+    std::sort(begin(latencies), end(latencies));
+    return latencies;
+}
+
+/// @brief Reports received by the VRPN remote.
+struct VrpnReceiver {
+    VrpnReceiver() : received(0) {}
+    std::atomic<std::size_t> received;
+    std::vector<double> latencies;
+};
+
+static void VRPN_CALLBACK handleVrpnPose(void *userdata,
+                                         const vrpn_TRACKERCB info) {
+    auto receiver = static_cast<VrpnReceiver *>(userdata);
+    OSVR_TimeValue now;
+    osvr::util::time::getMonotonicNow(now);
+    const OSVR_TimeValue sent =
+        osvr::util::time::fromStructTimeval(info.msg_time);
+    receiver->latencies.push_back(osvr::util::time::duration(now, sent) *
+                                  1e6);
+    ++receiver->received;
+}
+
+/// @brief Measures the same tracker report sent the way the server and
+/// clients talk by default: from a VRPN tracker server to a remote, over
+/// loopback. Both ends share a clock, so these are one-way latencies
+/// measured directly, in microseconds, sorted.
+static std::vector<double> measureVrpn() {
+    vrpn_ConnectionPtr server = vrpn_ConnectionPtr::create_server_connection(
+        VRPN_PORT, nullptr, nullptr, "localhost");
+    vrpn_Tracker_Server tracker("Tracker", server.get());
+    const std::string remoteName =
+        "Tracker@localhost:" + std::to_string(VRPN_PORT);
+    VrpnReceiver receiver;
+    std::atomic<bool> done(false);
+    boost::thread client([&] {
+        vrpn_Tracker_Remote remote(remoteName.c_str());
+        remote.register_change_handler(&receiver, &handleVrpnPose);
+        while (!done) {
+            remote.mainloop();
+        }
+    });
+
+    const vrpn_float64 pos[3] = {0, 0, 0};
+    const vrpn_float64 quat[4] = {0, 0, 0, 1};
+    /// Reports sent before the remote has connected are lost, so the first
+    /// is resent until one gets through, and isn't counted.
+    const std::size_t total = ROUND_TRIPS + 1;
+    while (receiver.received < total) {
+        const std::size_t before = receiver.received;
+        OSVR_TimeValue start;
+        OSVR_TimeValue now;
+        struct timeval sent;
+        osvr::util::time::getMonotonicNow(start);
+        osvr::util::time::toStructTimeval(sent, start);
+        tracker.report_pose(0, sent, pos, quat);
+        tracker.mainloop();
+        do {
+            server->mainloop();
+            osvr::util::time::getMonotonicNow(now);
+        } while (receiver.received == before &&
+                 osvr::util::time::duration(now, start) < 0.1);
+    }
+    done = true;
+    client.join();
+    std::vector<double> latencies(begin(receiver.latencies) + 1,
+                                  end(receiver.latencies));
+    std::sort(begin(latencies), end(latencies));
+    return latencies;
+}
+
+static double percentile(std::vector<double> const &sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    return sorted[std::size_t(p * double(sorted.size() - 1))];
+}
+
+static void report(std::string const &name,
+                   std::vector<double> const &latencies) {
+    std::cout << std::setw(20) << name << std::fixed << std::setprecision(2)
+              << std::setw(12) << percentile(latencies, 0.5) << std::setw(12)
+              << percentile(latencies, 0.99) << std::setw(12)
+              << percentile(latencies, 0.999) << std::endl;
+}
+
+int main() {
+    std::cout << "One-way latency of a " << trackerPacket().size()
+              << "-byte tracker report, " << ROUND_TRIPS
+              << " round trips (microseconds)" << std::endl;
+    std::cout << std::setw(20) << "Transport" << std::setw(12) << "median"
+              << std::setw(12) << "99%" << std::setw(12) << "99.9%"
+              << std::endl;
+    report("unix seqpacket", measure(unixSeqpacketPair()));
+    report("tcp loopback", measure(tcpLoopbackPair()));
+    report("udp loopback", measure(udpLoopbackPair()));
+    report("vrpn loopback", measureVrpn());
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "Unix domain sockets are not available on this platform."
+              << std::endl;
+    return 0;
+}
+
+#endif // OSVR_HAVE_UNIX_SOCKETS
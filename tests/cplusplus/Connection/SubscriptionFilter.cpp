@@ -0,0 +1,237 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/SubscriptionFilter.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <string>
+
+using osvr::connection::SubscriptionFilter;
+using osvr::common::SourceSubscription;
+using osvr::common::SourceSubscriptionList;
+using osvr::util::time::TimeValue;
+
+static const char TRACKER[] = "com_osvr_Example/Tracker";
+static const char ANALOG[] = "com_osvr_Example/Analog";
+
+inline TimeValue seconds(int s) {
+    TimeValue ret;
+    ret.seconds = s;
+    ret.microseconds = 0;
+    return ret;
+}
+
+class SubscriptionFilterTest : public ::testing::Test {
+  public:
+    SubscriptionFilterTest() { filter.setEnabled(true); }
+    SubscriptionFilter filter;
+};
+
+TEST(SubscriptionFilter, DisabledWantsEverything) {
+    SubscriptionFilter filter;
+    ASSERT_FALSE(filter.isEnabled());
+    auto dev = filter.getDevice(TRACKER);
+    ASSERT_TRUE(dev->wantsAny());
+    ASSERT_TRUE(dev->wants(0));
+    ASSERT_TRUE(dev->wants(5));
+}
+
+TEST_F(SubscriptionFilterTest, NoClientsWantsNothing) {
+    auto dev = filter.getDevice(TRACKER);
+    ASSERT_FALSE(dev->wantsAny());
+    ASSERT_FALSE(dev->wants(0));
+}
+
+TEST_F(SubscriptionFilterTest, SensorSubscription) {
+    auto tracker = filter.getDevice(TRACKER);
+    auto analog = filter.getDevice(ANALOG);
+    filter.setClientSubscriptions(
+        "client", SourceSubscriptionList{SourceSubscription(TRACKER, 2)},
+        seconds(0));
+    ASSERT_TRUE(tracker->wantsAny());
+    ASSERT_TRUE(tracker->wants(2));
+    ASSERT_FALSE(tracker->wants(0));
+    ASSERT_FALSE(tracker->wants(3));
+    ASSERT_FALSE(analog->wantsAny());
+}
+
+TEST_F(SubscriptionFilterTest, WholeDeviceSubscription) {
+    auto tracker = filter.getDevice(TRACKER);
+    filter.setClientSubscriptions(
+        "client", SourceSubscriptionList{SourceSubscription(TRACKER)},
+        seconds(0));
+    ASSERT_TRUE(tracker->wants(0));
+    ASSERT_TRUE(tracker->wants(7));
+}
+
+TEST_F(SubscriptionFilterTest, UnionOfClients) {
+    auto tracker = filter.getDevice(TRACKER);
+    filter.setClientSubscriptions(
+        "a", SourceSubscriptionList{SourceSubscription(TRACKER, 0)},
+        seconds(0));
+    filter.setClientSubscriptions(
+        "b", SourceSubscriptionList{SourceSubscription(TRACKER, 1)},
+        seconds(0));
+    ASSERT_TRUE(tracker->wants(0));
+    ASSERT_TRUE(tracker->wants(1));
+
+    filter.removeClient("a");
+    ASSERT_FALSE(tracker->wants(0));
+    ASSERT_TRUE(tracker->wants(1));
+}
+
+TEST_F(SubscriptionFilterTest, ReplacingSubscriptions) {
+    auto tracker = filter.getDevice(TRACKER);
+    auto analog = filter.getDevice(ANALOG);
+    filter.setClientSubscriptions(
+        "client", SourceSubscriptionList{SourceSubscription(TRACKER, 0)},
+        seconds(0));
+    filter.setClientSubscriptions(
+        "client", SourceSubscriptionList{SourceSubscription(ANALOG, 4)},
+        seconds(1));
+    ASSERT_FALSE(tracker->wantsAny());
+    ASSERT_TRUE(analog->wants(4));
+}
+
+TEST_F(SubscriptionFilterTest, ClientsExpire) {
+    auto tracker = filter.getDevice(TRACKER);
+    filter.setClientSubscriptions(
+        "old", SourceSubscriptionList{SourceSubscription(TRACKER, 0)},
+        seconds(0));
+    filter.setClientSubscriptions(
+        "new", SourceSubscriptionList{SourceSubscription(TRACKER, 1)},
+        seconds(8));
+    filter.expireClients(seconds(10), 5.0);
+    ASSERT_EQ(1u, filter.getNumClients());
+    ASSERT_FALSE(tracker->wants(0));
+    ASSERT_TRUE(tracker->wants(1));
+}
+
+TEST_F(SubscriptionFilterTest, DependenciesFollowSensors) {
+    static const char DERIVED[] = "org_osvr_ServerRoute/me_head";
+    auto tracker = filter.getDevice(TRACKER);
+    filter.setDependency(DERIVED, SourceSubscription(TRACKER));
+    filter.setClientSubscriptions(
+        "client", SourceSubscriptionList{SourceSubscription(DERIVED, 3)},
+        seconds(0));
+    ASSERT_TRUE(filter.getDevice(DERIVED)->wants(3));
+    ASSERT_TRUE(tracker->wants(3));
+    ASSERT_FALSE(tracker->wants(0));
+
+    filter.setDependency(DERIVED, SourceSubscription(TRACKER, 1));
+    ASSERT_TRUE(tracker->wants(1));
+    ASSERT_FALSE(tracker->wants(3));
+
+    filter.removeDependency(DERIVED);
+    ASSERT_FALSE(tracker->wantsAny());
+}
+
+TEST_F(SubscriptionFilterTest, Disabling) {
+    auto tracker = filter.getDevice(TRACKER);
+    ASSERT_FALSE(tracker->wantsAny());
+    filter.setEnabled(false);
+    ASSERT_TRUE(tracker->wants(0));
+}
+
+TEST_F(SubscriptionFilterTest, UnsubscribedConnectionWantsEverything) {
+    auto tracker = filter.getDevice(TRACKER);
+    filter.setClientSubscriptions(
+        "client", SourceSubscriptionList{SourceSubscription(TRACKER, 0)},
+        seconds(0));
+    filter.addConnection();
+    ASSERT_TRUE(filter.isFiltering());
+    ASSERT_FALSE(tracker->wants(1));
+
+    /// Say, a plain VRPN client.
+    filter.addConnection();
+    ASSERT_FALSE(filter.isFiltering());
+    ASSERT_TRUE(tracker->wants(1));
+    ASSERT_TRUE(filter.getDevice(ANALOG)->wantsAny());
+
+    filter.removeConnection();
+    ASSERT_TRUE(filter.isFiltering());
+    ASSERT_FALSE(tracker->wants(1));
+    ASSERT_TRUE(tracker->wants(0));
+}
+
+TEST_F(SubscriptionFilterTest, EmptySubscriptionCountsAsReported) {
+    filter.addConnection();
+    ASSERT_TRUE(filter.getDevice(TRACKER)->wantsAny());
+    filter.setClientSubscriptions("client", SourceSubscriptionList(),
+                                  seconds(0));
+    ASSERT_FALSE(filter.getDevice(TRACKER)->wantsAny());
+}
+
+TEST_F(SubscriptionFilterTest, ClientsSharingAConnectionCountOnce) {
+    auto tracker = filter.getDevice(TRACKER);
+    filter.addConnection();
+    filter.addConnection();
+    /// Two client contexts in one process, sharing a connection: the other
+    /// connection, say a plain VRPN client, hasn't reported.
+    filter.setClientSubscriptions(
+        "a", "shared", SourceSubscriptionList{SourceSubscription(TRACKER, 0)},
+        seconds(0));
+    filter.setClientSubscriptions(
+        "b", "shared", SourceSubscriptionList{SourceSubscription(TRACKER, 1)},
+        seconds(0));
+    ASSERT_EQ(2u, filter.getNumClients());
+    ASSERT_EQ(1u, filter.getNumReportedConnections());
+    ASSERT_FALSE(filter.isFiltering());
+    ASSERT_TRUE(tracker->wants(2));
+
+    filter.setClientSubscriptions(
+        "c", "other", SourceSubscriptionList{SourceSubscription(TRACKER, 2)},
+        seconds(0));
+    ASSERT_TRUE(filter.isFiltering());
+    ASSERT_TRUE(tracker->wants(0));
+    ASSERT_TRUE(tracker->wants(2));
+    ASSERT_FALSE(tracker->wants(3));
+
+    /// The shared connection still has a client.
+    filter.removeClient("a");
+    ASSERT_EQ(2u, filter.getNumReportedConnections());
+    ASSERT_TRUE(filter.isFiltering());
+    filter.expireClients(seconds(10), 5.0);
+    ASSERT_EQ(0u, filter.getNumReportedConnections());
+    ASSERT_FALSE(filter.isFiltering());
+}
+
+TEST_F(SubscriptionFilterTest, ClientChangingConnection) {
+    filter.addConnection();
+    filter.addConnection();
+    filter.setClientSubscriptions("a", "first", SourceSubscriptionList(),
+                                  seconds(0));
+    filter.setClientSubscriptions("b", "first", SourceSubscriptionList(),
+                                  seconds(0));
+    ASSERT_FALSE(filter.isFiltering());
+    filter.setClientSubscriptions("b", "second", SourceSubscriptionList(),
+                                  seconds(1));
+    ASSERT_EQ(2u, filter.getNumReportedConnections());
+    ASSERT_TRUE(filter.isFiltering());
+}
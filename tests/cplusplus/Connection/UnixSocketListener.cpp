@@ -0,0 +1,163 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2014
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2014 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/UnixSocketPath.h>
+
+#ifdef OSVR_HAVE_UNIX_SOCKETS
+#include "../../../src/osvr/Connection/UnixSocketListener.h"
+#include "../../../src/osvr/Connection/UnixSocketListener.cpp"
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using osvr::common::DirectReportPacket;
+using osvr::connection::UnixSocketListener;
+
+/// @brief Most packets to send trying to fill a socket buffer.
+static const int MAX_FILL = 100000;
+
+inline std::string makePath() {
+    return "/tmp/osvr_test_listener_" + std::to_string(getpid()) + ".sock";
+}
+
+inline DirectReportPacket makePose(double x) {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    pose.translation.data[0] = x;
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    DirectReportPacket ret;
+    ret.setPose(0, 0, now, pose);
+    return ret;
+}
+
+inline DirectReportPacket makeButton(OSVR_ButtonState state) {
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    DirectReportPacket ret;
+    ret.setButtons(0, 0, now, &state, 1);
+    return ret;
+}
+
+inline DirectReportPacket makeName(uint32_t device, std::string const &name) {
+    DirectReportPacket ret;
+    ret.setDeviceName(device, name);
+    return ret;
+}
+
+/// @brief A listener with one client, connected by a socketpair(), that
+/// doesn't read until asked to.
+class UnixSocketListenerTest : public ::testing::Test {
+  public:
+    UnixSocketListenerTest() : listener(makePath()) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds) != 0) {
+            throw std::runtime_error("Could not create a socket pair");
+        }
+        listener.addClient(fds[0]);
+        reader = fds[1];
+    }
+
+    ~UnixSocketListenerTest() { close(reader); }
+
+    /// @brief Sends tracker reports until the client's socket buffer is
+    /// full, and one is held.
+    void fill() {
+        for (int i = 0; i < MAX_FILL && listener.getDroppedPackets() == 0;
+             ++i) {
+            listener.broadcast(makePose(0));
+        }
+        ASSERT_EQ(1u, listener.getDroppedPackets());
+    }
+
+    /// @brief Reads everything sent, letting the listener send what it
+    /// held as room is made, and returns the last packets read.
+    std::vector<DirectReportPacket> drain(std::size_t last) {
+        std::vector<DirectReportPacket> ret;
+        std::vector<char> buf(DirectReportPacket::maxSize());
+        for (int i = 0; i < 10; ++i) {
+            listener.process([](UnixSocketListener::ClientHandle) {});
+            while (true) {
+                auto len = recv(reader, buf.data(), buf.size(), MSG_DONTWAIT);
+                if (len <= 0) {
+                    break;
+                }
+                DirectReportPacket packet;
+                EXPECT_TRUE(packet.assign(buf.data(), std::size_t(len)));
+                ret.push_back(packet);
+                if (ret.size() > last) {
+                    ret.erase(ret.begin());
+                }
+            }
+        }
+        return ret;
+    }
+
+    UnixSocketListener listener;
+    int reader;
+};
+
+TEST_F(UnixSocketListenerTest, HeldTrackerReportReplaced) {
+    fill();
+    listener.broadcast(makePose(1));
+    ASSERT_EQ(2u, listener.getDroppedPackets());
+    auto packets = drain(1);
+    ASSERT_EQ(1u, packets.size());
+    ASSERT_EQ(DirectReportPacket::TRACKER, packets[0].getKind());
+    ASSERT_EQ(1, packets[0].getPose().translation.data[0]);
+}
+
+TEST_F(UnixSocketListenerTest, ButtonsAndNamesNeverReplaced) {
+    fill();
+    listener.broadcast(makeButton(OSVR_BUTTON_PRESSED));
+    listener.broadcast(makeButton(OSVR_BUTTON_NOT_PRESSED));
+    listener.broadcast(makeName(1, "com_osvr_Test/A"));
+    listener.broadcast(makeName(2, "com_osvr_Test/Longer"));
+    ASSERT_EQ(1u, listener.getDroppedPackets());
+    ASSERT_EQ(1u, listener.getNumClients());
+
+    auto packets = drain(4);
+    ASSERT_EQ(4u, packets.size());
+    ASSERT_EQ(DirectReportPacket::BUTTON, packets[0].getKind());
+    ASSERT_EQ(OSVR_BUTTON_PRESSED, packets[0].getButton(0));
+    ASSERT_EQ(DirectReportPacket::BUTTON, packets[1].getKind());
+    ASSERT_EQ(OSVR_BUTTON_NOT_PRESSED, packets[1].getButton(0));
+    ASSERT_EQ(DirectReportPacket::DEVICE_NAME, packets[2].getKind());
+    ASSERT_EQ("com_osvr_Test/A", packets[2].getDeviceName());
+    ASSERT_EQ(DirectReportPacket::DEVICE_NAME, packets[3].getKind());
+    ASSERT_EQ("com_osvr_Test/Longer", packets[3].getDeviceName());
+}
+
+#endif // OSVR_HAVE_UNIX_SOCKETS
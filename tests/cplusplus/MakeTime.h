@@ -0,0 +1,46 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MakeTime_h_GUID_0960905B_DA56_4D65_AB54_6354D4454D17
+#define INCLUDED_MakeTime_h_GUID_0960905B_DA56_4D65_AB54_6354D4454D17
+
+// Internal Includes
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+/// @brief Builds a time value from its parts, for test data.
+inline osvr::util::time::TimeValue
+makeTime(OSVR_TimeValue_Seconds sec, OSVR_TimeValue_Microseconds usec) {
+    osvr::util::time::TimeValue ret;
+    ret.seconds = sec;
+    ret.microseconds = usec;
+    return ret;
+}
+
+#endif // INCLUDED_MakeTime_h_GUID_0960905B_DA56_4D65_AB54_6354D4454D17
@@ -0,0 +1,172 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Server/Server.h>
+#include <osvr/Client/ClientContext.h>
+#include <osvr/Client/ClientInterface.h>
+#include <osvr/Client/CreateContext.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Common/RoutingKeys.h>
+#include <osvr/Util/ClientCallbackTypesC.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+#include <json/writer.h>
+#include <vrpn_Connection.h>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+using osvr::client::ClientContext;
+using osvr::client::ClientInterfacePtr;
+using osvr::connection::Connection;
+using osvr::connection::ConnectionPtr;
+using osvr::connection::DeviceInitObject;
+using osvr::connection::DeviceToken;
+using osvr::connection::DeviceTokenPtr;
+using osvr::connection::TrackerServerInterface;
+using osvr::server::Server;
+using osvr::server::ServerPtr;
+namespace routing_keys = osvr::common::routing_keys;
+
+/// Not the default port, so a running server doesn't get in the way.
+static const int TEST_PORT = 3896;
+static const std::string LOCALHOST("localhost");
+static const char HOST[] = "localhost:3896";
+static const char SOURCE_DEVICE[] = "com_osvr_Test/Tracker";
+static const char DESTINATION[] = "/me/head";
+
+/// @brief Reports each server sends: few enough that the sequence numbers
+/// of a restarted server stay within the window taken as reordering.
+static const std::size_t REPORTS = 100;
+
+/// @brief How long to wait for the client to see a report.
+static const double TIMEOUT = 10.0;
+
+inline std::string makeRoute() {
+    Json::Value source(Json::objectValue);
+    source["tracker"] = "/" + std::string(SOURCE_DEVICE);
+    source["sensor"] = 0;
+    Json::Value route(Json::objectValue);
+    route[routing_keys::destination()] = DESTINATION;
+    route[routing_keys::source()] = source;
+    Json::FastWriter writer;
+    return writer.write(route);
+}
+
+/// @brief A running server with a virtual tracker that sends REPORTS poses,
+/// each with a z of the given value, once a client has connected.
+class TrackerServer {
+  public:
+    explicit TrackerServer(double z)
+        : m_conn(Connection::createSharedConnection(LOCALHOST, TEST_PORT)),
+          m_server(Server::create(m_conn)), m_tracker(nullptr), m_sent(0) {
+        DeviceInitObject init(m_conn);
+        init.setName(SOURCE_DEVICE);
+        init.setTracker(&m_tracker);
+        m_token = DeviceToken::createVirtualDevice(init);
+        m_server->addRoute(makeRoute());
+
+        auto vrpnConn =
+            static_cast<vrpn_Connection *>(m_conn->getUnderlyingObject());
+        /// Slow enough that the client has its routes before the last.
+        m_server->setSleepTime(10000);
+        m_server->registerMainloopMethod([this, vrpnConn, z] {
+            if (m_sent < REPORTS && vrpnConn->connected()) {
+                OSVR_PoseState pose;
+                osvrPose3SetIdentity(&pose);
+                osvrVec3SetZ(&pose.translation, z);
+                OSVR_TimeValue now;
+                osvrTimeValueGetNow(&now);
+                m_tracker->sendReport(pose, 0, now);
+                ++m_sent;
+            }
+        });
+        m_server->start();
+    }
+
+    ~TrackerServer() { m_server->stop(); }
+
+    bool doneSending() const { return m_sent == REPORTS; }
+
+  private:
+    ConnectionPtr m_conn;
+    ServerPtr m_server;
+    TrackerServerInterface *m_tracker;
+    DeviceTokenPtr m_token;
+    std::atomic<std::size_t> m_sent;
+};
+
+static void recordPose(void *userdata, const OSVR_TimeValue *,
+                       const OSVR_PoseReport *report) {
+    *static_cast<double *>(userdata) = report->pose.translation.data[2];
+}
+
+/// @brief Updates the client context until the predicate is true, or the
+/// timeout has passed.
+inline bool updateUntil(ClientContext &ctx, std::function<bool()> done) {
+    namespace time = osvr::util::time;
+    time::TimeValue start;
+    time::getMonotonicNow(start);
+    time::TimeValue now = start;
+    while (time::duration(now, start) < TIMEOUT) {
+        ctx.update();
+        if (done()) {
+            return true;
+        }
+        boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+        time::getMonotonicNow(now);
+    }
+    return false;
+}
+
+TEST(ServerRestart, ClientAcceptsReportsFromRestartedServer) {
+    std::unique_ptr<ClientContext> ctx(
+        osvr::client::createContext("org.osvr.test.restart", HOST));
+    ClientInterfacePtr iface = ctx->getInterface(DESTINATION);
+    double z = 0;
+    iface->registerCallback(&recordPose, &z);
+
+    {
+        TrackerServer first(1);
+        ASSERT_TRUE(updateUntil(*ctx, [&] { return z == 1; }));
+        ASSERT_TRUE(updateUntil(*ctx, [&] { return first.doneSending(); }));
+    }
+    /// The restarted server numbers its reports from the start again: they
+    /// must not be taken as older than those of the first.
+    TrackerServer second(2);
+    ASSERT_TRUE(updateUntil(*ctx, [&] { return z == 2; }));
+}
@@ -0,0 +1,298 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Server/Server.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Common/PoseBatchMessage.h>
+#include <osvr/Common/RoutingKeys.h>
+#include <osvr/Common/TrackerStateMessage.h>
+#include <osvr/Util/QuatlibInteropC.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+#include <json/reader.h>
+#include <json/writer.h>
+#include <vrpn_Connection.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+using osvr::connection::Connection;
+using osvr::connection::ConnectionPtr;
+using osvr::connection::DeviceInitObject;
+using osvr::connection::DeviceToken;
+using osvr::connection::DeviceTokenPtr;
+using osvr::connection::TrackerServerInterface;
+using osvr::server::Server;
+using osvr::server::ServerPtr;
+using osvr::common::PoseBatchMessage;
+using osvr::common::TrackerStateMessage;
+namespace routing_keys = osvr::common::routing_keys;
+
+/// Not the default port, so a running server doesn't get in the way.
+static const int TEST_PORT = 3894;
+static const std::string LOCALHOST("localhost");
+static const char SOURCE_DEVICE[] = "com_osvr_Test/Tracker";
+static const char DESTINATION[] = "/me/head";
+static const char TRANSFORMED_DEVICE[] = "org_osvr_ServerRoute/me_head";
+
+/// @brief Makes a route to DESTINATION from a tracker, translated by 1 along
+/// x in the room.
+inline std::string makeRoute(std::string const &tracker, int sensor,
+                             bool serverTransform) {
+    Json::Value leaf(Json::objectValue);
+    leaf["tracker"] = tracker;
+    if (sensor >= 0) {
+        leaf["sensor"] = sensor;
+    }
+    Json::Value translate(Json::arrayValue);
+    translate.append(1);
+    translate.append(0);
+    translate.append(0);
+    Json::Value source(Json::objectValue);
+    source["posttranslate"] = translate;
+    source[routing_keys::child()] = leaf;
+    Json::Value route(Json::objectValue);
+    route[routing_keys::destination()] = DESTINATION;
+    route[routing_keys::source()] = source;
+    if (serverTransform) {
+        route[routing_keys::serverTransform()] = true;
+    }
+    Json::FastWriter writer;
+    return writer.write(route);
+}
+
+inline Json::Value parse(std::string const &json) {
+    Json::Reader reader;
+    Json::Value ret;
+    reader.parse(json, ret);
+    return ret;
+}
+
+inline OSVR_PoseState makePose(double z) {
+    OSVR_PoseState pose;
+    osvrPose3SetIdentity(&pose);
+    osvrVec3SetZ(&pose.translation, z);
+    return pose;
+}
+
+class ServerRoutes : public ::testing::Test {
+  public:
+    ServerRoutes()
+        : conn(Connection::createSharedConnection(LOCALHOST, TEST_PORT)),
+          server(Server::create(conn)), tracker(nullptr),
+          vrpnConn(static_cast<vrpn_Connection *>(
+              conn->getUnderlyingObject())) {
+        DeviceInitObject init(conn);
+        init.setName(SOURCE_DEVICE);
+        init.setTracker(&tracker);
+        token = DeviceToken::createVirtualDevice(init);
+        osvrTimeValueGetNow(&now);
+    }
+
+    /// @brief Registers a handler for an OSVR tracker message sent by the
+    /// transformed device.
+    void listen(const char *identifier, vrpn_MESSAGEHANDLER handler) {
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(identifier), handler, this,
+            vrpnConn->register_sender(TRANSFORMED_DEVICE));
+    }
+
+    static void VRPN_CALLBACK handlePose(void *userdata, vrpn_TRACKERCB info) {
+        auto self = static_cast<ServerRoutes *>(userdata);
+        OSVR_PoseState pose;
+        osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+        osvrVec3FromQuatlib(&(pose.translation), info.pos);
+        self->poses.push_back(pose);
+        self->sensors.push_back(info.sensor);
+    }
+
+    static int VRPN_CALLBACK handleBatch(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ServerRoutes *>(userdata);
+        const PoseBatchMessage msg(p.buffer, std::size_t(p.payload_len));
+        EXPECT_TRUE(msg.isValid());
+        const int32_t end = msg.getFirst() + int32_t(msg.getCount());
+        for (int32_t i = msg.getFirst(); i < end; ++i) {
+            self->poses.push_back(msg.getPose(i));
+            self->sensors.push_back(i);
+        }
+        return 0;
+    }
+
+    static int VRPN_CALLBACK handleState(void *userdata, vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ServerRoutes *>(userdata);
+        uint32_t sequence;
+        int32_t sensor;
+        OSVR_TrackerState state;
+        EXPECT_TRUE(TrackerStateMessage::decode(
+            p.buffer, std::size_t(p.payload_len), sequence, sensor, state));
+        self->states.push_back(state);
+        self->sensors.push_back(sensor);
+        return 0;
+    }
+
+    ConnectionPtr conn;
+    ServerPtr server;
+    TrackerServerInterface *tracker;
+    DeviceTokenPtr token;
+    vrpn_Connection *vrpnConn;
+    OSVR_TimeValue now;
+    std::vector<OSVR_PoseState> poses;
+    std::vector<OSVR_TrackerState> states;
+    std::vector<int> sensors;
+};
+
+TEST_F(ServerRoutes, ClientTransformsLeftAlone) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker", 1, false));
+    Json::Value source = parse(server->getSource(DESTINATION));
+    ASSERT_TRUE(source.isMember("posttranslate"));
+    ASSERT_EQ("/com_osvr_Test/Tracker",
+              source[routing_keys::child()]["tracker"].asString());
+}
+
+TEST_F(ServerRoutes, ServerTransformRewritesSource) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker", 1, true));
+    Json::Value source = parse(server->getSource(DESTINATION));
+    ASSERT_FALSE(source.isMember("posttranslate"));
+    ASSERT_FALSE(source.isMember(routing_keys::child()));
+    ASSERT_EQ("/" + std::string(TRANSFORMED_DEVICE),
+              source["tracker"].asString());
+    ASSERT_EQ(1, source["sensor"].asInt());
+    ASSERT_EQ(std::string::npos,
+              server->getRoutes().find(routing_keys::serverTransform()));
+}
+
+TEST_F(ServerRoutes, RemoteSourcesLeftToClients) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker@elsewhere", 1, true));
+    Json::Value source = parse(server->getSource(DESTINATION));
+    ASSERT_TRUE(source.isMember("posttranslate"));
+    ASSERT_EQ("/com_osvr_Test/Tracker@elsewhere",
+              source[routing_keys::child()]["tracker"].asString());
+}
+
+TEST_F(ServerRoutes, RepublishesPoses) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker", -1, true));
+    vrpn_Tracker_Remote remote(TRANSFORMED_DEVICE, vrpnConn);
+    remote.register_change_handler(this, &ServerRoutes::handlePose);
+
+    tracker->sendReport(makePose(1), 2, now);
+    ASSERT_EQ(1u, poses.size());
+    ASSERT_EQ(2, sensors[0]);
+    ASSERT_DOUBLE_EQ(1, osvrVec3GetX(&poses[0].translation));
+    ASSERT_DOUBLE_EQ(1, osvrVec3GetZ(&poses[0].translation));
+}
+
+TEST_F(ServerRoutes, RepublishesOnlyTheRoutedSensor) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker", 1, true));
+    vrpn_Tracker_Remote remote(TRANSFORMED_DEVICE, vrpnConn);
+    remote.register_change_handler(this, &ServerRoutes::handlePose);
+
+    tracker->sendReport(makePose(1), 0, now);
+    tracker->sendReport(makePose(1), 1, now);
+    ASSERT_EQ(1u, poses.size());
+    ASSERT_EQ(1, sensors[0]);
+}
+
+TEST_F(ServerRoutes, RepublishesBatches) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker", -1, true));
+    listen(PoseBatchMessage::identifier(), &ServerRoutes::handleBatch);
+
+    const OSVR_PoseState batch[] = {makePose(0), makePose(1), makePose(2)};
+    tracker->sendReports(batch, 3, now);
+    ASSERT_EQ(3u, poses.size());
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(i, sensors[i]);
+        ASSERT_DOUBLE_EQ(1, osvrVec3GetX(&poses[i].translation));
+        ASSERT_DOUBLE_EQ(i, osvrVec3GetZ(&poses[i].translation));
+    }
+}
+
+TEST_F(ServerRoutes, RepublishesStates) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker", -1, true));
+    listen(TrackerStateMessage::identifier(), &ServerRoutes::handleState);
+
+    OSVR_TrackerState state = {};
+    state.pose = makePose(1);
+    osvrVec3SetX(&state.linearVelocity, 2);
+    osvrVec3SetX(&state.linearAcceleration, 3);
+    state.flags = OSVR_TRACKER_POSITION_VALID |
+                  OSVR_TRACKER_ORIENTATION_VALID |
+                  OSVR_TRACKER_LINEAR_VELOCITY_VALID |
+                  OSVR_TRACKER_LINEAR_ACCELERATION_VALID;
+    tracker->sendReport(state, 3, now);
+    ASSERT_EQ(1u, states.size());
+    ASSERT_EQ(3, sensors[0]);
+    ASSERT_DOUBLE_EQ(1, osvrVec3GetX(&states[0].pose.translation));
+    ASSERT_DOUBLE_EQ(1, osvrVec3GetZ(&states[0].pose.translation));
+    /// A translation in the room doesn't change the velocity, but
+    /// accelerations are never republished.
+    ASSERT_TRUE(states[0].flags & OSVR_TRACKER_LINEAR_VELOCITY_VALID);
+    ASSERT_DOUBLE_EQ(2, osvrVec3GetX(&states[0].linearVelocity));
+    ASSERT_FALSE(states[0].flags & OSVR_TRACKER_LINEAR_ACCELERATION_VALID);
+}
+
+TEST_F(ServerRoutes, MalformedFilterRejectsRoute) {
+    Json::Value route = parse(makeRoute("/com_osvr_Test/Tracker", -1, false));
+    Json::Value filter(Json::objectValue);
+    filter["type"] = "noSuchFilter";
+    route[routing_keys::serverFilter()] = filter;
+    ASSERT_THROW(server->addRoute(route.toStyledString()), std::runtime_error);
+    ASSERT_TRUE(server->getSource(DESTINATION).empty());
+
+    route[routing_keys::serverFilter()] = "exponential";
+    ASSERT_THROW(server->addRoute(route.toStyledString()), std::runtime_error);
+    ASSERT_TRUE(server->getSource(DESTINATION).empty());
+}
+
+TEST_F(ServerRoutes, UnappliableFilterRejectsRoute) {
+    Json::Value route =
+        parse(makeRoute("/com_osvr_Test/Tracker@elsewhere", 1, false));
+    Json::Value filter(Json::objectValue);
+    filter["type"] = "exponential";
+    route[routing_keys::serverFilter()] = filter;
+    ASSERT_THROW(server->addRoute(route.toStyledString()), std::runtime_error);
+    ASSERT_TRUE(server->getSource(DESTINATION).empty());
+}
+
+TEST_F(ServerRoutes, OutOfRangeSensorsIgnored) {
+    server->addRoute(makeRoute("/com_osvr_Test/Tracker", -1, true));
+    vrpn_Tracker_Remote remote(TRANSFORMED_DEVICE, vrpnConn);
+    remote.register_change_handler(this, &ServerRoutes::handlePose);
+
+    tracker->sendReport(makePose(1), 100000, now);
+    ASSERT_TRUE(poses.empty());
+    tracker->sendReport(makePose(1), 2, now);
+    ASSERT_EQ(1u, poses.size());
+}
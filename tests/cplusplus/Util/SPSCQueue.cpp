@@ -0,0 +1,110 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/SPSCQueue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <memory>
+
+using osvr::util::SPSCQueue;
+
+TEST(SPSCQueue, InitiallyEmpty) {
+    SPSCQueue<int> q(4);
+    ASSERT_TRUE(q.empty());
+    ASSERT_EQ(4u, q.capacity());
+    int val = 0;
+    ASSERT_FALSE(q.pop(val));
+}
+
+TEST(SPSCQueue, FirstInFirstOut) {
+    SPSCQueue<int> q(4);
+    ASSERT_TRUE(q.push(1));
+    ASSERT_TRUE(q.push(2));
+    ASSERT_FALSE(q.empty());
+    int val = 0;
+    ASSERT_TRUE(q.pop(val));
+    ASSERT_EQ(1, val);
+    ASSERT_TRUE(q.pop(val));
+    ASSERT_EQ(2, val);
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(SPSCQueue, PushFailsWhenFull) {
+    SPSCQueue<int> q(2);
+    ASSERT_TRUE(q.push(1));
+    ASSERT_TRUE(q.push(2));
+    ASSERT_FALSE(q.push(3));
+    int val = 0;
+    ASSERT_TRUE(q.pop(val));
+    ASSERT_TRUE(q.push(3));
+    ASSERT_TRUE(q.pop(val));
+    ASSERT_EQ(2, val);
+    ASSERT_TRUE(q.pop(val));
+    ASSERT_EQ(3, val);
+}
+
+TEST(SPSCQueue, PopReleasesSlot) {
+    SPSCQueue<std::shared_ptr<int> > q(2);
+    auto ptr = std::make_shared<int>(5);
+    ASSERT_TRUE(q.push(ptr));
+    ASSERT_EQ(2, ptr.use_count());
+    std::shared_ptr<int> out;
+    ASSERT_TRUE(q.pop(out));
+    out.reset();
+    ASSERT_EQ(1, ptr.use_count());
+}
+
+TEST(SPSCQueue, AcrossThreads) {
+    static const int COUNT = 100000;
+    SPSCQueue<int> q(64);
+    boost::thread producer([&] {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!q.push(i)) {
+                boost::this_thread::yield();
+            }
+        }
+    });
+    bool inOrder = true;
+    int expected = 0;
+    while (expected < COUNT) {
+        int val;
+        if (q.pop(val)) {
+            if (val != expected) {
+                inOrder = false;
+            }
+            ++expected;
+        } else {
+            boost::this_thread::yield();
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(inOrder);
+    ASSERT_TRUE(q.empty());
+}
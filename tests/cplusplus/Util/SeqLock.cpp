@@ -0,0 +1,80 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/SeqLock.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+
+using osvr::util::SeqLocked;
+
+struct Triple {
+    int a;
+    int b;
+    int c;
+};
+
+TEST(SeqLocked, InitiallyEmpty) {
+    SeqLocked<int> val;
+    ASSERT_FALSE(val.hasValue());
+    ASSERT_EQ(0, val.load());
+}
+
+TEST(SeqLocked, StoreLoad) {
+    SeqLocked<Triple> val;
+    Triple t = {1, 2, 3};
+    val.store(t);
+    ASSERT_TRUE(val.hasValue());
+    Triple out = val.load();
+    ASSERT_EQ(1, out.a);
+    ASSERT_EQ(2, out.b);
+    ASSERT_EQ(3, out.c);
+}
+
+TEST(SeqLocked, ReadersNeverSeeTornValues) {
+    SeqLocked<Triple> val;
+    std::atomic<bool> done(false);
+    boost::thread writer([&] {
+        for (int i = 0; i < 200000; ++i) {
+            Triple t = {i, i * 2, i * 3};
+            val.store(t);
+        }
+        done = true;
+    });
+    bool consistent = true;
+    while (!done) {
+        Triple t = val.load();
+        if (t.b != t.a * 2 || t.c != t.a * 3) {
+            consistent = false;
+        }
+    }
+    writer.join();
+    ASSERT_TRUE(consistent);
+}
@@ -0,0 +1,80 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::util::time::TimeValue;
+
+static bool isNotBefore(TimeValue const &later, TimeValue const &earlier) {
+    TimeValue diff = later;
+    osvrTimeValueDifference(&diff, &earlier);
+    return diff.seconds >= 0 && diff.microseconds >= 0;
+}
+
+TEST(TimeValue, monotonicNeverStepsBackwards) {
+    TimeValue prev;
+    osvr::util::time::getMonotonicNow(prev);
+    for (int i = 0; i < 10000; ++i) {
+        TimeValue now;
+        osvr::util::time::getMonotonicNow(now);
+        ASSERT_TRUE(isNotBefore(now, prev));
+        prev = now;
+    }
+}
+
+TEST(TimeValue, monotonicIsNormalized) {
+    TimeValue now;
+    osvr::util::time::getMonotonicNow(now);
+    ASSERT_GE(now.microseconds, 0);
+    ASSERT_LT(now.microseconds, 1000000);
+}
+
+#ifdef OSVR_HAVE_STRUCT_TIMEVAL
+TEST(TimeValue, steadyNowIsNearWallClock) {
+    TimeValue wall;
+    osvr::util::time::getNow(wall);
+    TimeValue steady;
+    osvr::util::time::getSteadyNow(steady);
+    TimeValue diff = steady;
+    osvrTimeValueDifference(&diff, &wall);
+    ASSERT_EQ(0, diff.seconds);
+}
+
+TEST(TimeValue, monotonicToWallClockMatchesSteadyNow) {
+    TimeValue mono;
+    osvr::util::time::getMonotonicNow(mono);
+    TimeValue steady;
+    osvr::util::time::getSteadyNow(steady);
+    ASSERT_TRUE(
+        isNotBefore(steady, osvr::util::time::monotonicToWallClock(mono)));
+}
+#endif